@@ -111,7 +111,7 @@ void CAirtank::TankTouch( CBaseEntity *pOther )
 	EMIT_SOUND( ENT(pev), CHAN_VOICE, "doors/aliendoor3.wav", 1.0, ATTN_NORM );
 
 	// recharge airtank in 30 seconds
-	pev->nextthink = gpGlobals->time + 30;
+	SetNextThink( 30 );
 	m_state = 0;
 	SUB_UseTargets( this, USE_TOGGLE, 1 );
 }
@@ -24,6 +24,7 @@
 #include	"gamerules.h"
 #include	"weapons.h"
 #include	"game.h"
+#include	"thinkqueue.h"
 
 //#define USE_ENGINE_TOUCH_TRIGGERS
 
@@ -36,11 +37,18 @@ static CUtlArray<CBaseEntity *>	g_TeleportStack;
 void CBaseEntity :: DontThink( void )
 {
 	pev->nextthink = 0;
+	g_pThinkQueue->Schedule( this );
 }
 
 void CBaseEntity :: SetNextThink( float delay )
 {
-	pev->nextthink = gpGlobals->time + delay;
+	SetAbsNextThink( gpGlobals->time + delay );
+}
+
+void CBaseEntity :: SetAbsNextThink( float time )
+{
+	pev->nextthink = time;
+	g_pThinkQueue->Schedule( this );
 }
 
 //-----------------------------------------------------------------------------
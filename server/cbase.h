@@ -173,6 +173,10 @@ public:
 
 	// physics stuff
 	unsigned int	m_iPhysicsFrame;	// to avoid executing one entity twice per frame
+	float		m_flScheduledThink;	// pev->nextthink known by think queue
+	unsigned int	m_iThinkFrame;	// to avoid executing one think twice per frame
+	BOOL		m_fSleeping;	// resting entity, physics is skipped until something wakes it
+	int		m_iRestFrames;	// how many frames entity was at rest
 
 	// A counter to help quickly build a list of potentially pushed objects for physics
 	int		m_iPushEnumCount;
@@ -386,7 +390,9 @@ public:
 	void SetBaseVelocity( const Vector& v ) { pev->basevelocity = v; }
 
 	virtual void	SetNextThink( float delay );
+	void		SetAbsNextThink( float time );
 	void		DontThink( void );
+	void		WakeUp( void ) { m_fSleeping = FALSE; m_iRestFrames = 0; }
 
 	// global concept of "entities with states", so that state_watchers and
 	// mastership (mastery? masterhood?) can work universally.
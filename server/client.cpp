@@ -38,6 +38,9 @@
 #include "weaponinfo.h"
 #include "usercmd.h"
 #include "netadr.h"
+#include "ropes/CRopeSystem.h"
+#include "profiler.h"
+#include "thinkqueue.h"
 
 extern DLL_GLOBAL ULONG		g_ulModelIndexPlayer;
 extern DLL_GLOBAL BOOL		g_fGameOver;
@@ -572,6 +575,9 @@ void ServerDeactivate( void )
 	// Peform any shutdown operations here...
 	WorldPhysic->FreeAllBodies();
 
+	// profiler keeps the classname pointers
+	PROFILE_RESET();
+
 	// purge all strings
 	g_GameStringPool.FreeAll();
 	g_GameStringPool.MakeEmptyString();
@@ -673,6 +679,10 @@ void StartFrame( void )
 {
 //	ALERT( at_console, "SV_Physics( %g, frametime %g )\n", gpGlobals->time, gpGlobals->frametime );
 
+	// previous frame is finished
+	PROFILE_FRAME();
+	PROFILE_SCOPE( PROF_FRAME, "StartFrame" );
+
 	if ( g_pGameRules )
 		g_pGameRules->Think();
 
@@ -681,6 +691,9 @@ void StartFrame( void )
 
 	gpGlobals->teamplay = teamplay.value;
 	g_ulFrameCount++;
+
+	// thinks are running before any movement
+	g_pThinkQueue->RunThinks();
 }
 
 void EndFrame( void )
@@ -688,8 +701,13 @@ void EndFrame( void )
 	if ( g_fGameOver )
 		return;
 
+	PROFILE_SCOPE( PROF_FRAME, "EndFrame" );
+
 	// update physic step
 	WorldPhysic->Update( gpGlobals->frametime );
+
+	// step all awake ropes together
+	g_RopeSystem.Simulate();
 }
 
 void ClientPrecache( void )
@@ -1010,6 +1028,71 @@ void SetupVisibility( edict_t *pViewEntity, edict_t *pClient, unsigned char **pv
 
 #include "entity_state.h"
 
+//
+// per-frame entity data what doesn't depend on the client
+//
+#define SENDINFO_INTERMISSION		BIT( 0 )
+
+typedef struct
+{
+	unsigned int	frame;
+	int		serialnumber;
+	string_t		classname;
+	string_t		weaponmodel;
+	int		weaponindex;	// MODEL_INDEX of weaponmodel
+	int		flags;
+} sendinfo_t;
+
+static sendinfo_t	*g_pSendInfo = NULL;
+static int	g_iMaxSendInfo = 0;
+
+static const sendinfo_t *GetSendInfo( int e, edict_t *ent )
+{
+	if( e >= g_iMaxSendInfo )
+	{
+		free( g_pSendInfo );
+		g_iMaxSendInfo = Q_max( gpGlobals->maxEntities, e + 1 );
+		g_pSendInfo = (sendinfo_t *)calloc( g_iMaxSendInfo, sizeof( sendinfo_t ));
+	}
+
+	sendinfo_t *info = &g_pSendInfo[e];
+
+	// already evaluated by previous client
+	if( info->frame == g_ulFrameCount && info->serialnumber == ent->serialnumber && info->classname == ent->v.classname && info->weaponmodel == ent->v.weaponmodel )
+		return info;
+
+	info->frame = g_ulFrameCount;
+	info->serialnumber = ent->serialnumber;
+	info->classname = ent->v.classname;
+	info->weaponmodel = ent->v.weaponmodel;
+	info->weaponindex = ent->v.weaponmodel ? MODEL_INDEX( STRING( ent->v.weaponmodel )) : 0;
+	info->flags = FClassnameIs( &ent->v, "info_intermission" ) ? SENDINFO_INTERMISSION : 0;
+
+	return info;
+}
+
+//
+// test entity leafs against the client PVS bits directly
+//
+static BOOL CheckEntityVisibility( const edict_t *ent, unsigned char *pSet )
+{
+	if( !pSet ) return TRUE;
+
+	// beams are upcasted to owner and big entities are checked by headnode, let the engine do it
+	if( ent->headnode >= 0 || FBitSet( ent->v.flags, FL_CUSTOMENTITY ))
+		return ENGINE_CHECK_VISIBILITY( ent, pSet ) ? TRUE : FALSE;
+
+	for( int i = 0; i < ent->num_leafs; i++ )
+	{
+		int leafnum = ent->leafnums[i];
+
+		if( pSet[leafnum >> 3] & BIT( leafnum & 7 ))
+			return TRUE;
+	}
+
+	return FALSE;
+}
+
 /*
 AddToFullPack
 
@@ -1025,6 +1108,7 @@ we could also use the pas/ pvs that we set in SetupVisibility, if we wanted to.
 */
 int AddToFullPack( struct entity_state_s *state, int e, edict_t *ent, edict_t *host, int hostflags, int player, unsigned char *pSet )
 {
+	PROFILE_SCOPE( PROF_FULLPACK, STRING( ent->v.classname ));
 	int	i;
 
 	// don't send if flagged for NODRAW and it's not the host getting the message
@@ -1052,12 +1136,12 @@ int AddToFullPack( struct entity_state_s *state, int e, edict_t *ent, edict_t *h
 	// If pSet is NULL, then the test will always succeed and the entity will be added to the update
 	if ( ent != host )
 	{
-		if ( !ENGINE_CHECK_VISIBILITY( (const struct edict_s *)ent, pSet ) )
+		if ( !CheckEntityVisibility( ent, pSet ) )
 		{
 			if( FBitSet( ent->v.effects, EF_PROJECTED_LIGHT ))
 			{
 				// projected light have second PVS point so we must check her too
-				if ( !ENGINE_CHECK_VISIBILITY( (const struct edict_s *)ent->v.enemy, pSet ) )
+				if ( !CheckEntityVisibility( ent->v.enemy, pSet ) )
 					return 0;				
 			}
 			else
@@ -1074,28 +1158,15 @@ int AddToFullPack( struct entity_state_s *state, int e, edict_t *ent, edict_t *h
 			return 0;
 	}
 	
-	if ( host->v.groupinfo )
+	// host groups are always tested with GROUP_OP_AND, so don't bother the engine with group trace mask
+	if ( host->v.groupinfo && ent->v.groupinfo )
 	{
-		UTIL_SetGroupTrace( host->v.groupinfo, GROUP_OP_AND );
-
-		// Should always be set, of course
-		if ( ent->v.groupinfo )
-		{
-			if ( g_groupop == GROUP_OP_AND )
-			{
-				if ( !(ent->v.groupinfo & host->v.groupinfo ) )
-					return 0;
-			}
-			else if ( g_groupop == GROUP_OP_NAND )
-			{
-				if ( ent->v.groupinfo & host->v.groupinfo )
-					return 0;
-			}
-		}
-
-		UTIL_UnsetGroupTrace();
+		if ( !(ent->v.groupinfo & host->v.groupinfo ) )
+			return 0;
 	}
 
+	const sendinfo_t *info = GetSendInfo( e, ent );
+
 	memset( state, 0, sizeof( *state ) );
 
 	// Assign index so we can track this entity from frame to frame and
@@ -1151,7 +1222,7 @@ int AddToFullPack( struct entity_state_s *state, int e, edict_t *ent, edict_t *h
 		state->eflags |= EFLAG_SLERP;
 	}
 
-	if( FClassnameIs( &ent->v, "info_intermission" ))
+	if( FBitSet( info->flags, SENDINFO_INTERMISSION ))
 	{
 		state->eflags |= EFLAG_INTERMISSION;
 	}
@@ -1238,7 +1309,6 @@ int AddToFullPack( struct entity_state_s *state, int e, edict_t *ent, edict_t *h
 	{
 		memcpy( state->basevelocity, ent->v.basevelocity, 3 * sizeof( float ) );
 
-		state->weaponmodel  = MODEL_INDEX( STRING( ent->v.weaponmodel ) );
 		state->gaitsequence = ent->v.gaitsequence;
 		state->spectator = ent->v.flags & FL_SPECTATOR;
 		state->friction     = ent->v.friction;
@@ -1249,7 +1319,7 @@ int AddToFullPack( struct entity_state_s *state, int e, edict_t *ent, edict_t *h
 		state->health		= ent->v.health;
 	}
 
-	state->weaponmodel  = MODEL_INDEX( STRING( ent->v.weaponmodel ) );
+	state->weaponmodel  = info->weaponindex;
 	state->team	= ent->v.team;
 
 	return 1;
@@ -29,6 +29,7 @@
 #include "animation.h"
 #include "weapons.h"
 #include "func_break.h"
+#include "sightcache.h"
 
 extern DLL_GLOBAL Vector		g_vecAttackDir;
 extern DLL_GLOBAL int		g_iSkillLevel;
@@ -334,7 +335,7 @@ void CBaseMonster :: GibMonster( void )
 		{
 			// don't remove players!
 			SetThink( &CBaseEntity::SUB_Remove );
-			pev->nextthink = gpGlobals->time;
+			SetNextThink( 0 );
 		}
 		else
 		{
@@ -664,7 +665,7 @@ void CBaseEntity :: SUB_StartFadeOut ( void )
 	pev->solid = SOLID_NOT;
 	SetLocalAvelocity( g_vecZero );
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	SetThink( &CBaseEntity::SUB_FadeOut );
 }
 
@@ -673,12 +674,12 @@ void CBaseEntity :: SUB_FadeOut ( void  )
 	if ( pev->renderamt > 7 )
 	{
 		pev->renderamt -= 7;
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 	else 
 	{
 		pev->renderamt = 0;
-		pev->nextthink = gpGlobals->time + 0.2;
+		SetNextThink( 0.2 );
 		SetThink( &CBaseEntity::SUB_Remove );
 	}
 }
@@ -1258,12 +1259,15 @@ BOOL CBaseEntity :: FVisible ( CBaseEntity *pEntity )
 	if(( pev->waterlevel != 3 && pEntity->pev->waterlevel == 3 ) || ( pev->waterlevel == 3 && pEntity->pev->waterlevel == 0 ))
 		return FALSE;
 
+	if( !FClassnameIs( pEntity, "monster_target" ))
+		return g_pSightCache->TestVisible( this, pEntity );
+
 	vecLookerOrigin = EyePosition(); // look through the caller's 'eyes'
 	vecTargetOrigin = pEntity->EyePosition();
 
 	UTIL_TraceLine(vecLookerOrigin, vecTargetOrigin, ignore_monsters, ignore_glass, ENT(pev)/*pentIgnore*/, &tr);
 
-	if( FClassnameIs( pEntity, "monster_target" ) && tr.fInOpen )
+	if( tr.fInOpen )
 		return TRUE; // monster_target can't be tracelined as well
 	
 	if( tr.flFraction != 1.0 )//&& tr.pHit != ENT( pEntity->pev ))
@@ -1276,6 +1280,173 @@ BOOL CBaseEntity :: FVisible ( CBaseEntity *pEntity )
 	}
 }
 
+//=========================================================
+// Sight cache - line of sight between monsters and clients
+// is traced once per frame for each pair
+//=========================================================
+CSightCache	s_SightCache;
+CSightCache	*g_pSightCache = &s_SightCache;
+
+void CSightCache :: CheckFrame( void )
+{
+	if( m_iFrame == g_ulFrameCount )
+		return;
+
+	// entries and queries from previous frames are outdated now
+	m_iFrame = g_ulFrameCount;
+	m_iNumQueries = 0;
+}
+
+BOOL CSightCache :: CanCache( CBaseEntity *pLooker, CBaseEntity *pTarget )
+{
+	// only entities ignored by the sight trace itself give the same result for both directions
+	if( !FBitSet( pLooker->pev->flags, FL_MONSTER|FL_CLIENT ) || pLooker->pev->solid == SOLID_BSP )
+		return FALSE;
+
+	if( !FBitSet( pTarget->pev->flags, FL_MONSTER|FL_CLIENT ) || pTarget->pev->solid == SOLID_BSP )
+		return FALSE;
+
+	return TRUE;
+}
+
+sightentry_t *CSightCache :: FindEntry( CBaseEntity *pLooker, CBaseEntity *pTarget, const Vector &vecLooker, const Vector &vecTarget, BOOL &found )
+{
+	int	looker = pLooker->entindex();
+	int	target = pTarget->entindex();
+	Vector	vecEyes[2];
+
+	if( looker > target )
+	{
+		int temp = looker;
+		looker = target;
+		target = temp;
+		vecEyes[0] = vecTarget;
+		vecEyes[1] = vecLooker;
+	}
+	else
+	{
+		vecEyes[0] = vecLooker;
+		vecEyes[1] = vecTarget;
+	}
+
+	unsigned int hash = ((unsigned int)looker * 2654435761U) ^ (unsigned int)target;
+	sightentry_t *pFree = NULL;
+
+	for( int i = 0; i < SIGHT_CACHE_PROBES; i++ )
+	{
+		sightentry_t *entry = &m_entries[(hash + i) & (SIGHT_CACHE_SIZE - 1)];
+
+		if( entry->frame != m_iFrame )
+		{
+			if( !pFree ) pFree = entry;
+			continue;
+		}
+
+		if( entry->entity[0] != looker || entry->entity[1] != target )
+			continue;
+
+		// same pair, but somebody has moved since
+		if( entry->vecEyes[0] != vecEyes[0] || entry->vecEyes[1] != vecEyes[1] )
+		{
+			pFree = entry;
+			break;
+		}
+
+		found = TRUE;
+		return entry;
+	}
+
+	// all the probes are used, replace the first one
+	if( !pFree ) pFree = &m_entries[hash & (SIGHT_CACHE_SIZE - 1)];
+
+	pFree->frame = m_iFrame;
+	pFree->entity[0] = looker;
+	pFree->entity[1] = target;
+	pFree->vecEyes[0] = vecEyes[0];
+	pFree->vecEyes[1] = vecEyes[1];
+	found = FALSE;
+
+	return pFree;
+}
+
+BOOL CSightCache :: TraceSight( CBaseEntity *pLooker, const Vector &vecLooker, const Vector &vecTarget )
+{
+	TraceResult tr;
+
+	UTIL_TraceLine( vecLooker, vecTarget, ignore_monsters, ignore_glass, pLooker->edict(), &tr );
+
+	return (tr.flFraction == 1.0f) ? TRUE : FALSE;
+}
+
+BOOL CSightCache :: TestVisible( CBaseEntity *pLooker, CBaseEntity *pTarget )
+{
+	Vector vecLooker = pLooker->EyePosition();
+	Vector vecTarget = pTarget->EyePosition();
+
+	CheckFrame();
+
+	if( !CanCache( pLooker, pTarget ))
+		return TraceSight( pLooker, vecLooker, vecTarget );
+
+	BOOL found;
+	sightentry_t *entry = FindEntry( pLooker, pTarget, vecLooker, vecTarget, found );
+
+	if( !found ) entry->fVisible = TraceSight( pLooker, vecLooker, vecTarget );
+
+	return entry->fVisible;
+}
+
+void CSightCache :: AddQuery( CBaseEntity *pLooker, CBaseEntity *pTarget )
+{
+	CheckFrame();
+
+	// no reasons to defer this check
+	if( !CanCache( pLooker, pTarget ))
+		return;
+
+	if( m_iNumQueries >= MAX_SIGHT_QUERIES )
+		RunQueries();
+
+	m_queries[m_iNumQueries].pLooker = pLooker;
+	m_queries[m_iNumQueries].pTarget = pTarget;
+	m_iNumQueries++;
+}
+
+//=========================================================
+// RunQueries - resolve all the pending checks. Targets
+// outside of looker PVS can't be seen and aren't traced
+//=========================================================
+void CSightCache :: RunQueries( void )
+{
+	CBaseEntity *pLastLooker = NULL;
+	byte *pvs = NULL;
+
+	CheckFrame();
+
+	for( int i = 0; i < m_iNumQueries; i++ )
+	{
+		sightquery_t *query = &m_queries[i];
+		Vector vecLooker = query->pLooker->EyePosition();
+		Vector vecTarget = query->pTarget->EyePosition();
+		BOOL found;
+
+		sightentry_t *entry = FindEntry( query->pLooker, query->pTarget, vecLooker, vecTarget, found );
+		if( found ) continue;
+
+		if( query->pLooker != pLastLooker )
+		{
+			pvs = ENGINE_SET_PVS( (float *)&vecLooker );
+			pLastLooker = query->pLooker;
+		}
+
+		if( pvs && !ENGINE_CHECK_VISIBILITY( query->pTarget->edict(), pvs ))
+			entry->fVisible = FALSE;
+		else entry->fVisible = TraceSight( query->pLooker, vecLooker, vecTarget );
+	}
+
+	m_iNumQueries = 0;
+}
+
 //=========================================================
 // FVisible - returns true if a line can be traced from
 // the caller's eyes to the target vector
@@ -79,7 +79,7 @@ void CCrossbowBolt::Spawn( void )
 
 	SetTouch( &CCrossbowBolt::BoltTouch );
 	SetThink( &CCrossbowBolt::BubbleThink );
-	pev->nextthink = gpGlobals->time + 0.2;
+	SetNextThink( 0.2 );
 }
 
 void CCrossbowBolt::Precache( )
@@ -201,7 +201,7 @@ void CCrossbowBolt::BoltTouch( CBaseEntity *pOther )
 	else
 	{
 		EMIT_SOUND_DYN(ENT(pev), CHAN_BODY, "weapons/xbow_hit1.wav", RANDOM_FLOAT(0.95, 1.0), ATTN_NORM, 0, 98 + RANDOM_LONG(0,7));
-		pev->nextthink = gpGlobals->time;// this will get changed below if the bolt is allowed to stick in what it hit.
+		SetNextThink( 0 );// this will get changed below if the bolt is allowed to stick in what it hit.
 		SetThink( &CBaseEntity::SUB_Remove );
 
 		if( UTIL_GetModelType( pOther->pev->modelindex ) == mod_brush || pOther->pev->solid == SOLID_CUSTOM )
@@ -231,7 +231,7 @@ void CCrossbowBolt::BoltTouch( CBaseEntity *pOther )
 	if ( g_pGameRules->IsMultiplayer() )
 	{
 		SetThink( &CCrossbowBolt::ExplodeThink );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 }
 
@@ -243,7 +243,7 @@ void CCrossbowBolt :: OnTeleport( void )
 
 void CCrossbowBolt::BubbleThink( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if( pev->waterlevel == 0 )
 		return;
@@ -501,11 +501,11 @@ void CCrossbow::FireSniperBolt()
 		if( FClassnameIs( tr.pHit, "worldspawn" ))
 		{
 			// let the bolt sit around for a while if it hit static architecture
-			pBolt->pev->nextthink = gpGlobals->time + 5.0;
+			pBolt->SetNextThink( 5.0 );
 		}
 		else
 		{
-			pBolt->pev->nextthink = gpGlobals->time;
+			pBolt->SetNextThink( 0 );
 		}
 	}
 }
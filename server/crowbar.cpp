@@ -165,7 +165,7 @@ void CCrowbar::PrimaryAttack( void )
 	if (! Swing( 1 ))
 	{
 		SetThink( &CCrowbar::SwingAgain );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 }
 
@@ -321,7 +321,7 @@ int CCrowbar::Swing( int fFirst )
 		// delay the decal a bit
 		m_trHit = tr;
 		SetThink( &CCrowbar::Smack );
-		pev->nextthink = gpGlobals->time + 0.2;
+		SetNextThink( 0.2 );
 
 		m_pPlayer->m_iWeaponVolume = flVol * CROWBAR_WALLHIT_VOLUME;
 	}
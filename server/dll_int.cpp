@@ -27,6 +27,8 @@
 #include	"client.h"
 #include	"game.h"
 #include	"gamerules.h"
+#include	"profiler.h"
+#include	"thinkqueue.h"
 
 // Holds engine functionality callbacks
 enginefuncs_t g_engfuncs;
@@ -266,7 +268,10 @@ void DispatchTouch( edict_t *pentTouched, edict_t *pentOther )
 	CBaseEntity *pOther = (CBaseEntity *)GET_PRIVATE( pentOther );
 
 	if ( pEntity && pOther && ! ((pEntity->pev->flags | pOther->pev->flags) & FL_KILLME) )
+	{
+		PROFILE_FUNCTION( PROF_TOUCH, pEntity->GetClassname(), pEntity->GetDataDescMap(), *(reinterpret_cast<void **>(&pEntity->m_pfnTouch)) );
 		pEntity->Touch( pOther );
+	}
 }
 
 void DispatchUse( edict_t *pentUsed, edict_t *pentOther )
@@ -286,7 +291,8 @@ void DispatchThink( edict_t *pent )
 	{
 		if( FBitSet( pEntity->pev->flags, FL_DORMANT ))
 			ALERT( at_error, "Dormant entity %s is thinking!!\n", pEntity->GetClassname() );
-				
+
+		PROFILE_FUNCTION( PROF_THINK, pEntity->GetClassname(), pEntity->GetDataDescMap(), *(reinterpret_cast<void **>(&pEntity->m_pfnThink)) );
 		pEntity->Think();
 	}
 }
@@ -423,6 +429,9 @@ int DispatchRestore( edict_t *pent, SAVERESTOREDATA *pSaveData, int globalEntity
 		// Again, could be deleted, get the pointer again.
 		pEntity = (CBaseEntity *)GET_PRIVATE(pent);
 
+		// pev->nextthink was restored directly
+		if( pEntity ) g_pThinkQueue->Schedule( pEntity );
+
 		// Is this an overriding global entity (coming over the transition), or one restoring in a level
 		if ( globalEntity )
 		{
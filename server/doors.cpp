@@ -305,7 +305,7 @@ void CBaseDoor::Spawn( void )
 			if( flTravelTime < 0.1f )
 			{
 				pev->velocity = g_vecZero;
-				pev->nextthink = pev->ltime + 0.1f;
+				SetAbsNextThink( pev->ltime + 0.1f );
 				return;
 			}
 		}
@@ -859,7 +859,7 @@ void CRotDoor :: Spawn( void )
 			if( flTravelTime < 0.1f )
 			{
 				pev->avelocity = g_vecZero;
-				pev->nextthink = pev->ltime + 0.1f;
+				SetAbsNextThink( pev->ltime + 0.1f );
 				return;
 			}
 		}
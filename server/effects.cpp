@@ -116,7 +116,7 @@ void CBubbling::Spawn( void )
 	if ( !(pev->spawnflags & SF_BUBBLES_STARTOFF) )
 	{
 		SetThink( &CBubbling::FizzThink );
-		pev->nextthink = gpGlobals->time + 2.0;
+		SetNextThink( 2.0 );
 		m_state = 1;
 	}
 	else 
@@ -137,12 +137,12 @@ void CBubbling::Use( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE use
 	if ( m_state )
 	{
 		SetThink( &CBubbling::FizzThink );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 	else
 	{
 		SetThink( NULL );
-		pev->nextthink = 0;
+		DontThink();
 	}
 }
 
@@ -179,9 +179,9 @@ void CBubbling::FizzThink( void )
 	MESSAGE_END();
 
 	if ( m_frequency > 19 )
-		pev->nextthink = gpGlobals->time + 0.5;
+		SetNextThink( 0.5 );
 	else
-		pev->nextthink = gpGlobals->time + 2.5 - (0.1 * m_frequency);
+		SetNextThink( 2.5 - (0.1 * m_frequency) );
 }
 
 // --------------------------------------------------
@@ -549,7 +549,7 @@ void CLightning::Spawn( void )
 		if ( pev->dmg > 0 )
 		{
 			SetThink( &CLightning::DamageThink );
-			pev->nextthink = gpGlobals->time + 0.1;
+			SetNextThink( 0.1 );
 		}
 		if ( pev->targetname )
 		{
@@ -575,7 +575,7 @@ void CLightning::Spawn( void )
 		if ( FStringNull(pev->targetname) || FBitSet(pev->spawnflags, SF_BEAM_STARTON) )
 		{
 			SetThink( &CLightning::StrikeThink );
-			pev->nextthink = gpGlobals->time + 1.0;
+			SetNextThink( 1.0 );
 		}
 	}
 }
@@ -676,7 +676,7 @@ void CLightning::ToggleUse( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_T
 		DoSparks( GetAbsStartPos(), GetAbsEndPos() );
 		if ( pev->dmg > 0 )
 		{
-			pev->nextthink = gpGlobals->time;
+			SetNextThink( 0 );
 			pev->dmgtime = gpGlobals->time;
 		}
 	}
@@ -695,7 +695,7 @@ void CLightning::StrikeUse( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_T
 	else
 	{
 		SetThink( &CLightning::StrikeThink );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 
 	if ( !FBitSet( pev->spawnflags, SF_BEAM_TOGGLE ) )
@@ -1219,7 +1219,7 @@ void CLaser :: Activate( void )
 void CLaser::TurnOff( void )
 {
 	pev->effects |= EF_NODRAW;
-	pev->nextthink = 0;
+	DontThink();
 
 	if ( m_pSprite )
 		m_pSprite->TurnOff();
@@ -1509,7 +1509,7 @@ void CGlow::Spawn( void )
 
 	m_maxFrame = (float) MODEL_FRAMES( pev->modelindex ) - 1;
 	if ( m_maxFrame > 1.0 && pev->framerate != 0 )
-		pev->nextthink	= gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 
 	m_lastTime = gpGlobals->time;
 }
@@ -1519,7 +1519,7 @@ void CGlow::Think( void )
 {
 	Animate( pev->framerate * (gpGlobals->time - m_lastTime) );
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	m_lastTime = gpGlobals->time;
 }
 
@@ -1625,7 +1625,7 @@ void CSprite::AnimateThink( void )
 {
 	Animate( pev->framerate * (gpGlobals->time - m_lastTime) );
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	m_lastTime = gpGlobals->time;
 }
 
@@ -1638,7 +1638,7 @@ void CSprite::AnimateUntilDead( void )
 	else
 	{
 		AnimateThink();
-		pev->nextthink = gpGlobals->time;
+		SetNextThink( 0 );
 	}
 }
 
@@ -1648,7 +1648,7 @@ void CSprite::Expand( float scaleSpeed, float fadeSpeed )
 	pev->health = fadeSpeed;
 	SetThink( &CSprite::ExpandThink );
 
-	pev->nextthink	= gpGlobals->time;
+	SetNextThink( 0 );
 	m_lastTime	= gpGlobals->time;
 }
 
@@ -1665,7 +1665,7 @@ void CSprite::ExpandThink( void )
 	}
 	else
 	{
-		pev->nextthink		= gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 		m_lastTime			= gpGlobals->time;
 	}
 }
@@ -1796,7 +1796,7 @@ void CSprite::TurnOff( void )
 
 	SetLocalVelocity( g_vecZero );
 	pev->effects |= EF_NODRAW;
-	pev->nextthink = 0;
+	DontThink();
 }
 
 void CSprite::TurnOn( void )
@@ -1814,7 +1814,7 @@ void CSprite::TurnOn( void )
 	else if ( (pev->framerate && m_maxFrame > 1.0) || (pev->spawnflags & SF_SPRITE_ONCE) )
 	{
 		SetThink( &CSprite::AnimateThink );
-		pev->nextthink = gpGlobals->time;
+		SetNextThink( 0 );
 		m_lastTime = gpGlobals->time;
 	}
 	pev->frame = 0;
@@ -2438,7 +2438,7 @@ void CTestEffect::TestThink( void )
 			m_pBeam[i]->SetBrightness( 255 * t );
 			// m_pBeam[i]->SetScrollRate( 20 * t );
 		}
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 	else
 	{
@@ -2457,7 +2457,7 @@ void CTestEffect::TestThink( void )
 void CTestEffect::Use( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE useType, float value )
 {
 	SetThink( &CTestEffect::TestThink );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	m_flStartTime = gpGlobals->time;
 }
 
@@ -2878,7 +2878,7 @@ void CEnvFunnel::Use( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE us
 	MESSAGE_END();
 
 	SetThink( &CBaseEntity::SUB_Remove );
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 }
 
 void CEnvFunnel::Spawn( void )
@@ -2990,7 +2990,7 @@ void CItemSoda::Spawn( void )
 	UTIL_SetSize ( pev, Vector ( 0, 0, 0 ), Vector ( 0, 0, 0 ) );
 	
 	SetThink( &CItemSoda::CanThink);
-	pev->nextthink = gpGlobals->time + 0.5;
+	SetNextThink( 0.5 );
 
 	m_pUserData = WorldPhysic->CreateBodyFromEntity( this );
 }
@@ -3027,7 +3027,7 @@ void CItemSoda::CanTouch ( CBaseEntity *pOther )
 	pev->effects |= EF_NODRAW;
 	SetTouch( NULL );
 	SetThink( &CBaseEntity::SUB_Remove );
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 }
 
 // =================== ENV_SKY ==============================================
@@ -3931,11 +3931,11 @@ void CEnvWarpBall::Use( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE
 			pBeam->SetScrollRate( 35 );
 //			pBeam->SetParent( this );
 			pBeam->SetThink( &CBeam:: SUB_Remove );
-			pBeam->pev->nextthink = gpGlobals->time + RANDOM_FLOAT(0.5, 1.6);
+			pBeam->SetNextThink( RANDOM_FLOAT(0.5, 1.6) );
 		}
 		iTimes++;
 	}
-	pev->nextthink = gpGlobals->time + pev->frags;
+	SetNextThink( pev->frags );
 }
 
 void CEnvWarpBall::Think( void )
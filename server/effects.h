@@ -95,7 +95,7 @@ public:
 		SetThink( &CSprite::AnimateUntilDead); 
 		pev->framerate = framerate;
 		pev->dmgtime = gpGlobals->time + (m_maxFrame / framerate); 
-		pev->nextthink = gpGlobals->time; 
+		SetNextThink( 0 ); 
 	}
 
 	void AnimateUntilDead( void );
@@ -53,7 +53,7 @@ void CShower::Spawn( void )
 
 	pev->movetype = MOVETYPE_BOUNCE;
 	pev->gravity = 0.5;
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	pev->solid = SOLID_NOT;
 	SET_MODEL( edict(), "models/grenade.mdl");	// Need a model, just use the grenade, we don't draw it anyway
 	UTIL_SetSize(pev, g_vecZero, g_vecZero );
@@ -207,7 +207,7 @@ void CEnvExplosion::Use( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE
 	}
 
 	SetThink( &CEnvExplosion::Smoke );
-	pev->nextthink = gpGlobals->time + 0.3;
+	SetNextThink( 0.3 );
 
 	// draw sparks
 	if ( !( pev->spawnflags & SF_ENVEXPLOSION_NOSPARKS ) )
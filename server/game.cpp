@@ -56,6 +56,12 @@ cvar_t	*g_physdebug = NULL;
 cvar_t	*p_speeds = NULL;
 cvar_t	*g_allow_physx = NULL;
 cvar_t	g_sync_physic = { "sv_sync_physic", "0", FCVAR_ARCHIVE };
+cvar_t	g_allow_sleep = { "sv_allow_sleep", "1", FCVAR_ARCHIVE };
+cvar_t	g_ai_lod = { "ai_lod", "0", FCVAR_ARCHIVE };
+cvar_t	g_ai_lod_dist = { "ai_lod_dist", "1536", FCVAR_ARCHIVE };
+cvar_t	g_ai_lod_budget = { "ai_lod_budget", "4", FCVAR_ARCHIVE };	// milliseconds
+cvar_t	g_physic_threads = { "sv_physic_threads", "0", FCVAR_ARCHIVE };	// 0 is autodetect
+cvar_t	g_profile = { "sv_profile", "0" };
 
 //CVARS FOR SKILL LEVEL SETTINGS
 // Agrunt
@@ -499,11 +505,23 @@ void GameDLLInit( void )
 	g_footsteps = CVAR_GET_POINTER( "mp_footsteps" );
 	g_psv_stepsize = CVAR_GET_POINTER( "sv_stepsize" );
 	CVAR_REGISTER( &g_sync_physic );
+	CVAR_REGISTER( &g_allow_sleep );
+	CVAR_REGISTER( &g_ai_lod );
+	CVAR_REGISTER( &g_ai_lod_dist );
+	CVAR_REGISTER( &g_ai_lod_budget );
+	CVAR_REGISTER( &g_physic_threads );
+	CVAR_REGISTER( &g_profile );
 
 	g_engfuncs.pfnAddServerCommand( "showtriggers_toggle", Cmd_ShowTriggers_f );
 
 	g_engfuncs.pfnAddServerCommand( "dump_entity_sizes", DumpEntitySizes_f );
 	g_engfuncs.pfnAddServerCommand( "dump_entity_names", DumpEntityNames_f );
+	g_engfuncs.pfnAddServerCommand( "dump_think_stats", DumpThinkStats_f );
+	g_engfuncs.pfnAddServerCommand( "dump_sleep_stats", DumpSleepStats_f );
+	g_engfuncs.pfnAddServerCommand( "dump_ai_lod", DumpAILod_f );
+	g_engfuncs.pfnAddServerCommand( "profile_dump", ProfileDump_f );
+	g_engfuncs.pfnAddServerCommand( "profile_trace", ProfileTrace_f );
+	g_engfuncs.pfnAddServerCommand( "profile_reset", ProfileReset_f );
 
 #ifdef HAVE_STRINGPOOL
 	g_engfuncs.pfnAddServerCommand( "dump_strings", DumpStrings_f );
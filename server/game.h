@@ -47,6 +47,12 @@ extern cvar_t	*p_speeds;
 extern cvar_t	*g_physdebug;	// quake physics debug
 extern cvar_t	*g_allow_physx;
 extern cvar_t	g_sync_physic;
+extern cvar_t	g_allow_sleep;
+extern cvar_t	g_ai_lod;
+extern cvar_t	g_ai_lod_dist;
+extern cvar_t	g_ai_lod_budget;
+extern cvar_t	g_physic_threads;
+extern cvar_t	g_profile;
 
 #endif		// GAME_H
 
@@ -138,7 +138,7 @@ void CGrenade::Explode( TraceResult *pTrace, int bitsDamageType )
 	pev->effects |= EF_NODRAW;
 	SetThink( &CGrenade::Smoke );
 	SetAbsVelocity( g_vecZero );
-	pev->nextthink = gpGlobals->time + 0.3;
+	SetNextThink( 0.3 );
 
 	if (iContents != CONTENTS_WATER)
 	{
@@ -183,7 +183,7 @@ void CGrenade::Killed( entvars_t *pevAttacker, int iGib )
 void CGrenade::DetonateUse( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE useType, float value )
 {
 	SetThink( &CGrenade::Detonate );
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 }
 
 void CGrenade::PreDetonate( void )
@@ -191,7 +191,7 @@ void CGrenade::PreDetonate( void )
 	CSoundEnt::InsertSound ( bits_SOUND_DANGER, GetAbsOrigin(), 400, 0.3 );
 
 	SetThink( &CGrenade::Detonate );
-	pev->nextthink = gpGlobals->time + 1;
+	SetNextThink( 1 );
 }
 
 
@@ -233,7 +233,7 @@ void CGrenade::DangerSoundThink( void )
 	}
 
 	CSoundEnt::InsertSound( bits_SOUND_DANGER, GetAbsOrigin() + GetAbsVelocity() * 0.5, GetAbsVelocity().Length( ), 0.2 );
-	pev->nextthink = gpGlobals->time + 0.2;
+	SetNextThink( 0.2 );
 
 	if( pev->waterlevel != 0 )
 	{
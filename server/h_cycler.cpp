@@ -102,7 +102,7 @@ void CCycler :: Spawn( )
 	m_flFrameRate		= 75;
 	m_flGroundSpeed		= 0;
 
-	pev->nextthink		+= 1.0;
+	SetAbsNextThink( pev->nextthink + 1.0 );
 
 	ResetSequenceInfo( );
 
@@ -125,7 +125,7 @@ void CCycler :: Spawn( )
 //
 void CCycler :: Think( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if (m_animate)
 	{
@@ -226,7 +226,7 @@ void CCyclerSprite::Spawn( void )
 	pev->effects		= 0;
 
 	pev->frame			= 0;
-	pev->nextthink		= gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	m_animate			= 1;
 	m_lastTime			= gpGlobals->time;
 
@@ -242,7 +242,7 @@ void CCyclerSprite::Think( void )
 	if ( ShouldAnimate() )
 		Animate( pev->framerate * (gpGlobals->time - m_lastTime) );
 
-	pev->nextthink		= gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	m_lastTime = gpGlobals->time;
 }
 
@@ -452,7 +452,7 @@ void CWreckage::Spawn( void )
 	pev->effects		= 0;
 
 	pev->frame			= 0;
-	pev->nextthink		= gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if (pev->model)
 	{
@@ -473,7 +473,7 @@ void CWreckage::Precache( )
 void CWreckage::Think( void )
 {
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.2;
+	SetNextThink( 0.2 );
 
 	if (pev->dmgtime)
 	{
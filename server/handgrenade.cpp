@@ -115,7 +115,7 @@ void CHandGrenade::Holster( void )
 		// no more grenades!
 		m_pPlayer->RemoveWeapon( WEAPON_HANDGRENADE );
 		SetThink( &CHandGrenade::DestroyItem );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 
 	EMIT_SOUND(ENT(m_pPlayer->pev), CHAN_WEAPON, "common/null.wav", 1.0, ATTN_NORM);
@@ -212,7 +212,7 @@ void CFlockingFlyerFlock :: SpawnFlock( void )
 		pBoid->SetAbsAngles( GetAbsAngles());
 		
 		pBoid->pev->frame = 0;
-		pBoid->pev->nextthink = gpGlobals->time + 0.2;
+		pBoid->SetNextThink( 0.2 );
 		pBoid->SetThink( &CFlockingFlyer :: IdleThink );
 
 		if ( pBoid != pLeader ) 
@@ -230,7 +230,7 @@ void CFlockingFlyer :: Spawn( )
 	SpawnCommonCode();
 	
 	pev->frame = 0;
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	SetThink( &CFlockingFlyer::IdleThink );
 }
 
@@ -295,7 +295,7 @@ void CFlockingFlyer :: Killed( entvars_t *pevAttacker, int iGib )
 	pev->movetype = MOVETYPE_TOSS;
 
 	SetThink( &CFlockingFlyer::FallHack );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 void CFlockingFlyer :: FallHack( void )
@@ -305,7 +305,7 @@ void CFlockingFlyer :: FallHack( void )
 		if( GetGroundEntity() != g_pWorld )
 		{
 			pev->flags &= ~FL_ONGROUND;
-			pev->nextthink = gpGlobals->time + 0.1;
+			SetNextThink( 0.1 );
 		}
 		else
 		{
@@ -365,13 +365,13 @@ void CFlockingFlyer :: BoidAdvanceFrame ( )
 //=========================================================
 void CFlockingFlyer :: IdleThink( void )
 {
-	pev->nextthink = gpGlobals->time + 0.2;
+	SetNextThink( 0.2 );
 
 	// see if there's a client in the same pvs as the monster
 	if ( !FNullEnt( FIND_CLIENT_IN_PVS( edict() ) ) )
 	{
 		SetThink( &CFlockingFlyer::Start );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 }
 
@@ -380,7 +380,7 @@ void CFlockingFlyer :: IdleThink( void )
 //=========================================================
 void CFlockingFlyer :: Start( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if ( IsLeader() )
 	{
@@ -443,7 +443,7 @@ void CFlockingFlyer :: FormFlock( void )
 	}
 
 	SetThink( &CFlockingFlyer::IdleThink );// now that flock is formed, go to idle and wait for a player to come along.
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 }
  
 //=========================================================
@@ -567,7 +567,7 @@ void CFlockingFlyer :: FlockLeaderThink( void )
 	float			flRightSide;
 	
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	
 	UTIL_MakeVectors ( GetAbsAngles() );
 
@@ -687,7 +687,7 @@ void CFlockingFlyer :: FlockFollowerThink( void )
 	Vector			vecDirToLeader;
 	float			flDistToLeader;
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if ( IsLeader() || !InSquad() )
 	{
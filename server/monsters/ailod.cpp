@@ -0,0 +1,156 @@
+/*
+ailod.cpp - monster AI level of detail
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include	"extdll.h"
+#include	"util.h"
+#include	"cbase.h"
+#include	"monsters.h"
+#include	"schedule.h"
+#include	"game.h"
+#include	"ailod.h"
+
+// think interval for each tier
+static const float s_flTierInterval[AI_LOD_COUNT] = { 0.1f, 0.2f, 0.5f };
+static const char *s_szTierName[AI_LOD_COUNT] = { "full", "reduced", "dormant" };
+
+CAILodManager	s_AILod;
+CAILodManager	*g_pAILod = &s_AILod;
+
+void CAILodManager :: CheckFrame( void )
+{
+	if( m_iFrame == g_ulFrameCount )
+		return;
+
+	m_flLastFrameTime = m_flFrameTime;
+	m_iLastDeferred = m_iDeferred;
+	m_flFrameTime = 0.0;
+	m_iDeferred = 0;
+	m_iFrame = g_ulFrameCount;
+}
+
+BOOL CAILodManager :: NeedFullRate( CBaseMonster *pMonster )
+{
+	// fighting, scripted and dying monsters always think at full rate
+	if( pMonster->m_MonsterState == MONSTERSTATE_COMBAT || pMonster->m_IdealMonsterState == MONSTERSTATE_COMBAT )
+		return TRUE;
+
+	if( pMonster->m_MonsterState == MONSTERSTATE_SCRIPT || pMonster->m_pCine != NULL )
+		return TRUE;
+
+	if( pMonster->m_hEnemy.Get() != NULL || pMonster->pev->deadflag != DEAD_NO )
+		return TRUE;
+
+	// movement is integrated with think interval
+	if( !pMonster->MovementIsComplete( ))
+		return TRUE;
+
+	if( pMonster->HasConditions( bits_COND_LIGHT_DAMAGE|bits_COND_HEAVY_DAMAGE|bits_COND_HEAR_SOUND ))
+		return TRUE;
+
+	return FALSE;
+}
+
+int CAILodManager :: SelectTier( CBaseMonster *pMonster )
+{
+	int tier = AI_LOD_FULL;
+
+	if( g_ai_lod.value && !NeedFullRate( pMonster ))
+	{
+		float flNearest = 99999.0f;
+
+		for( int i = 1; i <= gpGlobals->maxClients; i++ )
+		{
+			CBaseEntity *pPlayer = UTIL_PlayerByIndex( i );
+
+			if( !pPlayer || !FBitSet( pPlayer->pev->flags, FL_CLIENT ))
+				continue;
+
+			float flDist = ( pPlayer->GetAbsOrigin() - pMonster->GetAbsOrigin() ).Length();
+			if( flDist < flNearest ) flNearest = flDist;
+		}
+
+		BOOL bFar = ( flNearest > g_ai_lod_dist.value ) ? TRUE : FALSE;
+
+		if( !FNullEnt( FIND_CLIENT_IN_PVS( pMonster->edict() )))
+			tier = bFar ? AI_LOD_REDUCED : AI_LOD_FULL;
+		else tier = bFar ? AI_LOD_DORMANT : AI_LOD_REDUCED;
+	}
+
+	pMonster->m_iAILod = tier;
+
+	return tier;
+}
+
+float CAILodManager :: ThinkInterval( int tier )
+{
+	return s_flTierInterval[bound( AI_LOD_FULL, tier, AI_LOD_COUNT - 1 )];
+}
+
+BOOL CAILodManager :: AllowThink( int tier )
+{
+	CheckFrame();
+
+	if( tier == AI_LOD_FULL || g_ai_lod_budget.value <= 0.0f )
+		return TRUE;
+
+	// budget is in milliseconds
+	if( m_flFrameTime * 1000.0 < g_ai_lod_budget.value )
+		return TRUE;
+
+	m_iDeferred++;
+
+	return FALSE;
+}
+
+void CAILodManager :: EndThink( double flStartTime )
+{
+	CheckFrame();
+
+	m_flFrameTime += Sys_DoubleTime() - flStartTime;
+}
+
+void CAILodManager :: ReportStats( void )
+{
+	int	population[AI_LOD_COUNT];
+	int	total = 0;
+
+	memset( population, 0, sizeof( population ));
+
+	edict_t *pEdict = INDEXENT( 1 );
+	for( int i = 1; pEdict && i < gpGlobals->maxEntities; i++, pEdict++ )
+	{
+		if( pEdict->free || !FBitSet( pEdict->v.flags, FL_MONSTER ))
+			continue;
+
+		CBaseEntity *pEntity = CBaseEntity::Instance( pEdict );
+		CBaseMonster *pMonster = pEntity ? pEntity->MyMonsterPointer() : NULL;
+
+		if( !pMonster || pMonster->pev->deadflag == DEAD_DEAD )
+			continue;
+
+		population[bound( AI_LOD_FULL, pMonster->m_iAILod, AI_LOD_COUNT - 1 )]++;
+		total++;
+	}
+
+	for( int j = 0; j < AI_LOD_COUNT; j++ )
+		ALERT( at_console, "%-8s (%.1f sec): %i monsters\n", s_szTierName[j], s_flTierInterval[j], population[j] );
+
+	ALERT( at_console, "%i monsters total, last frame AI time %.2f ms, %i thinks deferred\n", total, m_flLastFrameTime * 1000.0, m_iLastDeferred );
+}
+
+void DumpAILod_f( void )
+{
+	g_pAILod->ReportStats();
+}
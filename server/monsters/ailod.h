@@ -0,0 +1,60 @@
+/*
+ailod.h - monster AI level of detail
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#ifndef AILOD_H
+#define AILOD_H
+
+// think rate tiers
+#define AI_LOD_FULL		0	// near players, fighting or scripted
+#define AI_LOD_REDUCED	1	// far but in players PVS or near but out of PVS
+#define AI_LOD_DORMANT	2	// far and out of players PVS
+#define AI_LOD_COUNT	3
+
+//-----------------------------------------------------------------------------
+// Purpose: Slows down thinking of monsters what nobody watches and limits
+//  the time spent by the reduced tiers in one frame.
+//-----------------------------------------------------------------------------
+class CAILodManager
+{
+public:
+	CAILodManager( void ) { m_iFrame = 0; m_flFrameTime = m_flLastFrameTime = 0.0; m_iDeferred = m_iLastDeferred = 0; }
+
+	// choose tier for this think
+	int		SelectTier( CBaseMonster *pMonster );
+	float		ThinkInterval( int tier );
+
+	// FALSE when the frame budget is exhausted
+	BOOL		AllowThink( int tier );
+
+	// measure AI time of the frame
+	double		BeginThink( void ) { return Sys_DoubleTime(); }
+	void		EndThink( double flStartTime );
+
+	void		ReportStats( void );
+
+private:
+	void		CheckFrame( void );
+	BOOL		NeedFullRate( CBaseMonster *pMonster );
+
+	unsigned int	m_iFrame;
+	double		m_flFrameTime;	// seconds spent in monster thinks this frame
+	double		m_flLastFrameTime;
+	int		m_iDeferred;	// thinks postponed by budget this frame
+	int		m_iLastDeferred;
+};
+
+extern CAILodManager	*g_pAILod;
+
+#endif//AILOD_H
@@ -147,7 +147,7 @@ void CApache :: Spawn( void )
 	{
 		SetThink( &CApache::HuntThink );
 		SetTouch( &CApache::FlyTouch );
-		pev->nextthink = gpGlobals->time + 1.0;
+		SetNextThink( 1.0 );
 	}
 
 	m_iRockets = 10;
@@ -185,7 +185,7 @@ void CApache::Precache( void )
 void CApache::NullThink( void )
 {
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.5;
+	SetNextThink( 0.5 );
 }
 
 
@@ -193,7 +193,7 @@ void CApache::StartupUse( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYP
 {
 	SetThink( &CApache::HuntThink );
 	SetTouch( &CApache::FlyTouch );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	SetUse( NULL );
 }
 
@@ -207,7 +207,7 @@ void CApache :: Killed( entvars_t *pevAttacker, int iGib )
 	UTIL_SetSize( pev, Vector( -32, -32, -64), Vector( 32, 32, 0) );
 	SetThink( &CApache::DyingThink );
 	SetTouch( &CApache::CrashTouch );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	pev->health = 0;
 	pev->takedamage = DAMAGE_NO;
 
@@ -224,7 +224,7 @@ void CApache :: Killed( entvars_t *pevAttacker, int iGib )
 void CApache :: DyingThink( void )
 {
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	SetLocalAvelocity( GetLocalAvelocity() * 1.02 );
 
@@ -295,7 +295,7 @@ void CApache :: DyingThink( void )
 
 		// don't stop it we touch a entity
 		pev->flags &= ~FL_ONGROUND;
-		pev->nextthink = gpGlobals->time + 0.2;
+		SetNextThink( 0.2 );
 		return;
 	}
 	else
@@ -412,7 +412,7 @@ void CApache :: DyingThink( void )
 		MESSAGE_END();
 
 		SetThink( &CBaseEntity::SUB_Remove );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 }
 
@@ -437,7 +437,7 @@ void CApache::CrashTouch( CBaseEntity *pOther )
 	{
 		SetTouch( NULL );
 		m_flNextRocket = gpGlobals->time;
-		pev->nextthink = gpGlobals->time;
+		SetNextThink( 0 );
 	}
 }
 
@@ -452,7 +452,7 @@ void CApache :: GibMonster( void )
 void CApache :: HuntThink( void )
 {
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	ShowDamage( );
 
@@ -994,7 +994,7 @@ void CApacheHVR :: Spawn( void )
 	m_vecForward = gpGlobals->v_forward;
 	pev->gravity = 0.5;
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	pev->dmg = 150;
 }
@@ -1035,7 +1035,7 @@ void CApacheHVR :: IgniteThink( void  )
 
 	// set to accelerate
 	SetThink( &CApacheHVR::AccelerateThink );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 
@@ -151,7 +151,7 @@ void CBarnacle :: BarnacleThink ( void )
 	CBaseMonster *pVictim;
 	float flLength;
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if ( m_hEnemy != NULL )
 	{
@@ -246,7 +246,7 @@ void CBarnacle :: BarnacleThink ( void )
 
 		// If idle and no nearby client, don't think so often
 		if ( FNullEnt( FIND_CLIENT_IN_PVS( edict() ) ) )
-			pev->nextthink = gpGlobals->time + RANDOM_FLOAT(1,1.5);	// Stagger a bit to keep barnacles from thinking on the same frame
+			SetNextThink( RANDOM_FLOAT(1,1.5) );	// Stagger a bit to keep barnacles from thinking on the same frame
 
 		if ( m_fSequenceFinished )
 		{// this is done so barnacle will fidget.
@@ -355,7 +355,7 @@ void CBarnacle :: Killed( entvars_t *pevAttacker, int iGib )
 
 	StudioFrameAdvance( 0.1 );
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	SetThink( &CBarnacle::WaitTillDead );
 }
 
@@ -363,7 +363,7 @@ void CBarnacle :: Killed( entvars_t *pevAttacker, int iGib )
 //=========================================================
 void CBarnacle :: WaitTillDead ( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	float flInterval = StudioFrameAdvance( 0.1 );
 	DispatchAnimEvents ( flInterval );
@@ -109,6 +109,7 @@ public:
 	Vector		m_HackedGunPos;	// HACK until we can query end of gun
 
 	BOOL		m_bHaveWeapons;	// user-specified weapon bits (don't save\restore this)
+	int		m_iAILod;		// think rate tier, selected every think (don't save\restore this)
 
 // Scripted sequence Info
 	SCRIPTSTATE	m_scriptState;		// internal cinematic state
@@ -98,7 +98,7 @@ void CSquidSpit:: Spawn( void )
 
 void CSquidSpit::Animate( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if ( pev->frame++ )
 	{
@@ -119,7 +119,7 @@ void CSquidSpit::Shoot( entvars_t *pevOwner, Vector vecStart, Vector vecVelocity
 	pSpit->pev->owner = ENT(pevOwner);
 
 	pSpit->SetThink( &CSquidSpit::Animate );
-	pSpit->pev->nextthink = gpGlobals->time + 0.1;
+	pSpit->SetNextThink( 0.1 );
 }
 
 void CSquidSpit :: Touch ( CBaseEntity *pOther )
@@ -170,7 +170,7 @@ void CSquidSpit :: Touch ( CBaseEntity *pOther )
 	}
 
 	SetThink( &CBaseEntity::SUB_Remove );
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 }
 
 //=========================================================
@@ -1185,7 +1185,7 @@ void CControllerHeadBall :: Spawn( void )
 
 	m_vecIdeal = Vector( 0, 0, 0 );
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	m_hOwner = Instance( pev->owner );
 	pev->dmgtime = gpGlobals->time;
@@ -1268,7 +1268,7 @@ void CControllerHeadBall :: HuntThink( void  )
 		m_flNextAttack = gpGlobals->time + 3.0;
 
 		SetThink( &CControllerHeadBall::DieThink );
-		pev->nextthink = gpGlobals->time + 0.3;
+		SetNextThink( 0.3 );
 	}
 
 	// Crawl( );
@@ -1385,7 +1385,7 @@ void CControllerZapBall :: Spawn( void )
 
 	m_hOwner = Instance( pev->owner );
 	pev->dmgtime = gpGlobals->time; // keep track of when ball spawned
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 
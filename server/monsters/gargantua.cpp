@@ -106,7 +106,7 @@ CStomp *CStomp::StompCreate( const Vector &origin, const Vector &end, float spee
 
 void CStomp::Spawn( void )
 {
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 	pev->classname = MAKE_STRING("garg_stomp");
 	pev->dmgtime = gpGlobals->time;
 
@@ -124,7 +124,7 @@ void CStomp::Think( void )
 {
 	TraceResult tr;
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	// Do damage for this frame
 	Vector vecStart = GetAbsOrigin();
@@ -162,7 +162,7 @@ void CStomp::Think( void )
 				pSprite->SetAbsOrigin( tr.vecEndPos );
 				pSprite->SetAbsVelocity( Vector(RANDOM_FLOAT(-200,200),RANDOM_FLOAT(-200,200),175));
 				// pSprite->AnimateAndDie( RANDOM_FLOAT( 8.0, 12.0 ) );
-				pSprite->pev->nextthink = gpGlobals->time + 0.3;
+				pSprite->SetNextThink( 0.3 );
 				pSprite->SetThink( &CBaseEntity::SUB_Remove );
 				pSprite->SetTransparency( kRenderTransAdd, 255, 255, 255, 255, kRenderFxFadeFast );
 			}
@@ -897,7 +897,7 @@ void CGargantua::DeathEffect( void )
 	pSmoker->pev->health = 1;	// 1 smoke balls
 	pSmoker->pev->scale = 46;	// 4.6X normal size
 	pSmoker->pev->dmg = 0;		// 0 radial distribution
-	pSmoker->pev->nextthink = gpGlobals->time + 2.5;	// Start in 2.5 seconds
+	pSmoker->SetNextThink( 2.5 );	// Start in 2.5 seconds
 }
 
 
@@ -1122,7 +1122,7 @@ void CGargantua::RunTask( Task_t *pTask )
 			pev->rendercolor.y = 0;
 			pev->rendercolor.z = 0;
 			StopAnimation();
-			pev->nextthink = gpGlobals->time + 0.15;
+			SetNextThink( 0.15 );
 			SetThink( &CBaseEntity::SUB_Remove );
 			int i;
 			int parts = MODEL_FRAMES( gGargGibModel );
@@ -1248,7 +1248,7 @@ LINK_ENTITY_TO_CLASS( env_smoker, CSmoker );
 void CSmoker::Spawn( void )
 {
 	pev->movetype = MOVETYPE_NONE;
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 	pev->solid = SOLID_NOT;
 	UTIL_SetSize(pev, g_vecZero, g_vecZero );
 	pev->effects |= EF_NODRAW;
@@ -1273,7 +1273,7 @@ void CSmoker::Think( void )
 
 	pev->health--;
 	if ( pev->health > 0 )
-		pev->nextthink = gpGlobals->time + RANDOM_FLOAT(0.1, 0.2);
+		SetNextThink( RANDOM_FLOAT(0.1, 0.2) );
 	else
 		UTIL_Remove( this );
 }
@@ -1282,7 +1282,7 @@ void CSmoker::Think( void )
 void CSpiral::Spawn( void )
 {
 	pev->movetype = MOVETYPE_NONE;
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 	pev->solid = SOLID_NOT;
 	UTIL_SetSize(pev, g_vecZero, g_vecZero );
 	pev->effects |= EF_NODRAW;
@@ -1339,7 +1339,7 @@ void CSpiral::Think( void )
 		time -= SPIRAL_INTERVAL;
 	}
 
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 
 	if ( pev->health >= pev->speed )
 		UTIL_Remove( this );
@@ -1363,5 +1363,5 @@ void SpawnExplosion( Vector center, float randomRange, float time, int magnitude
 
 	pExplosion->Spawn();
 	pExplosion->SetThink( &CBaseEntity::SUB_CallUseToggle );
-	pExplosion->pev->nextthink = gpGlobals->time + time;
+	pExplosion->SetNextThink( time );
 }
@@ -2436,7 +2436,7 @@ void CHGruntRepel::Use ( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE
 	pBeam->SetFlags( BEAM_FSOLID );
 	pBeam->SetColor( 255, 255, 255 );
 	pBeam->SetThink( &CBaseEntity::SUB_Remove );
-	pBeam->pev->nextthink = gpGlobals->time + -4096.0 * tr.flFraction / pGrunt->GetAbsVelocity().z + 0.5;
+	pBeam->SetNextThink( -4096.0 * tr.flFraction / pGrunt->GetAbsVelocity().z + 0.5 );
 
 	UTIL_Remove( this );
 }
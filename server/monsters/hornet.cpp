@@ -120,7 +120,7 @@ void CHornet :: Spawn( void )
 		pev->dmg = gSkillData.monDmgHornet;
 	}
 	
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	ResetSequenceInfo( );
 }
 
@@ -278,7 +278,7 @@ void CHornet :: TrackTarget ( void )
 	{
 		SetTouch( NULL );
 		SetThink( &CBaseEntity::SUB_Remove );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 		return;
 	}
 
@@ -341,11 +341,11 @@ void CHornet :: TrackTarget ( void )
 	{
 	case HORNET_TYPE_RED:
 		SetAbsVelocity( GetAbsVelocity() * ( m_flFlySpeed * flDelta ));// scale the dir by the ( speed * width of turn )
-		pev->nextthink = gpGlobals->time + RANDOM_FLOAT( 0.1, 0.3 );
+		SetNextThink( RANDOM_FLOAT( 0.1, 0.3 ) );
 		break;
 	case HORNET_TYPE_ORANGE:
 		SetAbsVelocity( GetAbsVelocity() * m_flFlySpeed ); // do not have to slow down to turn.
-		pev->nextthink = gpGlobals->time + 0.1;// fixed think time
+		SetNextThink( 0.1 );// fixed think time
 		break;
 	}
 
@@ -378,7 +378,7 @@ void CHornet :: TrackTarget ( void )
 			case 2: EMIT_SOUND( ENT(pev), CHAN_VOICE, "hornet/ag_buzz3.wav", HORNET_BUZZ_VOLUME, ATTN_NORM ); break;
 			}
 			SetAbsVelocity( GetAbsVelocity() * 2 );
-			pev->nextthink = gpGlobals->time + 1.0;
+			SetNextThink( 1.0 );
 			// don't attack again
 			m_flStopAttack = gpGlobals->time;
 		}
@@ -442,7 +442,7 @@ void CHornet::DieTouch ( CBaseEntity *pOther )
 	pev->solid = SOLID_NOT;
 
 	SetThink( &CBaseEntity::SUB_Remove );
-	pev->nextthink = gpGlobals->time + 1;// stick around long enough for the sound to finish!
+	SetNextThink( 1 );// stick around long enough for the sound to finish!
 }
 
 
@@ -434,7 +434,7 @@ void CLeech::DeadThink( void )
 		}
 	}
 	StudioFrameAdvance();
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	// Apply damage velocity, but keep out of the walls
 	if ( GetAbsVelocity().x != 0 || GetAbsVelocity().y != 0 )
@@ -570,12 +570,12 @@ void CLeech::SwimThink( void )
 
 	if ( FNullEnt( FIND_CLIENT_IN_PVS( edict() ) ) )
 	{
-		pev->nextthink = gpGlobals->time + RANDOM_FLOAT(1,1.5);
+		SetNextThink( RANDOM_FLOAT(1,1.5) );
 		SetAbsVelocity( g_vecZero );
 		return;
 	}
 	else
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 
 	targetSpeed = LEECH_SWIM_SPEED;
 
@@ -124,7 +124,7 @@ void CMonsterMaker :: Spawn( )
 	}
 	else
 	{// no targetname, just start.
-			pev->nextthink = gpGlobals->time + m_flDelay;
+			SetNextThink( m_flDelay );
 			m_fActive = TRUE;
 			SetThink( &CMonsterMaker::MakerThink );
 	}
@@ -264,7 +264,7 @@ void CMonsterMaker :: ToggleUse ( CBaseEntity *pActivator, CBaseEntity *pCaller,
 		SetThink( &CMonsterMaker::MakerThink );
 	}
 
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 }
 
 //=========================================================
@@ -272,7 +272,7 @@ void CMonsterMaker :: ToggleUse ( CBaseEntity *pActivator, CBaseEntity *pCaller,
 //=========================================================
 void CMonsterMaker :: MakerThink ( void )
 {
-	pev->nextthink = gpGlobals->time + m_flDelay;
+	SetNextThink( m_flDelay );
 
 	MakeMonster();
 }
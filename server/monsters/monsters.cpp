@@ -34,6 +34,8 @@
 #include "soundent.h"
 #include "gamerules.h"
 #include "player.h"
+#include "sightcache.h"
+#include "ailod.h"
 
 #define MONSTER_CUT_CORNER_DIST		8 // 8 means the monster's bounding box is contained without the box of the node in WC
 
@@ -315,7 +317,9 @@ void CBaseMonster :: Look ( int iDistance )
 
 		// Find only monsters/clients in box, NOT limited to PVS
 		int count = UTIL_EntitiesInBox( pList, 100, GetAbsOrigin() - delta, GetAbsOrigin() + delta, FL_CLIENT|FL_MONSTER );
-		for ( int i = 0; i < count; i++ )
+		int i, numCandidates = 0;
+
+		for ( i = 0; i < count; i++ )
 		{
 			pSightEnt = pList[i];
 			// !!!temporarily only considering other monsters and clients, don't see prisoners
@@ -325,63 +329,76 @@ void CBaseMonster :: Look ( int iDistance )
 			{
 				// the looker will want to consider this entity
 				// don't check anything else about an entity that can't be seen, or an entity that you don't care about.
-				if ( IRelationship( pSightEnt ) != R_NO && FInViewCone( pSightEnt ) && !FBitSet( pSightEnt->pev->flags, FL_NOTARGET ) && FVisible( pSightEnt ) )
+				if ( IRelationship( pSightEnt ) != R_NO && FInViewCone( pSightEnt ) && !FBitSet( pSightEnt->pev->flags, FL_NOTARGET ) )
 				{
-					if ( pSightEnt->IsPlayer() )
+					pList[numCandidates++] = pSightEnt;
+					g_pSightCache->AddQuery( this, pSightEnt );
+				}
+			}
+		}
+
+		// trace all the candidates at once, FVisible will pick up the results
+		g_pSightCache->RunQueries();
+
+		for ( i = 0; i < numCandidates; i++ )
+		{
+			pSightEnt = pList[i];
+			if ( FVisible( pSightEnt ) )
+			{
+				if ( pSightEnt->IsPlayer() )
+				{
+					if ( pev->spawnflags & SF_MONSTER_WAIT_TILL_SEEN )
 					{
-						if ( pev->spawnflags & SF_MONSTER_WAIT_TILL_SEEN )
+						CBaseMonster *pClient;
+
+						pClient = pSightEnt->MyMonsterPointer();
+						// don't link this client in the list if the monster is wait till seen and the player isn't facing the monster
+						if ( pSightEnt && !pClient->FInViewCone( this ) )
 						{
-							CBaseMonster *pClient;
-
-							pClient = pSightEnt->MyMonsterPointer();
-							// don't link this client in the list if the monster is wait till seen and the player isn't facing the monster
-							if ( pSightEnt && !pClient->FInViewCone( this ) )
-							{
-								// we're not in the player's view cone. 
-								continue;
-							}
-							else
-							{
-								// player sees us, become normal now.
-								pev->spawnflags &= ~SF_MONSTER_WAIT_TILL_SEEN;
-							}
+							// we're not in the player's view cone. 
+							continue;
+						}
+						else
+						{
+							// player sees us, become normal now.
+							pev->spawnflags &= ~SF_MONSTER_WAIT_TILL_SEEN;
 						}
-
-						// if we see a client, remember that (mostly for scripted AI)
-						iSighted |= bits_COND_SEE_CLIENT;
 					}
 
-					pSightEnt->m_pLink = m_pLink;
-					m_pLink = pSightEnt;
+					// if we see a client, remember that (mostly for scripted AI)
+					iSighted |= bits_COND_SEE_CLIENT;
+				}
 
-					if ( pSightEnt == m_hEnemy )
-					{
-						// we know this ent is visible, so if it also happens to be our enemy, store that now.
-						iSighted |= bits_COND_SEE_ENEMY;
-					}
+				pSightEnt->m_pLink = m_pLink;
+				m_pLink = pSightEnt;
 
-					// don't add the Enemy's relationship to the conditions. We only want to worry about conditions when
-					// we see monsters other than the Enemy.
-					switch ( IRelationship ( pSightEnt ) )
-					{
-					case	R_NM:
-						iSighted |= bits_COND_SEE_NEMESIS;		
-						break;
-					case	R_HT:		
-						iSighted |= bits_COND_SEE_HATE;		
-						break;
-					case	R_DL:
-						iSighted |= bits_COND_SEE_DISLIKE;
-						break;
-					case	R_FR:
-						iSighted |= bits_COND_SEE_FEAR;
-						break;
-					case    R_AL:
-						break;
-					default:
-						ALERT ( at_aiconsole, "%s can't assess %s\n", STRING(pev->classname), STRING(pSightEnt->pev->classname ) );
-						break;
-					}
+				if ( pSightEnt == m_hEnemy )
+				{
+					// we know this ent is visible, so if it also happens to be our enemy, store that now.
+					iSighted |= bits_COND_SEE_ENEMY;
+				}
+
+				// don't add the Enemy's relationship to the conditions. We only want to worry about conditions when
+				// we see monsters other than the Enemy.
+				switch ( IRelationship ( pSightEnt ) )
+				{
+				case	R_NM:
+					iSighted |= bits_COND_SEE_NEMESIS;		
+					break;
+				case	R_HT:		
+					iSighted |= bits_COND_SEE_HATE;		
+					break;
+				case	R_DL:
+					iSighted |= bits_COND_SEE_DISLIKE;
+					break;
+				case	R_FR:
+					iSighted |= bits_COND_SEE_FEAR;
+					break;
+				case    R_AL:
+					break;
+				default:
+					ALERT ( at_aiconsole, "%s can't assess %s\n", STRING(pev->classname), STRING(pSightEnt->pev->classname ) );
+					break;
 				}
 			}
 		}
@@ -513,8 +530,18 @@ CSound* CBaseMonster :: PBestScent ( void )
 //=========================================================
 void CBaseMonster :: MonsterThink ( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;// keep monster thinking.
+	int iLod = g_pAILod->SelectTier( this );
+
+	SetNextThink( g_pAILod->ThinkInterval( iLod ) );// keep monster thinking.
+
+	// AI time of this frame is exhausted, try again on the next frame
+	if ( !g_pAILod->AllowThink( iLod ) )
+	{
+		SetNextThink( gpGlobals->frametime );
+		return;
+	}
 
+	double flStartTime = g_pAILod->BeginThink();
 
 	RunAI();
 
@@ -558,6 +585,7 @@ void CBaseMonster :: MonsterThink ( void )
 			ALERT( at_error, "Schedule stalled!!\n" );
 	}
 #endif
+	g_pAILod->EndThink( flStartTime );
 }
 
 //=========================================================
@@ -2113,7 +2141,7 @@ void CBaseMonster :: StartMonster ( void )
 	// Delay drop to floor to make sure each door in the level has had its chance to spawn
 	// Spread think times so that they don't all happen at the same time (Carmack)
 	SetThink( &CBaseMonster::CallMonsterThink );
-	pev->nextthink += RANDOM_FLOAT(0.1, 0.4); // spread think times.
+	SetAbsNextThink( pev->nextthink + RANDOM_FLOAT( 0.1, 0.4 )); // spread think times.
 	
 	if ( !FStringNull(pev->targetname) )// wait until triggered
 	{
@@ -3405,7 +3433,7 @@ void CBaseMonster::CorpseFallThink( void )
 		UTIL_SetOrigin( this, GetLocalOrigin());// link into world.
 	}
 	else
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 }
 
 // Call after animation/pose is set up
@@ -3430,7 +3458,7 @@ void CBaseMonster :: MonsterInitDead( void )
 	// Setup health counters, etc.
 	BecomeDead();
 	SetThink( &CBaseMonster::CorpseFallThink );
-	pev->nextthink = gpGlobals->time + 0.5;
+	SetNextThink( 0.5 );
 }
 
 //=========================================================
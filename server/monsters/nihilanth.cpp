@@ -307,7 +307,7 @@ void CNihilanth :: Spawn( void )
 	InitBoneControllers();
 
 	SetThink( &CNihilanth::StartupThink );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	m_vecDesired = Vector( 1, 0, 0 );
 	m_posDesired = Vector( GetAbsOrigin().x, GetAbsOrigin().y, 512 );
@@ -382,14 +382,14 @@ void CNihilanth :: DeathSound( void )
 void CNihilanth::NullThink( void )
 {
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.5;
+	SetNextThink( 0.5 );
 }
 
 
 void CNihilanth::StartupUse( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE useType, float value )
 {
 	SetThink( &CNihilanth::HuntThink );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	SetUse( &CNihilanth::CommandUse );
 }
 
@@ -846,7 +846,7 @@ void CNihilanth :: NextActivity( )
 
 void CNihilanth :: HuntThink( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	DispatchAnimEvents( );
 	StudioFrameAdvance( );
 
@@ -1344,7 +1344,7 @@ void CNihilanthHVR :: CircleInit( CBaseEntity *pTarget )
 
 	SetThink( &CNihilanthHVR::HoverThink );
 	SetTouch( &CNihilanthHVR::BounceTouch );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	
 	m_hTargetEnt = pTarget;
 }
@@ -1367,7 +1367,7 @@ CBaseEntity *CNihilanthHVR::RandomClassname( const char *szName )
 
 void CNihilanthHVR :: HoverThink( void  )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if (m_hTargetEnt != NULL)
 	{
@@ -1509,7 +1509,7 @@ void CNihilanthHVR :: ZapThink( void  )
 
 		SetTouch( NULL );
 		UTIL_Remove( this );
-		pev->nextthink = gpGlobals->time + 0.2;
+		SetNextThink( 0.2 );
 		return;
 	}
 
@@ -1592,7 +1592,7 @@ void CNihilanthHVR :: GreenBallInit( )
 
 void CNihilanthHVR :: TeleportThink( void  )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	// check world boundaries
 	if (m_hEnemy == NULL || !m_hEnemy->IsAlive() || !IsInWorld( FALSE ))
@@ -1686,7 +1686,7 @@ void CNihilanthHVR::TeleportTouch( CBaseEntity *pOther )
 
 void CNihilanthHVR :: DissipateThink( void  )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if (pev->scale > 5.0)
 		UTIL_Remove( this );
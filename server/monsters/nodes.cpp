@@ -1472,12 +1472,12 @@ void CTestHull :: Spawn( entvars_t *pevMasterNode )
 	{
 		// graph loaded from disk, so we don't need the test hull
 		SetThink( &CTestHull::SUB_Remove );
-		pev->nextthink = gpGlobals->time;
+		SetNextThink( 0 );
 	}
 	else
 	{
 		SetThink( &CTestHull::DropDelay );
-		pev->nextthink = gpGlobals->time + 1;
+		SetNextThink( 1 );
 	}
 
 	// Make this invisible
@@ -1498,7 +1498,7 @@ void CTestHull::DropDelay ( void )
 
 	SetThink( &CTestHull::CallBuildNodeGraph );
 
-	pev->nextthink = gpGlobals->time + 1;
+	SetNextThink( 1 );
 }
 
 //=========================================================
@@ -1588,7 +1588,7 @@ void CTestHull :: ShowBadNode( void )
 	UTIL_ParticleEffect ( absOrigin + gpGlobals->v_right * 64, g_vecZero, 255, 25 );
 	UTIL_ParticleEffect ( absOrigin - gpGlobals->v_right * 64, g_vecZero, 255, 25 );
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 extern BOOL gTouchDisabled;
@@ -1651,7 +1651,7 @@ void CTestHull :: BuildNodeGraph( void )
 	int		step;
 
 	SetThink( &CBaseEntity::SUB_Remove );// no matter what happens, the hull gets rid of itself.
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 
 	// malloc a swollen temporary connection pool that we trim down after we know exactly how many connections there are.
 	pTempPool = (CLink *)calloc ( sizeof ( CLink ) , ( WorldGraph.m_cNodes * MAX_NODE_INITIAL_LINKS ) );
@@ -3555,7 +3555,7 @@ void CNodeViewer::Spawn( )
 
 	m_iDraw = 0;
 	SetThink( &CNodeViewer::DrawThink );
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 }
 
 
@@ -3596,7 +3596,7 @@ void CNodeViewer::AddNode( int iFrom, int iTo )
 
 void CNodeViewer :: DrawThink( void )
 {
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 
 	for (int i = 0; i < 10; i++)
 	{
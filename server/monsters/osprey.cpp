@@ -171,7 +171,7 @@ void COsprey :: Spawn( void )
 
 	if (!(pev->spawnflags & SF_WAITFORTRIGGER))
 	{
-		pev->nextthink = gpGlobals->time + 1.0;
+		SetNextThink( 1.0 );
 	}
 
 	m_pos2 = GetAbsOrigin();
@@ -203,7 +203,7 @@ void COsprey::Precache( void )
 
 void COsprey::CommandUse( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE useType, float value )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 void COsprey :: FindAllThink( void )
@@ -259,7 +259,7 @@ void COsprey :: DeployThink( void )
 	m_hRepel[3] = MakeGrunt( vecSrc );
 
 	SetThink( &COsprey::HoverThink );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 
@@ -310,7 +310,7 @@ CBaseMonster *COsprey :: MakeGrunt( Vector vecSrc )
 			pBeam->SetFlags( BEAM_FSOLID );
 			pBeam->SetColor( 255, 255, 255 );
 			pBeam->SetThink( &CBaseEntity::SUB_Remove );
-			pBeam->pev->nextthink = gpGlobals->time + -4096.0 * tr.flFraction / pGrunt->GetAbsVelocity().z + 0.5;
+			pBeam->SetNextThink( -4096.0 * tr.flFraction / pGrunt->GetAbsVelocity().z + 0.5 );
 
 			// ALERT( at_console, "%d at %.0f %.0f %.0f\n", i, m_vecOrigin[i].x, m_vecOrigin[i].y, m_vecOrigin[i].z );  
 			pGrunt->m_vecLastPosition = m_vecOrigin[i];
@@ -340,7 +340,7 @@ void COsprey :: HoverThink( void )
 		SetThink( &COsprey::FlyThink );
 	}
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	UTIL_MakeAimVectors( GetAbsAngles() );
 	ShowDamage( );
 }
@@ -385,7 +385,7 @@ void COsprey::UpdateGoal( )
 void COsprey::FlyThink( void )
 {
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if ( m_pGoalEnt == NULL && !FStringNull(pev->target) )// this monster has a target
 	{
@@ -488,7 +488,7 @@ void COsprey::Flight( )
 
 void COsprey::HitTouch( CBaseEntity *pOther )
 {
-	pev->nextthink = gpGlobals->time + 2.0;
+	SetNextThink( 2.0 );
 }
 
 void COsprey :: Killed( entvars_t *pevAttacker, int iGib )
@@ -604,7 +604,7 @@ void COsprey :: DyingThink( void )
 
 		// don't stop it we touch a entity
 		pev->flags &= ~FL_ONGROUND;
-		pev->nextthink = gpGlobals->time + 0.2;
+		SetNextThink( 0.2 );
 		return;
 	}
 	else
@@ -204,9 +204,9 @@ void CRoach :: Killed( entvars_t *pevAttacker, int iGib )
 void CRoach :: MonsterThink( void  )
 {
 	if ( FNullEnt( FIND_CLIENT_IN_PVS( edict() ) ) )
-		pev->nextthink = gpGlobals->time + RANDOM_FLOAT(1,1.5);
+		SetNextThink( RANDOM_FLOAT(1,1.5) );
 	else
-		pev->nextthink = gpGlobals->time + 0.1;// keep monster thinking
+		SetNextThink( 0.1 );// keep monster thinking
 
 	FCheckAITrigger();
 
@@ -216,7 +216,7 @@ void CRoach :: MonsterThink( void  )
 	{
 		// if light value hasn't been collection for the first time yet, 
 		// suspend the creature for a second so the world finishes spawning, then we'll collect the light level.
-		pev->nextthink = gpGlobals->time + 1;
+		SetNextThink( 1 );
 		m_fLightHacked = TRUE;
 		return;
 	}
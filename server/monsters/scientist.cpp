@@ -1264,7 +1264,7 @@ void CSittingScientist :: Spawn( )
 	ResetSequenceInfo( );
 	
 	SetThink( &CSittingScientist::SittingThink);
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	UTIL_DropToFloor( this );
 }
@@ -1391,7 +1391,7 @@ void CSittingScientist :: SittingThink( void )
 		pev->frame = 0;
 		SetBoneController( 0, m_headTurn );
 	}
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 // prepare sitting scientist to answer a question
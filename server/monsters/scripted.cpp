@@ -140,7 +140,7 @@ void CCineMonster :: Spawn( void )
 	if ( FStringNull(pev->targetname) || !FStringNull( m_iszIdle ) )
 	{
 		SetThink( &CCineMonster::CineThink );
-		pev->nextthink = gpGlobals->time + 1.0;
+		SetNextThink( 1.0 );
 		// Wait to be used?
 		if ( pev->targetname )
 			m_startTime = gpGlobals->time + 1E6;
@@ -205,7 +205,7 @@ void CCineMonster :: Use( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYP
 	{
 		// if not, try finding them
 		SetThink( &CCineMonster::CineThink );
-		pev->nextthink = gpGlobals->time;
+		SetNextThink( 0 );
 	}
 }
 
@@ -466,7 +466,7 @@ void CCineMonster :: CineThink( void )
 	{
 		CancelScript( );
 		ALERT( at_aiconsole, "script \"%s\" can't find monster \"%s\"\n", STRING( pev->targetname ), STRING( m_iszEntity ) );
-		pev->nextthink = gpGlobals->time + 1.0;
+		SetNextThink( 1.0 );
 	}
 }
 
@@ -548,7 +548,7 @@ void CCineMonster :: SequenceDone ( CBaseMonster *pMonster )
 	if ( !( pev->spawnflags & SF_SCRIPT_REPEATABLE ) )
 	{
 		SetThink( &CBaseEntity::SUB_Remove );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 	
 	// This is done so that another sequence can take over the monster when triggered by the first
@@ -1018,7 +1018,7 @@ void CScriptedSentence :: Use( CBaseEntity *pActivator, CBaseEntity *pCaller, US
 
 //		ALERT( at_console, "Firing sentence: %s\n", STRING(m_iszSentence) );
 		SetThink( &CScriptedSentence::FindThink );
-		pev->nextthink = gpGlobals->time;
+		SetNextThink( 0 );
 	}
 }
 
@@ -1032,7 +1032,7 @@ void CScriptedSentence :: Spawn( void )
 	if ( !pev->targetname )
 	{
 		SetThink( &CScriptedSentence::FindThink );
-		pev->nextthink = gpGlobals->time + 1.0;
+		SetNextThink( 1.0 );
 	}
 
 	switch( pev->impulse )
@@ -1071,7 +1071,7 @@ void CScriptedSentence :: FindThink( void )
 		if ( pev->spawnflags & SF_SENTENCE_ONCE )
 			UTIL_Remove( this );
 		SetThink( &CScriptedSentence::DelayThink );
-		pev->nextthink = gpGlobals->time + m_flDuration + m_flRepeat;
+		SetNextThink( m_flDuration + m_flRepeat );
 		m_active = FALSE;
 //		ALERT( at_console, "%s: found monster %s\n", STRING(m_iszSentence), STRING(m_iszEntity) );
 	}
@@ -1089,13 +1089,13 @@ void CScriptedSentence :: FindThink( void )
 			if ( pev->spawnflags & SF_SENTENCE_ONCE )
 				UTIL_Remove( this );
 			SetThink( &CScriptedSentence::DelayThink );
-			pev->nextthink = gpGlobals->time + m_flDuration + m_flRepeat;
+			SetNextThink( m_flDuration + m_flRepeat );
 			m_active = FALSE;
 		}
 		else
 		{
 	//		ALERT( at_console, "%s: can't find monster %s\n", STRING(m_iszSentence), STRING(m_iszEntity) );
-			pev->nextthink = gpGlobals->time + m_flRepeat + 0.5;
+			SetNextThink( m_flRepeat + 0.5 );
 		}
 	}
 }
@@ -1105,7 +1105,7 @@ void CScriptedSentence :: DelayThink( void )
 {
 	m_active = TRUE;
 	if ( !pev->targetname )
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	SetThink( &CScriptedSentence::FindThink );
 }
 
@@ -1262,7 +1262,7 @@ LINK_ENTITY_TO_CLASS( monster_furniture, CFurniture );
 void CFurniture :: Die ( void )
 {
 	SetThink( &CBaseEntity::SUB_Remove );
-	pev->nextthink = gpGlobals->time;
+	SetNextThink( 0 );
 }
 
 //=========================================================
@@ -82,7 +82,7 @@ void CSoundEnt :: Spawn( void )
 	pev->solid = SOLID_NOT;
 	Initialize();
 
-	pev->nextthink = gpGlobals->time + 1; 
+	SetNextThink( 1 ); 
 }
 
 //=========================================================
@@ -95,7 +95,7 @@ void CSoundEnt :: Think ( void )
 	int iSound;
 	int iPreviousSound;
 
-	pev->nextthink = gpGlobals->time + 0.3;// how often to check the sound list.
+	SetNextThink( 0.3 );// how often to check the sound list.
 
 	iPreviousSound = SOUNDLIST_EMPTY;
 	iSound = m_iActiveSound; 
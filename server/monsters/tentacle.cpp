@@ -448,7 +448,7 @@ void CTentacle :: Test( void )
 	pev->sequence = TENTACLE_ANIM_Floor_Strike;
 	pev->framerate = 0;
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 
@@ -737,7 +737,7 @@ void CTentacle::CommandUse( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_T
 
 void CTentacle :: DieThink( void )
 {
-	pev->nextthink = gpGlobals-> time + 0.1;
+	SetNextThink( 0.1 );
 
 	DispatchAnimEvents( );
 	StudioFrameAdvance( );
@@ -934,7 +934,7 @@ void CTentacle :: Start( void )
 		g_fSquirmSound = TRUE;
 	}
 	
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 
@@ -238,7 +238,7 @@ void CBaseTurret::KeyValue( KeyValueData *pkvd )
 void CBaseTurret::Spawn()
 { 
 	Precache( );
-	pev->nextthink		= gpGlobals->time + 1;
+	SetNextThink( 1 );
 	pev->movetype		= MOVETYPE_FLY;
 	pev->sequence		= 0;
 	pev->frame		= 0;
@@ -313,7 +313,7 @@ void CTurret::Spawn()
 	m_pEyeGlow->SetAttachment( edict(), 2 );
 	m_eyeBrightness = 0;
 
-	pev->nextthink = gpGlobals->time + 0.3; 
+	SetNextThink( 0.3 ); 
 }
 
 void CTurret::Precache()
@@ -345,7 +345,7 @@ void CMiniTurret::Spawn()
 	UTIL_SetSize(pev, Vector(-16, -16, -m_iRetractHeight), Vector(16, 16, m_iRetractHeight));
 
 	SetThink( &CBaseTurret::Initialize);
-	pev->nextthink = gpGlobals->time + 0.3; 
+	SetNextThink( 0.3 ); 
 }
 
 
@@ -395,7 +395,7 @@ void CBaseTurret::Initialize(void)
 	{
 		m_flLastSight = gpGlobals->time + m_flMaxWait;
 		SetThink( &CBaseTurret::AutoSearchThink );		
-		pev->nextthink = gpGlobals->time + .1;
+		SetNextThink( .1 );
 	}
 	else
 	{
@@ -418,14 +418,14 @@ void CBaseTurret::TurretUse( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_
 	if (m_iOn)
 	{
 		m_hEnemy = NULL;
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 		m_iAutoStart = FALSE;// switching off a turret disables autostart
 		//!!!! this should spin down first!!BUGBUG
 		SetThink( &CBaseTurret::Retire );
 	}
 	else 
 	{
-		pev->nextthink = gpGlobals->time + 0.1; // turn on delay
+		SetNextThink( 0.1 ); // turn on delay
 
 		// if the turret is flagged as an autoactivate turret, re-enable it's ability open self.
 		if ( pev->spawnflags & SF_MONSTER_TURRET_AUTOACTIVATE )
@@ -487,7 +487,7 @@ void CBaseTurret::ActiveThink(void)
 	int fAttack = 0;
 	Vector vecDirToEnemy;
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	StudioFrameAdvance( );
 
 	if ((!m_iOn) || (m_hEnemy == NULL))
@@ -665,7 +665,7 @@ void CMiniTurret::Shoot(Vector &vecSrc, Vector &vecDirToEnemy)
 
 void CBaseTurret::Deploy(void)
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	StudioFrameAdvance( );
 
 	if (pev->sequence != TURRET_ANIM_DEPLOY)
@@ -707,7 +707,7 @@ void CBaseTurret::Retire(void)
 	m_vecGoalAngles.x = 0;
 	m_vecGoalAngles.y = m_flStartYaw;
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	StudioFrameAdvance( );
 
@@ -736,7 +736,7 @@ void CBaseTurret::Retire(void)
 			if (m_iAutoStart)
 			{
 				SetThink( &CBaseTurret::AutoSearchThink);		
-				pev->nextthink = gpGlobals->time + .1;
+				SetNextThink( .1 );
 			}
 			else
 				SetThink( &CBaseEntity::SUB_DoNothing);
@@ -752,7 +752,7 @@ void CBaseTurret::Retire(void)
 void CTurret::SpinUpCall(void)
 {
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	// Are we already spun up? If not start the two stage process.
 	if (!m_iSpin)
@@ -761,7 +761,7 @@ void CTurret::SpinUpCall(void)
 		// for the first pass, spin up the the barrel
 		if (!m_iStartSpin)
 		{
-			pev->nextthink = gpGlobals->time + 1.0; // spinup delay
+			SetNextThink( 1.0 ); // spinup delay
 			EMIT_SOUND(ENT(pev), CHAN_BODY, "turret/tu_spinup.wav", TURRET_MACHINE_VOLUME, ATTN_NORM);
 			m_iStartSpin = 1;
 			pev->framerate = 0.1;
@@ -769,7 +769,7 @@ void CTurret::SpinUpCall(void)
 		// after the barrel is spun up, turn on the hum
 		else if (pev->framerate >= 1.0)
 		{
-			pev->nextthink = gpGlobals->time + 0.1; // retarget delay
+			SetNextThink( 0.1 ); // retarget delay
 			EMIT_SOUND(ENT(pev), CHAN_STATIC, "turret/tu_active2.wav", TURRET_MACHINE_VOLUME, ATTN_NORM);
 			SetThink( &CBaseTurret::ActiveThink);
 			m_iStartSpin = 0;
@@ -854,7 +854,7 @@ void CBaseTurret::SearchThink(void)
 	// ensure rethink
 	SetTurretAnim(TURRET_ANIM_SPIN);
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if (m_flSpinUpTime == 0 && m_flMaxSpin)
 		m_flSpinUpTime = gpGlobals->time + m_flMaxSpin;
@@ -916,7 +916,7 @@ void CBaseTurret::AutoSearchThink(void)
 {
 	// ensure rethink
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.3;
+	SetNextThink( 0.3 );
 
 	// If we have a target and we're still healthy
 
@@ -947,7 +947,7 @@ void CBaseTurret ::	TurretDeath( void )
 	BOOL iActive = FALSE;
 
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if (pev->deadflag != DEAD_DEAD)
 	{
@@ -1052,7 +1052,7 @@ int CBaseTurret::TakeDamage(entvars_t *pevInflictor, entvars_t *pevAttacker, flo
 		SetUse( NULL );
 		SetThink( &CBaseTurret::TurretDeath);
 		SUB_UseTargets( this, USE_ON, 0 ); // wake up others
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 
 		return 0;
 	}
@@ -1226,7 +1226,7 @@ void CSentry::Spawn()
 
 	SetTouch( &CSentry::SentryTouch);
 	SetThink( &CBaseTurret::Initialize);	
-	pev->nextthink = gpGlobals->time + 0.3; 
+	SetNextThink( 0.3 ); 
 }
 
 void CSentry::Shoot(Vector &vecSrc, Vector &vecDirToEnemy)
@@ -1251,7 +1251,7 @@ int CSentry::TakeDamage(entvars_t *pevInflictor, entvars_t *pevAttacker, float f
 	{
 		SetThink( &CBaseTurret::Deploy );
 		SetUse( NULL );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 
 	pev->health -= flDamage;
@@ -1266,7 +1266,7 @@ int CSentry::TakeDamage(entvars_t *pevInflictor, entvars_t *pevAttacker, float f
 		SetUse( NULL);
 		SetThink( &CSentry::SentryDeath);
 		SUB_UseTargets( this, USE_ON, 0 ); // wake up others
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 
 		return 0;
 	}
@@ -1289,7 +1289,7 @@ void CSentry :: SentryDeath( void )
 	BOOL iActive = FALSE;
 
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if (pev->deadflag != DEAD_DEAD)
 	{
@@ -87,7 +87,7 @@ void CXenPLight :: Spawn( void )
 
 	UTIL_SetSize( pev, Vector(-80,-80,0), Vector(80,80,32));
 	SetActivity( ACT_IDLE );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	pev->frame = RANDOM_FLOAT(0,255);
 
 	m_pGlow = CSprite::SpriteCreate( XEN_PLANT_GLOW_SPRITE, GetAbsOrigin() + Vector(0 ,0 , (pev->mins.z + pev->maxs.z ) * 0.5 ), FALSE );
@@ -105,7 +105,7 @@ void CXenPLight :: Precache( void )
 void CXenPLight :: Think( void )
 {
 	StudioFrameAdvance();
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	switch( GetActivity() )
 	{
@@ -196,13 +196,13 @@ void CXenHair::Spawn( void )
 
 	pev->solid = SOLID_NOT;
 	pev->movetype = MOVETYPE_NONE;
-	pev->nextthink = gpGlobals->time + RANDOM_FLOAT( 0.1, 0.4 );	// Load balance these a bit
+	SetNextThink( RANDOM_FLOAT( 0.1, 0.4 ) );	// Load balance these a bit
 }
 
 void CXenHair::Think( void )
 {
 	StudioFrameAdvance();
-	pev->nextthink = gpGlobals->time + 0.5;
+	SetNextThink( 0.5 );
 }
 
 void CXenHair::Precache( void )
@@ -283,7 +283,7 @@ void CXenTree :: Spawn( void )
 
 	UTIL_SetSize( pev, Vector(-30,-30,0), Vector(30,30,188));
 	SetActivity( ACT_IDLE );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	pev->frame = RANDOM_FLOAT(0,255);
 	pev->framerate = RANDOM_FLOAT( 0.7, 1.4 );
 
@@ -375,7 +375,7 @@ void CXenTree :: HandleAnimEvent( MonsterEvent_t *pEvent )
 void CXenTree :: Think( void )
 {
 	float flInterval = StudioFrameAdvance();
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	DispatchAnimEvents( flInterval );
 
 	switch( GetActivity() )
@@ -525,7 +525,7 @@ void CXenSpore :: Spawn( void )
 	pev->frame = RANDOM_FLOAT(0,255);
 	pev->framerate = RANDOM_FLOAT( 0.7, 1.4 );
 	ResetSequenceInfo( );
-	pev->nextthink = gpGlobals->time + RANDOM_FLOAT( 0.1, 0.4 );	// Load balance these a bit
+	SetNextThink( RANDOM_FLOAT( 0.1, 0.4 ) );	// Load balance these a bit
 }
 
 const char *CXenSpore::pModelNames[] = 
@@ -548,5 +548,5 @@ void CXenSpore :: Touch( CBaseEntity *pOther )
 void CXenSpore :: Think( void )
 {
 	float flInterval = StudioFrameAdvance();
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
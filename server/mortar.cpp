@@ -176,7 +176,7 @@ void CFuncMortarField :: FieldUse( CBaseEntity *pActivator, CBaseEntity *pCaller
 		if (pActivator)	pentOwner = pActivator->edict();
 
 		CBaseEntity *pMortar = Create("monster_mortar", tr.vecEndPos, Vector( 0, 0, 0 ), pentOwner );
-		pMortar->pev->nextthink = gpGlobals->time + t;
+		pMortar->SetNextThink( t );
 		t += RANDOM_FLOAT( 0.2, 0.5 );
 
 		if (i == 0)
@@ -212,7 +212,7 @@ void CMortar::Spawn( )
 	pev->dmg		= 200;
 
 	SetThink( &CMortar::MortarExplode );
-	pev->nextthink = 0;
+	DontThink();
 
 	Precache( );
 
@@ -179,7 +179,7 @@ void CPathTrack :: Spawn( void )
 // DEBUGGING CODE
 #ifdef PATH_SPARKLE_DEBUG
 	SetThink( &Sparkle );
-	pev->nextthink = gpGlobals->time + 0.5;
+	SetNextThink( 0.5 );
 #endif
 }
 
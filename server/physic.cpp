@@ -24,6 +24,8 @@ GNU General Public License for more details.
 #include	"game.h"
 #include	"com_model.h"
 #include	"movelist.h"
+#include	"thinkqueue.h"
+#include	"profiler.h"
 #include	"xash3d_features.h"
 #include  "render_api.h"
 #include	"physic.h"
@@ -38,6 +40,10 @@ GNU General Public License for more details.
 CPhysicsPushedEntities	s_PushedEntities;
 CPhysicsPushedEntities	*g_pPushedEntities = &s_PushedEntities;
 
+// schedule of entity thinks
+CThinkQueue		s_ThinkQueue;
+CThinkQueue		*g_pThinkQueue = &s_ThinkQueue;
+
 unsigned int EngineSetFeatures( void )
 {
 	unsigned int flags = (ENGINE_WRITE_LARGE_COORD|ENGINE_TRANSFORM_TRACE_AABB|ENGINE_COMPUTE_STUDIO_LERP);
@@ -343,6 +349,8 @@ int DispatchPhysicsEntity( edict_t *pEdict )
 	if( !pEntity )
 		return 0;	// not initialized
 
+	PROFILE_SCOPE( PROF_PHYSICS, pEntity->GetClassname() );
+
 	if( RunPhysicsFrame( pEntity ))
 	{
 		// g-cont. don't alow free entities during loading because
@@ -459,6 +467,8 @@ void SV_LinearMove( CBaseEntity *pEntity, float frametime, float friction )
 //-----------------------------------------------------------------------------
 void CPhysicsPushedEntities::AddEntity( CBaseEntity *ent )
 {
+	ent->WakeUp();
+
 	int i = m_rgMoved.AddToTail();
 	m_rgMoved[i].m_pEntity = ent;
 	m_rgMoved[i].m_vecStartAbsOrigin = ent->GetAbsOrigin();
@@ -1108,36 +1118,244 @@ void SV_UpdateBaseVelocity( CBaseEntity *pEntity )
 	}
 }
 
+//-----------------------------------------------------------------------------
+// Purpose: entity think scheduling
+//-----------------------------------------------------------------------------
+void CThinkQueue::Clear( void )
+{
+	m_rgEntries.RemoveAll();
+	m_flLastTime = -1.0;
+
+	// entities must be scheduled again
+	edict_t *pEdict = INDEXENT( 0 );
+	for( int i = 0; pEdict && i < gpGlobals->maxEntities; i++, pEdict++ )
+	{
+		if( pEdict->free || !pEdict->pvPrivateData )
+			continue;
+
+		CBaseEntity *pEntity = CBaseEntity::Instance( pEdict );
+		if( !pEntity ) continue;
+
+		pEntity->m_flScheduledThink = 0.0f;
+		Schedule( pEntity );
+	}
+}
+
+void CThinkQueue::Push( const ThinkEntry_t &entry )
+{
+	int i = m_rgEntries.AddToTail( entry );
+
+	// sift up
+	while( i > 0 )
+	{
+		int parent = (i - 1) >> 1;
+		if( m_rgEntries[parent].time <= entry.time )
+			break;
+		m_rgEntries[i] = m_rgEntries[parent];
+		i = parent;
+	}
+
+	m_rgEntries[i] = entry;
+}
+
+void CThinkQueue::Pop( ThinkEntry_t &entry )
+{
+	int count = m_rgEntries.Count() - 1;
+
+	entry = m_rgEntries[0];
+	ThinkEntry_t last = m_rgEntries[count];
+	m_rgEntries.Remove( count );
+	if( !count ) return;
+
+	// sift down
+	int i = 0;
+	while( 1 )
+	{
+		int child = (i << 1) + 1;
+		if( child >= count ) break;
+		if( child + 1 < count && m_rgEntries[child + 1].time < m_rgEntries[child].time )
+			child++;
+		if( last.time <= m_rgEntries[child].time )
+			break;
+		m_rgEntries[i] = m_rgEntries[child];
+		i = child;
+	}
+
+	m_rgEntries[i] = last;
+}
+
+CBaseEntity *CThinkQueue::EntityForEntry( const ThinkEntry_t &entry )
+{
+	if( entry.entindex < 0 || entry.entindex >= gpGlobals->maxEntities )
+		return NULL;
+
+	edict_t *pEdict = INDEXENT( entry.entindex );
+
+	if( !pEdict || pEdict->free || !pEdict->pvPrivateData )
+		return NULL;
+
+	if( pEdict->serialnumber != entry.serialnumber )
+		return NULL; // edict was reused
+
+	CBaseEntity *pEntity = CBaseEntity::Instance( pEdict );
+
+	// entity was rescheduled since
+	if( !pEntity || pEntity->m_flScheduledThink != entry.time || pEntity->pev->nextthink != entry.time )
+		return NULL;
+
+	return pEntity;
+}
+
+// rebuild the heap without outdated entries
+void CThinkQueue::Compact( void )
+{
+	CUtlArray<ThinkEntry_t> entries;
+	ThinkEntry_t entry;
+
+	while( m_rgEntries.Count() > 0 )
+	{
+		Pop( entry );
+		if( EntityForEntry( entry ) != NULL )
+			entries.AddToTail( entry );
+	}
+
+	// already sorted so it's a valid heap
+	for( int i = 0; i < entries.Count(); i++ )
+		m_rgEntries.AddToTail( entries[i] );
+}
+
+void CThinkQueue::Schedule( CBaseEntity *pEntity )
+{
+	float thinktime = pEntity->pev->nextthink;
+
+	if( thinktime == pEntity->m_flScheduledThink )
+		return; // already known
+
+	pEntity->m_flScheduledThink = thinktime;
+
+	if( thinktime <= 0.0f )
+		return; // doesn't think
+
+	ThinkEntry_t entry;
+	entry.time = thinktime;
+	entry.entindex = pEntity->entindex();
+	entry.serialnumber = pEntity->edict()->serialnumber;
+	Push( entry );
+}
+
 /*
 =============
-SV_RunThink
+RunThinks
 
-Runs thinking code if time.  There is some play in the exact time the think
-function will be called, because it is called before any movement is done
-in a frame.  Not used for pushmove objects, because they must be exact.
-Returns false if the entity removed itself.
+Runs thinking code of all the entities what are due in this frame.
+Called before any movement is done in a frame. Thinks that become due
+while the queue is running are dispatched too, but each entity thinks
+only once per frame
 =============
 */
-BOOL SV_RunThink( CBaseEntity *pEntity )
+void CThinkQueue::RunThinks( void )
 {
-	float	thinktime;
-	edict_t	*ed = pEntity->edict();
+	double frametime = PHYSICS_TIME();
 
-	thinktime = pEntity->pev->nextthink;
+	// server time was reset (changelevel, restore etc)
+	if( frametime < m_flLastTime )
+		Clear();
 
-	if( thinktime <= 0 || thinktime > PHYSICS_TIME( ) + gpGlobals->frametime )
-		return TRUE;
-		
-	if( thinktime < PHYSICS_TIME( ))
-		thinktime = PHYSICS_TIME();	// don't let things stay in the past.
-					// it is possible to start that way
-					// by a trigger with a local time.
-	pEntity->DontThink();
+	m_flLastTime = frametime;
+
+	ThinkStats_t *stats = &m_stats[m_iCurStats];
+	m_iCurStats = (m_iCurStats + 1) % THINK_HISTORY;
+	memset( stats, 0, sizeof( *stats ));
+	stats->frame = g_ulFrameCount;
+	stats->time = frametime;
+
+	double dueTime = frametime + gpGlobals->frametime;
+	BOOL bActive = ( GET_SERVER_STATE() == SERVER_ACTIVE );
+	m_rgDeferred.RemoveAll();
 
-	gpGlobals->time = thinktime;	// ouch!!!
-	DispatchThink( pEntity->edict() );
+	while( m_rgEntries.Count() > 0 && m_rgEntries[0].time <= dueTime )
+	{
+		ThinkEntry_t entry;
+		Pop( entry );
+
+		CBaseEntity *pEntity = EntityForEntry( entry );
+
+		if( !pEntity )
+		{
+			stats->stale++;
+			continue;
+		}
+
+		// clients are thinking by engine
+		if( entry.entindex >= 1 && entry.entindex <= gpGlobals->maxClients )
+			continue;
+
+		// pushers are not thinking while level is loading
+		// and each entity may think only once per frame
+		if(( !bActive && pEntity->pev->movetype == MOVETYPE_PUSH ) || pEntity->m_iThinkFrame == g_ulFrameCount )
+		{
+			m_rgDeferred.AddToTail( entry );
+			continue;
+		}
+
+		float thinktime = pEntity->pev->nextthink;
+
+		if( thinktime < frametime )
+			thinktime = frametime;	// don't let things stay in the past.
+						// it is possible to start that way
+						// by a trigger with a local time.
+		pEntity->m_iThinkFrame = g_ulFrameCount;
+		pEntity->WakeUp();
+		pEntity->DontThink();
+
+		gpGlobals->time = thinktime;	// ouch!!!
+		DispatchThink( pEntity->edict() );
+		stats->due++;
+	}
+
+	gpGlobals->time = frametime;
+
+	for( int i = 0; i < m_rgDeferred.Count(); i++ )
+		Push( m_rgDeferred[i] );
+
+	if( m_rgEntries.Count() > gpGlobals->maxEntities * 4 )
+		Compact();
+
+	stats->queued = m_rgEntries.Count();
+}
+
+void CThinkQueue::ReportStats( void )
+{
+	ALERT( at_console, "frame     time    due  stale  queued\n" );
+
+	for( int i = 0; i < THINK_HISTORY; i++ )
+	{
+		const ThinkStats_t *stats = &m_stats[(m_iCurStats + i) % THINK_HISTORY];
+		if( !stats->frame ) continue;
+
+		ALERT( at_console, "%-8u %7.2f %6i %6i %7i\n", stats->frame, stats->time, stats->due, stats->stale, stats->queued );
+	}
 
-	return (ed->free) ? FALSE : TRUE;
+	ALERT( at_console, "%i thinks queued\n", m_rgEntries.Count() );
+}
+
+void DumpThinkStats_f( void )
+{
+	g_pThinkQueue->ReportStats();
+}
+
+/*
+=============
+SV_RunThink
+
+Thinks are dispatched by the think queue at the start of the frame,
+here we only check if the entity removed itself.
+Returns false if the entity removed itself.
+=============
+*/
+BOOL SV_RunThink( CBaseEntity *pEntity )
+{
+	return (pEntity->edict()->free) ? FALSE : TRUE;
 }
 
 /*
@@ -1157,6 +1375,10 @@ void SV_Impact( CBaseEntity *pEntity1, CBaseEntity *pEntity2, TraceResult *trace
 	if(( pEntity1->pev->flags|pEntity2->pev->flags ) & FL_KILLME )
 		return;
 
+	// touches may push resting entities
+	pEntity1->WakeUp();
+	pEntity2->WakeUp();
+
 	// group trace support
 	if( pEntity1->pev->groupinfo && pEntity2->pev->groupinfo )
 	{
@@ -2576,6 +2798,118 @@ void SV_Physics_Vehicle( CBaseEntity *pEntity )
 		pEntity->SetGroundEntity( trace.pHit ? trace.pHit : ENT( 0 ));
 }
 
+/*
+=============
+Sleeping entities
+
+Motionless entities that rest on the ground and have no parent are put
+to sleep after a few frames so the physics frame skips them. They are
+woken by touches, pushers, UTIL_SetOrigin, thinks and velocity changes
+=============
+*/
+#define SLEEP_REST_FRAMES	10
+
+static unsigned int	s_iSleepFrame;
+static int	s_nAwake, s_nSleeping;
+static int	s_nLastAwake, s_nLastSleeping;
+
+static BOOL SV_CanSleep( CBaseEntity *pEntity )
+{
+	if( !g_allow_sleep.value || pEntity->m_hParent != NULL || pEntity->m_hChild != NULL )
+		return FALSE;
+
+	if( pEntity->pev->flags & (FL_CLIENT|FL_KILLME|FL_BASEVELOCITY))
+		return FALSE;
+
+	// physic-driven actors are moved by the physics engine
+	if( pEntity->m_iActorType != ACTOR_INVALID && pEntity->m_iActorType != ACTOR_STATIC )
+		return FALSE;
+
+	switch( pEntity->pev->movetype )
+	{
+	case MOVETYPE_NONE:
+		return TRUE;
+	case MOVETYPE_TOSS:
+	case MOVETYPE_BOUNCE:
+	case MOVETYPE_STEP:
+	case MOVETYPE_PUSHSTEP:
+		break;
+	default:
+		return FALSE;
+	}
+
+	// live monsters are stepping themselves
+	if(( pEntity->pev->flags & FL_MONSTER ) && pEntity->pev->deadflag == DEAD_NO )
+		return FALSE;
+
+	if( !( pEntity->pev->flags & FL_ONGROUND ) || pEntity->pev->waterlevel != 0 )
+		return FALSE;
+
+	// ground was removed or will move us
+	edict_t *pGround = pEntity->pev->groundentity;
+	if( pGround && ( pGround->free || ( pGround->v.flags & FL_CONVEYOR )))
+		return FALSE;
+
+	if( pEntity->GetAbsVelocity() != g_vecZero || pEntity->GetBaseVelocity() != g_vecZero )
+		return FALSE;
+
+	if( pEntity->GetLocalAvelocity() != g_vecZero )
+		return FALSE;
+
+	return TRUE;
+}
+
+//
+// returns true if entity is sleeping and can be skipped for this frame
+//
+static BOOL SV_CheckSleep( CBaseEntity *pEntity )
+{
+	if( s_iSleepFrame != g_ulFrameCount )
+	{
+		s_nLastAwake = s_nAwake;
+		s_nLastSleeping = s_nSleeping;
+		s_nAwake = s_nSleeping = 0;
+		s_iSleepFrame = g_ulFrameCount;
+	}
+
+	if( pEntity->m_fSleeping )
+	{
+		if( gpGlobals->force_retouch == 0.0f && SV_CanSleep( pEntity ))
+		{
+			s_nSleeping++;
+			return TRUE;
+		}
+
+		pEntity->WakeUp();
+	}
+
+	s_nAwake++;
+	return FALSE;
+}
+
+//
+// count the frames entity spent at rest after the physics frame
+//
+static void SV_CheckRest( CBaseEntity *pEntity )
+{
+	if( pEntity->edict()->free )
+		return;
+
+	if( !SV_CanSleep( pEntity ))
+	{
+		pEntity->m_iRestFrames = 0;
+		return;
+	}
+
+	if( ++pEntity->m_iRestFrames >= SLEEP_REST_FRAMES )
+		pEntity->m_fSleeping = TRUE;
+}
+
+void DumpSleepStats_f( void )
+{
+	ALERT( at_console, "%i entities awake, %i sleeping\n", s_nLastAwake, s_nLastSleeping );
+}
+
 //
 // assume pEntity is valid
 //
@@ -2587,18 +2921,31 @@ int RunPhysicsFrame( CBaseEntity *pEntity )
 
 	pEntity->m_iPhysicsFrame = g_ulFrameCount;
 
+#ifdef _DEBUG
+	if( pEntity->pev->nextthink != pEntity->m_flScheduledThink )
+	{
+		ALERT( at_warning, "%s: nextthink was changed directly\n", pEntity->GetClassname( ));
+		g_pThinkQueue->Schedule( pEntity );
+	}
+#endif
+
 	if( gpGlobals->force_retouch != 0.0f )
 	{
 		// force retouch even for stationary
 		pEntity->RelinkEntity( true );
 	}
 
+	// resting entities cost nothing until woken up
+	if( SV_CheckSleep( pEntity ))
+		return 1;
+
 	// If we've have a parent, we must simulate that first.
 	CBaseEntity *pParent = pEntity->m_hParent;
 
 	if( pEntity->pev->movetype == MOVETYPE_NONE && !pParent )
 	{
 		SV_Physics_None( pEntity );
+		SV_CheckRest( pEntity );
 		return 1;
 	}
 
@@ -2652,10 +2999,12 @@ int RunPhysicsFrame( CBaseEntity *pEntity )
 	case MOVETYPE_FLYMISSILE:
 	case MOVETYPE_BOUNCEMISSILE:
 		SV_Physics_Toss( pEntity );
+		SV_CheckRest( pEntity );
 		return 1;
 	case MOVETYPE_STEP:
 	case MOVETYPE_PUSHSTEP:
 		SV_Physics_Step( pEntity );
+		SV_CheckRest( pEntity );
 		return 1;
 	case MOVETYPE_PUSH:
 		SV_Physics_Pusher( pEntity );
@@ -0,0 +1,2768 @@
+/*
+physnative.cpp - built-in rigid body simulation
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include "physic.h"		// must be first!
+#ifndef USE_PHYSICS_ENGINE
+
+#include "extdll.h"
+#include "util.h"
+#include "cbase.h"
+#include "saverestore.h"
+#include "client.h"
+#include "com_model.h"
+#include "studio.h"
+#include "triangleapi.h"
+#include "physcallback.h"
+#include "tracemesh.h"
+#include "physnative.h"
+#include "game.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#define HAVE_PHYSIC_THREADS
+#endif
+
+CPhysicNative	NativePhysic;
+IPhysicLayer	*WorldPhysic = &NativePhysic;
+
+// Vector members can't be cleared with memset, copy these instead.
+// Static storage keeps them zero filled
+static rigidbody_t	s_emptyBody;
+static trace_t	s_emptyTrace;
+static TraceResult	s_emptyTraceResult;
+
+typedef void (*pfnPhysicJob)( void *context, int index );
+
+//-----------------------------------------------------------------------------
+// Purpose: Tiny pool of worker threads. Run() splits [0..count) between
+//  the workers and the calling thread and returns when all of them are done.
+//  Jobs must not call the engine.
+//-----------------------------------------------------------------------------
+class CPhysicWorkers
+{
+public:
+	CPhysicWorkers( void ) { m_iNumThreads = 0; }
+
+	void		Init( int numThreads );
+	void		Shutdown( void );
+	void		Run( pfnPhysicJob pfnJob, void *pContext, int count );
+	int		NumThreads( void ) { return m_iNumThreads; }
+private:
+#ifdef HAVE_PHYSIC_THREADS
+	static void	*WorkerThread( void *arg );
+	void		ProcessJobs( void );
+
+	pthread_t		m_threads[MAX_PHYSIC_THREADS];
+	pthread_mutex_t	m_lock;
+	pthread_cond_t	m_wake;
+	pthread_cond_t	m_done;
+	int		m_iGeneration;
+	int		m_iBusy;
+	bool		m_fQuit;
+
+	pfnPhysicJob	m_pfnJob;
+	void		*m_pContext;
+	int		m_iCount;
+	volatile int	m_iNext;
+#endif
+	int		m_iNumThreads;	// worker threads, calling thread is not counted
+};
+
+static CPhysicWorkers	s_Workers;
+
+void CPhysicWorkers :: Init( int numThreads )
+{
+	Shutdown();
+#ifdef HAVE_PHYSIC_THREADS
+	numThreads = bound( 0, numThreads, MAX_PHYSIC_THREADS );
+	if( numThreads <= 0 ) return;
+
+	pthread_mutex_init( &m_lock, NULL );
+	pthread_cond_init( &m_wake, NULL );
+	pthread_cond_init( &m_done, NULL );
+	m_iGeneration = 0;
+	m_iBusy = 0;
+	m_fQuit = false;
+
+	for( int i = 0; i < numThreads; i++ )
+	{
+		if( pthread_create( &m_threads[i], NULL, WorkerThread, this ) != 0 )
+			break;
+		m_iNumThreads++;
+	}
+
+	if( !m_iNumThreads )
+	{
+		pthread_cond_destroy( &m_done );
+		pthread_cond_destroy( &m_wake );
+		pthread_mutex_destroy( &m_lock );
+	}
+#endif
+}
+
+void CPhysicWorkers :: Shutdown( void )
+{
+#ifdef HAVE_PHYSIC_THREADS
+	if( !m_iNumThreads ) return;
+
+	pthread_mutex_lock( &m_lock );
+	m_fQuit = true;
+	pthread_cond_broadcast( &m_wake );
+	pthread_mutex_unlock( &m_lock );
+
+	for( int i = 0; i < m_iNumThreads; i++ )
+		pthread_join( m_threads[i], NULL );
+
+	pthread_cond_destroy( &m_done );
+	pthread_cond_destroy( &m_wake );
+	pthread_mutex_destroy( &m_lock );
+#endif
+	m_iNumThreads = 0;
+}
+
+#ifdef HAVE_PHYSIC_THREADS
+void CPhysicWorkers :: ProcessJobs( void )
+{
+	int	i;
+
+	while(( i = __sync_fetch_and_add( &m_iNext, 1 )) < m_iCount )
+		m_pfnJob( m_pContext, i );
+}
+
+void *CPhysicWorkers :: WorkerThread( void *arg )
+{
+	CPhysicWorkers *pWorkers = (CPhysicWorkers *)arg;
+	int generation = 0;
+
+	while( 1 )
+	{
+		pthread_mutex_lock( &pWorkers->m_lock );
+
+		while( pWorkers->m_iGeneration == generation && !pWorkers->m_fQuit )
+			pthread_cond_wait( &pWorkers->m_wake, &pWorkers->m_lock );
+
+		if( pWorkers->m_fQuit )
+		{
+			pthread_mutex_unlock( &pWorkers->m_lock );
+			break;
+		}
+
+		generation = pWorkers->m_iGeneration;
+		pthread_mutex_unlock( &pWorkers->m_lock );
+
+		pWorkers->ProcessJobs();
+
+		pthread_mutex_lock( &pWorkers->m_lock );
+		if( --pWorkers->m_iBusy == 0 )
+			pthread_cond_signal( &pWorkers->m_done );
+		pthread_mutex_unlock( &pWorkers->m_lock );
+	}
+
+	return NULL;
+}
+#endif
+
+void CPhysicWorkers :: Run( pfnPhysicJob pfnJob, void *pContext, int count )
+{
+#ifdef HAVE_PHYSIC_THREADS
+	if( m_iNumThreads > 0 && count > 1 )
+	{
+		pthread_mutex_lock( &m_lock );
+		m_pfnJob = pfnJob;
+		m_pContext = pContext;
+		m_iCount = count;
+		m_iNext = 0;
+		m_iBusy = m_iNumThreads;
+		m_iGeneration++;
+		pthread_cond_broadcast( &m_wake );
+		pthread_mutex_unlock( &m_lock );
+
+		// calling thread works too
+		ProcessJobs();
+
+		pthread_mutex_lock( &m_lock );
+		while( m_iBusy > 0 )
+			pthread_cond_wait( &m_done, &m_lock );
+		pthread_mutex_unlock( &m_lock );
+		return;
+	}
+#endif
+	for( int i = 0; i < count; i++ )
+		pfnJob( pContext, i );
+}
+
+static int PhysicThreadsCount( void )
+{
+	int count = (int)g_physic_threads.value;
+
+	if( count <= 0 )
+	{
+#ifdef HAVE_PHYSIC_THREADS
+		count = (int)sysconf( _SC_NPROCESSORS_ONLN );
+#else
+		count = 1;
+#endif
+	}
+
+	// NOTE: cvar counts the main thread too
+	return bound( 1, count, MAX_PHYSIC_THREADS + 1 ) - 1;
+}
+
+/*
+===============
+
+GEOMETRY HELPERS
+
+===============
+*/
+// box corners: bit 0 is X, bit 1 is Y, bit 2 is Z
+static const int s_BoxFaces[6][4] =
+{
+{ 0, 2, 6, 4 },	// -X
+{ 1, 3, 7, 5 },	// +X
+{ 0, 1, 5, 4 },	// -Y
+{ 2, 3, 7, 6 },	// +Y
+{ 0, 1, 3, 2 },	// -Z
+{ 4, 5, 7, 6 },	// +Z
+};
+
+static const int s_BoxEdges[12][2] =
+{
+{ 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+{ 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 },
+};
+
+static void BoxPoints( const Vector &mins, const Vector &maxs, Vector points[8] )
+{
+	for( int i = 0; i < 8; i++ )
+	{
+		points[i].x = ( i & 1 ) ? maxs.x : mins.x;
+		points[i].y = ( i & 2 ) ? maxs.y : mins.y;
+		points[i].z = ( i & 4 ) ? maxs.z : mins.z;
+	}
+}
+
+static int BodyPoints( const rigidbody_t *body, Vector points[MAX_HULL_POINTS] )
+{
+	int	i;
+
+	if( body->shape == SHAPE_HULL )
+	{
+		// hull is in model space, rotation goes around the center
+		for( i = 0; i < body->hull->numPoints; i++ )
+			points[i] = body->position + body->rot.VectorRotate( body->hull->points[i] - body->center );
+		return body->hull->numPoints;
+	}
+
+	BoxPoints( -body->extents, body->extents, points );
+
+	for( i = 0; i < 8; i++ )
+		points[i] = body->position + body->rot.VectorRotate( points[i] );
+
+	return 8;
+}
+
+/*
+=================
+PointDepth
+
+penetration of the point into the box or hull and the surface normal.
+Result is below -PHYS_CONTACT_MARGIN when the point is outside
+=================
+*/
+static float PointDepth( const rigidbody_t *body, const Vector &point, Vector &normal )
+{
+	Vector local = body->rot.VectorIRotate( point - body->position );
+	float depth = 99999.0f;
+	int i;
+
+	if( body->shape == SHAPE_HULL )
+	{
+		const rbhull_t *hull = body->hull;
+
+		local += body->center; // back to model space
+
+		for( i = 0; i < hull->numFaces; i++ )
+		{
+			float d = hull->dists[i] - DotProduct( local, hull->normals[i] );
+
+			if( d < -PHYS_CONTACT_MARGIN )
+				return d;
+
+			if( d < depth )
+			{
+				normal = hull->normals[i];
+				depth = d;
+			}
+		}
+	}
+	else
+	{
+		for( i = 0; i < 3; i++ )
+		{
+			float d = body->extents[i] - fabs( local[i] );
+
+			if( d < -PHYS_CONTACT_MARGIN )
+				return d;
+
+			if( d < depth )
+			{
+				normal = g_vecZero;
+				normal[i] = ( local[i] > 0.0f ) ? 1.0f : -1.0f;
+				depth = d;
+			}
+		}
+	}
+
+	normal = body->rot.VectorRotate( normal );
+
+	return depth;
+}
+
+/*
+=================
+AddFacet
+
+CMeshDesc builds the facet plane from winding,
+so make sure what the triangle is facing along the normal
+=================
+*/
+static void AddFacet( CMeshDesc *pMesh, Vector triangle[3], const Vector &normal )
+{
+	Vector facing = CrossProduct( triangle[2] - triangle[0], triangle[1] - triangle[0] );
+
+	if( DotProduct( facing, normal ) < 0.0f )
+	{
+		Vector temp = triangle[1];
+		triangle[1] = triangle[2];
+		triangle[2] = temp;
+	}
+
+	pMesh->AddMeshTrinagle( triangle );
+}
+
+static void AddBoxFacets( CMeshDesc *pMesh, const Vector points[8] )
+{
+	Vector center = g_vecZero;
+	Vector triangle[3];
+	int i;
+
+	for( i = 0; i < 8; i++ )
+		center += points[i];
+	center *= ( 1.0f / 8.0f );
+
+	for( i = 0; i < 6; i++ )
+	{
+		const int *face = s_BoxFaces[i];
+		Vector normal = ( points[face[0]] + points[face[2]] ) * 0.5f - center;
+
+		triangle[0] = points[face[0]];
+		triangle[1] = points[face[1]];
+		triangle[2] = points[face[2]];
+		AddFacet( pMesh, triangle, normal );
+
+		triangle[0] = points[face[0]];
+		triangle[1] = points[face[2]];
+		triangle[2] = points[face[3]];
+		AddFacet( pMesh, triangle, normal );
+	}
+}
+
+static void AddBodyFacets( CMeshDesc *pMesh, const rigidbody_t *body )
+{
+	Vector points[MAX_HULL_POINTS];
+	Vector triangle[3];
+
+	BodyPoints( body, points );
+
+	if( body->shape != SHAPE_HULL )
+	{
+		AddBoxFacets( pMesh, points );
+		return;
+	}
+
+	for( int i = 0; i < body->hull->numFaces; i++ )
+	{
+		const int *face = body->hull->faces[i];
+
+		triangle[0] = points[face[0]];
+		triangle[1] = points[face[1]];
+		triangle[2] = points[face[2]];
+		AddFacet( pMesh, triangle, body->rot.VectorRotate( body->hull->normals[i] ));
+	}
+}
+
+static Vector SurfaceVertex( model_t *mod, int edge )
+{
+	int e = mod->surfedges[edge];
+	int index = (e > 0) ? mod->edges[e].v[0] : mod->edges[-e].v[1];
+
+	return mod->vertexes[index].position;
+}
+
+static Vector SurfaceNormal( msurface_t *surf )
+{
+	if( FBitSet( surf->flags, SURF_PLANEBACK ))
+		return -surf->plane->normal;
+	return surf->plane->normal;
+}
+
+static void SurfaceTriangle( model_t *mod, msurface_t *surf, int tri, Vector triangle[3] )
+{
+	triangle[0] = SurfaceVertex( mod, surf->firstedge );
+	triangle[1] = SurfaceVertex( mod, surf->firstedge + tri + 1 );
+	triangle[2] = SurfaceVertex( mod, surf->firstedge + tri + 2 );
+}
+
+static BOOL SurfaceHasCollision( msurface_t *surf )
+{
+	// don't create collision for water and sky
+	if( FBitSet( surf->flags, SURF_DRAWTURB|SURF_DRAWSKY ))
+		return FALSE;
+	return ( surf->numedges >= 3 ) ? TRUE : FALSE;
+}
+
+static _inline BOOL IsSimulated( const rigidbody_t *body )
+{
+	return ( body->type == ACTOR_DYNAMIC && !FBitSet( body->flags, RB_KINEMATIC )) ? TRUE : FALSE;
+}
+
+static Vector InvInertiaMul( const rigidbody_t *body, const Vector &v )
+{
+	Vector local = body->rot.VectorIRotate( v );
+
+	local.x *= body->invInertia.x;
+	local.y *= body->invInertia.y;
+	local.z *= body->invInertia.z;
+
+	return body->rot.VectorRotate( local );
+}
+
+static void ApplyImpulse( rigidbody_t *body, const Vector &impulse, const Vector &r )
+{
+	body->velocity += impulse * body->invMass;
+	body->avelocity += InvInertiaMul( body, CrossProduct( r, impulse ));
+}
+
+/*
+===============
+
+CONVEX HULLS
+
+===============
+*/
+static bool HullFacePlane( rbhull_t *hull, int face )
+{
+	const int *f = hull->faces[face];
+	Vector normal = CrossProduct( hull->points[f[1]] - hull->points[f[0]], hull->points[f[2]] - hull->points[f[0]] );
+	float length = normal.Length();
+
+	if( length < 0.001f )
+		return false; // degenerate
+
+	hull->normals[face] = normal * ( 1.0f / length );
+	hull->dists[face] = DotProduct( hull->normals[face], hull->points[f[0]] );
+
+	return true;
+}
+
+static void HullAddFace( rbhull_t *hull, int a, int b, int c )
+{
+	int *f = hull->faces[hull->numFaces++];
+
+	f[0] = a;
+	f[1] = b;
+	f[2] = c;
+}
+
+static int HullFarthestPoint( const Vector *in, int numIn, const Vector &from )
+{
+	float bestDist = -1.0f;
+	int best = 0;
+
+	for( int i = 0; i < numIn; i++ )
+	{
+		float dist = ( in[i] - from ).LengthSqr();
+
+		if( dist > bestDist )
+		{
+			bestDist = dist;
+			best = i;
+		}
+	}
+
+	return best;
+}
+
+//
+// tetrahedron from the extreme points
+//
+static bool HullInitialSimplex( const Vector *in, int numIn, rbhull_t *hull )
+{
+	int i, i0, i1, i2 = -1, i3 = -1;
+	float bestDist;
+
+	i1 = HullFarthestPoint( in, numIn, in[0] );
+	i0 = HullFarthestPoint( in, numIn, in[i1] );
+
+	Vector dir = in[i1] - in[i0];
+	if( dir.Length() < PHYS_HULL_EPSILON )
+		return false;
+	dir = dir.Normalize();
+
+	for( i = 0, bestDist = PHYS_HULL_EPSILON; i < numIn; i++ )
+	{
+		float dist = CrossProduct( in[i] - in[i0], dir ).Length();
+
+		if( dist > bestDist )
+		{
+			bestDist = dist;
+			i2 = i;
+		}
+	}
+
+	if( i2 == -1 ) return false; // all points on the line
+
+	Vector normal = CrossProduct( in[i1] - in[i0], in[i2] - in[i0] ).Normalize();
+
+	for( i = 0, bestDist = PHYS_HULL_EPSILON; i < numIn; i++ )
+	{
+		float dist = fabs( DotProduct( in[i] - in[i0], normal ));
+
+		if( dist > bestDist )
+		{
+			bestDist = dist;
+			i3 = i;
+		}
+	}
+
+	if( i3 == -1 ) return false; // flat model
+
+	hull->points[0] = in[i0];
+	hull->points[1] = in[i1];
+	hull->points[2] = in[i2];
+	hull->points[3] = in[i3];
+	hull->numPoints = 4;
+
+	// put the fourth point behind the first face
+	if( DotProduct( in[i3] - in[i0], normal ) > 0.0f )
+	{
+		HullAddFace( hull, 0, 2, 1 );
+		HullAddFace( hull, 0, 1, 3 );
+		HullAddFace( hull, 1, 2, 3 );
+		HullAddFace( hull, 2, 0, 3 );
+	}
+	else
+	{
+		HullAddFace( hull, 0, 1, 2 );
+		HullAddFace( hull, 0, 3, 1 );
+		HullAddFace( hull, 1, 3, 2 );
+		HullAddFace( hull, 2, 3, 0 );
+	}
+
+	for( i = 0; i < hull->numFaces; i++ )
+	{
+		if( !HullFacePlane( hull, i ))
+			return false;
+	}
+
+	return true;
+}
+
+//
+// replace the faces what can see the point with the fan around the horizon
+//
+static bool HullAddPoint( rbhull_t *hull, const Vector &point )
+{
+	bool visible[MAX_HULL_FACES];
+	int horizon[MAX_HULL_FACES * 3][2];
+	int i, j, k, numHorizon = 0;
+	int numVisible = 0;
+	rbhull_t newhull;
+
+	for( i = 0; i < hull->numFaces; i++ )
+	{
+		visible[i] = ( DotProduct( point, hull->normals[i] ) - hull->dists[i] > 0.01f );
+		if( visible[i] ) numVisible++;
+	}
+
+	// edge is on the horizon when the face on the other side is hidden
+	for( i = 0; i < hull->numFaces; i++ )
+	{
+		if( !visible[i] ) continue;
+
+		for( k = 0; k < 3; k++ )
+		{
+			int a = hull->faces[i][k];
+			int b = hull->faces[i][(k+1)%3];
+
+			for( j = 0; j < hull->numFaces; j++ )
+			{
+				const int *f = hull->faces[j];
+
+				if(( f[0] == b && f[1] == a ) || ( f[1] == b && f[2] == a ) || ( f[2] == b && f[0] == a ))
+					break;
+			}
+
+			if( j == hull->numFaces )
+				return false; // hull is broken
+
+			if( !visible[j] )
+			{
+				horizon[numHorizon][0] = a;
+				horizon[numHorizon][1] = b;
+				numHorizon++;
+			}
+		}
+	}
+
+	if( numHorizon < 3 || hull->numFaces - numVisible + numHorizon > MAX_HULL_FACES )
+		return false;
+
+	newhull = *hull;
+	newhull.numFaces = 0;
+	newhull.points[newhull.numPoints] = point;
+
+	for( i = 0; i < hull->numFaces; i++ )
+	{
+		if( visible[i] ) continue;
+
+		newhull.faces[newhull.numFaces][0] = hull->faces[i][0];
+		newhull.faces[newhull.numFaces][1] = hull->faces[i][1];
+		newhull.faces[newhull.numFaces][2] = hull->faces[i][2];
+		newhull.normals[newhull.numFaces] = hull->normals[i];
+		newhull.dists[newhull.numFaces] = hull->dists[i];
+		newhull.numFaces++;
+	}
+
+	for( i = 0; i < numHorizon; i++ )
+	{
+		HullAddFace( &newhull, horizon[i][0], horizon[i][1], newhull.numPoints );
+
+		if( !HullFacePlane( &newhull, newhull.numFaces - 1 ))
+			return false;
+	}
+
+	newhull.numPoints++;
+	*hull = newhull;
+
+	return true;
+}
+
+/*
+=================
+BuildHull
+
+incremental convex hull. The farthest point is added first so the hull
+stays close to the model when MAX_HULL_POINTS is reached
+=================
+*/
+static bool BuildHull( const Vector *in, int numIn, rbhull_t *hull )
+{
+	int i, j;
+
+	if( numIn < 4 || !HullInitialSimplex( in, numIn, hull ))
+		return false;
+
+	while( hull->numPoints < MAX_HULL_POINTS )
+	{
+		float bestDist = PHYS_HULL_EPSILON;
+		int best = -1;
+
+		for( i = 0; i < numIn; i++ )
+		{
+			for( j = 0; j < hull->numFaces; j++ )
+			{
+				float dist = DotProduct( in[i], hull->normals[j] ) - hull->dists[j];
+
+				if( dist > bestDist )
+				{
+					bestDist = dist;
+					best = i;
+				}
+			}
+		}
+
+		if( best == -1 || !HullAddPoint( hull, in[best] ))
+			break;
+	}
+
+	ClearBounds( hull->mins, hull->maxs );
+	for( i = 0; i < hull->numPoints; i++ )
+		AddPointToBounds( hull->points[i], hull->mins, hull->maxs );
+
+	hull->volume = 0.0f;
+	for( i = 0; i < hull->numFaces; i++ )
+	{
+		const int *f = hull->faces[i];
+		hull->volume += DotProduct( hull->points[f[0]], CrossProduct( hull->points[f[1]], hull->points[f[2]] )) / 6.0f;
+	}
+
+	return ( hull->volume > 0.0f );
+}
+
+static Vector *HullPointsFromBmodel( model_t *bmodel, int &numPoints )
+{
+	msurface_t *psurf = &bmodel->surfaces[bmodel->firstmodelsurface];
+	int i, j;
+
+	numPoints = 0;
+
+	for( i = 0; i < bmodel->nummodelsurfaces; i++ )
+	{
+		if( SurfaceHasCollision( &psurf[i] ))
+			numPoints += psurf[i].numedges;
+	}
+
+	if( !numPoints ) return NULL;
+
+	Vector *points = new Vector[numPoints];
+	numPoints = 0;
+
+	for( i = 0; i < bmodel->nummodelsurfaces; i++ )
+	{
+		if( !SurfaceHasCollision( &psurf[i] ))
+			continue;
+
+		for( j = 0; j < psurf[i].numedges; j++ )
+			points[numPoints++] = SurfaceVertex( bmodel, psurf[i].firstedge + j );
+	}
+
+	return points;
+}
+
+static void StudioBonePose( mstudiobone_t *pbone, mstudioanim_t *panim, Vector &pos, Vector4D &q )
+{
+	mstudioanimvalue_t *panimvalue;
+	Radian angle;
+
+	for( int j = 0; j < 3; j++ )
+	{
+		pos[j] = pbone->value[j];
+		angle[j] = pbone->value[j+3];
+
+		if( panim->offset[j] != 0 )
+		{
+			panimvalue = (mstudioanimvalue_t *)((byte *)panim + panim->offset[j]);
+			pos[j] += panimvalue[1].value * pbone->scale[j];
+		}
+
+		if( panim->offset[j+3] != 0 )
+		{
+			panimvalue = (mstudioanimvalue_t *)((byte *)panim + panim->offset[j+3]);
+			angle[j] += panimvalue[1].value * pbone->scale[j+3];
+		}
+	}
+
+	AngleQuaternion( angle, q );
+}
+
+//
+// vertices of the first submodel in the first frame of default sequence
+//
+static Vector *HullPointsFromStudio( studiohdr_t *phdr, int &numPoints )
+{
+	numPoints = 0;
+
+	if( phdr->numbones < 1 || phdr->numbones > MAXSTUDIOBONES || phdr->numseq < 1 || phdr->numbodyparts < 1 )
+		return NULL;
+
+	mstudioseqdesc_t *pseqdesc = (mstudioseqdesc_t *)((byte *)phdr + phdr->seqindex);
+	mstudioseqgroup_t *pseqgroup = (mstudioseqgroup_t *)((byte *)phdr + phdr->seqgroupindex) + pseqdesc->seqgroup;
+
+	if( pseqdesc->seqgroup != 0 )
+		return NULL; // animation is not loaded
+
+	mstudioanim_t *panim = (mstudioanim_t *)((byte *)phdr + pseqgroup->data + pseqdesc->animindex);
+	mstudiobone_t *pbone = (mstudiobone_t *)((byte *)phdr + phdr->boneindex);
+	matrix3x4	bonetransform[MAXSTUDIOBONES];
+	Vector4D	q;
+	Vector	pos;
+
+	for( int i = 0; i < phdr->numbones; i++ )
+	{
+		StudioBonePose( &pbone[i], &panim[i], pos, q );
+		matrix3x4	bonematrix( pos, q );
+
+		if( pbone[i].parent == -1 )
+			bonetransform[i] = bonematrix;
+		else bonetransform[i] = bonetransform[pbone[i].parent].ConcatTransforms( bonematrix );
+	}
+
+	mstudiobodyparts_t *pbodypart = (mstudiobodyparts_t *)((byte *)phdr + phdr->bodypartindex);
+	mstudiomodel_t *psubmodel = (mstudiomodel_t *)((byte *)phdr + pbodypart->modelindex);
+	Vector *pstudioverts = (Vector *)((byte *)phdr + psubmodel->vertindex);
+	byte *pvertbone = ((byte *)phdr + psubmodel->vertinfoindex);
+
+	if( psubmodel->numverts <= 0 )
+		return NULL;
+
+	Vector *points = new Vector[psubmodel->numverts];
+
+	for( int i = 0; i < psubmodel->numverts; i++ )
+		points[i] = bonetransform[pvertbone[i]].VectorTransform( pstudioverts[i] );
+	numPoints = psubmodel->numverts;
+
+	return points;
+}
+
+/*
+===============
+
+BODIES
+
+===============
+*/
+void CPhysicNative :: InitPhysic( void )
+{
+	if( m_pBodies )
+	{
+		ALERT( at_error, "InitPhysic: physics already initalized\n" );
+		return;
+	}
+
+	if( g_allow_physx != NULL && g_allow_physx->value == 0.0f )
+	{
+		ALERT( at_console, "InitPhysic: physics support is disabled by user.\n" );
+		GameInitNullPhysics ();
+		return;
+	}
+
+	m_pBodies = (rigidbody_t *)calloc( MAX_RIGID_BODIES, sizeof( rigidbody_t ));
+	m_iMaxBodies = 0;
+	m_vecGravity = Vector( 0.0f, 0.0f, -800.0f );
+
+	s_Workers.Init( PhysicThreadsCount( ));
+}
+
+void CPhysicNative :: FreePhysic( void )
+{
+	if( !m_pBodies ) return;
+
+	FreeAllBodies();
+	s_Workers.Shutdown();
+
+	free( m_pBodies );
+	m_pBodies = NULL;
+}
+
+rigidbody_t *CPhysicNative :: AllocBody( CBaseEntity *pEntity, int type )
+{
+	if( !m_pBodies ) return NULL;
+
+	for( int i = 0; i < MAX_RIGID_BODIES; i++ )
+	{
+		rigidbody_t *body = &m_pBodies[i];
+
+		if( FBitSet( body->flags, RB_INUSE ))
+			continue;
+
+		*body = s_emptyBody;
+		body->flags = RB_INUSE;
+		body->type = type;
+		body->edict = pEntity->edict();
+		body->quat = Vector4D( 0.0f, 0.0f, 0.0f, 1.0f );
+		body->rot = matrix3x3( body->quat );
+		m_iMaxBodies = Q_max( m_iMaxBodies, i + 1 );
+
+		pEntity->m_iActorType = type;
+		pEntity->m_pUserData = body;
+
+		return body;
+	}
+
+	ALERT( at_error, "AllocBody: MAX_RIGID_BODIES limit exceeded\n" );
+	return NULL;
+}
+
+void CPhysicNative :: FreeBody( rigidbody_t *body )
+{
+	delete body->mesh;
+	*body = s_emptyBody;
+
+	while( m_iMaxBodies > 0 && !FBitSet( m_pBodies[m_iMaxBodies - 1].flags, RB_INUSE ))
+		m_iMaxBodies--;
+}
+
+rigidbody_t *CPhysicNative :: BodyFromEntity( CBaseEntity *pEntity )
+{
+	if( !m_pBodies || FNullEnt( pEntity ) || !pEntity->m_pUserData )
+		return NULL;
+
+	rigidbody_t *body = (rigidbody_t *)pEntity->m_pUserData;
+
+	// entity may keep the pointer after the bodies was purged
+	if( body < m_pBodies || body >= m_pBodies + MAX_RIGID_BODIES )
+		return NULL;
+
+	if( !FBitSet( body->flags, RB_INUSE ) || body->edict != pEntity->edict( ))
+		return NULL;
+
+	return body;
+}
+
+void CPhysicNative :: GetModelBounds( CBaseEntity *pEntity, Vector &mins, Vector &maxs )
+{
+	modtype_t type = UTIL_GetModelType( pEntity->pev->modelindex );
+
+	if( type == mod_brush )
+	{
+		model_t *mod = (model_t *)MODEL_HANDLE( pEntity->pev->modelindex );
+
+		if( mod != NULL )
+		{
+			// bounds at angles '0 0 0'
+			mins = mod->mins;
+			maxs = mod->maxs;
+			return;
+		}
+	}
+	else if( type == mod_studio )
+	{
+		studiohdr_t *pstudiohdr = (studiohdr_t *)GET_MODEL_PTR( pEntity->edict() );
+
+		if( pstudiohdr != NULL && pEntity->pev->sequence >= 0 && pEntity->pev->sequence < pstudiohdr->numseq )
+		{
+			mstudioseqdesc_t *pseqdesc = (mstudioseqdesc_t *)((byte *)pstudiohdr + pstudiohdr->seqindex);
+			mins = pseqdesc[pEntity->pev->sequence].bbmin;
+			maxs = pseqdesc[pEntity->pev->sequence].bbmax;
+			return;
+		}
+	}
+
+	mins = pEntity->pev->mins;
+	maxs = pEntity->pev->maxs;
+}
+
+CMeshDesc *CPhysicNative :: MeshFromBmodel( CBaseEntity *pEntity )
+{
+	int modelindex = pEntity->pev->modelindex;
+
+	if( modelindex == 1 )
+	{
+		ALERT( at_error, "MeshFromBmodel: can't create triangle mesh from worldmodel\n" );
+		return NULL; // don't create rigidbody from world
+	}
+
+	model_t *bmodel = (model_t *)MODEL_HANDLE( modelindex );
+
+	if( !bmodel )
+	{
+		ALERT( at_error, "MeshFromBmodel: unable to fetch model pointer %i\n", modelindex );
+		return NULL;
+	}
+
+	// don't build meshes for water
+	if( bmodel->nummodelsurfaces <= 0 || FBitSet( bmodel->flags, MODEL_LIQUID ))
+		return NULL;
+
+	msurface_t *psurf = &bmodel->surfaces[bmodel->firstmodelsurface];
+	int i, j, numTris = 0;
+
+	for( i = 0; i < bmodel->nummodelsurfaces; i++ )
+	{
+		if( SurfaceHasCollision( &psurf[i] ))
+			numTris += psurf[i].numedges - 2;
+	}
+
+	CMeshDesc *pMesh = new CMeshDesc;
+
+	if( !pMesh->InitMeshBuild( bmodel->name, numTris ))
+	{
+		delete pMesh;
+		return NULL;
+	}
+
+	for( i = 0; i < bmodel->nummodelsurfaces; i++ )
+	{
+		if( !SurfaceHasCollision( &psurf[i] ))
+			continue;
+
+		Vector normal = SurfaceNormal( &psurf[i] );
+		Vector triangle[3];
+
+		for( j = 0; j < psurf[i].numedges - 2; j++ )
+		{
+			SurfaceTriangle( bmodel, &psurf[i], j, triangle );
+			AddFacet( pMesh, triangle, normal );
+		}
+	}
+
+	if( !pMesh->FinishMeshBuild( ))
+	{
+		delete pMesh;
+		return NULL;
+	}
+
+	return pMesh;
+}
+
+CMeshDesc *CPhysicNative :: MeshFromBounds( const Vector &mins, const Vector &maxs )
+{
+	CMeshDesc *pMesh = new CMeshDesc;
+	Vector points[8];
+
+	BoxPoints( mins, maxs, points );
+
+	// each box contain 12 triangles
+	pMesh->InitMeshBuild( "box", 12 );
+	AddBoxFacets( pMesh, points );
+
+	if( !pMesh->FinishMeshBuild( ))
+	{
+		delete pMesh;
+		return NULL;
+	}
+
+	return pMesh;
+}
+
+void CPhysicNative :: SetupBox( rigidbody_t *body, const Vector &mins, const Vector &maxs )
+{
+	body->shape = SHAPE_BOX;
+	body->center = ( mins + maxs ) * 0.5f;
+	body->extents = ( maxs - mins ) * 0.5f;
+
+	for( int i = 0; i < 3; i++ )
+		body->extents[i] = Q_max( body->extents[i], 1.0f );
+
+	Vector size = body->extents * 2.0f;
+
+	body->mass = Q_max( size.x * size.y * size.z * DENSITY_FACTOR, 1.0f );
+	body->invMass = 1.0f / body->mass;
+
+	float k = body->mass / 12.0f;
+	body->invInertia.x = 1.0f / ( k * ( size.y * size.y + size.z * size.z ));
+	body->invInertia.y = 1.0f / ( k * ( size.x * size.x + size.z * size.z ));
+	body->invInertia.z = 1.0f / ( k * ( size.x * size.x + size.y * size.y ));
+}
+
+/*
+=================
+HullForEntity
+
+convex hull of the model, built from the same geometry as collision meshes.
+Returns NULL if the model is flat or can't be used, the body will be a box
+=================
+*/
+const rbhull_t *CPhysicNative :: HullForEntity( CBaseEntity *pEntity )
+{
+	int modelindex = pEntity->pev->modelindex;
+	Vector *points = NULL;
+	int i, numPoints = 0;
+
+	for( i = 0; i < m_iNumHulls; i++ )
+	{
+		if( m_pHulls[i]->modelindex == modelindex )
+			return m_pHulls[i];
+	}
+
+	if( m_iNumHulls >= MAX_BODY_HULLS || modelindex <= 1 )
+		return NULL;
+
+	modtype_t type = UTIL_GetModelType( modelindex );
+
+	if( type == mod_brush )
+	{
+		model_t *bmodel = (model_t *)MODEL_HANDLE( modelindex );
+
+		if( bmodel != NULL && !FBitSet( bmodel->flags, MODEL_LIQUID ))
+			points = HullPointsFromBmodel( bmodel, numPoints );
+	}
+	else if( type == mod_studio )
+	{
+		studiohdr_t *phdr = (studiohdr_t *)GET_MODEL_PTR( pEntity->edict() );
+
+		if( phdr != NULL )
+			points = HullPointsFromStudio( phdr, numPoints );
+	}
+
+	if( !points ) return NULL;
+
+	rbhull_t *hull = (rbhull_t *)calloc( 1, sizeof( rbhull_t ));
+	bool result = BuildHull( points, numPoints, hull );
+	delete [] points;
+
+	if( !result )
+	{
+		ALERT( at_aiconsole, "HullForEntity: can't build convex hull for %s, using box\n", pEntity->GetModel( ));
+		free( hull );
+		return NULL;
+	}
+
+	hull->modelindex = modelindex;
+	m_pHulls[m_iNumHulls++] = hull;
+
+	return hull;
+}
+
+void CPhysicNative :: SetupHull( rigidbody_t *body, const rbhull_t *hull )
+{
+	SetupBox( body, hull->mins, hull->maxs );
+	body->shape = SHAPE_HULL;
+	body->hull = hull;
+
+	// mass from the real volume, inertia of the bounds is close enough
+	float scale = Q_max( hull->volume * DENSITY_FACTOR, 1.0f ) / body->mass;
+
+	body->mass *= scale;
+	body->invMass = 1.0f / body->mass;
+	body->invInertia *= ( 1.0f / scale );
+}
+
+void CPhysicNative :: FreeHulls( void )
+{
+	for( int i = 0; i < m_iNumHulls; i++ )
+		free( m_pHulls[i] );
+	m_iNumHulls = 0;
+}
+
+void CPhysicNative :: SetBodyPose( rigidbody_t *body, const Vector &origin, const Vector &angles )
+{
+	matrix3x3	m( angles );
+
+	body->quat = m.GetQuaternion();
+	body->rot = m;
+	body->position = origin + body->rot.VectorRotate( body->center );
+}
+
+Vector CPhysicNative :: BodyOrigin( const rigidbody_t *body )
+{
+	return body->position - body->rot.VectorRotate( body->center );
+}
+
+void CPhysicNative :: WakeBody( rigidbody_t *body )
+{
+	ClearBits( body->flags, RB_SLEEPING );
+	body->sleepTime = 0.0f;
+}
+
+void *CPhysicNative :: CreateBodyFromEntity( CBaseEntity *pObject )
+{
+	const rbhull_t *hull = HullForEntity( pObject );
+	rigidbody_t *body = AllocBody( pObject, ACTOR_DYNAMIC );
+	if( !body ) return NULL;
+
+	if( hull != NULL )
+	{
+		SetupHull( body, hull );
+	}
+	else
+	{
+		Vector mins, maxs;
+		GetModelBounds( pObject, mins, maxs );
+		SetupBox( body, mins, maxs );
+	}
+
+	SetBodyPose( body, pObject->GetAbsOrigin(), pObject->GetAbsAngles( ));
+	body->velocity = pObject->GetLocalVelocity();
+	body->avelocity = pObject->GetLocalAvelocity();
+
+	return body;
+}
+
+/*
+=================
+CreateBoxFromEntity
+
+used for characters: clients and monsters
+=================
+*/
+void *CPhysicNative :: CreateBoxFromEntity( CBaseEntity *pObject )
+{
+	rigidbody_t *body = AllocBody( pObject, ACTOR_CHARACTER );
+	if( !body ) return NULL;
+
+	SetupBox( body, pObject->pev->mins, pObject->pev->maxs );
+	SetBodyPose( body, pObject->GetAbsOrigin(), g_vecZero );
+	SetBits( body->flags, RB_KINEMATIC );
+	body->invMass = 0.0f;
+	body->invInertia = g_vecZero;
+
+	return body;
+}
+
+void *CPhysicNative :: CreateMeshBody( CBaseEntity *pObject, int type )
+{
+	Vector mins, maxs;
+	CMeshDesc *pMesh;
+
+	GetModelBounds( pObject, mins, maxs );
+
+	if( UTIL_GetModelType( pObject->pev->modelindex ) == mod_brush )
+		pMesh = MeshFromBmodel( pObject );
+	else pMesh = MeshFromBounds( mins, maxs );
+
+	if( !pMesh ) return NULL;
+
+	rigidbody_t *body = AllocBody( pObject, type );
+
+	if( !body )
+	{
+		delete pMesh;
+		return NULL;
+	}
+
+	SetupBox( body, mins, maxs );
+	SetBodyPose( body, pObject->GetAbsOrigin(), pObject->GetAbsAngles( ));
+	SetBits( body->flags, RB_KINEMATIC );
+	body->shape = SHAPE_MESH;
+	body->mesh = pMesh;
+	body->invMass = 0.0f;
+	body->invInertia = g_vecZero;
+
+	return body;
+}
+
+void *CPhysicNative :: CreateKinematicBodyFromEntity( CBaseEntity *pObject )
+{
+	return CreateMeshBody( pObject, ACTOR_KINEMATIC );
+}
+
+void *CPhysicNative :: CreateStaticBodyFromEntity( CBaseEntity *pObject )
+{
+	return CreateMeshBody( pObject, ACTOR_STATIC );
+}
+
+void *CPhysicNative :: CreateVehicle( CBaseEntity *pObject, string_t scriptName )
+{
+	ALERT( at_error, "CreateVehicle: vehicles are not supported by built-in physics\n" );
+	return NULL;
+}
+
+void CPhysicNative :: RemoveBody( struct edict_s *pEdict )
+{
+	if( !m_pBodies || !pEdict || pEdict->free )
+		return;
+
+	CBaseEntity *pEntity = CBaseEntity::Instance( pEdict );
+	rigidbody_t *body = BodyFromEntity( pEntity );
+
+	if( body ) FreeBody( body );
+	if( pEntity ) pEntity->m_pUserData = NULL;
+}
+
+void CPhysicNative :: FreeAllBodies( void )
+{
+	if( !m_pBodies ) return;
+
+	// throw all bodies
+	for( int i = 0; i < m_iMaxBodies; i++ )
+		delete m_pBodies[i].mesh;
+
+	for( int i = 0; i < MAX_RIGID_BODIES; i++ )
+		m_pBodies[i] = s_emptyBody;
+	m_iMaxBodies = 0;
+	m_iNumActive = 0;
+
+	FreeHulls();
+	FreeWorld();
+}
+
+/*
+===============
+SaveBody
+
+body flags, mass and sleep state
+===============
+*/
+void CPhysicNative :: SaveBody( CBaseEntity *pEntity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+
+	if( !body )
+	{
+		ALERT( at_warning, "SaveBody: physic entity %i missed body!\n", pEntity->m_iActorType );
+		return;
+	}
+
+	pEntity->m_iActorFlags = ( body->flags & ( RB_KINEMATIC|RB_NOCOLLIDE ));
+	pEntity->m_iBodyFlags = 0;
+	pEntity->m_usActorGroup = 0;
+	pEntity->m_flBodyMass = body->mass;
+	pEntity->m_fFreezed = FBitSet( body->flags, RB_SLEEPING ) ? TRUE : FALSE;
+
+	if( pEntity->m_iActorType == ACTOR_DYNAMIC )
+	{
+		// update movement variables
+		UpdateEntityPos( pEntity );
+	}
+}
+
+/*
+===============
+RestoreBody
+
+re-create shape, apply physic params
+===============
+*/
+void *CPhysicNative :: RestoreBody( CBaseEntity *pEntity )
+{
+	// physics not initialized?
+	if( !m_pBodies ) return NULL;
+
+	rigidbody_t *body;
+
+	switch( pEntity->m_iActorType )
+	{
+	case ACTOR_DYNAMIC:
+		body = (rigidbody_t *)CreateBodyFromEntity( pEntity );
+		if( body ) body->velocity = pEntity->GetAbsVelocity();
+		if( body ) body->avelocity = pEntity->GetAbsAvelocity();
+		break;
+	case ACTOR_CHARACTER:
+		body = (rigidbody_t *)CreateBoxFromEntity( pEntity );
+		break;
+	case ACTOR_KINEMATIC:
+	case ACTOR_STATIC:
+		body = (rigidbody_t *)CreateMeshBody( pEntity, pEntity->m_iActorType );
+		break;
+	default:
+		ALERT( at_error, "RestoreBody: invalid actor type %i\n", pEntity->m_iActorType );
+		return NULL;
+	}
+
+	if( !body )
+	{
+		ALERT( at_error, "RestoreBody: unable to create body with type (%i)\n", pEntity->m_iActorType );
+		return NULL;
+	}
+
+	if( pEntity->m_iActorType == ACTOR_DYNAMIC )
+	{
+		SetBits( body->flags, pEntity->m_iActorFlags & ( RB_KINEMATIC|RB_NOCOLLIDE ));
+
+		if( pEntity->m_fFreezed )
+		{
+			SetBits( body->flags, RB_SLEEPING );
+			body->velocity = body->avelocity = g_vecZero;
+		}
+	}
+
+	return body;
+}
+
+bool CPhysicNative :: UpdateEntityPos( CBaseEntity *pEntity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+
+	if( !body || !IsSimulated( body ) || FBitSet( body->flags, RB_SLEEPING ))
+		return false;
+
+	matrix3x3	m = body->rot;
+	Vector angles = m.GetAngles();
+	Vector origin = BodyOrigin( body );
+
+	// store body velocities too
+	pEntity->SetLocalVelocity( body->velocity );
+	pEntity->SetLocalAvelocity( body->avelocity );
+	Vector vecPrevOrigin = pEntity->GetAbsOrigin();
+
+	pEntity->SetLocalAngles( angles );
+	pEntity->SetLocalOrigin( origin );
+	pEntity->RelinkEntity( TRUE, &vecPrevOrigin );
+
+	return true;
+}
+
+bool CPhysicNative :: UpdateActorPos( CBaseEntity *pEntity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return false;
+
+	Vector vecPrevPos = body->position;
+
+	SetBodyPose( body, pEntity->GetAbsOrigin(), pEntity->GetAbsAngles( ));
+
+	if( FBitSet( body->flags, RB_KINEMATIC ))
+	{
+		// held objects push the others with their own speed
+		if( gpGlobals->frametime > 0.0f )
+			body->velocity = ( body->position - vecPrevPos ) * ( 1.0f / gpGlobals->frametime );
+	}
+	else
+	{
+		body->velocity = pEntity->GetLocalVelocity();
+		body->avelocity = pEntity->GetLocalAvelocity();
+		WakeBody( body );
+	}
+
+	return true;
+}
+
+bool CPhysicNative :: IsBodySleeping( CBaseEntity *pEntity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return false;
+
+	return FBitSet( body->flags, RB_SLEEPING ) ? true : false;
+}
+
+void CPhysicNative :: UpdateEntityAABB( CBaseEntity *pEntity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	Vector points[MAX_HULL_POINTS];
+
+	if( !body ) return;
+
+	int numPoints = BodyPoints( body, points );
+	ClearBounds( pEntity->pev->absmin, pEntity->pev->absmax );
+
+	for( int i = 0; i < numPoints; i++ )
+		AddPointToBounds( points[i], pEntity->pev->absmin, pEntity->pev->absmax );
+
+	// shrink AABB by 1 units in each axis
+	// or pushers can't be moving them
+	pEntity->pev->absmin.x += 1;
+	pEntity->pev->absmin.y += 1;
+	pEntity->pev->absmin.z += 1;
+	pEntity->pev->absmax.x -= 1;
+	pEntity->pev->absmax.y -= 1;
+	pEntity->pev->absmax.z -= 1;
+
+	pEntity->pev->mins = pEntity->pev->absmin - pEntity->pev->origin;
+	pEntity->pev->maxs = pEntity->pev->absmax - pEntity->pev->origin;
+	pEntity->pev->size = pEntity->pev->maxs - pEntity->pev->mins;
+}
+
+void CPhysicNative :: SetAngles( CBaseEntity *pEntity, const Vector &angles )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	SetBodyPose( body, BodyOrigin( body ), angles );
+	WakeBody( body );
+}
+
+void CPhysicNative :: SetOrigin( CBaseEntity *pEntity, const Vector &origin )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	body->position = origin + body->rot.VectorRotate( body->center );
+	WakeBody( body );
+}
+
+void CPhysicNative :: SetVelocity( CBaseEntity *pEntity, const Vector &velocity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	body->velocity = velocity;
+	WakeBody( body );
+}
+
+void CPhysicNative :: SetAvelocity( CBaseEntity *pEntity, const Vector &velocity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	body->avelocity = velocity;
+	WakeBody( body );
+}
+
+void CPhysicNative :: MoveObject( CBaseEntity *pEntity, const Vector &finalPos )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	Vector vecPrevPos = body->position;
+	body->position = finalPos + body->rot.VectorRotate( body->center );
+
+	if( FBitSet( body->flags, RB_KINEMATIC ) && gpGlobals->frametime > 0.0f )
+		body->velocity = ( body->position - vecPrevPos ) * ( 1.0f / gpGlobals->frametime );
+	WakeBody( body );
+}
+
+void CPhysicNative :: RotateObject( CBaseEntity *pEntity, const Vector &finalAngle )
+{
+	SetAngles( pEntity, finalAngle );
+}
+
+void CPhysicNative :: SetLinearMomentum( CBaseEntity *pEntity, const Vector &velocity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body || !IsSimulated( body )) return;
+
+	body->velocity = velocity * body->invMass;
+	WakeBody( body );
+}
+
+void CPhysicNative :: AddImpulse( CBaseEntity *pEntity, const Vector &impulse, const Vector &position, float factor )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body || !IsSimulated( body )) return;
+
+	float coeff = ( 1000.0f / body->mass ) * factor;
+
+	// prevent to apply too much impulse
+	if( body->mass < 8.0f )
+	{
+		coeff *= 0.0001f;
+	}
+
+	ApplyImpulse( body, impulse * coeff, position - body->position );
+	WakeBody( body );
+}
+
+void CPhysicNative :: AddForce( CBaseEntity *pEntity, const Vector &force )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body || !IsSimulated( body )) return;
+
+	body->force += force;
+	WakeBody( body );
+}
+
+void CPhysicNative :: EnableCollision( CBaseEntity *pEntity, int fEnable )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	if( fEnable )
+		ClearBits( body->flags, RB_NOCOLLIDE );
+	else SetBits( body->flags, RB_NOCOLLIDE );
+	WakeBody( body );
+}
+
+void CPhysicNative :: MakeKinematic( CBaseEntity *pEntity, int fEnable )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body || body->type != ACTOR_DYNAMIC ) return;
+
+	if( fEnable )
+	{
+		SetBits( body->flags, RB_KINEMATIC );
+	}
+	else
+	{
+		ClearBits( body->flags, RB_KINEMATIC );
+		body->velocity = body->avelocity = g_vecZero;
+	}
+	WakeBody( body );
+}
+
+void CPhysicNative :: TeleportCharacter( CBaseEntity *pEntity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	SetupBox( body, pEntity->pev->mins, pEntity->pev->maxs );
+	SetBodyPose( body, pEntity->GetAbsOrigin(), g_vecZero );
+	body->velocity = g_vecZero;
+	body->invMass = 0.0f;
+	body->invInertia = g_vecZero;
+}
+
+void CPhysicNative :: TeleportActor( CBaseEntity *pEntity )
+{
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	SetBodyPose( body, pEntity->GetAbsOrigin(), pEntity->GetAbsAngles( ));
+	WakeBody( body );
+}
+
+void CPhysicNative :: MoveCharacter( CBaseEntity *pEntity )
+{
+	if( !pEntity || pEntity->m_vecOldPosition == pEntity->pev->origin )
+		return;
+
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	// if were in NOCLIP or FLY (ladder climbing) mode - disable collisions
+	if( pEntity->pev->movetype != MOVETYPE_WALK && pEntity->pev->movetype != MOVETYPE_STEP )
+		SetBits( body->flags, RB_NOCOLLIDE );
+	else ClearBits( body->flags, RB_NOCOLLIDE );
+
+	SetupBox( body, pEntity->pev->mins, pEntity->pev->maxs );
+	SetBodyPose( body, pEntity->GetAbsOrigin(), g_vecZero );
+	body->velocity = pEntity->GetAbsVelocity();
+	body->invMass = 0.0f;
+	body->invInertia = g_vecZero;
+
+	pEntity->m_vecOldPosition = pEntity->GetAbsOrigin(); // update old position
+}
+
+void CPhysicNative :: MoveKinematic( CBaseEntity *pEntity )
+{
+	if( !pEntity || ( pEntity->pev->movetype != MOVETYPE_PUSH && pEntity->pev->movetype != MOVETYPE_PUSHSTEP ))
+		return;	// probably not a mover
+
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body ) return;
+
+	if( pEntity->pev->solid == SOLID_NOT || pEntity->pev->solid == SOLID_TRIGGER )
+		SetBits( body->flags, RB_NOCOLLIDE );
+	else ClearBits( body->flags, RB_NOCOLLIDE );
+
+	SetBodyPose( body, pEntity->GetAbsOrigin(), pEntity->GetAbsAngles( ));
+	body->velocity = pEntity->GetAbsVelocity();
+}
+
+/*
+===============
+
+WORLD COLLISION
+
+===============
+*/
+void CPhysicNative :: FreeWorld( void )
+{
+	if( m_pWorldCells )
+	{
+		int numCells = m_iNumCells[0] * m_iNumCells[1] * m_iNumCells[2];
+
+		for( int i = 0; i < numCells; i++ )
+			delete m_pWorldCells[i];
+		delete [] m_pWorldCells;
+	}
+
+	m_pWorldCells = NULL;
+	m_iNumCells[0] = m_iNumCells[1] = m_iNumCells[2] = 0;
+	m_fWorldLoaded = FALSE;
+}
+
+/*
+=================
+BuildCollisionTree
+
+world is too big for one CMeshDesc, so it splitted into
+the cells and each triangle is linked into all the cells it touches
+=================
+*/
+int CPhysicNative :: BuildCollisionTree( char *szMapName )
+{
+	if( !m_pBodies )
+		return FALSE;
+
+	model_t *world = (model_t *)MODEL_HANDLE( 1 );
+
+	// get a world struct
+	if( !world )
+	{
+		ALERT( at_error, "BuildCollisionTree: unbale to fetch world pointer %s\n", szMapName );
+		return FALSE;
+	}
+
+	FreeWorld();
+
+	int i, j, x, y, z, numCells = 1;
+	int cellMins[3], cellMaxs[3];
+	msurface_t *psurf;
+	Vector triangle[3];
+
+	m_vecWorldMins = world->mins;
+
+	for( i = 0; i < 3; i++ )
+	{
+		m_iNumCells[i] = (int)ceil(( world->maxs[i] - world->mins[i] ) / PHYS_WORLD_CELL_SIZE );
+		m_iNumCells[i] = bound( 1, m_iNumCells[i], PHYS_MAX_WORLD_CELLS );
+		numCells *= m_iNumCells[i];
+	}
+
+	int *counts = new int[numCells];
+	memset( counts, 0, sizeof( int ) * numCells );
+
+	m_pWorldCells = new CMeshDesc*[numCells];
+	memset( m_pWorldCells, 0, sizeof( CMeshDesc* ) * numCells );
+
+	// two passes: count triangles in each cell, then fill the meshes
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		for( i = 0; i < world->nummodelsurfaces; i++ )
+		{
+			psurf = &world->surfaces[world->firstmodelsurface + i];
+
+			if( !SurfaceHasCollision( psurf ))
+				continue;
+
+			Vector normal = SurfaceNormal( psurf );
+
+			for( j = 0; j < psurf->numedges - 2; j++ )
+			{
+				Vector mins, maxs;
+
+				SurfaceTriangle( world, psurf, j, triangle );
+				ClearBounds( mins, maxs );
+				AddPointToBounds( triangle[0], mins, maxs );
+				AddPointToBounds( triangle[1], mins, maxs );
+				AddPointToBounds( triangle[2], mins, maxs );
+
+				for( int k = 0; k < 3; k++ )
+				{
+					cellMins[k] = (int)floor(( mins[k] - m_vecWorldMins[k] - 1.0f ) / PHYS_WORLD_CELL_SIZE );
+					cellMaxs[k] = (int)floor(( maxs[k] - m_vecWorldMins[k] + 1.0f ) / PHYS_WORLD_CELL_SIZE );
+					cellMins[k] = bound( 0, cellMins[k], m_iNumCells[k] - 1 );
+					cellMaxs[k] = bound( 0, cellMaxs[k], m_iNumCells[k] - 1 );
+				}
+
+				for( z = cellMins[2]; z <= cellMaxs[2]; z++ )
+				{
+					for( y = cellMins[1]; y <= cellMaxs[1]; y++ )
+					{
+						for( x = cellMins[0]; x <= cellMaxs[0]; x++ )
+						{
+							int cell = x + ( y + z * m_iNumCells[1] ) * m_iNumCells[0];
+
+							if( pass == 0 )
+							{
+								counts[cell]++;
+								continue;
+							}
+
+							if( m_pWorldCells[cell] != NULL )
+							{
+								Vector facet[3] = { triangle[0], triangle[1], triangle[2] };
+								AddFacet( m_pWorldCells[cell], facet, normal );
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if( pass != 0 ) continue;
+
+		for( i = 0; i < numCells; i++ )
+		{
+			if( !counts[i] ) continue;
+
+			m_pWorldCells[i] = new CMeshDesc;
+
+			if( !m_pWorldCells[i]->InitMeshBuild( "world", counts[i] ))
+			{
+				delete m_pWorldCells[i];
+				m_pWorldCells[i] = NULL;
+			}
+		}
+	}
+
+	for( i = 0; i < numCells; i++ )
+	{
+		if( m_pWorldCells[i] && !m_pWorldCells[i]->FinishMeshBuild( ))
+		{
+			delete m_pWorldCells[i];
+			m_pWorldCells[i] = NULL;
+		}
+	}
+
+	delete [] counts;
+	m_fWorldLoaded = TRUE;
+
+	return TRUE;
+}
+
+void CPhysicNative :: SetupWorld( void )
+{
+	if( m_fWorldLoaded || !m_pBodies )
+		return;	// already loaded
+
+	BuildCollisionTree( (char *)STRING( gpGlobals->mapname ));
+}
+
+/*
+=================
+TraceWorld
+
+line trace through the world cells. Thread safe
+=================
+*/
+bool CPhysicNative :: TraceWorld( const Vector &start, const Vector &end, trace_t *tr )
+{
+	int cellMins[3], cellMaxs[3];
+	trace_t trace;
+
+	*tr = s_emptyTrace;
+	tr->fraction = 1.0f;
+	tr->endpos = end;
+
+	if( !m_pWorldCells )
+		return false;
+
+	for( int k = 0; k < 3; k++ )
+	{
+		float mins = Q_min( start[k], end[k] ) - m_vecWorldMins[k];
+		float maxs = Q_max( start[k], end[k] ) - m_vecWorldMins[k];
+
+		cellMins[k] = bound( 0, (int)floor( mins / PHYS_WORLD_CELL_SIZE ), m_iNumCells[k] - 1 );
+		cellMaxs[k] = bound( 0, (int)floor( maxs / PHYS_WORLD_CELL_SIZE ), m_iNumCells[k] - 1 );
+	}
+
+	for( int z = cellMins[2]; z <= cellMaxs[2]; z++ )
+	{
+		for( int y = cellMins[1]; y <= cellMaxs[1]; y++ )
+		{
+			for( int x = cellMins[0]; x <= cellMaxs[0]; x++ )
+			{
+				CMeshDesc *pCell = m_pWorldCells[x + ( y + z * m_iNumCells[1] ) * m_iNumCells[0]];
+				TraceMesh	trm;
+
+				if( !pCell ) continue;
+
+				trm.SetTraceMesh( pCell->GetMesh(), pCell->GetHeadNode( ));
+				trm.SetupTrace( start, g_vecZero, g_vecZero, end, &trace );
+
+				if( trm.DoTrace() && trace.fraction < tr->fraction )
+					*tr = trace;
+			}
+		}
+	}
+
+	return ( tr->fraction < 1.0f );
+}
+
+/*
+=================
+TraceBody
+
+line trace against body mesh, in and out are in world space. Thread safe
+=================
+*/
+bool CPhysicNative :: TraceBody( rigidbody_t *other, const Vector &start, const Vector &end, trace_t *tr )
+{
+	if( !other )
+		return TraceWorld( start, end, tr );
+
+	Vector origin = BodyOrigin( other );
+	Vector localStart = other->rot.VectorIRotate( start - origin );
+	Vector localEnd = other->rot.VectorIRotate( end - origin );
+	TraceMesh	trm;
+
+	trm.SetTraceMesh( other->mesh->GetMesh(), other->mesh->GetHeadNode( ));
+	trm.SetupTrace( localStart, g_vecZero, g_vecZero, localEnd, tr );
+
+	if( !trm.DoTrace( ))
+		return false;
+
+	Vector normal = other->rot.VectorRotate( tr->plane.normal );
+	tr->plane.dist += DotProduct( normal, origin );
+	tr->plane.normal = normal;
+	VectorLerp( start, tr->fraction, end, tr->endpos );
+
+	return true;
+}
+
+/*
+===============
+
+COLLISION DETECTION
+
+===============
+*/
+void CPhysicNative :: ComputeBounds( rigidbody_t *body )
+{
+	Vector	points[MAX_HULL_POINTS];
+	int	numPoints;
+
+	numPoints = BodyPoints( body, points );
+	ClearBounds( body->absmin, body->absmax );
+
+	for( int i = 0; i < numPoints; i++ )
+		AddPointToBounds( points[i], body->absmin, body->absmax );
+
+	// moving bodies may collide at the end of step
+	Vector move = body->velocity * m_flStepTime;
+
+	for( int j = 0; j < 3; j++ )
+	{
+		if( move[j] < 0.0f ) body->absmin[j] += move[j];
+		else body->absmax[j] += move[j];
+
+		body->absmin[j] -= PHYS_CONTACT_MARGIN;
+		body->absmax[j] += PHYS_CONTACT_MARGIN;
+	}
+}
+
+static int SortBodiesByX( const void *a, const void *b )
+{
+	const rigidbody_t *body1 = *(const rigidbody_t **)a;
+	const rigidbody_t *body2 = *(const rigidbody_t **)b;
+
+	if( body1->absmin.x < body2->absmin.x )
+		return -1;
+	if( body1->absmin.x > body2->absmin.x )
+		return 1;
+	return 0;
+}
+
+void CPhysicNative :: AddPair( rigidbody_t *body, rigidbody_t *other )
+{
+	BOOL simulated1 = IsSimulated( body );
+	BOOL simulated2 = IsSimulated( other );
+
+	if( !simulated1 && !simulated2 )
+		return;	// nothing to simulate
+
+	// contacts are owned by the awake dynamic body
+	if( !simulated1 || FBitSet( body->flags, RB_SLEEPING ))
+	{
+		rigidbody_t *temp = body;
+		body = other;
+		other = temp;
+		simulated2 = simulated1;
+	}
+
+	if( FBitSet( body->flags, RB_SLEEPING ))
+	{
+		// sleeping body was touched by mover or character
+		if( simulated2 || other->velocity == g_vecZero )
+			return;
+		WakeBody( body );
+	}
+
+	if( body->numPairs < MAX_BODY_PAIRS )
+		body->pairs[body->numPairs++] = other;
+}
+
+/*
+=================
+Broadphase
+
+sort and sweep along X axis
+=================
+*/
+void CPhysicNative :: Broadphase( void )
+{
+	int	i, j;
+
+	m_iNumSorted = 0;
+
+	for( i = 0; i < m_iMaxBodies; i++ )
+	{
+		rigidbody_t *body = &m_pBodies[i];
+
+		if( !FBitSet( body->flags, RB_INUSE ))
+			continue;
+
+		body->numPairs = 0;
+
+		if( FBitSet( body->flags, RB_NOCOLLIDE ))
+			continue;
+
+		ComputeBounds( body );
+		m_pSorted[m_iNumSorted++] = body;
+	}
+
+	qsort( m_pSorted, m_iNumSorted, sizeof( rigidbody_t* ), SortBodiesByX );
+
+	for( i = 0; i < m_iNumSorted; i++ )
+	{
+		rigidbody_t *body = m_pSorted[i];
+
+		for( j = i + 1; j < m_iNumSorted; j++ )
+		{
+			rigidbody_t *other = m_pSorted[j];
+
+			if( other->absmin.x > body->absmax.x )
+				break;
+
+			if( other->absmin.y > body->absmax.y || other->absmax.y < body->absmin.y )
+				continue;
+
+			if( other->absmin.z > body->absmax.z || other->absmax.z < body->absmin.z )
+				continue;
+
+			AddPair( body, other );
+		}
+	}
+}
+
+void CPhysicNative :: AddContact( rigidbody_t *body, rigidbody_t *other, const Vector &point, const Vector &normal, float depth )
+{
+	rbcontact_t *contact;
+
+	if( body->numContacts < MAX_BODY_CONTACTS )
+	{
+		contact = &body->contacts[body->numContacts++];
+	}
+	else
+	{
+		// replace the shallowest one
+		contact = &body->contacts[0];
+
+		for( int i = 1; i < MAX_BODY_CONTACTS; i++ )
+		{
+			if( body->contacts[i].depth < contact->depth )
+				contact = &body->contacts[i];
+		}
+
+		if( contact->depth >= depth )
+			return;
+	}
+
+	contact->pOther = other;
+	contact->pDynamicOther = ( other && IsSimulated( other )) ? other : NULL;
+	contact->point = point;
+	contact->normal = normal;
+	contact->depth = depth;
+	contact->surfaceVelocity = g_vecZero;
+
+	if( other && !contact->pDynamicOther )
+	{
+		contact->surfaceVelocity = other->velocity;
+
+		// conveyors are moving their surface only
+		if( FBitSet( other->edict->v.flags, FL_CONVEYOR ))
+			contact->surfaceVelocity += other->edict->v.movedir * other->edict->v.speed;
+	}
+}
+
+/*
+=================
+CollidePoints
+
+box corners or hull vertices against world or mesh. Each point is traced from
+the body center to find penetration and along the corner
+movement to find the contact before it happens
+=================
+*/
+void CPhysicNative :: CollidePoints( rigidbody_t *body, rigidbody_t *other )
+{
+	Vector	points[MAX_HULL_POINTS];
+	trace_t	tr;
+	int	numPoints;
+
+	numPoints = BodyPoints( body, points );
+
+	for( int i = 0; i < numPoints; i++ )
+	{
+		if( TraceBody( other, body->position, points[i], &tr ) && !tr.startsolid )
+		{
+			float depth = tr.plane.dist - DotProduct( points[i], tr.plane.normal );
+
+			if( depth > 0.0f )
+				AddContact( body, other, points[i], tr.plane.normal, depth );
+			continue;
+		}
+
+		Vector r = points[i] - body->position;
+		Vector velocity = body->velocity + CrossProduct( body->avelocity, r ) + m_vecGravity * m_flStepTime;
+		if( other ) velocity -= other->velocity;
+
+		Vector move = velocity * m_flStepTime;
+		if( DotProduct( move, move ) < 0.0001f )
+			continue;
+
+		if( TraceBody( other, points[i], points[i] + move, &tr ) && !tr.startsolid )
+		{
+			float dist = DotProduct( points[i], tr.plane.normal ) - tr.plane.dist;
+			AddContact( body, other, points[i], tr.plane.normal, -dist );
+		}
+	}
+}
+
+/*
+=================
+CollideConvex
+
+points of each box or hull inside the other one
+=================
+*/
+void CPhysicNative :: CollideConvex( rigidbody_t *body, rigidbody_t *other )
+{
+	rigidbody_t	*shapes[2] = { body, other };
+	Vector		points[MAX_HULL_POINTS];
+	Vector		normal;
+
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		rigidbody_t *src = shapes[pass];
+		rigidbody_t *dst = shapes[pass^1];
+		int numPoints = BodyPoints( src, points );
+
+		for( int i = 0; i < numPoints; i++ )
+		{
+			float depth = PointDepth( dst, points[i], normal );
+
+			if( depth < -PHYS_CONTACT_MARGIN )
+				continue;
+
+			// normal must point from other to body
+			if( pass == 1 ) normal = -normal;
+
+			AddContact( body, other, points[i], normal, depth );
+		}
+	}
+}
+
+void CPhysicNative :: GenerateContacts( rigidbody_t *body )
+{
+	body->numContacts = 0;
+
+	if( FBitSet( body->flags, RB_NOCOLLIDE ))
+		return;
+
+	CollidePoints( body, NULL );
+
+	for( int i = 0; i < body->numPairs; i++ )
+	{
+		rigidbody_t *other = body->pairs[i];
+
+		if( other->shape == SHAPE_MESH )
+			CollidePoints( body, other );
+		else CollideConvex( body, other );
+	}
+}
+
+void CPhysicNative :: ContactsJob( void *context, int index )
+{
+	CPhysicNative *pPhysic = (CPhysicNative *)context;
+	pPhysic->GenerateContacts( pPhysic->m_pActive[index] );
+}
+
+/*
+===============
+
+SOLVER
+
+===============
+*/
+int CPhysicNative :: FindIsland( int index )
+{
+	int root = index;
+
+	while( m_iParent[root] != root )
+		root = m_iParent[root];
+
+	// path compression
+	while( m_iParent[index] != root )
+	{
+		int next = m_iParent[index];
+		m_iParent[index] = root;
+		index = next;
+	}
+
+	return root;
+}
+
+/*
+=================
+BuildIslands
+
+dynamic bodies touching each other are solved together.
+Sleeping bodies touched by the awake ones are waked up
+=================
+*/
+void CPhysicNative :: BuildIslands( void )
+{
+	int	i, j;
+
+	for( i = 0; i < m_iMaxBodies; i++ )
+		m_iParent[i] = i;
+
+	// NOTE: m_iNumActive is growing while we wake up the bodies
+	for( i = 0; i < m_iNumActive; i++ )
+	{
+		rigidbody_t *body = m_pActive[i];
+
+		for( j = 0; j < body->numContacts; j++ )
+		{
+			rigidbody_t *other = body->contacts[j].pDynamicOther;
+			if( !other ) continue;
+
+			if( FBitSet( other->flags, RB_SLEEPING ))
+			{
+				WakeBody( other );
+				GenerateContacts( other );
+				m_pActive[m_iNumActive++] = other;
+			}
+
+			int root1 = FindIsland( body - m_pBodies );
+			int root2 = FindIsland( other - m_pBodies );
+			if( root1 != root2 ) m_iParent[root1] = root2;
+		}
+	}
+
+	// enumerate the islands
+	for( i = 0; i < m_iNumActive; i++ )
+		m_pActive[i]->island = -1;
+
+	m_iNumIslands = 0;
+
+	for( i = 0; i < m_iNumActive; i++ )
+	{
+		rigidbody_t *root = &m_pBodies[FindIsland( m_pActive[i] - m_pBodies )];
+		if( root->island == -1 ) root->island = m_iNumIslands++;
+	}
+
+	memset( m_iIslandStart, 0, sizeof( int ) * ( m_iNumIslands + 1 ));
+
+	for( i = 0; i < m_iNumActive; i++ )
+	{
+		rigidbody_t *body = m_pActive[i];
+		body->island = m_pBodies[FindIsland( body - m_pBodies )].island;
+		m_iIslandStart[body->island + 1]++;
+	}
+
+	for( i = 0; i < m_iNumIslands; i++ )
+		m_iIslandStart[i + 1] += m_iIslandStart[i];
+
+	// m_iParent is not needed anymore, use it as fill counter
+	for( i = 0; i < m_iNumIslands; i++ )
+		m_iParent[i] = m_iIslandStart[i];
+
+	for( i = 0; i < m_iNumActive; i++ )
+	{
+		rigidbody_t *body = m_pActive[i];
+		m_pIslandBodies[m_iParent[body->island]++] = body;
+	}
+}
+
+static Vector RelativeVelocity( rigidbody_t *body, rbcontact_t *c )
+{
+	Vector velocity = body->velocity + CrossProduct( body->avelocity, c->rA );
+	rigidbody_t *other = c->pDynamicOther;
+
+	if( other )
+		return velocity - ( other->velocity + CrossProduct( other->avelocity, c->rB ));
+	return velocity - c->surfaceVelocity;
+}
+
+static float EffectiveMass( rigidbody_t *body, rigidbody_t *other, const Vector &rA, const Vector &rB, const Vector &dir )
+{
+	Vector rn = CrossProduct( rA, dir );
+	float k = body->invMass + DotProduct( rn, InvInertiaMul( body, rn ));
+
+	if( other )
+	{
+		rn = CrossProduct( rB, dir );
+		k += other->invMass + DotProduct( rn, InvInertiaMul( other, rn ));
+	}
+
+	return ( k > 0.0f ) ? ( 1.0f / k ) : 0.0f;
+}
+
+static void PrepareContact( rigidbody_t *body, rbcontact_t *c, float dt )
+{
+	rigidbody_t *other = c->pDynamicOther;
+
+	c->rA = c->point - body->position;
+	c->rB = other ? ( c->point - other->position ) : g_vecZero;
+	c->normalMass = EffectiveMass( body, other, c->rA, c->rB, c->normal );
+
+	// first tangent is along the sliding direction
+	Vector dv = RelativeVelocity( body, c );
+	Vector vt = dv - c->normal * DotProduct( dv, c->normal );
+
+	if( DotProduct( vt, vt ) > 0.0001f )
+		c->tangent[0] = vt.Normalize();
+	else if( fabs( c->normal.x ) > 0.57735f )
+		c->tangent[0] = Vector( c->normal.y, -c->normal.x, 0.0f ).Normalize();
+	else c->tangent[0] = Vector( 0.0f, c->normal.z, -c->normal.y ).Normalize();
+
+	c->tangent[1] = CrossProduct( c->normal, c->tangent[0] );
+	c->tangentMass[0] = EffectiveMass( body, other, c->rA, c->rB, c->tangent[0] );
+	c->tangentMass[1] = EffectiveMass( body, other, c->rA, c->rB, c->tangent[1] );
+
+	if( c->depth > PHYS_CONTACT_SLOP )
+		c->bias = Q_min( PHYS_BAUMGARTE * ( c->depth - PHYS_CONTACT_SLOP ) / dt, PHYS_MAX_BIAS_VELOCITY );
+	else if( c->depth < 0.0f )
+		c->bias = c->depth / dt;	// allow to approach the surface
+	else c->bias = 0.0f;
+
+	c->Pn = c->Pt[0] = c->Pt[1] = 0.0f;
+}
+
+static void SolveContact( rigidbody_t *body, rbcontact_t *c )
+{
+	rigidbody_t *other = c->pDynamicOther;
+	float lambda, old;
+	Vector P;
+
+	// friction
+	for( int k = 0; k < 2; k++ )
+	{
+		Vector dv = RelativeVelocity( body, c );
+		float maxFriction = PHYS_FRICTION * c->Pn;
+
+		lambda = -DotProduct( dv, c->tangent[k] ) * c->tangentMass[k];
+		old = c->Pt[k];
+		c->Pt[k] = bound( -maxFriction, old + lambda, maxFriction );
+		P = c->tangent[k] * ( c->Pt[k] - old );
+
+		ApplyImpulse( body, P, c->rA );
+		if( other ) ApplyImpulse( other, -P, c->rB );
+	}
+
+	// non-penetration
+	Vector dv = RelativeVelocity( body, c );
+	lambda = ( c->bias - DotProduct( dv, c->normal )) * c->normalMass;
+	old = c->Pn;
+	c->Pn = Q_max( old + lambda, 0.0f );
+	P = c->normal * ( c->Pn - old );
+
+	ApplyImpulse( body, P, c->rA );
+	if( other ) ApplyImpulse( other, -P, c->rB );
+}
+
+static void IntegrateRotation( rigidbody_t *body, float dt )
+{
+	Vector4D &q = body->quat;
+	Vector w = body->avelocity * ( 0.5f * dt );
+	Vector4D dq;
+
+	// dq = 0.5 * ( w, 0 ) * q * dt
+	dq.x = w.x * q.w + w.y * q.z - w.z * q.y;
+	dq.y = w.y * q.w + w.z * q.x - w.x * q.z;
+	dq.z = w.z * q.w + w.x * q.y - w.y * q.x;
+	dq.w = -( w.x * q.x + w.y * q.y + w.z * q.z );
+
+	q.x += dq.x;
+	q.y += dq.y;
+	q.z += dq.z;
+	q.w += dq.w;
+
+	float len = sqrt( q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w );
+	if( len > 0.0f )
+	{
+		float ilen = 1.0f / len;
+		q = Vector4D( q.x * ilen, q.y * ilen, q.z * ilen, q.w * ilen );
+	}
+	else q = Vector4D( 0.0f, 0.0f, 0.0f, 1.0f );
+
+	body->rot = matrix3x3( q );
+}
+
+void CPhysicNative :: SolveIsland( int island )
+{
+	rigidbody_t **bodies = &m_pIslandBodies[m_iIslandStart[island]];
+	int count = m_iIslandStart[island + 1] - m_iIslandStart[island];
+	float dt = m_flStepTime;
+	float minSleepTime = 99999.0f;
+	int i, j, iter;
+
+	for( i = 0; i < count; i++ )
+	{
+		rigidbody_t *body = bodies[i];
+
+		body->velocity += ( m_vecGravity + body->force * body->invMass ) * dt;
+		body->avelocity += InvInertiaMul( body, body->torque ) * dt;
+		body->avelocity *= 1.0f / ( 1.0f + dt * PHYS_ANGULAR_DAMPING );
+
+		for( j = 0; j < body->numContacts; j++ )
+			PrepareContact( body, &body->contacts[j], dt );
+	}
+
+	for( iter = 0; iter < PHYS_SOLVER_ITERATIONS; iter++ )
+	{
+		for( i = 0; i < count; i++ )
+		{
+			rigidbody_t *body = bodies[i];
+
+			for( j = 0; j < body->numContacts; j++ )
+				SolveContact( body, &body->contacts[j] );
+		}
+	}
+
+	for( i = 0; i < count; i++ )
+	{
+		rigidbody_t *body = bodies[i];
+
+		float speed = body->velocity.Length();
+		if( speed > m_flMaxVelocity )
+			body->velocity *= ( m_flMaxVelocity / speed );
+
+		float aspeed = body->avelocity.Length();
+		if( aspeed > PHYS_MAX_ANGULAR_VELOCITY )
+			body->avelocity *= ( PHYS_MAX_ANGULAR_VELOCITY / aspeed );
+
+		body->position += body->velocity * dt;
+		IntegrateRotation( body, dt );
+
+		if( speed < PHYS_SLEEP_LINEAR && aspeed < PHYS_SLEEP_ANGULAR )
+			body->sleepTime += dt;
+		else body->sleepTime = 0.0f;
+
+		minSleepTime = Q_min( minSleepTime, body->sleepTime );
+	}
+
+	// whole island goes to sleep at once
+	if( minSleepTime < PHYS_SLEEP_TIME )
+		return;
+
+	for( i = 0; i < count; i++ )
+	{
+		rigidbody_t *body = bodies[i];
+
+		SetBits( body->flags, RB_SLEEPING );
+		body->velocity = body->avelocity = g_vecZero;
+	}
+}
+
+void CPhysicNative :: IslandJob( void *context, int index )
+{
+	CPhysicNative *pPhysic = (CPhysicNative *)context;
+	pPhysic->SolveIsland( index );
+}
+
+void CPhysicNative :: Simulate( float flTime )
+{
+	m_flStepTime = flTime;
+
+	Broadphase();
+
+	// collect awake bodies after broadphase, movers can wake up some of them
+	m_iNumActive = 0;
+
+	for( int i = 0; i < m_iMaxBodies; i++ )
+	{
+		rigidbody_t *body = &m_pBodies[i];
+
+		if( FBitSet( body->flags, RB_INUSE ) && IsSimulated( body ) && !FBitSet( body->flags, RB_SLEEPING ))
+			m_pActive[m_iNumActive++] = body;
+	}
+
+	s_Workers.Run( ContactsJob, this, m_iNumActive );
+	BuildIslands();
+	s_Workers.Run( IslandJob, this, m_iNumIslands );
+}
+
+/*
+=================
+DispatchTouches
+
+engine callbacks can't be called from workers,
+so touch the entities after simulation
+=================
+*/
+void CPhysicNative :: DispatchTouches( void )
+{
+	edict_t	*touched[MAX_RIGID_BODIES * 2];
+	int	i, j, k, numTouched = 0;
+
+	m_iNumContacts = 0;
+
+	for( i = 0; i < m_iNumActive; i++ )
+	{
+		rigidbody_t *body = m_pActive[i];
+
+		m_iNumContacts += body->numContacts;
+
+		for( j = 0; j < body->numContacts && numTouched < (int)ARRAYSIZE( touched ); j++ )
+		{
+			rbcontact_t *c = &body->contacts[j];
+
+			if( c->depth < 0.0f || c->Pn <= 0.0f )
+				continue;	// not touched yet
+
+			edict_t *pOther = c->pOther ? c->pOther->edict : g_pWorld->edict();
+
+			// one touch per pair
+			for( k = 0; k < j; k++ )
+			{
+				if( body->contacts[k].pOther == c->pOther && body->contacts[k].depth >= 0.0f && body->contacts[k].Pn > 0.0f )
+					break;
+			}
+
+			if( k != j ) continue;
+
+			touched[numTouched++] = body->edict;
+			touched[numTouched++] = pOther;
+		}
+	}
+
+	for( i = 0; i < numTouched; i += 2 )
+	{
+		edict_t *e1 = touched[i+0];
+		edict_t *e2 = touched[i+1];
+
+		// entity can be removed by previous touch
+		if( e1->free || e2->free )
+			continue;
+
+		if( e1->v.solid != SOLID_NOT )
+			DispatchTouch( e1, e2 );
+
+		if( e2->v.solid != SOLID_NOT )
+			DispatchTouch( e2, e1 );
+	}
+}
+
+void CPhysicNative :: Update( float flTime )
+{
+	if( !m_pBodies || GET_SERVER_STATE() != SERVER_ACTIVE )
+		return;
+
+	if( flTime <= 0.0f || !m_fWorldLoaded )
+		return;
+
+	if( g_psv_gravity )
+	{
+		// clamp gravity
+		if( g_psv_gravity->value < 0.0f )
+			CVAR_SET_FLOAT( "sv_gravity", 0.0f );
+		if( g_psv_gravity->value > 800.0f )
+			CVAR_SET_FLOAT( "sv_gravity", 800.0f );
+
+		m_vecGravity = Vector( 0.0f, 0.0f, -g_psv_gravity->value );
+	}
+
+	m_flMaxVelocity = CVAR_GET_FLOAT( "sv_maxvelocity" );
+	if( m_flMaxVelocity <= 0.0f ) m_flMaxVelocity = 2000.0f;
+
+	// thread count was changed
+	if( s_Workers.NumThreads() != PhysicThreadsCount( ))
+		s_Workers.Init( PhysicThreadsCount( ));
+
+	double start = Sys_DoubleTime();
+	int numSteps = bound( 1, (int)ceil( flTime / PHYS_MAX_TIMESTEP ), PHYS_MAX_SUBSTEPS );
+
+	for( int step = 0; step < numSteps; step++ )
+		Simulate( flTime / numSteps );
+
+	// forces are applied for one frame
+	for( int i = 0; i < m_iMaxBodies; i++ )
+		m_pBodies[i].force = m_pBodies[i].torque = g_vecZero;
+
+	m_flSimulationTime = Sys_DoubleTime() - start;
+
+	DispatchTouches();
+}
+
+void CPhysicNative :: EndFrame( void )
+{
+	if( !m_pBodies || GET_SERVER_STATE() != SERVER_ACTIVE )
+		return;
+
+	// fill physics stats
+	if( !p_speeds || p_speeds->value <= 0.0f )
+		return;
+
+	int numBodies = 0;
+
+	for( int i = 0; i < m_iMaxBodies; i++ )
+	{
+		if( FBitSet( m_pBodies[i].flags, RB_INUSE ))
+			numBodies++;
+	}
+
+	switch( (int)p_speeds->value )
+	{
+	case 1:
+		Q_snprintf( p_speeds_msg, sizeof( p_speeds_msg ), "%3i active bodies, %3i bodies\n%3i contacts, %3i islands\n%.2f ms, %i threads",
+		m_iNumActive, numBodies, m_iNumContacts, m_iNumIslands, m_flSimulationTime * 1000.0, s_Workers.NumThreads() + 1 );
+		break;
+	}
+}
+
+/*
+===============
+
+TRACING
+
+===============
+*/
+void CPhysicNative :: SweepTest( CBaseEntity *pTouch, const Vector &start, const Vector &mins, const Vector &maxs, const Vector &end, trace_t *tr )
+{
+	rigidbody_t *body = BodyFromEntity( pTouch );
+
+	if( !body || FBitSet( body->flags, RB_NOCOLLIDE ))
+	{
+		// bad body?
+		tr->allsolid = false;
+		return;
+	}
+
+	Vector trace_mins, trace_maxs;
+	UTIL_MoveBounds( start, mins, maxs, end, trace_mins, trace_maxs );
+
+	// NOTE: pmove code completely ignore a bounds checking. So we need to do it here
+	if( !BoundsIntersect( trace_mins, trace_maxs, pTouch->pev->absmin, pTouch->pev->absmax ))
+	{
+		tr->allsolid = false;
+		return;
+	}
+
+	mmesh_t *pMesh = pTouch->m_BodyMesh.CheckMesh( pTouch->GetAbsOrigin(), pTouch->GetAbsAngles( ));
+	areanode_t *pHeadNode = pTouch->m_BodyMesh.GetHeadNode();
+
+	if( !pMesh )
+	{
+		int numTris = ( body->shape == SHAPE_HULL ) ? body->hull->numFaces : 12;
+
+		// NOTE: we compute triangles in abs coords because player AABB
+		// can't be transformed as done for not axial cases
+		pTouch->m_BodyMesh.InitMeshBuild( pTouch->GetModel(), numTris );
+		AddBodyFacets( &pTouch->m_BodyMesh, body );
+
+		if( !pTouch->m_BodyMesh.FinishMeshBuild( ))
+		{
+			ALERT( at_error, "failed to build mesh from %s\n", pTouch->GetModel() );
+			tr->allsolid = false;
+			return;
+		}
+
+		pMesh = pTouch->m_BodyMesh.GetMesh();
+		pHeadNode = pTouch->m_BodyMesh.GetHeadNode();
+	}
+
+	TraceMesh	trm;
+
+	trm.SetTraceMesh( pMesh, pHeadNode );
+	trm.SetupTrace( start, mins, maxs, end, tr );
+
+	if( trm.DoTrace())
+	{
+		if( tr->fraction < 1.0f || tr->startsolid )
+			tr->ent = pTouch->edict();
+	}
+}
+
+void CPhysicNative :: SweepEntity( CBaseEntity *pEntity, const Vector &start, const Vector &end, TraceResult *tr )
+{
+	// make trace default
+	*tr = s_emptyTraceResult;
+	tr->flFraction = 1.0f;
+	tr->vecEndPos = end;
+
+	rigidbody_t *body = BodyFromEntity( pEntity );
+	if( !body || pEntity->pev->solid == SOLID_NOT )
+		return; // only dynamic solid objects can be traced
+
+	if( start == end )
+	{
+		Vector points[MAX_HULL_POINTS];
+		Vector offset = start - pEntity->GetAbsOrigin();
+
+		// test for stuck entity into another
+		int numPoints = BodyPoints( body, points );
+
+		for( int i = 0; i < numPoints; i++ )
+		{
+			UTIL_TraceLine( points[i] + offset, points[i] + offset, ignore_monsters, pEntity->edict(), tr );
+			if( tr->fStartSolid ) return;	// one of points in solid
+		}
+		return;
+	}
+
+	// make a linear sweep of entity AABB through the world
+	TRACE_MONSTER_HULL( pEntity->edict(), start, end, dont_ignore_monsters, pEntity->edict(), tr );
+}
+
+/*
+===============
+
+DEBUG
+
+===============
+*/
+void CPhysicNative :: DebugDraw( void )
+{
+	if( !m_pBodies ) return;
+
+	Tri->Begin( TRI_LINES );
+
+	for( int i = 0; i < m_iMaxBodies; i++ )
+	{
+		rigidbody_t *body = &m_pBodies[i];
+		Vector points[MAX_HULL_POINTS];
+
+		if( !FBitSet( body->flags, RB_INUSE ))
+			continue;
+
+		if( FBitSet( body->flags, RB_NOCOLLIDE ))
+			Tri->Color4f( 0.5f, 0.5f, 0.5f, 1.0f );
+		else if( !IsSimulated( body ))
+			Tri->Color4f( 1.0f, 0.5f, 0.0f, 1.0f );
+		else if( FBitSet( body->flags, RB_SLEEPING ))
+			Tri->Color4f( 0.0f, 0.5f, 1.0f, 1.0f );
+		else Tri->Color4f( 0.0f, 1.0f, 0.0f, 1.0f );
+
+		BodyPoints( body, points );
+
+		if( body->shape == SHAPE_HULL )
+		{
+			for( int j = 0; j < body->hull->numFaces; j++ )
+			{
+				const int *face = body->hull->faces[j];
+
+				for( int k = 0; k < 3; k++ )
+				{
+					Tri->Vertex3fv( points[face[k]] );
+					Tri->Vertex3fv( points[face[(k+1)%3]] );
+				}
+			}
+			continue;
+		}
+
+		for( int j = 0; j < 12; j++ )
+		{
+			Tri->Vertex3fv( points[s_BoxEdges[j][0]] );
+			Tri->Vertex3fv( points[s_BoxEdges[j][1]] );
+		}
+	}
+
+	Tri->End();
+}
+
+/*
+===============
+P_SpeedsMessage
+===============
+*/
+bool CPhysicNative :: P_SpeedsMessage( char *out, size_t size )
+{
+	if( !p_speeds || p_speeds->value <= 0.0f )
+		return false;
+
+	if( !out || !size ) return false;
+	Q_strncpy( out, p_speeds_msg, size );
+
+	return true;
+}
+
+/*
+================
+SCR_RSpeeds
+================
+*/
+void CPhysicNative :: DrawPSpeeds( void )
+{
+	char	msg[1024];
+	int	iScrWidth = CVAR_GET_FLOAT( "width" );
+
+	if( P_SpeedsMessage( msg, sizeof( msg )))
+	{
+		int	x, y, height;
+		char	*p, *start, *end;
+
+		x = iScrWidth - 320;
+		y = 128;
+
+		DrawConsoleStringLen( NULL, NULL, &height );
+		DrawSetTextColor( 1.0f, 1.0f, 1.0f );
+
+		p = start = msg;
+		do
+		{
+			end = Q_strchr( p, '\n' );
+			if( end ) msg[end-start] = '\0';
+
+			DrawConsoleString( x, y, p );
+			y += height;
+
+			if( end )
+				p = end + 1;
+			else
+				break;
+		} while( 1 );
+	}
+}
+
+#endif//USE_PHYSICS_ENGINE
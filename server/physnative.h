@@ -0,0 +1,253 @@
+/*
+physnative.h - built-in rigid body simulation
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#ifndef PHYSNATIVE_H
+#define PHYSNATIVE_H
+
+#include "matrix.h"
+#include "meshdesc.h"
+
+#define DENSITY_FACTOR		0.0013f	// same as novodex to keep the masses
+#define MAX_RIGID_BODIES		1024
+#define MAX_BODY_CONTACTS		24
+#define MAX_BODY_PAIRS		16
+#define MAX_PHYSIC_THREADS		8
+#define MAX_HULL_POINTS		24	// convex hull is reduced to this count of vertices
+#define MAX_HULL_FACES		(MAX_HULL_POINTS * 2 - 4)
+#define MAX_BODY_HULLS		256	// hulls are shared by the bodies with same model
+
+#define PHYS_MAX_TIMESTEP		(1.0f / 100.0f)
+#define PHYS_MAX_SUBSTEPS		4
+#define PHYS_SOLVER_ITERATIONS	10
+#define PHYS_WORLD_CELL_SIZE		512.0f	// world mesh is splitted into cells of this size
+#define PHYS_MAX_WORLD_CELLS		64	// per axis
+#define PHYS_CONTACT_MARGIN		1.0f	// vertices closer than this are already in contact
+#define PHYS_CONTACT_SLOP		0.5f	// allowed penetration
+#define PHYS_BAUMGARTE		0.2f	// penetration recovery factor
+#define PHYS_MAX_BIAS_VELOCITY	100.0f
+#define PHYS_FRICTION		0.5f
+#define PHYS_ANGULAR_DAMPING		0.05f
+#define PHYS_MAX_ANGULAR_VELOCITY	30.0f	// radians per second
+#define PHYS_SLEEP_LINEAR		4.0f	// units per second
+#define PHYS_SLEEP_ANGULAR		0.1f	// radians per second
+#define PHYS_SLEEP_TIME		0.5f
+#define PHYS_HULL_EPSILON		0.1f	// points closer to the hull are not added
+
+// rigid body flags
+#define RB_INUSE			BIT( 0 )
+#define RB_KINEMATIC		BIT( 1 )	// moved by game code, has infinite mass
+#define RB_NOCOLLIDE		BIT( 2 )
+#define RB_SLEEPING			BIT( 3 )
+
+// collision shapes
+#define SHAPE_BOX			0	// oriented box around the model bounds
+#define SHAPE_MESH			1	// triangle mesh in model space
+#define SHAPE_HULL			2	// convex hull in model space
+
+typedef struct rbhull_s
+{
+	int		modelindex;
+	int		numPoints;
+	Vector		points[MAX_HULL_POINTS];	// model space
+	int		numFaces;
+	int		faces[MAX_HULL_FACES][3];	// counter-clockwise seen from outside
+	Vector		normals[MAX_HULL_FACES];
+	float		dists[MAX_HULL_FACES];
+	Vector		mins, maxs;
+	float		volume;
+} rbhull_t;
+
+typedef struct rbcontact_s
+{
+	struct rigidbody_s	*pOther;		// NULL is the world
+	struct rigidbody_s	*pDynamicOther;	// pOther when it's moved by solver too
+	Vector		point;
+	Vector		normal;		// points from other to the owner
+	float		depth;		// > 0 penetration, < 0 distance to go
+	Vector		surfaceVelocity;	// velocity of static or kinematic other
+
+	// solver data
+	Vector		rA, rB;
+	Vector		tangent[2];
+	float		normalMass;
+	float		tangentMass[2];
+	float		bias;
+	float		Pn, Pt[2];	// accumulated impulses
+} rbcontact_t;
+
+typedef struct rigidbody_s
+{
+	edict_t		*edict;
+	int		flags;
+	int		type;		// ACTOR_ type
+	int		shape;
+
+	// model space geometry
+	Vector		center;		// center of the bounds, rotation goes around it
+	Vector		extents;		// half size of the bounds
+	CMeshDesc		*mesh;		// SHAPE_MESH only
+	const rbhull_t	*hull;		// SHAPE_HULL only
+
+	// state
+	Vector		position;		// world position of center
+	Vector4D		quat;
+	matrix3x3		rot;		// cached from quat
+	Vector		velocity;
+	Vector		avelocity;	// world axis, radians per second
+	Vector		force;		// accumulated until the end of frame
+	Vector		torque;
+	float		mass;
+	float		invMass;
+	Vector		invInertia;	// model space diagonal
+	float		sleepTime;
+
+	// per step data
+	Vector		absmin, absmax;
+	int		island;
+	int		numPairs;
+	struct rigidbody_s	*pairs[MAX_BODY_PAIRS];
+	int		numContacts;
+	rbcontact_t	contacts[MAX_BODY_CONTACTS];
+} rigidbody_t;
+
+//-----------------------------------------------------------------------------
+// Purpose: Lightweight rigid body simulation that used when game was built
+//  without PhysX. Dynamic objects are convex hulls of their models (or
+//  oriented boxes when the hull can't be built), world and movers are
+//  triangle meshes from CMeshDesc. Contacts and islands are processed by
+//  the worker threads.
+//-----------------------------------------------------------------------------
+class CPhysicNative : public IPhysicLayer
+{
+private:
+	rigidbody_t	*m_pBodies;	// pool of the bodies
+	int		m_iMaxBodies;	// high water mark of pool
+
+	// world mesh splitted into the cells
+	CMeshDesc		**m_pWorldCells;
+	int		m_iNumCells[3];
+	Vector		m_vecWorldMins;
+	BOOL		m_fWorldLoaded;
+
+	rbhull_t		*m_pHulls[MAX_BODY_HULLS];
+	int		m_iNumHulls;
+
+	// per step data
+	rigidbody_t	*m_pActive[MAX_RIGID_BODIES];	// awake dynamic bodies
+	int		m_iNumActive;
+	rigidbody_t	*m_pSorted[MAX_RIGID_BODIES];	// collidable bodies sorted along X axis
+	int		m_iNumSorted;
+	int		m_iParent[MAX_RIGID_BODIES];	// islands union-find
+	rigidbody_t	*m_pIslandBodies[MAX_RIGID_BODIES];
+	int		m_iIslandStart[MAX_RIGID_BODIES+1];
+	int		m_iNumIslands;
+	float		m_flStepTime;
+	Vector		m_vecGravity;
+	float		m_flMaxVelocity;
+
+	// stats
+	int		m_iNumContacts;
+	double		m_flSimulationTime;
+	char		p_speeds_msg[1024];	// debug message
+public:
+	void		InitPhysic( void );
+	void		FreePhysic( void );
+	void		*GetUtilLibrary( void ) { return NULL; }
+	void		Update( float flTime );
+	void		EndFrame( void );
+	void		RemoveBody( edict_t *pEdict );
+	void		*CreateBodyFromEntity( CBaseEntity *pEntity );
+	void		*CreateBoxFromEntity( CBaseEntity *pObject );
+	void		*CreateKinematicBodyFromEntity( CBaseEntity *pEntity );
+	void		*CreateStaticBodyFromEntity( CBaseEntity *pObject );
+	void		*CreateVehicle( CBaseEntity *pObject, string_t scriptName = 0 );
+	void		*RestoreBody( CBaseEntity *pEntity );
+	void		SaveBody( CBaseEntity *pObject );
+	bool		Initialized( void ) { return (m_pBodies != NULL); }
+	void		SetOrigin( CBaseEntity *pEntity, const Vector &origin );
+	void		SetAngles( CBaseEntity *pEntity, const Vector &angles );
+	void		SetVelocity( CBaseEntity *pEntity, const Vector &velocity );
+	void		SetAvelocity( CBaseEntity *pEntity, const Vector &velocity );
+	void		MoveObject( CBaseEntity *pEntity, const Vector &finalPos );
+	void		RotateObject( CBaseEntity *pEntity, const Vector &finalAngle );
+	void		SetLinearMomentum( CBaseEntity *pEntity, const Vector &velocity );
+	void		AddImpulse( CBaseEntity *pEntity, const Vector &impulse, const Vector &position, float factor );
+	void		AddForce( CBaseEntity *pEntity, const Vector &force );
+	void		EnableCollision( CBaseEntity *pEntity, int fEnable );
+	void		MakeKinematic( CBaseEntity *pEntity, int fEnable );
+	void		UpdateVehicle( CBaseEntity *pObject ) {}
+	int		FLoadTree( char *szMapName ) { return 0; }
+	int		CheckBINFile( char *szMapName ) { return 0; }
+	int		BuildCollisionTree( char *szMapName );
+	bool		UpdateEntityPos( CBaseEntity *pEntity );
+	void		UpdateEntityAABB( CBaseEntity *pEntity );
+	bool		UpdateActorPos( CBaseEntity *pEntity );
+	void		SetupWorld( void );
+	void		DebugDraw( void );
+	void		DrawPSpeeds( void );
+	void		FreeAllBodies( void );
+
+	void		TeleportCharacter( CBaseEntity *pEntity );
+	void		TeleportActor( CBaseEntity *pEntity );
+	void		MoveCharacter( CBaseEntity *pEntity );
+	void		MoveKinematic( CBaseEntity *pEntity );
+	void		SweepTest( CBaseEntity *pTouch, const Vector &start, const Vector &mins, const Vector &maxs, const Vector &end, struct trace_s *tr );
+	void		SweepEntity( CBaseEntity *pEntity, const Vector &start, const Vector &end, struct gametrace_s *tr );
+	bool		IsBodySleeping( CBaseEntity *pEntity );
+	void		*GetCookingInterface( void ) { return NULL; }
+	void		*GetPhysicInterface( void ) { return NULL; }
+private:
+	// bodies
+	rigidbody_t	*AllocBody( CBaseEntity *pEntity, int type );
+	void		FreeBody( rigidbody_t *body );
+	rigidbody_t	*BodyFromEntity( CBaseEntity *pEntity );
+	void		GetModelBounds( CBaseEntity *pEntity, Vector &mins, Vector &maxs );
+	CMeshDesc		*MeshFromBmodel( CBaseEntity *pEntity );
+	CMeshDesc		*MeshFromBounds( const Vector &mins, const Vector &maxs );
+	void		SetupBox( rigidbody_t *body, const Vector &mins, const Vector &maxs );
+	const rbhull_t	*HullForEntity( CBaseEntity *pEntity );
+	void		SetupHull( rigidbody_t *body, const rbhull_t *hull );
+	void		FreeHulls( void );
+	void		SetBodyPose( rigidbody_t *body, const Vector &origin, const Vector &angles );
+	Vector		BodyOrigin( const rigidbody_t *body );
+	void		WakeBody( rigidbody_t *body );
+	void		*CreateMeshBody( CBaseEntity *pEntity, int type );
+
+	// collision
+	void		FreeWorld( void );
+	bool		TraceWorld( const Vector &start, const Vector &end, trace_t *tr );
+	bool		TraceBody( rigidbody_t *other, const Vector &start, const Vector &end, trace_t *tr );
+	void		ComputeBounds( rigidbody_t *body );
+	void		Broadphase( void );
+	void		AddPair( rigidbody_t *body, rigidbody_t *other );
+	void		GenerateContacts( rigidbody_t *body );
+	void		AddContact( rigidbody_t *body, rigidbody_t *other, const Vector &point, const Vector &normal, float depth );
+	void		CollidePoints( rigidbody_t *body, rigidbody_t *other );
+	void		CollideConvex( rigidbody_t *body, rigidbody_t *other );
+
+	// solver
+	void		Simulate( float flTime );
+	int		FindIsland( int index );
+	void		BuildIslands( void );
+	void		SolveIsland( int island );
+	void		DispatchTouches( void );
+
+	static void	ContactsJob( void *context, int index );
+	static void	IslandJob( void *context, int index );
+
+	bool		P_SpeedsMessage( char *out, size_t size );
+};
+
+#endif//PHYSNATIVE_H
@@ -986,7 +986,7 @@ void CBasePlayer::Killed( entvars_t *pevAttacker, int iGib )
 	SetAbsAngles( vecAngles );
 
 	SetThink( &CBasePlayer::PlayerDeathThink);
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 
@@ -1373,7 +1373,7 @@ void CBasePlayer::PlayerDeathThink(void)
 	//ALERT(at_console, "Respawn\n");
 
 	respawn( this, !(m_afPhysicsFlags & PFLAG_OBSERVER) );// don't copy a corpse if we're in deathcam.
-	pev->nextthink = -1;
+	SetAbsNextThink( -1 );
 }
 
 //=========================================================
@@ -4050,7 +4050,7 @@ int CBasePlayer::RemovePlayerItem( CBasePlayerItem *pItem )
 	{
 		ResetAutoaim( );
 		pItem->Holster( );
-		pItem->pev->nextthink = 0;// crowbar may be trying to swing again, etc.
+		pItem->DontThink();// crowbar may be trying to swing again, etc.
 		pItem->SetThink( NULL );
 		m_pActiveItem = NULL;
 		pev->viewmodel = 0;
@@ -5385,7 +5385,7 @@ void CRevertSaved :: KeyValue( KeyValueData *pkvd )
 void CRevertSaved :: Use( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_TYPE useType, float value )
 {
 	UTIL_ScreenFadeAll( pev->rendercolor, Duration(), HoldTime(), pev->renderamt, FFADE_OUT );
-	pev->nextthink = gpGlobals->time + MessageTime();
+	SetNextThink( MessageTime() );
 	SetThink( &CRevertSaved::MessageThink );
 }
 
@@ -5396,7 +5396,7 @@ void CRevertSaved :: MessageThink( void )
 	float nextThink = LoadTime() - MessageTime();
 	if ( nextThink > 0 ) 
 	{
-		pev->nextthink = gpGlobals->time + nextThink;
+		SetNextThink( nextThink );
 		SetThink( &CRevertSaved::LoadThink );
 	}
 	else
@@ -5430,7 +5430,7 @@ void CInfoIntermission::Spawn( void )
 	pev->effects = EF_NODRAW;
 	pev->v_angle = g_vecZero;
 
-	pev->nextthink = gpGlobals->time + 2;// let targets spawn!
+	SetNextThink( 2 );// let targets spawn!
 }
 
 void CInfoIntermission::Think ( void )
@@ -0,0 +1,388 @@
+/*
+profiler.cpp - server frame profiler
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include	"extdll.h"
+#include	"util.h"
+#include	"cbase.h"
+#include	"game.h"
+#include	"virtualfs.h"
+#include	"physcallback.h"
+#include	"profiler.h"
+
+#ifndef NO_SERVER_PROFILER
+
+static const char *s_szGroupName[PROF_GROUPS] = { "frame", "physics", "think", "touch", "trace", "fullpack" };
+
+// frame time histogram buckets, milliseconds
+static const float s_flFrameBuckets[] = { 1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 33.0f };
+#define NUM_FRAME_BUCKETS	((int)ARRAYSIZE( s_flFrameBuckets ) + 1 )
+
+CServerProfiler	g_Profiler;
+
+typedef struct
+{
+	int	node;
+	float	avgTime;
+	float	maxTime;
+	float	avgCalls;
+} profstat_t;
+
+void CServerProfiler :: Reset( void )
+{
+	if( m_pEvents )
+	{
+		ALERT( at_console, "profiler: trace capture aborted\n" );
+		free( m_pEvents );
+	}
+
+	memset( m_nodes, 0, sizeof( m_nodes ));
+	memset( m_flFrameTimes, 0, sizeof( m_flFrameTimes ));
+	m_iNumNodes = 0;
+	m_iHistory = 0;
+	m_iNumFrames = 0;
+	m_flFrameStart = 0.0;
+	m_bCollecting = FALSE;
+
+	m_pEvents = NULL;
+	m_iNumEvents = 0;
+	m_iCaptureFrames = 0;
+}
+
+// drop the frames collected before the profiler was turned off, keep the nodes
+void CServerProfiler :: ClearHistory( void )
+{
+	for( int i = 0; i < PROFILE_MAX_NODES; i++ )
+	{
+		profnode_t *node = &m_nodes[i];
+
+		memset( node->time, 0, sizeof( node->time ));
+		memset( node->calls, 0, sizeof( node->calls ));
+		node->frameTime = 0.0f;
+		node->frameCalls = 0;
+	}
+
+	memset( m_flFrameTimes, 0, sizeof( m_flFrameTimes ));
+	m_iHistory = 0;
+	m_iNumFrames = 0;
+}
+
+profnode_t *CServerProfiler :: FindNode( int group, const char *label, DATAMAP *pMap, void *function )
+{
+	unsigned int hash = (unsigned int)((size_t)label >> 2) * 2654435761U;
+	hash ^= (unsigned int)((size_t)function >> 2) * 2246822519U;
+	hash ^= group;
+
+	for( int i = 0; i < PROFILE_MAX_NODES; i++ )
+	{
+		profnode_t *node = &m_nodes[( hash + i ) & ( PROFILE_MAX_NODES - 1 )];
+
+		if( node->name[0] )
+		{
+			if( node->group == group && node->label == label && node->function == function )
+				return node;
+			continue;
+		}
+
+		// leave a few empty slots to keep probing short
+		if( m_iNumNodes >= PROFILE_MAX_NODES - 16 )
+			return NULL;
+
+		const char *name = ( label && *label ) ? label : "unnamed";
+
+		node->group = group;
+		node->label = label;
+		node->function = function;
+
+		if( function )
+		{
+			// resolve the name once, when node is created
+			const char *funcName = pMap ? UTIL_FunctionToName( pMap, function ) : NULL;
+			Q_snprintf( node->name, sizeof( node->name ), "%s::%s", name, funcName ? funcName : "unknown" );
+		}
+		else Q_strncpy( node->name, name, sizeof( node->name ));
+
+		m_iNumNodes++;
+
+		return node;
+	}
+
+	return NULL;
+}
+
+void CServerProfiler :: AddTime( profnode_t *node, double start, double end )
+{
+	node->frameTime += ( end - start ) * 1000.0;
+	node->frameCalls++;
+
+	if( m_pEvents && m_iNumEvents < PROFILE_MAX_EVENTS )
+	{
+		profevent_t *ev = &m_pEvents[m_iNumEvents++];
+
+		ev->node = node - m_nodes;
+		ev->start = start;
+		ev->duration = end - start;
+	}
+}
+
+void CServerProfiler :: FrameBoundary( void )
+{
+	double now = Sys_DoubleTime();
+
+	if( m_flFrameStart > 0.0 )
+	{
+		// store the last frame in the rings
+		m_flFrameTimes[m_iHistory] = ( now - m_flFrameStart ) * 1000.0;
+
+		for( int i = 0; i < PROFILE_MAX_NODES; i++ )
+		{
+			profnode_t *node = &m_nodes[i];
+
+			if( !node->name[0] ) continue;
+
+			node->time[m_iHistory] = node->frameTime;
+			node->calls[m_iHistory] = Q_min( node->frameCalls, 65535 );
+			node->frameTime = 0.0f;
+			node->frameCalls = 0;
+		}
+
+		m_iHistory = ( m_iHistory + 1 ) % PROFILE_HISTORY;
+		m_iNumFrames = Q_min( m_iNumFrames + 1, PROFILE_HISTORY );
+
+		if( m_pEvents )
+		{
+			if( m_iNumEvents < PROFILE_MAX_EVENTS )
+			{
+				profevent_t *ev = &m_pEvents[m_iNumEvents++];
+
+				ev->node = -1;
+				ev->start = m_flFrameStart;
+				ev->duration = now - m_flFrameStart;
+			}
+
+			if( --m_iCaptureFrames <= 0 )
+				FinishCapture();
+		}
+	}
+
+	// frames are not counted while profiler is off,
+	// stale rings are dropped when it's turned on again
+	if( IsActive() && !m_bCollecting )
+		ClearHistory();
+	m_bCollecting = IsActive();
+	m_flFrameStart = m_bCollecting ? now : 0.0;
+}
+
+static int SortStats( const void *a, const void *b )
+{
+	const profstat_t *stat1 = (const profstat_t *)a;
+	const profstat_t *stat2 = (const profstat_t *)b;
+
+	if( stat1->avgTime > stat2->avgTime )
+		return -1;
+	if( stat1->avgTime < stat2->avgTime )
+		return 1;
+	return 0;
+}
+
+void CServerProfiler :: ReportStats( int count )
+{
+	if( !m_iNumFrames )
+	{
+		ALERT( at_console, "profiler: no frames recorded, set sv_profile 1\n" );
+		return;
+	}
+
+	static profstat_t stats[PROFILE_MAX_NODES];
+	int buckets[NUM_FRAME_BUCKETS];
+	float flFrameAvg = 0.0f, flFrameMax = 0.0f;
+	int i, j, numStats = 0;
+
+	memset( buckets, 0, sizeof( buckets ));
+
+	for( j = 0; j < m_iNumFrames; j++ )
+	{
+		float flTime = m_flFrameTimes[j];
+
+		for( i = 0; i < NUM_FRAME_BUCKETS - 1; i++ )
+		{
+			if( flTime < s_flFrameBuckets[i] )
+				break;
+		}
+
+		buckets[i]++;
+		flFrameAvg += flTime;
+		flFrameMax = Q_max( flFrameMax, flTime );
+	}
+
+	flFrameAvg /= m_iNumFrames;
+
+	for( i = 0; i < PROFILE_MAX_NODES; i++ )
+	{
+		profnode_t *node = &m_nodes[i];
+		profstat_t *stat = &stats[numStats];
+
+		if( !node->name[0] ) continue;
+
+		stat->node = i;
+		stat->avgTime = stat->maxTime = stat->avgCalls = 0.0f;
+
+		for( j = 0; j < m_iNumFrames; j++ )
+		{
+			stat->avgTime += node->time[j];
+			stat->avgCalls += node->calls[j];
+			stat->maxTime = Q_max( stat->maxTime, node->time[j] );
+		}
+
+		stat->avgTime /= m_iNumFrames;
+		stat->avgCalls /= m_iNumFrames;
+		numStats++;
+	}
+
+	qsort( stats, numStats, sizeof( profstat_t ), SortStats );
+
+	ALERT( at_console, "last %i frames: avg %.2f ms, max %.2f ms\n", m_iNumFrames, flFrameAvg, flFrameMax );
+
+	for( i = 0; i < NUM_FRAME_BUCKETS; i++ )
+	{
+		if( i < NUM_FRAME_BUCKETS - 1 )
+			ALERT( at_console, "  < %2.0f ms: %i\n", s_flFrameBuckets[i], buckets[i] );
+		else ALERT( at_console, " >= %2.0f ms: %i\n", s_flFrameBuckets[i-1], buckets[i] );
+	}
+
+	ALERT( at_console, "%-8s %-40s %9s %9s %8s\n", "group", "name", "avg ms", "max ms", "calls" );
+
+	for( i = 0; i < numStats && i < count; i++ )
+	{
+		profnode_t *node = &m_nodes[stats[i].node];
+
+		ALERT( at_console, "%-8s %-40s %9.3f %9.3f %8.1f\n", s_szGroupName[node->group], node->name,
+		stats[i].avgTime, stats[i].maxTime, stats[i].avgCalls );
+	}
+
+	ALERT( at_console, "%i of %i entries, timers are inclusive\n", Q_min( count, numStats ), numStats );
+}
+
+void CServerProfiler :: StartCapture( int frames )
+{
+	if( m_pEvents )
+	{
+		ALERT( at_console, "profiler: trace capture already in progress\n" );
+		return;
+	}
+
+	m_pEvents = (profevent_t *)calloc( PROFILE_MAX_EVENTS, sizeof( profevent_t ));
+	m_iNumEvents = 0;
+	m_iCaptureFrames = Q_max( frames, 1 );
+	m_flCaptureStart = Sys_DoubleTime();
+
+	// start from the next frame
+	m_flFrameStart = 0.0;
+
+	ALERT( at_console, "profiler: capturing %i frames\n", m_iCaptureFrames );
+}
+
+/*
+=================
+FinishCapture
+
+write the events in Chrome trace format (chrome://tracing)
+=================
+*/
+void CServerProfiler :: FinishCapture( void )
+{
+	char filename[64];
+	CVirtualFS file;
+
+	file.Printf( "{\"traceEvents\":[\n" );
+
+	for( int i = 0; i < m_iNumEvents; i++ )
+	{
+		profevent_t *ev = &m_pEvents[i];
+		const char *name = "frame";
+		const char *group = "frame";
+		char escaped[PROFILE_NAME_LENGTH * 2];
+
+		if( ev->node >= 0 )
+		{
+			name = m_nodes[ev->node].name;
+			group = s_szGroupName[m_nodes[ev->node].group];
+		}
+
+		// classnames may contain anything
+		int j = 0;
+		for( const char *s = name; *s && j < (int)sizeof( escaped ) - 2; s++ )
+		{
+			if( *s == '"' || *s == '\\' )
+				escaped[j++] = '\\';
+			escaped[j++] = ( *s < ' ' ) ? ' ' : *s;
+		}
+		escaped[j] = '\0';
+
+		file.Printf( "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}%s\n",
+		escaped, group, ( ev->start - m_flCaptureStart ) * 1000000.0, ev->duration * 1000000.0, ( i < m_iNumEvents - 1 ) ? "," : "" );
+	}
+
+	file.Printf( "]}\n" );
+
+	Q_snprintf( filename, sizeof( filename ), "profile_%s.json", STRING( gpGlobals->mapname ));
+
+	if( SAVE_FILE( filename, file.GetBuffer(), file.GetSize( )))
+		ALERT( at_console, "profiler: wrote %s (%i events)\n", filename, m_iNumEvents );
+	else ALERT( at_error, "profiler: couldn't write %s\n", filename );
+
+	if( m_iNumEvents >= PROFILE_MAX_EVENTS )
+		ALERT( at_warning, "profiler: events limit %i was reached, capture fewer frames\n", PROFILE_MAX_EVENTS );
+
+	free( m_pEvents );
+	m_pEvents = NULL;
+	m_iNumEvents = 0;
+}
+
+void ProfileDump_f( void )
+{
+	int count = ( CMD_ARGC() > 1 ) ? atoi( CMD_ARGV( 1 )) : 20;
+
+	g_Profiler.ReportStats( count );
+}
+
+void ProfileTrace_f( void )
+{
+	int frames = ( CMD_ARGC() > 1 ) ? atoi( CMD_ARGV( 1 )) : 100;
+
+	g_Profiler.StartCapture( frames );
+}
+
+void ProfileReset_f( void )
+{
+	g_Profiler.Reset();
+}
+
+#else
+
+void ProfileDump_f( void )
+{
+	ALERT( at_console, "server was built without profiler\n" );
+}
+
+void ProfileTrace_f( void )
+{
+	ALERT( at_console, "server was built without profiler\n" );
+}
+
+void ProfileReset_f( void )
+{
+}
+
+#endif//NO_SERVER_PROFILER
@@ -0,0 +1,148 @@
+/*
+profiler.h - server frame profiler
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "game.h"
+
+// build with NO_SERVER_PROFILER to remove all the timers
+#ifndef NO_SERVER_PROFILER
+
+#define PROFILE_MAX_NODES	1024	// must be power of two
+#define PROFILE_HISTORY	64	// frames in rolling window
+#define PROFILE_MAX_EVENTS	65536	// trace capture limit
+#define PROFILE_NAME_LENGTH	64
+
+// what kind of code was measured
+enum
+{
+	PROF_FRAME = 0,
+	PROF_PHYSICS,
+	PROF_THINK,
+	PROF_TOUCH,
+	PROF_TRACE,
+	PROF_FULLPACK,
+	PROF_GROUPS
+};
+
+typedef struct
+{
+	int		group;
+	const char	*label;		// key: classname or callback name
+	void		*function;	// key: think or touch function
+	char		name[PROFILE_NAME_LENGTH];
+
+	float		time[PROFILE_HISTORY];	// milliseconds per frame
+	unsigned short	calls[PROFILE_HISTORY];
+	float		frameTime;	// accumulated in current frame
+	int		frameCalls;
+} profnode_t;
+
+typedef struct
+{
+	short		node;
+	double		start;
+	float		duration;
+} profevent_t;
+
+//-----------------------------------------------------------------------------
+// Purpose: Collects the time of server callbacks per entity class and
+//  function over the last frames. Optionally records every call of a few
+//  frames and writes them as Chrome trace. Enabled by sv_profile.
+//-----------------------------------------------------------------------------
+class CServerProfiler
+{
+public:
+	CServerProfiler( void ) { Reset(); }
+
+	_inline BOOL	IsActive( void );
+	profnode_t	*FindNode( int group, const char *label, DATAMAP *pMap, void *function );
+	void		AddTime( profnode_t *node, double start, double end );
+
+	// called from StartFrame, closes the previous frame
+	void		FrameBoundary( void );
+	void		Reset( void );
+
+	void		ReportStats( int count );
+	void		StartCapture( int frames );
+private:
+	void		FinishCapture( void );
+	void		ClearHistory( void );
+
+	profnode_t	m_nodes[PROFILE_MAX_NODES];
+	int		m_iNumNodes;
+	int		m_iHistory;	// current slot of rings
+	int		m_iNumFrames;	// valid slots
+	double		m_flFrameStart;
+	float		m_flFrameTimes[PROFILE_HISTORY];
+	BOOL		m_bCollecting;	// was active on the last frame
+
+	// trace capture
+	profevent_t	*m_pEvents;
+	int		m_iNumEvents;
+	int		m_iCaptureFrames;	// frames left to record
+	double		m_flCaptureStart;
+};
+
+extern CServerProfiler	g_Profiler;
+
+_inline BOOL CServerProfiler :: IsActive( void )
+{
+	return ( g_profile.value != 0.0f || m_pEvents != NULL );
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: measures the time until end of the scope
+//-----------------------------------------------------------------------------
+class CProfileScope
+{
+public:
+	CProfileScope( int group, const char *label, DATAMAP *pMap = NULL, void *function = NULL )
+	{
+		m_pNode = NULL;
+
+		if( g_Profiler.IsActive( ))
+		{
+			m_pNode = g_Profiler.FindNode( group, label, pMap, function );
+			m_flStart = Sys_DoubleTime();
+		}
+	}
+
+	~CProfileScope()
+	{
+		if( m_pNode )
+			g_Profiler.AddTime( m_pNode, m_flStart, Sys_DoubleTime( ));
+	}
+private:
+	profnode_t	*m_pNode;
+	double		m_flStart;
+};
+
+#define PROFILE_SCOPE( group, label )			CProfileScope profileScope( group, label )
+#define PROFILE_FUNCTION( group, label, map, func )	CProfileScope profileScope( group, label, map, func )
+#define PROFILE_FRAME()				g_Profiler.FrameBoundary()
+#define PROFILE_RESET()				g_Profiler.Reset()
+
+#else
+
+#define PROFILE_SCOPE( group, label )
+#define PROFILE_FUNCTION( group, label, map, func )
+#define PROFILE_FRAME()
+#define PROFILE_RESET()
+
+#endif//NO_SERVER_PROFILER
+
+#endif//PROFILER_H
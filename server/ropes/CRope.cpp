@@ -19,14 +19,16 @@
 #include "gamerules.h"
 #include "CRope.h"
 #include "CRopeSegment.h"
+#include "CRopeSystem.h"
 #include "studio.h"
 #include "player.h"
 
-#define HOOK_CONSTANT	2500.0f
-#define SPRING_DAMPING	0.1f	
 #define ROPE_IGNORE_SAMPLES	4		// integrator may be hanging if less than
-
-RopeSampleData g_pTempList[MAX_LIST_SEGMENTS][MAX_SEGMENTS];
+#define ROPE_SLEEP_SPEED	2.0f		// samples slower than this are at rest
+#define ROPE_SLEEP_TIME	2.0f
+#define ROPE_TRACE_EPSILON	0.25f		// don't trace samples that moved less than
+#define ROPE_BONES_EPSILON	0.5f		// don't send bones until segment moved more than
+#define ROPE_BONES_REFRESH	1.0f		// resend resting bones for clients who entered the PVS
 	
 static const char* const g_pszCreakSounds[] = 
 {
@@ -221,6 +223,22 @@ void CRope :: SendUpdateBones( void )
 	studiohdr_t *phdr = (studiohdr_t *)CBaseAnimating::GetModelPtr( pev->modelindex );
 	if( !phdr ) return;
 
+	int numbones = Q_min( phdr->numbones, m_iNumSamples );
+	bool bMoved = ( gpGlobals->time >= m_flNextBonesTime );
+
+	for( int i = 0; i < numbones && !bMoved; i++ )
+	{
+		if(( m_pSegments[i]->GetAbsOrigin() - m_vecBonesOrigin[i] ).Length() > ROPE_BONES_EPSILON )
+			bMoved = true;
+	}
+
+	// clients still have the actual pose
+	if( !bMoved ) return;
+
+	for( int i = 0; i < numbones; i++ )
+		m_vecBonesOrigin[i] = m_pSegments[i]->GetAbsOrigin();
+	m_flNextBonesTime = gpGlobals->time + ROPE_BONES_REFRESH;
+
 	matrix4x4 localSpace = EntityToWorldTransform().Invert();
 	Vector pos, mins, maxs;
 	Radian ang;
@@ -254,190 +272,78 @@ void CRope :: SendUpdateBones( void )
 
 void CRope :: Think( void )
 {
-	int subSteps = Q_rint( 100.0f * gpGlobals->frametime ) * 2;
-	float delta = (1.0f / 100.0f) * 2.0f;
-	subSteps = bound( 2, subSteps, 10 );
-
 	if( m_hParent != NULL )
 	{
 		// get move origin from parent class
 		CRopeSegment* pSegment = m_pSegments[0];
+
+		if( pSegment->m_Data.mPosition != GetAbsOrigin( ))
+			WakeUp();
+
 		pSegment->SetAbsOrigin( GetAbsOrigin() );
 		pSegment->m_Data.mPosition = GetAbsOrigin();
 	}
 
-	// make ropes nonsense to sv_fps
-	for( int idx = 0; idx < subSteps; idx++ )
+	if( m_bSleeping && ShouldWakeUp( ))
+		WakeUp();
+
+	if( m_bSleeping )
 	{
-		ComputeForces( m_pSegments );
-		RK4Integrate( delta );
+		// resting pose doesn't change, just refresh the bones for a new viewers
+		if( gpGlobals->time >= m_flNextBonesTime )
+			SendUpdateBones();
+	}
+	else
+	{
+		// will be stepped at the end of frame with all the other ropes
+		g_RopeSystem.AddRope( this );
 	}
-
-	TraceModels();
 
 	if( ShouldCreak() )
 	{
 		EMIT_SOUND( edict(), CHAN_BODY, g_pszCreakSounds[RANDOM_LONG( 0, ARRAYSIZE( g_pszCreakSounds ) - 1 )], VOL_NORM, ATTN_NORM );
 	}
 
-	SendUpdateBones();
 	SetNextThink( 0.0f );
 }
 
-void CRope :: ComputeForces( RopeSampleData* pSystem )
-{
-	int i;
-
-	for( i = 0; i < m_iNumSamples; i++ )
-	{
-		ComputeSampleForce( pSystem[i] );
-	}
-
-	for( i = 0; i < m_iSegments; i++ )
-	{
-		ComputeSpringForce( pSystem[i+0], pSystem[i+1] );
-	}
-}
-
-void CRope :: ComputeSampleForce( RopeSampleData& data )
+void CRope :: PostSimulate( void )
 {
-	data.mForce = g_vecZero;
-
-	if( data.mMassReciprocal != 0.0 )
-	{
-		data.mForce = data.mForce + ( m_vecGravity / data.mMassReciprocal );
-	}
+	TraceModels();
 
-	if( data.mApplyExternalForce )
-	{
-		data.mForce += data.mExternalForce;
-		data.mApplyExternalForce = false;
-		data.mExternalForce = g_vecZero;
-	}
+	if( m_bObjectAttached || m_flSimulatedSpeed > ROPE_SLEEP_SPEED )
+		m_flRestTime = 0.0f;
+	else m_flRestTime += gpGlobals->frametime;
 
-	if( DotProduct( m_vecGravity, data.mVelocity ) >= 0 )
-	{
-		data.mForce += data.mVelocity * -0.04;
-	}
-	else
+	if( m_flRestTime > ROPE_SLEEP_TIME )
 	{
-		data.mForce -= data.mVelocity;
+		for( int i = 0; i < m_iNumSamples; i++ )
+			m_pSegments[i]->m_Data.mVelocity = g_vecZero;
+		m_bSleeping = true;
 	}
-}
-
-void CRope :: ComputeSpringForce( RopeSampleData& first, RopeSampleData& second )
-{
-	Vector vecDist = first.mPosition - second.mPosition;
-
-	const double flDistance = vecDist.Length();
-	const double flForce = ( flDistance - first.restLength ) * HOOK_CONSTANT;
 
-	const double flNewRelativeDist = DotProduct( first.mVelocity - second.mVelocity, vecDist ) * SPRING_DAMPING;
-
-	vecDist = vecDist.Normalize();
-
-	const double flSpringFactor = -( flNewRelativeDist / flDistance + flForce );
-	const Vector vecForce = flSpringFactor * vecDist;
-
-	first.mForce += vecForce;
-	second.mForce -= vecForce;
+	SendUpdateBones();
 }
 
-void CRope :: ComputeForces( CRopeSegment** ppSystem )
+void CRope :: WakeUp( void )
 {
-	int i;
-
-	for( i = 0; i < m_iNumSamples; i++ )
-	{
-		ComputeSampleForce( ppSystem[i]->m_Data );
-	}
-
-	for( i = 0; i < m_iSegments; i++ )
-	{
-		ComputeSpringForce( ppSystem[i+0]->m_Data, ppSystem[i+1]->m_Data );
-	}
+	m_bSleeping = false;
+	m_flRestTime = 0.0f;
 }
 
-void CRope :: RK4Integrate( const float flDeltaTime )
+bool CRope :: ShouldWakeUp( void ) const
 {
-	const float flDeltas[MAX_LIST_SEGMENTS - 1] = 
-	{
-		flDeltaTime * 0.5f,
-		flDeltaTime * 0.5f,
-		flDeltaTime * 0.5f,
-		flDeltaTime
-	};
-
-	RopeSampleData *pTemp1, *pTemp2, *pTemp3, *pTemp4;
-	int i;
-
-	pTemp1 = g_pTempList[0];
-	pTemp2 = g_pTempList[1];
-
-	for( i = 0; i < m_iNumSamples; i++, pTemp1++, pTemp2++ )
-	{
-		const RopeSampleData& data = m_pSegments[i]->m_Data;
-
-		pTemp2->mForce = data.mMassReciprocal * data.mForce * flDeltas[0];
-		pTemp2->mVelocity = data.mVelocity * flDeltas[0];
-		pTemp2->restLength = data.restLength;
-
-		pTemp1->mMassReciprocal = data.mMassReciprocal;
-		pTemp1->mVelocity = data.mVelocity + pTemp2->mForce;
-		pTemp1->mPosition = data.mPosition + pTemp2->mVelocity;
-		pTemp1->restLength = data.restLength;
-	}
-
-	ComputeForces( g_pTempList[0] );
-
-	for( int iStep = 2; iStep < MAX_LIST_SEGMENTS - 1; iStep++ )
-	{
-		pTemp1 = g_pTempList[0];
-		pTemp2 = g_pTempList[iStep];
-
-		for( i = 0; i < m_iNumSamples; i++, pTemp1++, pTemp2++ )
-		{
-			const RopeSampleData& data = m_pSegments[i]->m_Data;
-
-			pTemp2->mForce = data.mMassReciprocal * pTemp1->mForce * flDeltas[iStep - 1];
-			pTemp2->mVelocity = pTemp1->mVelocity * flDeltas[iStep - 1];
-			pTemp2->restLength = data.restLength;
-
-			pTemp1->mMassReciprocal = data.mMassReciprocal;
-			pTemp1->mVelocity = data.mVelocity + pTemp2->mForce;
-			pTemp1->mPosition = data.mPosition + pTemp2->mVelocity;
-			pTemp1->restLength = data.restLength;
-		}
-
-		ComputeForces( g_pTempList[0] );
-	}
-
-	pTemp1 = g_pTempList[0];
-	pTemp2 = g_pTempList[4];
+	if( m_bObjectAttached )
+		return true;
 
-	for( i = 0; i < m_iNumSamples; i++, pTemp1++, pTemp2++ )
+	// somebody pushed the rope
+	for( int i = 0; i < m_iNumSamples; i++ )
 	{
-		const RopeSampleData& data = m_pSegments[i]->m_Data;
-
-		pTemp2->mForce = data.mMassReciprocal * pTemp1->mForce * flDeltas[3];
-		pTemp2->mVelocity = pTemp1->mVelocity * flDeltas[3];
+		if( m_pSegments[i]->m_Data.mApplyExternalForce )
+			return true;
 	}
 
-	pTemp1 = g_pTempList[1];
-	pTemp2 = g_pTempList[2];
-	pTemp3 = g_pTempList[3];
-	pTemp4 = g_pTempList[4];
-
-	for( i = 0; i < m_iNumSamples; i++, pTemp1++, pTemp2++, pTemp3++, pTemp4++ )
-	{
-		CRopeSegment *pSegment = m_pSegments[i];
-		const Vector vecPosChange = 1.0f / 6.0f * ( pTemp1->mVelocity + ( pTemp2->mVelocity + pTemp3->mVelocity ) * 2 + pTemp4->mVelocity );
-		const Vector vecVelChange = 1.0f / 6.0f * ( pTemp1->mForce + ( pTemp2->mForce + pTemp3->mForce ) * 2 + pTemp4->mForce );
-
-		// store final changes for each segment
-		pSegment->m_Data.mPosition += vecPosChange;
-		pSegment->m_Data.mVelocity += vecVelChange;
-	}
+	return false;
 }
 
 void CRope :: SetSegmentOrigin( CRopeSegment *pCurr, CRopeSegment *pNext )
@@ -519,6 +425,13 @@ void CRope :: TraceModels( void )
 		for( int iSeg = 1; iSeg < m_iNumSamples; iSeg++ )
 		{
 			CRopeSegment* pSegment = m_pSegments[iSeg];
+			Vector vecTarget = pSegment->m_Data.mPosition;
+
+			TruncateEpsilon( vecTarget );
+
+			// sample stays where it was placed last time
+			if(( vecTarget - pSegment->GetAbsOrigin( )).Length() < ROPE_TRACE_EPSILON )
+				continue;
 
 			UTIL_TraceLine( pSegment->GetAbsOrigin(), pSegment->m_Data.mPosition, ignore_monsters, edict(), &tr );
 
@@ -552,7 +465,7 @@ void CRope :: TraceModels( void )
 		SetSegmentAngles( m_pSegments[iSeg - 1], m_pSegments[iSeg] );
 	}
 
-	if( m_iSegments > 1 )
+	if( m_iSegments > 1 && m_vecLastEndPos != m_pSegments[m_iNumSamples - 1]->m_Data.mPosition )
 	{
 		CRopeSegment *pSegment = m_pSegments[m_iNumSamples - 1];
 
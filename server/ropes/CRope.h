@@ -19,13 +19,13 @@ class CRopeSegment;
 class CRopeSample;
 
 #define MAX_SEGMENTS	64
-#define MAX_LIST_SEGMENTS	5
 
 struct RopeSampleData;
 
 /**
 *	A rope with a number of segments.
-*	Uses an RK4 integrator with dampened springs to simulate rope physics.
+*	Samples are kept at the segment length by the position based solver in CRopeSystem,
+*	which steps all awake ropes together. Ropes at rest are going to sleep.
 */
 class CRope : public CBaseDelay
 {
@@ -43,11 +43,11 @@ public:
 
 	void Think();
 
-	void ComputeForces( RopeSampleData* pSystem );
-	void ComputeForces( CRopeSegment** ppSystem );
-	void ComputeSampleForce( RopeSampleData& data );
-	void ComputeSpringForce( RopeSampleData& first, RopeSampleData& second );
-	void RK4Integrate( const float flDeltaTime );
+	void PostSimulate( void );
+	void SetSimulatedSpeed( const float flSpeed ) { m_flSimulatedSpeed = flSpeed; }
+	bool IsSleeping() const { return m_bSleeping; }
+	void WakeUp( void );
+	bool ShouldWakeUp( void ) const;
 	void TraceModels( void );
 	bool MoveUp( const float flDeltaTime );
 	bool MoveDown( const float flDeltaTime );
@@ -59,6 +59,8 @@ public:
 	bool IsObjectAttached() const { return m_bObjectAttached; }
 	bool IsAcceptingAttachment() const;
 	int GetNumSegments() const { return m_iSegments; }
+	int GetNumSamples() const { return m_iNumSamples; }
+	const Vector& GetGravity() const { return m_vecGravity; }
 	CRopeSegment** GetSegments() { return m_pSegments; }
 	bool IsSimulateBones() { return m_bSimulateBones; }
 	bool IsSoundAllowed() const { return m_bMakeSound; }
@@ -101,6 +103,13 @@ private:
 	string_t m_iszEndingModel;
 	bool m_bSimulateBones;
 	bool m_bMakeSound;
+
+	// not saved, restored ropes are awake and resend the bones
+	bool m_bSleeping;
+	float m_flRestTime;
+	float m_flSimulatedSpeed;	// fastest sample after the last step
+	float m_flNextBonesTime;
+	Vector m_vecBonesOrigin[MAX_SEGMENTS];	// segment origins at last bones update
 };
 
 #endif //GAME_SERVER_ENTITIES_ROPE_CROPE_H
@@ -81,6 +81,10 @@ void CRopeSegment :: Spawn( void )
 
 void CRopeSegment :: Touch( CBaseEntity* pOther )
 {
+	// something hit the resting rope, let it swing again
+	if( GetMasterRope()->IsSleeping() && pOther->GetAbsVelocity() != g_vecZero )
+		GetMasterRope()->WakeUp();
+
 	if( pOther->IsPlayer() )
 	{
 		CBasePlayer *pPlayer = (CBasePlayer *)pOther;
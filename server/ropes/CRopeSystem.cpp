@@ -0,0 +1,237 @@
+/*
+CRopeSystem.cpp - batched solver of the awake ropes
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include "extdll.h"
+#include "util.h"
+#include "cbase.h"
+#include "CRope.h"
+#include "CRopeSegment.h"
+#include "CRopeSystem.h"
+
+#define ROPE_STEP_TIME		0.02f	// fixed substep, as the old RK4 integrator
+#define ROPE_DAMPING_FALL		0.04f	// moving along gravity
+#define ROPE_DAMPING_RISE		1.0f	// moving against gravity
+
+CRopeSystem g_RopeSystem;
+
+// samples of all ropes in the batch, one array per component
+typedef struct
+{
+	float	px[MAX_BATCH_SAMPLES], py[MAX_BATCH_SAMPLES], pz[MAX_BATCH_SAMPLES];	// position
+	float	qx[MAX_BATCH_SAMPLES], qy[MAX_BATCH_SAMPLES], qz[MAX_BATCH_SAMPLES];	// predicted position
+	float	vx[MAX_BATCH_SAMPLES], vy[MAX_BATCH_SAMPLES], vz[MAX_BATCH_SAMPLES];	// velocity
+	float	ex[MAX_BATCH_SAMPLES], ey[MAX_BATCH_SAMPLES], ez[MAX_BATCH_SAMPLES];	// external force, first substep only
+	float	gx[MAX_BATCH_SAMPLES], gy[MAX_BATCH_SAMPLES], gz[MAX_BATCH_SAMPLES];	// gravity of the owner rope
+	float	invMass[MAX_BATCH_SAMPLES];
+	float	restLength[MAX_BATCH_SAMPLES];	// to the next sample, < 0 for the last sample of rope
+} ropebatch_t;
+
+static ropebatch_t s_Batch;
+
+void CRopeSystem :: AddRope( CRope *pRope )
+{
+	m_hRopes[m_hRopes.AddToTail()] = pRope;
+}
+
+void CRopeSystem :: Simulate( void )
+{
+	int i, iNumRopes;
+
+	// arrays keep their memory between frames
+	m_pActive.RemoveAll();
+
+	for( i = 0; i < m_hRopes.Count(); i++ )
+	{
+		CRope *pRope = (CRope *)(CBaseEntity *)m_hRopes[i];
+
+		if( pRope && !FBitSet( pRope->pev->flags, FL_KILLME ))
+			m_pActive.AddToTail( pRope );
+	}
+
+	m_hRopes.RemoveAll();
+
+	CRope **pRopes = m_pActive.Base();
+	iNumRopes = m_pActive.Count();
+
+	if( !iNumRopes || gpGlobals->frametime <= 0.0f )
+		return;
+
+	// make ropes nonsense to sv_fps
+	int iSubSteps = Q_rint( 100.0f * gpGlobals->frametime ) * 2;
+	iSubSteps = bound( 2, iSubSteps, 10 );
+
+	int iFirst = 0, iNumSamples = 0;
+
+	for( i = 0; i < iNumRopes; i++ )
+	{
+		int iRopeSamples = pRopes[i]->GetNumSamples();
+
+		if( iNumSamples + iRopeSamples > MAX_BATCH_SAMPLES )
+		{
+			SolveBatch( &pRopes[iFirst], i - iFirst, iNumSamples, iSubSteps, ROPE_STEP_TIME );
+			iFirst = i;
+			iNumSamples = 0;
+		}
+
+		iNumSamples += iRopeSamples;
+	}
+
+	SolveBatch( &pRopes[iFirst], iNumRopes - iFirst, iNumSamples, iSubSteps, ROPE_STEP_TIME );
+
+	// collisions and networking are done when all ropes are moved
+	for( i = 0; i < iNumRopes; i++ )
+		pRopes[i]->PostSimulate();
+}
+
+void CRopeSystem :: SolveBatch( CRope **ppRopes, int iNumRopes, int iNumSamples, int iSubSteps, float flDelta )
+{
+	ropebatch_t *b = &s_Batch;
+	int i, j, n = 0;
+
+	if( iNumRopes <= 0 || iNumSamples <= 0 )
+		return;
+
+	// gather
+	for( i = 0; i < iNumRopes; i++ )
+	{
+		CRopeSegment **ppSegments = ppRopes[i]->GetSegments();
+		const Vector &vecGravity = ppRopes[i]->GetGravity();
+		int iRopeSamples = ppRopes[i]->GetNumSamples();
+
+		for( j = 0; j < iRopeSamples; j++, n++ )
+		{
+			RopeSampleData &data = ppSegments[j]->m_Data;
+
+			b->px[n] = data.mPosition.x;
+			b->py[n] = data.mPosition.y;
+			b->pz[n] = data.mPosition.z;
+			b->vx[n] = data.mVelocity.x;
+			b->vy[n] = data.mVelocity.y;
+			b->vz[n] = data.mVelocity.z;
+			b->gx[n] = vecGravity.x;
+			b->gy[n] = vecGravity.y;
+			b->gz[n] = vecGravity.z;
+			b->invMass[n] = data.mMassReciprocal;
+			b->restLength[n] = ( j < iRopeSamples - 1 ) ? data.restLength : -1.0f;
+
+			if( data.mApplyExternalForce )
+			{
+				b->ex[n] = data.mExternalForce.x;
+				b->ey[n] = data.mExternalForce.y;
+				b->ez[n] = data.mExternalForce.z;
+				data.mApplyExternalForce = false;
+				data.mExternalForce = g_vecZero;
+			}
+			else
+			{
+				b->ex[n] = b->ey[n] = b->ez[n] = 0.0f;
+			}
+		}
+	}
+
+	const float flInvDelta = 1.0f / flDelta;
+
+	for( int iStep = 0; iStep < iSubSteps; iStep++ )
+	{
+		// integrate forces and predict positions
+		for( i = 0; i < n; i++ )
+		{
+			const float w = b->invMass[i];
+			const float grav = ( w != 0.0f ) ? 1.0f : 0.0f;
+			const float damp = ( b->gx[i] * b->vx[i] + b->gy[i] * b->vy[i] + b->gz[i] * b->vz[i] >= 0.0f ) ? -ROPE_DAMPING_FALL : -ROPE_DAMPING_RISE;
+
+			b->vx[i] += ( w * ( b->vx[i] * damp + b->ex[i] ) + b->gx[i] * grav ) * flDelta;
+			b->vy[i] += ( w * ( b->vy[i] * damp + b->ey[i] ) + b->gy[i] * grav ) * flDelta;
+			b->vz[i] += ( w * ( b->vz[i] * damp + b->ez[i] ) + b->gz[i] * grav ) * flDelta;
+
+			b->qx[i] = b->px[i] + b->vx[i] * flDelta;
+			b->qy[i] = b->py[i] + b->vy[i] * flDelta;
+			b->qz[i] = b->pz[i] + b->vz[i] * flDelta;
+		}
+
+		if( iStep == 0 )
+		{
+			// external forces are applied for one substep
+			memset( b->ex, 0, sizeof( float ) * n );
+			memset( b->ey, 0, sizeof( float ) * n );
+			memset( b->ez, 0, sizeof( float ) * n );
+		}
+
+		// keep the segments length. Links with same parity don't share
+		// samples, so each pass has no dependencies between iterations
+		for( int iter = 0; iter < ROPE_SOLVER_ITERATIONS; iter++ )
+		{
+			for( int parity = 0; parity < 2; parity++ )
+			{
+				for( i = parity; i < n - 1; i += 2 )
+				{
+					const float rest = b->restLength[i];
+					const float w1 = b->invMass[i];
+					const float w2 = b->invMass[i+1];
+
+					if( rest < 0.0f || ( w1 + w2 ) == 0.0f )
+						continue;
+
+					float dx = b->qx[i+1] - b->qx[i];
+					float dy = b->qy[i+1] - b->qy[i];
+					float dz = b->qz[i+1] - b->qz[i];
+					float len = sqrt( dx * dx + dy * dy + dz * dz );
+
+					if( len < 0.0001f )
+						continue;
+
+					float s = ( len - rest ) / ( len * ( w1 + w2 ));
+
+					b->qx[i] += dx * s * w1;
+					b->qy[i] += dy * s * w1;
+					b->qz[i] += dz * s * w1;
+					b->qx[i+1] -= dx * s * w2;
+					b->qy[i+1] -= dy * s * w2;
+					b->qz[i+1] -= dz * s * w2;
+				}
+			}
+		}
+
+		// velocities from corrected positions
+		for( i = 0; i < n; i++ )
+		{
+			b->vx[i] = ( b->qx[i] - b->px[i] ) * flInvDelta;
+			b->vy[i] = ( b->qy[i] - b->py[i] ) * flInvDelta;
+			b->vz[i] = ( b->qz[i] - b->pz[i] ) * flInvDelta;
+			b->px[i] = b->qx[i];
+			b->py[i] = b->qy[i];
+			b->pz[i] = b->qz[i];
+		}
+	}
+
+	// scatter
+	for( i = 0, n = 0; i < iNumRopes; i++ )
+	{
+		CRopeSegment **ppSegments = ppRopes[i]->GetSegments();
+		int iRopeSamples = ppRopes[i]->GetNumSamples();
+		float flMaxSpeed = 0.0f;
+
+		for( j = 0; j < iRopeSamples; j++, n++ )
+		{
+			RopeSampleData &data = ppSegments[j]->m_Data;
+
+			data.mPosition = Vector( b->px[n], b->py[n], b->pz[n] );
+			data.mVelocity = Vector( b->vx[n], b->vy[n], b->vz[n] );
+			flMaxSpeed = Q_max( flMaxSpeed, DotProduct( data.mVelocity, data.mVelocity ));
+		}
+
+		ppRopes[i]->SetSimulatedSpeed( sqrt( flMaxSpeed ));
+	}
+}
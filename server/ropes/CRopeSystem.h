@@ -0,0 +1,51 @@
+/*
+CRopeSystem.h - batched solver of the awake ropes
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#ifndef GAME_SERVER_ENTITIES_ROPE_CROPESYSTEM_H
+#define GAME_SERVER_ENTITIES_ROPE_CROPESYSTEM_H
+
+#include <utlarray.h>
+
+class CRope;
+
+#define MAX_BATCH_SAMPLES		2048	// bigger lists are solved in a few batches
+#define ROPE_SOLVER_ITERATIONS	4
+
+/**
+*	Steps all the awake ropes together at the end of frame.
+*	Samples are copied into the flat arrays so the solver loops run over
+*	plain floats instead of chasing the segment entities.
+*/
+class CRopeSystem
+{
+public:
+	CRopeSystem() {}
+
+	// awake ropes are added from their Think
+	void AddRope( CRope *pRope );
+
+	// called from EndFrame
+	void Simulate( void );
+
+private:
+	void SolveBatch( CRope **ppRopes, int iNumRopes, int iNumSamples, int iSubSteps, float flDelta );
+
+	CUtlArray<EHANDLE>	m_hRopes;	// added this frame
+	CUtlArray<CRope*>	m_pActive;	// valid ropes of the current step
+};
+
+extern CRopeSystem g_RopeSystem;
+
+#endif //GAME_SERVER_ENTITIES_ROPE_CROPESYSTEM_H
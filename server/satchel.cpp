@@ -68,7 +68,7 @@ void CSatchelCharge :: Spawn( void )
 	SetTouch( &CSatchelCharge::SatchelSlide );
 	SetUse( &CGrenade::DetonateUse );
 	SetThink( &CSatchelCharge::SatchelThink );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	pev->gravity = 0.5;
 	pev->friction = 0.8;
@@ -112,7 +112,7 @@ void CSatchelCharge::SatchelSlide( CBaseEntity *pOther )
 void CSatchelCharge :: SatchelThink( void )
 {
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if (!IsInWorld())
 	{
@@ -348,7 +348,7 @@ void CSatchel::Holster( void )
 	{
 		m_pPlayer->RemoveWeapon( WEAPON_SATCHEL );
 		SetThink( &CSatchel::DestroyItem );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 }
 
@@ -213,6 +213,10 @@ int CSaveRestoreBuffer :: EntityIndex( EOFFSET eoLookup )
 	return EntityIndex( ENT( eoLookup ) );
 }
 
+// last known table index for each edict, validated on every lookup
+static int	*g_pEntityTableIndex = NULL;
+static int	g_iMaxEntityTableIndex = 0;
+
 int CSaveRestoreBuffer :: EntityIndex( edict_t *pentLookup )
 {
 	if ( !m_pdata || pentLookup == NULL )
@@ -220,12 +224,31 @@ int CSaveRestoreBuffer :: EntityIndex( edict_t *pentLookup )
 
 	int i;
 	ENTITYTABLE *pTable;
+	int e = ENTINDEX( pentLookup );
+
+	if ( e >= 0 && e < g_iMaxEntityTableIndex )
+	{
+		i = g_pEntityTableIndex[e];
+		if ( i >= 0 && i < m_pdata->tableCount && m_pdata->pTable[i].pent == pentLookup )
+			return i;
+	}
 
 	for ( i = 0; i < m_pdata->tableCount; i++ )
 	{
 		pTable = m_pdata->pTable + i;
 		if ( pTable->pent == pentLookup )
+		{
+			if ( e >= g_iMaxEntityTableIndex )
+			{
+				int maxEntities = Q_max( gpGlobals->maxEntities, e + 1 );
+				g_pEntityTableIndex = (int *)realloc( g_pEntityTableIndex, maxEntities * sizeof( int ));
+				memset( g_pEntityTableIndex + g_iMaxEntityTableIndex, 0xFF, ( maxEntities - g_iMaxEntityTableIndex ) * sizeof( int ));
+				g_iMaxEntityTableIndex = maxEntities;
+			}
+
+			if ( e >= 0 ) g_pEntityTableIndex[e] = i;
 			return i;
+		}
 	}
 	return -1;
 }
@@ -238,6 +261,10 @@ edict_t *CSaveRestoreBuffer :: EntityFromIndex( int entityIndex )
 	int i;
 	ENTITYTABLE *pTable;
 
+	// ids are normally the same as table indexes
+	if ( entityIndex < m_pdata->tableCount && m_pdata->pTable[entityIndex].id == entityIndex )
+		return m_pdata->pTable[entityIndex].pent;
+
 	for ( i = 0; i < m_pdata->tableCount; i++ )
 	{
 		pTable = m_pdata->pTable + i;
@@ -303,8 +330,25 @@ unsigned int CSaveRestoreBuffer :: HashString( const char *pszToken )
 	return hash;
 }
 
+// save code passes the same static strings (class and field names) over and over
+// so remember where they were stored. The slot is valid while the table keeps our pointer
+#define TOKEN_CACHE_SIZE	2048	// must be power of two
+
+typedef struct
+{
+	const char	*pszToken;
+	int		index;
+} tokencache_t;
+
+static tokencache_t	g_TokenCache[TOKEN_CACHE_SIZE];
+
 unsigned short CSaveRestoreBuffer :: TokenHash( const char *pszToken )
 {
+	tokencache_t *pCache = &g_TokenCache[((size_t)pszToken >> 2) & (TOKEN_CACHE_SIZE - 1)];
+
+	if ( pCache->pszToken == pszToken && pCache->index < m_pdata->tokenCount && m_pdata->pTokens[pCache->index] == pszToken )
+		return pCache->index;
+
 	unsigned short	hash = (unsigned short)(HashString( pszToken ) % (unsigned)m_pdata->tokenCount );
 	
 #if _DEBUG
@@ -332,6 +376,8 @@ unsigned short CSaveRestoreBuffer :: TokenHash( const char *pszToken )
 		if ( !m_pdata->pTokens[index] || strcmp( pszToken, m_pdata->pTokens[index] ) == 0 )
 		{
 			m_pdata->pTokens[index] = (char *)pszToken;
+			pCache->pszToken = pszToken;
+			pCache->index = index;
 			return index;
 		}
 	}
@@ -660,34 +706,34 @@ int CSave::DoWriteAll( const void *pLeafObject, DATAMAP *pLeafMap, DATAMAP *pCur
 
 int CSave :: WriteFields( const char *pname, const void *pBaseData, DATAMAP *pMap, TYPEDESCRIPTION *pFields, int fieldCount )
 {
-	int i, j, actualCount, emptyCount;
+	int i, j, actualCount;
 	int entityArray[MAX_ENTITYARRAY];
 	TYPEDESCRIPTION *pTest;
+	char *pCount = NULL;
 
-	// Precalculate the number of empty fields
-	emptyCount = 0;
-	for ( i = 0; i < fieldCount; i++ )
+	// Empty fields will not be written, the actual number of written
+	// fields is patched in after the fields are done
+	actualCount = 0;
+
+	if ( m_pdata )
 	{
-		void *pOutputData;
-		pOutputData = ((char *)pBaseData + pFields[i].fieldOffset );
-		if ( DataEmpty( (const char *)pOutputData, pFields[i].fieldSize * gSizes[pFields[i].fieldType] ) )
-			emptyCount++;
+		int size = m_pdata->size;
+		WriteInt( pname, &actualCount, 1 );
+		if ( m_pdata->size == size + 2 * sizeof( short ) + sizeof( int ))
+			pCount = m_pdata->pCurrentData - sizeof( int );
 	}
 
-	// Empty fields will not be written, write out the actual number of fields to be written
-	actualCount = fieldCount - emptyCount;
-	WriteInt( pname, &actualCount, 1 );
-
 	for ( i = 0; i < fieldCount; i++ )
 	{
 		void *pOutputData;
 		pTest = &pFields[ i ];
 		pOutputData = ((char *)pBaseData + pTest->fieldOffset );
 
-		// UNDONE: Must we do this twice?
 		if ( DataEmpty( (const char *)pOutputData, pTest->fieldSize * gSizes[pTest->fieldType] ) )
 			continue;
 
+		actualCount++;
+
 #ifdef _DEBUG
 		// Log( pMap, pname, pTest->fieldName, pTest->fieldType, pOutputData, pTest->fieldSize );
 #endif
@@ -763,6 +809,9 @@ int CSave :: WriteFields( const char *pname, const void *pBaseData, DATAMAP *pMa
 		}
 	}
 
+	if ( pCount )
+		memcpy( pCount, &actualCount, sizeof( int ));
+
 	return 1;
 }
 
@@ -776,7 +825,17 @@ void CSave :: BufferString( char *pdata, int len )
 
 int CSave :: DataEmpty( const char *pdata, int size )
 {
-	for ( int i = 0; i < size; i++ )
+	int i = 0;
+
+	// test by words while possible
+	for ( ; i + (int)sizeof( int ) <= size; i += sizeof( int ))
+	{
+		int word;
+		memcpy( &word, pdata + i, sizeof( int ));
+		if ( word ) return 0;
+	}
+
+	for ( ; i < size; i++ )
 	{
 		if ( pdata[i] )
 			return 0;
@@ -850,6 +909,25 @@ int CRestore::ReadField( const void *pBaseData, DATAMAP *pMap, TYPEDESCRIPTION *
 		{
 			if ( !m_global || !(pTest->flags & FTYPEDESC_GLOBAL) )
 			{
+				switch( pTest->fieldType )
+				{
+				case FIELD_FLOAT:
+				case FIELD_VECTOR:
+				case FIELD_BOOLEAN:
+				case FIELD_INTEGER:
+				case FIELD_SHORT:
+				case FIELD_CHARACTER:
+					// plain data of the same size can be copied at once
+					if ( size == pTest->fieldSize * gSizes[pTest->fieldType] )
+					{
+						memcpy( (char *)pBaseData + pTest->fieldOffset, pData, size );
+						return fieldNumber;
+					}
+					break;
+				default:
+					break;
+				}
+
 				for ( j = 0; j < pTest->fieldSize; j++ )
 				{
 					void *pOutputData = ((char *)pBaseData + pTest->fieldOffset + (j*gSizes[pTest->fieldType]) );
@@ -0,0 +1,69 @@
+/*
+sightcache.h - per-frame cache of line of sight checks
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#ifndef SIGHTCACHE_H
+#define SIGHTCACHE_H
+
+#define SIGHT_CACHE_SIZE	2048	// must be power of two
+#define SIGHT_CACHE_PROBES	8
+#define MAX_SIGHT_QUERIES	256
+
+typedef struct
+{
+	unsigned int	frame;		// entry is valid only for this frame
+	short		entity[2];	// lower entindex is always first
+	Vector		vecEyes[2];	// eye positions the trace was made from
+	BOOL		fVisible;
+} sightentry_t;
+
+typedef struct
+{
+	CBaseEntity	*pLooker;
+	CBaseEntity	*pTarget;
+} sightquery_t;
+
+//-----------------------------------------------------------------------------
+// Purpose: Monsters and clients are ignored by sight traces so the result
+//  of trace between their eyes is the same for both directions. Remember it
+//  until the end of frame to avoid tracing the same pair again.
+//-----------------------------------------------------------------------------
+class CSightCache
+{
+public:
+	CSightCache( void ) { m_iFrame = 0; m_iNumQueries = 0; }
+
+	// traceline from looker eyes to target eyes
+	BOOL		TestVisible( CBaseEntity *pLooker, CBaseEntity *pTarget );
+
+	// batched checks: add them all, then resolve in one pass
+	void		AddQuery( CBaseEntity *pLooker, CBaseEntity *pTarget );
+	void		RunQueries( void );
+
+private:
+	void		CheckFrame( void );
+	BOOL		CanCache( CBaseEntity *pLooker, CBaseEntity *pTarget );
+	sightentry_t	*FindEntry( CBaseEntity *pLooker, CBaseEntity *pTarget, const Vector &vecLooker, const Vector &vecTarget, BOOL &found );
+	BOOL		TraceSight( CBaseEntity *pLooker, const Vector &vecLooker, const Vector &vecTarget );
+
+	sightentry_t	m_entries[SIGHT_CACHE_SIZE];
+	unsigned int	m_iFrame;
+
+	sightquery_t	m_queries[MAX_SIGHT_QUERIES];
+	int		m_iNumQueries;
+};
+
+extern CSightCache	*g_pSightCache;
+
+#endif//SIGHTCACHE_H
@@ -218,7 +218,7 @@ void CAmbientGeneric :: Spawn( void )
 	// start thinking yet.
 
 	SetThink( &CAmbientGeneric::RampThink );
-	pev->nextthink = 0;
+	DontThink();
 
 	// allow on/off switching via 'use' function.
 	SetUse( &CAmbientGeneric::ToggleUse );
@@ -486,7 +486,7 @@ void CAmbientGeneric :: RampThink( void )
 	}
 
 	// update ramps at 5hz
-	pev->nextthink = gpGlobals->time + 0.2;
+	SetNextThink( 0.2 );
 	return;
 }
 
@@ -639,7 +639,7 @@ void CAmbientGeneric :: ToggleUse ( CBaseEntity *pActivator, CBaseEntity *pCalle
 				m_dpv.pitchrun = m_dpv.pitchstart + pitchinc * m_dpv.cspincount;
 				if (m_dpv.pitchrun > 255) m_dpv.pitchrun = 255;
 
-				pev->nextthink = gpGlobals->time + 0.1;
+				SetNextThink( 0.1 );
 			}
 			
 		}
@@ -658,7 +658,7 @@ void CAmbientGeneric :: ToggleUse ( CBaseEntity *pActivator, CBaseEntity *pCalle
 
 				m_dpv.fadeout = m_dpv.fadeoutsav;
 				m_dpv.fadein = 0;
-				pev->nextthink = gpGlobals->time + 0.1;
+				SetNextThink( 0.1 );
 			}
 			else
 			{
@@ -1046,11 +1046,11 @@ void CEnvSound :: Think( void )
 	// not in range. do nothing, fall through to think_fast...
 
 env_sound_Think_fast:
-	pev->nextthink = gpGlobals->time + 0.25;
+	SetNextThink( 0.25 );
 	return;
 
 env_sound_Think_slow:
-	pev->nextthink = gpGlobals->time + 0.75;
+	SetNextThink( 0.75 );
 	return;
 }
 
@@ -1062,7 +1062,7 @@ env_sound_Think_slow:
 void CEnvSound :: Spawn( )
 {
 	// spread think times
-	pev->nextthink = gpGlobals->time + RANDOM_FLOAT(0.0, 0.5); 
+	SetNextThink( RANDOM_FLOAT(0.0, 0.5) ); 
 }
 
 //=====================
@@ -2058,7 +2058,7 @@ void CSpeaker :: Spawn( void )
 	pev->movetype = MOVETYPE_NONE;
 
 	SetThink( &CSpeaker::SpeakerThink );
-	pev->nextthink = 0.0;
+	DontThink();
 
 	// allow on/off switching via 'use' function.
 
@@ -2074,7 +2074,7 @@ void CSpeaker :: Precache( void )
 {
 	if ( !FBitSet (pev->spawnflags, SPEAKER_START_SILENT ) )
 		// set first announcement time for random n second
-		pev->nextthink = gpGlobals->time + RANDOM_FLOAT(5.0, 15.0);
+		SetNextThink( RANDOM_FLOAT(5.0, 15.0) );
 }
 void CSpeaker :: SpeakerThink( void )
 {
@@ -2088,7 +2088,7 @@ void CSpeaker :: SpeakerThink( void )
 	// Wait for the talkmonster to finish first.
 	if (gpGlobals->time <= CTalkMonster::g_talkWaitTime)
 	{
-		pev->nextthink = CTalkMonster::g_talkWaitTime + RANDOM_FLOAT( 5, 10 );
+		SetAbsNextThink( CTalkMonster::g_talkWaitTime + RANDOM_FLOAT( 5, 10 ));
 		return;
 	}
 	
@@ -2119,7 +2119,7 @@ void CSpeaker :: SpeakerThink( void )
 		UTIL_EmitAmbientSound( edict(), GetAbsOrigin(), szSoundFile, flvolume, flattenuation, flags, pitch );
 
 		// shut off and reset
-		pev->nextthink = 0.0;
+		DontThink();
 	}
 	else
 	{
@@ -2129,8 +2129,7 @@ void CSpeaker :: SpeakerThink( void )
 			ALERT(at_console, "Level Design Error!\nSPEAKER has bad sentence group name: %s\n",szSoundFile); 
 
 		// set next announcement time for random 5 to 10 minute delay
-		pev->nextthink = gpGlobals->time + 
-						RANDOM_FLOAT(ANNOUNCE_MINUTES_MIN * 60.0, ANNOUNCE_MINUTES_MAX * 60.0);
+		SetNextThink( RANDOM_FLOAT(ANNOUNCE_MINUTES_MIN * 60.0, ANNOUNCE_MINUTES_MAX * 60.0));
 
 		CTalkMonster::g_talkWaitTime = gpGlobals->time + 5;		// time delay until it's ok to speak: used so that two NPCs don't talk at once
 	}
@@ -2159,14 +2158,14 @@ void CSpeaker :: ToggleUse ( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_
 	if ( useType == USE_ON )
 	{
 		// turn on announcements
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 		return;
 	}
 
 	if ( useType == USE_OFF )
 	{
 		// turn off announcements
-		pev->nextthink = 0.0;
+		DontThink();
 		return;
 	
 	}
@@ -2177,12 +2176,12 @@ void CSpeaker :: ToggleUse ( CBaseEntity *pActivator, CBaseEntity *pCaller, USE_
 	if ( fActive )
 	{
 		// turn off announcements
-		pev->nextthink = 0.0;
+		DontThink();
 	}
 	else 
 	{
 		// turn on announcements
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	} 
 }
 
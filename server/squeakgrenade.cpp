@@ -120,7 +120,7 @@ void CSqueakGrenade :: Spawn( void )
 
 	SetTouch( &CSqueakGrenade::SuperBounceTouch );
 	SetThink( &CSqueakGrenade::HuntThink );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 	m_flNextHunt = gpGlobals->time + 1E6;
 
 	pev->flags |= FL_MONSTER;
@@ -161,7 +161,7 @@ void CSqueakGrenade :: Killed( entvars_t *pevAttacker, int iGib )
 	pev->model = iStringNull;// make invisible
 	SetThink( &CBaseEntity::SUB_Remove );
 	SetTouch( NULL );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	// since squeak grenades never leave a body behind, clear out their takedamage now.
 	// Squeaks do a bit of radius damage when they pop, and that radius damage will
@@ -204,7 +204,7 @@ void CSqueakGrenade::HuntThink( void )
 	}
 	
 	StudioFrameAdvance( );
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	// explode when ready
 	if (gpGlobals->time >= m_flDie)
@@ -497,7 +497,7 @@ void CSqueak::Holster( void )
 	{
 		m_pPlayer->RemoveWeapon( WEAPON_SNARK );
 		SetThink( &CSqueak::DestroyItem );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 		return;
 	}
 	
@@ -0,0 +1,77 @@
+/*
+thinkqueue.h - schedule of entity thinks
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#ifndef THINKQUEUE_H
+#define THINKQUEUE_H
+
+#include <utlarray.h>
+
+#define THINK_HISTORY	32	// frames remembered for think_stats
+
+typedef struct
+{
+	float		time;		// pev->nextthink at the moment of scheduling
+	int		entindex;
+	int		serialnumber;	// to skip entries of freed edicts
+} ThinkEntry_t;
+
+typedef struct
+{
+	unsigned int	frame;
+	float		time;
+	int		due;		// thinks dispatched in this frame
+	int		stale;		// outdated entries dropped
+	int		queued;		// entries left in the queue
+} ThinkStats_t;
+
+//-----------------------------------------------------------------------------
+// Purpose: Keeps the thinking entities ordered by nextthink. The frame pops the
+//  entities that are due and runs their thinks, entities which don't think
+//  cost nothing. pev->nextthink must be changed through SetNextThink,
+//  SetAbsNextThink or DontThink so the queue can see it
+//-----------------------------------------------------------------------------
+class CThinkQueue
+{
+public:
+	CThinkQueue( void ) : m_rgEntries( 256, 256 ) { m_flLastTime = -1.0; m_iCurStats = 0; }
+
+	// forget all the entries and schedule the entities again (time was reset)
+	void		Clear( void );
+
+	// entity changed pev->nextthink
+	void		Schedule( CBaseEntity *pEntity );
+
+	// run thinks of the entities what are due in this frame
+	void		RunThinks( void );
+
+	int		CountQueued( void ) { return m_rgEntries.Count(); }
+	void		ReportStats( void );
+
+private:
+	void		Push( const ThinkEntry_t &entry );
+	void		Pop( ThinkEntry_t &entry );
+	void		Compact( void );
+	CBaseEntity	*EntityForEntry( const ThinkEntry_t &entry );
+
+	CUtlArray<ThinkEntry_t>	m_rgEntries;	// binary min-heap by time
+	CUtlArray<ThinkEntry_t>	m_rgDeferred;	// due entries what can't think in this frame
+	double			m_flLastTime;	// to catch time resets
+	ThinkStats_t		m_stats[THINK_HISTORY];
+	int			m_iCurStats;
+};
+
+extern CThinkQueue	*g_pThinkQueue;
+
+#endif//THINKQUEUE_H
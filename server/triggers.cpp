@@ -497,7 +497,7 @@ void CAutoTrigger::Spawn( void )
 
 void CAutoTrigger::Precache( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 void CAutoTrigger::Think( void )
@@ -798,7 +798,7 @@ void CMultiManager :: ManagerThink ( void )
 	}
 	else
 	{
-		pev->nextthink = m_startTime + m_flTargetDelay[m_index];
+		SetAbsNextThink( m_startTime + m_flTargetDelay[m_index] );
 	}
 }
 
@@ -2136,7 +2136,7 @@ void CTriggerMonsterJump :: Spawn ( void )
 {
 	InitTrigger ();
 
-	pev->nextthink = 0;
+	DontThink();
 	pev->speed = 200;
 	m_flHeight = 150;
 
@@ -2352,7 +2352,7 @@ void CTriggerHurt :: Spawn( void )
 	if (m_bitsDamageInflict & DMG_RADIATION)
 	{
 		SetThink( &CTriggerHurt::RadiationThink );
-		pev->nextthink = gpGlobals->time + RANDOM_FLOAT(0.0, 0.5); 
+		SetNextThink( RANDOM_FLOAT(0.0, 0.5) ); 
 	}
 
 	if ( FBitSet (pev->spawnflags, SF_TRIGGER_HURT_START_OFF) )// if flagged to Start Turned Off, make trigger nonsolid.
@@ -3123,7 +3123,7 @@ void CFireAndDie::Spawn( void )
 void CFireAndDie::Precache( void )
 {
 	// This gets called on restore
-	pev->nextthink = gpGlobals->time + m_flDelay;
+	SetNextThink( m_flDelay );
 }
 
 void CFireAndDie::Think( void )
@@ -3548,7 +3548,7 @@ void NextLevel( void )
 	if (pChange->pev->nextthink < gpGlobals->time)
 	{
 		pChange->SetThink( &CChangeLevel::ExecuteChangeLevel );
-		pChange->pev->nextthink = gpGlobals->time + 0.1;
+		pChange->SetNextThink( 0.1 );
 	}
 }
 
@@ -331,7 +331,7 @@ int CTripmineGrenade :: TakeDamage( entvars_t *pevInflictor, entvars_t *pevAttac
 	if (gpGlobals->time < m_flPowerUp && flDamage < pev->health)
 	{
 		SetThink( &CBaseEntity::SUB_Remove );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 		KillBeam();
 		return FALSE;
 	}
@@ -349,7 +349,7 @@ void CTripmineGrenade::Killed( entvars_t *pevAttacker, int iGib )
 	}
 
 	SetThink( &CTripmineGrenade::DelayDeathThink );
-	pev->nextthink = gpGlobals->time + RANDOM_FLOAT( 0.1, 0.3 );
+	SetNextThink( RANDOM_FLOAT( 0.1, 0.3 ) );
 
 	EMIT_SOUND( ENT(pev), CHAN_BODY, "common/null.wav", 0.5, ATTN_NORM ); // shut off chargeup
 }
@@ -449,7 +449,7 @@ void CTripmine::Holster( void )
 		// out of mines
 		m_pPlayer->RemoveWeapon( WEAPON_TRIPMINE );
 		SetThink( &CBasePlayerItem::DestroyItem );
-		pev->nextthink = gpGlobals->time + 0.1;
+		SetNextThink( 0.1 );
 	}
 
 	SendWeaponAnim( TRIPMINE_HOLSTER );
@@ -34,6 +34,7 @@
 #include "tracemesh.h"
 #include "utldict.h"
 #include "render_api.h"
+#include "profiler.h"
 
 //-----------------------------------------------------------------------------
 // Entity creation factory
@@ -1255,12 +1256,14 @@ void UTIL_ShowMessageAll( const char *pString )
 // Overloaded to add IGNORE_GLASS
 void UTIL_TraceLine( const Vector &vecStart, const Vector &vecEnd, IGNORE_MONSTERS igmon, IGNORE_GLASS ignoreGlass, edict_t *pentIgnore, TraceResult *ptr )
 {
+	PROFILE_SCOPE( PROF_TRACE, pentIgnore ? STRING( pentIgnore->v.classname ) : "UTIL_TraceLine" );
 	TRACE_LINE( vecStart, vecEnd, (igmon == ignore_monsters ? TRUE : FALSE) | (ignoreGlass?0x100:0), pentIgnore, ptr );
 }
 
 
 void UTIL_TraceLine( const Vector &vecStart, const Vector &vecEnd, IGNORE_MONSTERS igmon, edict_t *pentIgnore, TraceResult *ptr )
 {
+	PROFILE_SCOPE( PROF_TRACE, pentIgnore ? STRING( pentIgnore->v.classname ) : "UTIL_TraceLine" );
 	TRACE_LINE( vecStart, vecEnd, (igmon == ignore_monsters ? TRUE : FALSE), pentIgnore, ptr );
 }
 
@@ -1388,6 +1391,7 @@ float UTIL_VecToYaw( const Vector &vec )
 
 void UTIL_SetOrigin( CBaseEntity *pEntity, const Vector &vecOrigin )
 {
+	pEntity->WakeUp();
 	pEntity->SetLocalOrigin( vecOrigin );
 	pEntity->RelinkEntity( TRUE );
 }
@@ -3093,3 +3097,31 @@ void Sys_FreeLibrary( dllhandle_t *handle )
 	FreeLibrary( *handle );
 	*handle = NULL;
 }
+
+/*
+====================
+Sys_DoubleTime
+
+high resolution timer for profiling
+====================
+*/
+double Sys_DoubleTime( void )
+{
+#ifdef _WIN32
+	static LARGE_INTEGER	g_PerformanceFrequency;
+	LARGE_INTEGER		CurrentTime;
+
+	if( !g_PerformanceFrequency.QuadPart )
+		QueryPerformanceFrequency( &g_PerformanceFrequency );
+
+	QueryPerformanceCounter( &CurrentTime );
+
+	return (double)CurrentTime.QuadPart / (double)g_PerformanceFrequency.QuadPart;
+#else
+	struct timespec	ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 0.000000001;
+#endif
+}
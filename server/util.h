@@ -204,6 +204,7 @@ inline BOOL FStringNull(int iString)			{ return iString == iStringNull; }
 bool Sys_LoadLibrary( const char *dllname, dllhandle_t *handle, const dllfunc_t *fcts = NULL );
 void *Sys_GetProcAddress( dllhandle_t handle, const char *name );
 void Sys_FreeLibrary( dllhandle_t *handle );
+double Sys_DoubleTime( void );
 
 #define cchMapNameMost 32
 
@@ -301,6 +302,12 @@ BOOL FClassnameIs( CBaseEntity *pEnt, const char *szClassname );
 extern void DumpEntityNames_f( void );
 extern void DumpEntitySizes_f( void );
 extern void DumpStrings_f( void );
+extern void DumpThinkStats_f( void );
+extern void DumpSleepStats_f( void );
+extern void DumpAILod_f( void );
+extern void ProfileDump_f( void );
+extern void ProfileTrace_f( void );
+extern void ProfileReset_f( void );
 
 extern const char* GetStringForUseType( USE_TYPE useType );
 extern const char* GetStringForState( STATE state );
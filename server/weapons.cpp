@@ -457,7 +457,7 @@ void CBasePlayerItem :: FallInit( void )
 	SetTouch( &CBasePlayerItem::DefaultTouch );
 	SetThink( &CBasePlayerItem::FallThink );
 
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 }
 
 //=========================================================
@@ -469,7 +469,7 @@ void CBasePlayerItem :: FallInit( void )
 //=========================================================
 void CBasePlayerItem::FallThink ( void )
 {
-	pev->nextthink = gpGlobals->time + 0.1;
+	SetNextThink( 0.1 );
 
 	if ( pev->flags & FL_ONGROUND )
 	{
@@ -528,7 +528,7 @@ void CBasePlayerItem::AttemptToMaterialize( void )
 		return;
 	}
 
-	pev->nextthink = gpGlobals->time + time;
+	SetNextThink( time );
 }
 
 //=========================================================
@@ -568,7 +568,7 @@ CBaseEntity* CBasePlayerItem::Respawn( void )
 
 		// not a typo! We want to know when the weapon the player just picked up should respawn! This new entity we created is the replacement,
 		// but when it should respawn is based on conditions belonging to the weapon that was taken.
-		pNewWeapon->pev->nextthink = g_pGameRules->FlWeaponRespawnTime( this );
+		pNewWeapon->SetAbsNextThink( g_pGameRules->FlWeaponRespawnTime( this ));
 	}
 	else
 	{
@@ -706,14 +706,14 @@ void CBasePlayerItem::Drop( void )
 {
 	SetTouch( NULL );
 	SetThink( &CBaseEntity::SUB_Remove );
-	pev->nextthink = gpGlobals->time + .1;
+	SetNextThink( .1 );
 }
 
 void CBasePlayerItem::Kill( void )
 {
 	SetTouch( NULL );
 	SetThink( &CBaseEntity::SUB_Remove);
-	pev->nextthink = gpGlobals->time + .1;
+	SetNextThink( .1 );
 }
 
 void CBasePlayerItem::Holster( void )
@@ -731,7 +731,7 @@ void CBasePlayerItem::AttachToPlayer ( CBasePlayer *pPlayer )
 	pev->modelindex = 0;// server won't send down to clients if modelindex == 0
 	pev->model = iStringNull;
 	pev->owner = pPlayer->edict();
-	pev->nextthink = gpGlobals->time + .1;
+	SetNextThink( .1 );
 
 	SetParent( NULL );
 	SetTouch( NULL );
@@ -1043,7 +1043,7 @@ CBaseEntity* CBasePlayerAmmo::Respawn( void )
 	UTIL_SetOrigin( this, g_pGameRules->VecAmmoRespawnSpot( this ) );// move to wherever I'm supposed to repawn.
 
 	SetThink( &CBasePlayerAmmo::Materialize );
-	pev->nextthink = g_pGameRules->FlAmmoRespawnTime( this );
+	SetAbsNextThink( g_pGameRules->FlAmmoRespawnTime( this ));
 
 	return this;
 }
@@ -1078,7 +1078,7 @@ void CBasePlayerAmmo :: DefaultTouch( CBaseEntity *pOther )
 		{
 			SetTouch( NULL );
 			SetThink( &CBaseEntity::SUB_Remove);
-			pev->nextthink = gpGlobals->time + .1;
+			SetNextThink( .1 );
 		}
 	}
 	else if( gEvilImpulse101 )
@@ -1233,7 +1233,7 @@ void CWeaponBox::Kill( void )
 		while ( pWeapon )
 		{
 			pWeapon->SetThink( &CBaseEntity::SUB_Remove);
-			pWeapon->pev->nextthink = gpGlobals->time + 0.1;
+			pWeapon->SetNextThink( 0.1 );
 			pWeapon = pWeapon->m_pNext;
 		}
 	}
@@ -1540,7 +1540,7 @@ void CLaserSpot::Suspend( float flSuspendTime )
 	pev->effects |= EF_NODRAW;
 	
 	SetThink( &CLaserSpot::Revive );
-	pev->nextthink = gpGlobals->time + flSuspendTime;
+	SetNextThink( flSuspendTime );
 }
 
 //=========================================================
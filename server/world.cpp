@@ -34,6 +34,7 @@
 #include "gamerules.h"
 #include "teamplay_gamerules.h"
 #include "physcallback.h"
+#include "thinkqueue.h"
 
 extern CGraph WorldGraph;
 extern CSoundEnt *pSoundEnt;
@@ -99,10 +100,6 @@ public:
 
 CPhysicNull NullPhysic;
 
-#ifndef USE_PHYSICS_ENGINE
-IPhysicLayer *WorldPhysic = &NullPhysic;
-#endif// USE_PHYSICS_ENGINE
-
 void GameInitNullPhysics( void )
 {
 	WorldPhysic = &NullPhysic;
@@ -268,7 +265,7 @@ void CDecal :: Spawn( void )
 	{
 		SetThink( &CDecal::StaticDecal );
 		// if there's no targetname, the decal will spray itself on as soon as the world is done spawning.
-		pev->nextthink = gpGlobals->time;
+		SetNextThink( 0 );
 	}
 	else
 	{
@@ -644,6 +641,9 @@ void CWorld :: Precache( void )
 	g_pLastSpawn = NULL;
 	g_pWorld = this;	
 
+	// drop the thinks of previous level
+	g_pThinkQueue->Clear();
+
 	if ( pev->gravity > 0.0f )
 		CVAR_SET_FLOAT( "sv_gravity", pev->gravity );
 	else
@@ -794,7 +794,7 @@ void CWorld :: Precache( void )
 			pEntity->SetThink( &CBaseEntity::SUB_CallUseToggle );
 			pEntity->pev->message = pev->netname;
 			pev->netname = 0;
-			pEntity->pev->nextthink = gpGlobals->time + 0.3;
+			pEntity->SetNextThink( 0.3 );
 			pEntity->pev->spawnflags = SF_MESSAGE_ONCE;
 		}
 	}
@@ -105,6 +105,22 @@ entity_t		g_entities[MAX_MAP_ENTITIES];
 dheader_t		*header, outheader;
 long		wadfile;
 
+// LoadBSPFile keeps the file view until WriteBSPFile
+// so the variable-size lumps can reference it directly
+#define MAX_VIEW_LUMPS	16
+
+typedef struct
+{
+	byte		*data;	// NULL when detached
+	int		length;
+} viewlump_t;
+
+static byte	*g_bspview;
+static size_t	g_bspviewsize;
+static bool	g_bspviewmapped;	// false if mapping failed and the file was loaded
+static viewlump_t	g_viewlumps[MAX_VIEW_LUMPS];
+static int	g_numviewlumps;
+
 char		g_wadpath[1024];	// path to wads may be empty
 
 // can be overrided from hlcsg
@@ -266,20 +282,125 @@ void DecompressVis( byte *in, byte *decompressed )
 
 //=============================================================================
 
+/*
+=============
+ViewLump
+
+variable-size lumps are not copied: they point straight
+into the file view until somebody reallocates them
+=============
+*/
+static byte *ViewLump( int ofs, int length )
+{
+	viewlump_t	*vl;
+
+	if( length <= 0 ) return (byte *)Mem_Alloc( length );
+
+	if( g_numviewlumps == MAX_VIEW_LUMPS )
+		COM_FatalError( "LoadBSPFile: MAX_VIEW_LUMPS limit exceeded\n" );
+
+	vl = &g_viewlumps[g_numviewlumps++];
+	vl->data = g_bspview + ofs;
+	vl->length = length;
+
+	return vl->data;
+}
+
+static viewlump_t *FindViewLump( const void *data )
+{
+	if( !data ) return NULL;
+
+	for( int i = 0; i < g_numviewlumps; i++ )
+	{
+		if( g_viewlumps[i].data == data )
+			return &g_viewlumps[i];
+	}
+
+	return NULL;
+}
+
+static void CheckLumpBounds( int lump, int ofs, int length )
+{
+	if( ofs < 0 || length < 0 || (size_t)ofs + (size_t)length > g_bspviewsize )
+		COM_FatalError( "LoadBSPFile: lump %i is out of file bounds\n", lump );
+}
+
+/*
+=============
+ReallocLumpData
+
+same as Mem_Realloc but also accepts lumps that
+still reference the file view
+=============
+*/
+void *ReallocLumpData( void *data, size_t size )
+{
+	viewlump_t	*vl = FindViewLump( data );
+	byte		*mem;
+
+	if( !vl ) return Mem_Realloc( data, size );
+	if( size <= 0 ) return data; // no need to reallocate
+
+	mem = (byte *)Mem_Alloc( size );
+	memcpy( mem, vl->data, Q_min( (size_t)vl->length, size ));
+	vl->data = NULL; // detached from view
+
+	return mem;
+}
+
+/*
+=============
+FreeLumpData
+=============
+*/
+void FreeLumpData( void *data )
+{
+	viewlump_t	*vl = FindViewLump( data );
+
+	if( vl ) vl->data = NULL;
+	else if( data ) Mem_Free( data );
+}
+
+/*
+=============
+ReleaseBSPView
+
+all the lumps that referenced the view
+must be released before this call
+=============
+*/
+static void ReleaseBSPView( void )
+{
+	if( !g_bspview ) return;
+
+	if( g_bspviewmapped )
+		COM_UnmapFile( g_bspview );
+	else Mem_Free( g_bspview, C_FILESYSTEM );
+
+	if( (byte *)header == g_bspview )
+		header = NULL;
+
+	g_bspview = NULL;
+	g_bspviewsize = 0;
+	g_numviewlumps = 0;
+}
+
 int CopyLump( int lump, void *dest, int size )
 {
 	int length = header->lumps[lump].filelen;
 	int ofs = header->lumps[lump].fileofs;
 
+	CheckLumpBounds( lump, ofs, length );
+
 	if( length % size )
 		COM_FatalError( "LoadBSPFile: odd lump size\n" );
 
-	// alloc matched size
+	// big lumps are used in-place
 	if( lump == LUMP_TEXTURES )
-		dest = g_dtexdata = (byte *)Mem_Alloc( length );
-	if( lump == LUMP_LIGHTING )
-		dest = g_dlightdata = (byte *)Mem_Alloc( length );
-	memcpy( dest, (byte *)header + ofs, length );
+		g_dtexdata = ViewLump( ofs, length );
+	else if( lump == LUMP_LIGHTING )
+		g_dlightdata = ViewLump( ofs, length );
+	else memcpy( dest, (byte *)header + ofs, length );
 
 	return length / size;
 }
@@ -291,22 +412,25 @@ static int CopyExtraLump( int lump, void *dest, int size, const dheader_t *heade
 	int length = extrahdr->lumps[lump].filelen;
 	int ofs = extrahdr->lumps[lump].fileofs;
 
+	CheckLumpBounds( lump, ofs, length );
+
 	if( length % size )
 		COM_FatalError( "LoadBSPFile: odd lump size\n" );
 
+	// big lumps are used in-place
 	if( lump == LUMP_LIGHTVECS )
-		dest = g_ddeluxdata = (byte *)Mem_Alloc( length );
-	if( lump == LUMP_SHADOWMAP )
-		dest = g_dshadowdata = (byte *)Mem_Alloc( length );
-	if( lump == LUMP_VERTEX_LIGHT )
-		dest = g_dvlightdata = (byte *)Mem_Alloc( length );
-	if( lump == LUMP_SURFACE_LIGHT )
-		dest = g_dflightdata = (byte *)Mem_Alloc( length );
-	if( lump == LUMP_VERTNORMALS )
-		dest = g_dnormaldata = (byte *)Mem_Alloc( length );
-	if( lump == LUMP_VISLIGHTDATA )
-		dest = g_dvislightdata = (byte *)Mem_Alloc( length );
-	memcpy( dest, (byte *)header + ofs, length );
+		g_ddeluxdata = ViewLump( ofs, length );
+	else if( lump == LUMP_SHADOWMAP )
+		g_dshadowdata = ViewLump( ofs, length );
+	else if( lump == LUMP_VERTEX_LIGHT )
+		g_dvlightdata = ViewLump( ofs, length );
+	else if( lump == LUMP_SURFACE_LIGHT )
+		g_dflightdata = ViewLump( ofs, length );
+	else if( lump == LUMP_VERTNORMALS )
+		g_dnormaldata = ViewLump( ofs, length );
+	else if( lump == LUMP_VISLIGHTDATA )
+		g_dvislightdata = ViewLump( ofs, length );
+	else memcpy( dest, (byte *)header + ofs, length );
 
 	return length / size;
 }
@@ -354,9 +478,18 @@ void LoadBSPFile( const char *filename )
 {
 	size_t	filesize;
 
-	// load the file header
-	header = (dheader_t *)COM_LoadFile( filename, &filesize );
-	if( !header ) COM_FatalError( "couldn't load: %s\n", filename );
+	ReleaseBSPView(); // lumps from a previous load are overwritten below
+
+	// map the file, fallback to loading it when mapping is not possible
+	g_bspview = COM_MapFile( filename, &filesize, false );
+	g_bspviewmapped = ( g_bspview != NULL );
+	if( !g_bspview ) g_bspview = COM_LoadFile( filename, &filesize, false );
+	if( !g_bspview ) COM_FatalError( "couldn't load: %s\n", filename );
+	g_bspviewsize = filesize;
+
+	if( filesize < sizeof( dheader_t ) + sizeof( dextrahdr_t ))
+		COM_FatalError( "%s is too short\n", filename );
+	header = (dheader_t *)g_bspview;
 
 	if( header->version != BSPVERSION )
 		COM_FatalError( "%s is version %i, not %i\n", filename, header->version, BSPVERSION );
@@ -402,17 +535,26 @@ void LoadBSPFile( const char *filename )
 		g_vislightdatasize = CopyExtraLump( LUMP_VISLIGHTDATA, g_dvislightdata, 1, header );
 	}
 
-	Mem_Free( header, C_FILESYSTEM ); // everything has been copied out
+	// the view is released by WriteBSPFile
 }
 
 //============================================================================
 
+static void WriteLumpData( void *data, int len )
+{
+	static byte	pad[4];
+
+	// lump may end at the end of file view, so pad separately
+	SafeWrite( wadfile, data, len );
+	if( len & 3 ) SafeWrite( wadfile, pad, 4 - ( len & 3 ));
+}
+
 void AddLump( int lumpnum, void *data, int len )
 {
 	dlump_t *lump = &header->lumps[lumpnum];
 	lump->fileofs = tell( wadfile );
 	lump->filelen = len;
-	SafeWrite( wadfile, data, (len + 3) & ~3 );
+	WriteLumpData( data, len );
 }
 
 static void AddExtraLump( int lumpnum, void *data, int len, dextrahdr_t *header )
@@ -420,7 +562,7 @@ static void AddExtraLump( int lumpnum, void *data, int len, dextrahdr_t *header
 	dlump_t* lump = &header->lumps[lumpnum];
 	lump->fileofs = tell( wadfile );
 	lump->filelen = len;
-	SafeWrite( wadfile, data, (len + 3) & ~3 );
+	WriteLumpData( data, len );
 }
 
 void AddLumpClipnodes( int lumpnum )
@@ -453,13 +595,17 @@ void AddLumpClipnodes( int lumpnum )
 =============
 WriteBSPFile
 
-Swaps the bsp file in place, so it should not be referenced again
+Swaps the bsp file in place, so it should not be referenced again.
+Untouched lumps are written straight from the file view, so the
+output goes to a temporary file that replaces the source at the end
 =============
 */
 void WriteBSPFile( const char *filename )
 {		
 	dextrahdr_t	outextrahdr;
 	dextrahdr_t	*extrahdr;
+	char		tempname[1024];
+	const char	*outname = filename;
 
 	header = &outheader;
 	memset( header, 0, sizeof( dheader_t ));
@@ -470,7 +616,13 @@ void WriteBSPFile( const char *filename )
 	extrahdr->id = IDEXTRAHEADER;
 	extrahdr->version = EXTRA_VERSION;
 	
-	wadfile = SafeOpenWrite( filename );
+	if( g_bspview )
+	{
+		Q_snprintf( tempname, sizeof( tempname ), "%s.tmp", filename );
+		outname = tempname;
+	}
+
+	wadfile = SafeOpenWrite( outname );
 	SafeWrite( wadfile, header, sizeof( dheader_t ));		// overwritten later
 	SafeWrite( wadfile, extrahdr, sizeof( dextrahdr_t ));	// overwritten later
 
@@ -508,14 +660,14 @@ void WriteBSPFile( const char *filename )
 
 	close( wadfile );	
 
-	if( g_dvislightdata ) Mem_Free( g_dvislightdata );
-	if( g_dlightdata ) Mem_Free( g_dlightdata );
-	if( g_ddeluxdata ) Mem_Free( g_ddeluxdata );
-	if( g_dshadowdata ) Mem_Free( g_dshadowdata );
-	if( g_dvlightdata ) Mem_Free( g_dvlightdata );
-	if( g_dflightdata ) Mem_Free( g_dflightdata );
-	if( g_dnormaldata ) Mem_Free( g_dnormaldata );
-	if( g_dtexdata ) Mem_Free( g_dtexdata );
+	FreeLumpData( g_dvislightdata );
+	FreeLumpData( g_dlightdata );
+	FreeLumpData( g_ddeluxdata );
+	FreeLumpData( g_dshadowdata );
+	FreeLumpData( g_dvlightdata );
+	FreeLumpData( g_dflightdata );
+	FreeLumpData( g_dnormaldata );
+	FreeLumpData( g_dtexdata );
 
 	g_dvislightdata = NULL;
 	g_dlightdata = NULL;
@@ -525,6 +677,16 @@ void WriteBSPFile( const char *filename )
 	g_dflightdata = NULL;
 	g_dnormaldata = NULL;
 	g_dtexdata = NULL;
+
+	if( outname != filename )
+	{
+		// source is no longer referenced, so it can be replaced
+		ReleaseBSPView();
+		remove( filename );
+
+		if( rename( outname, filename ) != 0 )
+			COM_FatalError( "couldn't rename %s to %s\n", outname, filename );
+	}
 }
 
 //============================================================================
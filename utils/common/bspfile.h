@@ -213,6 +213,8 @@ int CompressVis( const byte *src, const uint src_length, byte *dest, uint dest_l
 
 void LoadBSPFile( const char *filename );
 void WriteBSPFile( const char *filename );
+void *ReallocLumpData( void *data, size_t size );
+void FreeLumpData( void *data );
 void PrintBSPFileSizes( void );
 
 const char *ContentsToString( int type );
@@ -121,6 +121,9 @@ void COM_FatalError( const char *error, ... )
 	_vsnprintf( message, sizeof( message ), error, argptr );
 	va_end( argptr );
 
+	// show what the failed job has printed so far
+	Sys_FlushCapture( Sys_EndCapture( ));
+
 	Msg( "^1Fatal Error:^7 %s", message );
 	exit( 1 );
 }
@@ -141,6 +144,8 @@ void COM_Assert( const char *error, ... )
 	_vsnprintf( message, sizeof( message ), error, argptr );
 	va_end( argptr );
 
+	Sys_FlushCapture( Sys_EndCapture( ));
+
 	Msg( "^1assert failed at:^7 %s", message );
 	exit( 1 );
 }
@@ -85,6 +85,21 @@ void Mem_Free( void *ptr, unsigned int target = C_COMMON );
 size_t Mem_Size( void *ptr );
 void Mem_Check( void );
 void Mem_Peak( void );
+void Mem_ThreadInit( int slot );
+void Mem_ResetArenas( void );
+void Mem_ResetThreadArena( void );
+
+typedef struct
+{
+	long		active;
+	long		peakactive;
+	long		catactive[C_MAXSTAT];
+	long		catpeak[C_MAXSTAT];
+} memstats_t;
+
+extern const char *c_stats[];
+
+void Mem_GetStats( memstats_t *stats );
 
 //
 // basefs.c
@@ -19,6 +19,7 @@ GNU General Public License for more details.
 #include <basetypes.h>
 #include "stringlib.h"
 #include "conprint.h"
+#include "threads.h"
 
 #define IsColorString( p )		( p && *( p ) == '^' && *(( p ) + 1) && *(( p ) + 1) >= '0' && *(( p ) + 1 ) <= '9' )
 #define ColorIndex( c )		((( c ) - '0' ) & 7 )
@@ -92,6 +93,86 @@ void Sys_PrintLog( const char *pMsg )
 	fflush( logfile );
 }
 
+static THREAD_LOCAL msgbuf_t	*t_capture;
+
+void Sys_Print( const char *pMsg );
+
+/*
+================
+Sys_BeginCapture
+
+messages of the calling thread goes into the buffer
+================
+*/
+void Sys_BeginCapture( msgbuf_t *buf )
+{
+	t_capture = buf;
+}
+
+msgbuf_t *Sys_EndCapture( void )
+{
+	msgbuf_t	*buf = t_capture;
+
+	t_capture = NULL;
+
+	return buf;
+}
+
+msgbuf_t *Sys_GetCapture( void )
+{
+	return t_capture;
+}
+
+static void Sys_AppendCapture( msgbuf_t *buf, const char *pMsg )
+{
+	size_t	len = Q_strlen( pMsg );
+
+	while( InterlockedCompareExchange( &buf->lock, 1, 0 ) != 0 )
+		Sleep( 0 );
+
+	if( buf->len + len + 1 > buf->maxlen )
+	{
+		size_t	maxlen = buf->maxlen ? buf->maxlen * 2 : 4096;
+		char	*text;
+
+		while( maxlen < buf->len + len + 1 )
+			maxlen *= 2;
+
+		// on failure the message is dropped
+		if(( text = (char *)realloc( buf->text, maxlen )) != NULL )
+		{
+			buf->text = text;
+			buf->maxlen = maxlen;
+		}
+	}
+
+	if( buf->len + len + 1 <= buf->maxlen )
+	{
+		memcpy( buf->text + buf->len, pMsg, len + 1 );
+		buf->len += len;
+	}
+
+	InterlockedExchange( &buf->lock, 0 );
+}
+
+/*
+================
+Sys_FlushCapture
+
+print the collected text and release the buffer,
+must be called when nobody appends to it
+================
+*/
+void Sys_FlushCapture( msgbuf_t *buf )
+{
+	if( !buf || !buf->text )
+		return;
+
+	Sys_Print( buf->text );
+	free( buf->text );
+	memset( buf, 0, sizeof( *buf ));
+}
+
 /*
 ================
 Sys_Print
@@ -106,6 +187,12 @@ void Sys_Print( const char *pMsg )
 	unsigned long cbWritten;
 	char *pTemp = tmpBuf;
 
+	if( t_capture && pMsg )
+	{
+		Sys_AppendCapture( t_capture, pMsg );
+		return;
+	}
+
 	while( pMsg && *pMsg )
 	{
 		if( IsColorString( pMsg ))
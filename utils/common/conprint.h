@@ -30,4 +30,19 @@ void Sys_CloseLog( void );
 void Sys_PrintLog( const char *pMsg );
 void Sys_IgnoreLog( bool ignore );
 
+// output of a worker thread can be collected and printed
+// later from the main thread, so the jobs are not mixed
+typedef struct
+{
+	char		*text;
+	size_t		len;
+	size_t		maxlen;
+	volatile long	lock;		// tasks of the worker are appending too
+} msgbuf_t;
+
+void Sys_BeginCapture( msgbuf_t *buf );
+msgbuf_t *Sys_EndCapture( void );
+msgbuf_t *Sys_GetCapture( void );
+void Sys_FlushCapture( msgbuf_t *buf );
+
 #endif//CONRPINT_H
\ No newline at end of file
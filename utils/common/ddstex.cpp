@@ -28,8 +28,10 @@ GNU General Public License for more details.
 #include "ddstex.h"
 #include "squish.h"
 #include "mathlib.h"
+#include "threads.h"
 
 #define BLOCK_SIZE			( 4 * 4 )	// DXT block size quad 4x4 pixels
+#define DXT_MIN_THREADED_BLOCKS	256		// 64x64 pixels and above
 #define RGB_TO_YCOCG_Y( r, g, b )	(((  r +   (g<<1) +  b     ) + 2 ) >> 2 )
 #define RGB_TO_YCOCG_CO( r, g, b )	((( (r<<1)-(b<<1) ) + 2 ) >> 2 )
 #define RGB_TO_YCOCG_CG( r, g, b )	((( -r +   (g<<1) -  b     ) + 2 ) >> 2 )
@@ -46,6 +48,9 @@ typedef enum
 	PF_ATI2_NORM_PARABOLOID,
 } saveformat_t;
 
+int	g_dxtquality = DXT_QUALITY_HIGH;
+char	g_dxtcache[256];	// folder for already compressed images, empty if disabled
+
 /*
 ========================
 ExtractBlock
@@ -156,89 +161,152 @@ inline static void NormalizeBlock( byte *colorBlock, int format )
 
 /*
 ========================
-CompressYCoCgDXT5HQ
+Image_DXTGetCompressFlags
+
+params:	format		- saveformat
+paramO:	typeString	- readable name of the format
+========================
+*/
+static int Image_DXTGetCompressFlags( int format, const char **typeString )
+{
+	int	fitFlags, flags = 0;
+
+	switch( g_dxtquality )
+	{
+	case DXT_QUALITY_FAST:
+		fitFlags = squish::kColourRangeFit;
+		break;
+	case DXT_QUALITY_NORMAL:
+		fitFlags = squish::kColourClusterFit;
+		break;
+	default:
+		fitFlags = squish::kColourIterativeClusterFit;
+		break;
+	}
+
+	switch( format )
+	{
+	case PF_DXT5_YCoCg:
+		SetBits( flags, squish::kDxt5 | fitFlags );
+		*typeString = "DXT5 YCoCg";
+		break;
+	case PF_DXT5_NORM_BASE:
+		SetBits( flags, squish::kDxt5 | fitFlags );
+		*typeString = "DXT5 NormXYZ Base";
+		break;
+	case PF_ATI2_NORM_PARABOLOID:
+		SetBits( flags, squish::kAti2 );
+		*typeString = "ATI2 NormAG Paraboloid";
+		break;
+	case PF_DXT5:
+		SetBits( flags, squish::kDxt5 | fitFlags );
+		*typeString = "DXT5 RGB";
+		break;
+	case PF_DXT5_ALPHA:
+	case PF_DXT5_SDF_ALPHA:
+		SetBits( flags, squish::kDxt5 | fitFlags | squish::kWeightColourByAlpha );
+		*typeString = "DXT5 RGBA";
+		break;
+	case PF_DXT1:
+		SetBits( flags, squish::kDxt1 | fitFlags );
+		*typeString = "DXT1 RGB";
+		break;
+	}
+
+	return flags;
+}
+
+/*
+========================================================================
+
+Block-parallel compression. Every 4x4 block is independent
+so each thread compress it into own slot of the output buffer
+
+========================================================================
+*/
+typedef struct
+{
+	const byte	*inBuf;		// source mip level
+	byte		*outBuf;		// compressed blocks
+	int		width;
+	int		blocksWide;
+	int		format;
+	int		flags;
+	size_t		blockSize;	// compressed block size
+} dxtwork_t;
+
+static dxtwork_t	g_dxtwork;
+
+static void CompressDXTBlock( int blocknum, int threadnum )
+{
+	ALIGN16 byte	block[64];
+	const dxtwork_t	*work = &g_dxtwork;
+	int		bx = blocknum % work->blocksWide;
+	int		by = blocknum / work->blocksWide;
+
+	ExtractBlock( work->inBuf + ( by * work->width * BLOCK_SIZE ) + ( bx * 16 ), work->width, block );
+
+	if( work->format == PF_DXT5_YCoCg )
+		ScaleYCoCg( block );
+	else if( work->format >= PF_DXT5_NORM_BASE && work->format <= PF_ATI2_NORM_PARABOLOID )
+		NormalizeBlock( block, work->format );
+
+	squish::Compress( block, work->outBuf + blocknum * work->blockSize, work->flags, NULL );
+}
+
+/*
+========================
+CompressRGBABufferToDXT
 
 params:	inBuf		- image to compress
-paramO:	outBuf		- result of compression
+paramO:	f		- result of compression
 params:	width		- width of image
 params:	height		- height of image
 ========================
 */
-inline static void CompressRGBABufferToDXT( const byte *inBuf, vfile_t *f, int width, int height, int format, bool estimate )
+static void CompressRGBABufferToDXT( const byte *inBuf, vfile_t *f, int width, int height, int format, bool estimate )
 {
-	ALIGN16 byte	block[64];
-	ALIGN16 byte	outBlock[16];
-	float		metricsRGB[3] = { 0.2126f, 0.7152f, 0.0722f };
 	const char	*typeString = NULL;
-	float		*metrics = NULL;
 	double		start, end;
-	int		flags = 0;
+	int		numBlocks;
 	char		str[64];
 
 	start = I_FloatTime();
 
-	for( int j = 0; j < height; j += 4, inBuf += width * BLOCK_SIZE )
-	{
-		for( int i = 0; i < width; i += 4 )
-		{
-			ExtractBlock( inBuf + i * 4, width, block );
-
-			if( format == PF_DXT5_YCoCg )
-			{
-				SetBits( flags, squish::kDxt5 | squish::kColourIterativeClusterFit );
-				typeString = "DXT5 YCoCg";
-				ScaleYCoCg( block );
-			}
-			else if( format >= PF_DXT5_NORM_BASE && format <= PF_ATI2_NORM_PARABOLOID )
-			{
-				switch( format )
-				{
-				case PF_DXT5_NORM_BASE:
-					typeString = "DXT5 NormXYZ Base";
-					SetBits( flags, squish::kDxt5 | squish::kColourIterativeClusterFit );
-					break;
-				case PF_ATI2_NORM_PARABOLOID:
-					typeString = "ATI2 NormAG Paraboloid";
-					SetBits( flags, squish::kAti2 );
-					break;
-				}
+	g_dxtwork.inBuf = inBuf;
+	g_dxtwork.width = width;
+	g_dxtwork.blocksWide = ( width + 3 ) / 4;
+	g_dxtwork.format = format;
+	g_dxtwork.flags = Image_DXTGetCompressFlags( format, &typeString );
+	g_dxtwork.blockSize = Image_DXTGetBlockSize( format );
 
-				NormalizeBlock( block, format );
-			}
-			else if( format == PF_DXT5 )
-			{
-				SetBits( flags, squish::kDxt5 | squish::kColourIterativeClusterFit );
-				typeString = "DXT5 RGB";
-			}
-			else if( format == PF_DXT5_ALPHA || format == PF_DXT5_SDF_ALPHA )
-			{
-				SetBits( flags, squish::kDxt5 | squish::kColourIterativeClusterFit | squish::kWeightColourByAlpha );
-				typeString = "DXT5 RGBA";
-			}
-			else if( format == PF_DXT1 )
-			{
-				SetBits( flags, squish::kDxt1 | squish::kColourIterativeClusterFit );
-				typeString = "DXT1 RGB";
-			}
+	numBlocks = g_dxtwork.blocksWide * (( height + 3 ) / 4 );
+	g_dxtwork.outBuf = (byte *)Mem_Alloc( numBlocks * g_dxtwork.blockSize );
 
-			squish::Compress( block, outBlock, flags, metrics );
-			VFS_Write( f, outBlock, Image_DXTGetBlockSize( format ));
+	if( g_numthreads == -1 )
+		ThreadSetDefault();
 
-			if( estimate )
-			{
-				Sys_IgnoreLog( true );
-				Msg( "\rcompress %s: %2d%%", typeString, ( j * width + i ) * 100 / ( width * height ) );
-				Sys_IgnoreLog( false );
-			}
-		}
+	// small mips are not worth the thread startup
+	if( g_numthreads > 1 && numBlocks >= DXT_MIN_THREADED_BLOCKS )
+	{
+		RunThreadsOnIndividual( numBlocks, false, CompressDXTBlock );
+	}
+	else
+	{
+		for( int i = 0; i < numBlocks; i++ )
+			CompressDXTBlock( i, 0 );
 	}
 
+	// blocks are stored in the same order as serial compressor wrote them
+	VFS_Write( f, g_dxtwork.outBuf, numBlocks * g_dxtwork.blockSize );
+	Mem_Free( g_dxtwork.outBuf );
+	memset( &g_dxtwork, 0, sizeof( g_dxtwork ));
+
 	end = I_FloatTime();
 	Q_timestring((int)(end - start), str );
 
 	if( estimate )
 	{
-		Msg( "\r" );
 		Msg( "compress %s: 100%%. %s elapsed\n", typeString, str );
 	}
 }
@@ -729,12 +797,88 @@ static size_t CompressDXT( vfile_t *f, const byte *buffer, int width, int height
 	return true;
 }
 
+/*
+=============
+Image_DXTCacheName
+
+build cache filename from the image contents and
+all the parameters that affects to the compressed result
+=============
+*/
+static void Image_DXTCacheName( rgbdata_t *pix, int saveformat, int numSides, char *out, size_t size )
+{
+	size_t	bufsize = pix->width * pix->height * 4 * numSides;
+	dword	crc, hash = 2166136261U; // FNV-1a as secondary key
+	dword	params[6];
+
+	params[0] = pix->width;
+	params[1] = pix->height;
+	params[2] = pix->flags & ( IMAGE_CUBEMAP|IMAGE_SKYBOX|IMAGE_NOMIPS );
+	params[3] = saveformat;
+	params[4] = g_dxtquality;
+	Image_PackRGB( pix->reflectivity, params[5] );
+
+	CRC32_Init( &crc );
+	CRC32_ProcessBuffer( &crc, params, sizeof( params ));
+	CRC32_ProcessBuffer( &crc, pix->buffer, bufsize );
+	CRC32_Final( &crc );
+
+	for( size_t i = 0; i < bufsize; i++ )
+		hash = ( hash ^ pix->buffer[i] ) * 16777619U;
+
+	Q_snprintf( out, size, "%s/%08x%08x.dds", g_dxtcache, crc, hash );
+}
+
+static rgbdata_t *Image_DXTCreatePic( rgbdata_t *pix, const byte *buffer, size_t size )
+{
+	// create a new pic
+	rgbdata_t *out = (rgbdata_t *)Mem_Alloc( sizeof( rgbdata_t ) + size );
+	out->buffer = ((byte *)out) + sizeof( rgbdata_t ); 
+	memcpy( out->buffer, buffer, size );
+
+	out->width = pix->width;
+	out->height = pix->height;
+	out->size = size;
+
+	SetBits( out->flags, IMAGE_HAS_COLOR );
+	SetBits( out->flags, IMAGE_DXT_FORMAT );
+
+	if( FBitSet( pix->flags, IMAGE_CUBEMAP ))
+		SetBits( out->flags, IMAGE_CUBEMAP );
+
+	if( FBitSet( pix->flags, IMAGE_SKYBOX ))
+		SetBits( out->flags, IMAGE_SKYBOX );
+
+	return out;
+}
+
+static rgbdata_t *Image_DXTLoadFromCache( rgbdata_t *pix, const char *cachename )
+{
+	rgbdata_t	*out = NULL;
+	size_t	filesize;
+	byte	*buffer;
+
+	buffer = COM_LoadFile( cachename, &filesize, false );
+	if( !buffer ) return NULL;
+
+	if( filesize > sizeof( dds_t ) && ((dds_t *)buffer)->dwIdent == DDSHEADER )
+	{
+		MsgDev( D_REPORT, "BufferToDDS: %s reused\n", cachename );
+		out = Image_DXTCreatePic( pix, buffer, filesize );
+	}
+
+	Mem_Free( buffer, C_FILESYSTEM );
+
+	return out;
+}
+
 rgbdata_t *BufferToDDS( rgbdata_t *pix, int saveformat )
 {
 	vfile_t	*file;	// virtual file
 	rgbdata_t	*out = NULL;
 	rgbdata_t	*mip = NULL;
 	bool	normalMap = (saveformat >= PF_DXT5_NORM_BASE && saveformat <= PF_ATI2_NORM_PARABOLOID) ? true : false;
+	char	cachename[512];
 	int	width, height;
 	int	nummips = 1;
 	int	numSides = 1;
@@ -748,6 +892,17 @@ rgbdata_t *BufferToDDS( rgbdata_t *pix, int saveformat )
 	if(( pix->width & 15 ) || ( pix->height & 15 ))
 		return NULL; // not aligned by 16
 
+	if( FBitSet( pix->flags, IMAGE_CUBEMAP|IMAGE_SKYBOX ))
+		numSides = 6;
+
+	if( g_dxtcache[0] )
+	{
+		// same image with same settings was already compressed
+		Image_DXTCacheName( pix, saveformat, numSides, cachename, sizeof( cachename ));
+		if(( out = Image_DXTLoadFromCache( pix, cachename )) != NULL )
+			return out;
+	}
+
 	file = VFS_Create( NULL, 0 );
 	if( !file ) return NULL;
 
@@ -762,9 +917,6 @@ rgbdata_t *BufferToDDS( rgbdata_t *pix, int saveformat )
 
 	mip = Image_Copy( pix );
 
-	if( FBitSet( pix->flags, IMAGE_CUBEMAP|IMAGE_SKYBOX ))
-		numSides = 6;
-
 	for( int i = 0; i < numSides; i++ )
 	{
 		byte	*buffer = mip->buffer + ((pix->width * pix->height * 4) * i);
@@ -791,23 +943,10 @@ rgbdata_t *BufferToDDS( rgbdata_t *pix, int saveformat )
 
 	Mem_Free( mip );
 
-	// create a new pic
-	out = (rgbdata_t *)Mem_Alloc( sizeof( rgbdata_t ) + VFS_Tell( file ));
-	out->buffer = ((byte *)out) + sizeof( rgbdata_t ); 
-	memcpy( out->buffer, VFS_GetBuffer( file ), VFS_Tell( file ));
-
-	out->width = pix->width;
-	out->height = pix->height;
-	out->size = VFS_Tell( file );
-
-	SetBits( out->flags, IMAGE_HAS_COLOR );
-	SetBits( out->flags, IMAGE_DXT_FORMAT );
-
-	if( FBitSet( pix->flags, IMAGE_CUBEMAP ))
-		SetBits( out->flags, IMAGE_CUBEMAP );
+	out = Image_DXTCreatePic( pix, VFS_GetBuffer( file ), VFS_Tell( file ));
 
-	if( FBitSet( pix->flags, IMAGE_SKYBOX ))
-		SetBits( out->flags, IMAGE_SKYBOX );
+	if( g_dxtcache[0] )
+		COM_SaveFile( cachename, out->buffer, out->size, false );
 
 	// release virtual file
 	VFS_Close( file );
@@ -16,6 +16,14 @@ GNU General Public License for more details.
 #ifndef DDSTEX_H
 #define DDSTEX_H
 
+// compression quality
+#define DXT_QUALITY_FAST		0	// range fit, for quick previews
+#define DXT_QUALITY_NORMAL		1	// single pass cluster fit
+#define DXT_QUALITY_HIGH		2	// iterative cluster fit
+
+extern int	g_dxtquality;
+extern char	g_dxtcache[256];
+
 rgbdata_t *DDSToBuffer( const char *name, const byte *buffer, size_t filesize );
 rgbdata_t *DDSToRGBA( const char *name, const byte *buffer, size_t filesize );
 rgbdata_t *BufferToDDS( rgbdata_t *pix, int saveformat );
@@ -316,6 +316,64 @@ byte *COM_LoadFile( const char *filepath, size_t *filesize, bool safe )
 	return buf;	
 }
 
+/*
+==================
+COM_MapFile
+
+maps the whole file copy-on-write: pages are read
+on demand and any writes stay private to the process
+==================
+*/
+byte *COM_MapFile( const char *filepath, size_t *filesize, bool safe )
+{
+	HANDLE	file, mapping;
+	DWORD	size;
+	byte	*view = NULL;
+
+	if( filesize ) *filesize = 0;
+
+	file = CreateFile( filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if( file == INVALID_HANDLE_VALUE )
+	{
+		if( safe ) COM_FatalError( "Couldn't open %s\n", filepath );
+		return NULL;
+	}
+
+	size = GetFileSize( file, NULL );
+
+	// empty files can't be mapped
+	if( size != 0 && size != INVALID_FILE_SIZE )
+	{
+		mapping = CreateFileMapping( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+
+		if( mapping != NULL )
+		{
+			view = (byte *)MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 );
+			CloseHandle( mapping ); // view holds the section
+		}
+	}
+	CloseHandle( file );
+
+	if( !view )
+	{
+		if( safe ) COM_FatalError( "Couldn't map %s\n", filepath );
+		return NULL;
+	}
+
+	if( filesize ) *filesize = size;
+	return view;
+}
+
+/*
+==================
+COM_UnmapFile
+==================
+*/
+void COM_UnmapFile( byte *view )
+{
+	if( view ) UnmapViewOfFile( view );
+}
+
 bool COM_SaveFile( const char *filepath, void *buffer, size_t filesize, bool safe )
 {
 	long		handle;
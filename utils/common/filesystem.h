@@ -82,6 +82,8 @@ search_t *COM_Search( const char *pattern, int caseinsensitive, wfile_t *source_
 search_t *FS_Search( const char *pattern, int caseinsensitive, int gamedironly );
 byte *COM_LoadFile( const char *filepath, size_t *filesize, bool safe = true );
 bool COM_SaveFile( const char *filepath, void *buffer, size_t filesize, bool safe = true );
+byte *COM_MapFile( const char *filepath, size_t *filesize, bool safe = true );
+void COM_UnmapFile( byte *view );
 long COM_FileTime( const char *filename );
 bool COM_FolderExists( const char *path );
 bool COM_FileExists( const char *path );
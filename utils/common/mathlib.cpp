@@ -13,6 +13,13 @@
 #include "mathlib.h"
 #include "bspfile.h"
 
+// SSE2 only for double: it produces exactly the same dot products
+// as the scalar code, while single precision would not match x87
+#if defined( DOUBLEVEC_T ) && ( defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ))
+#define MATHLIB_SSE2
+#include <emmintrin.h>
+#endif
+
 vec3_t vec3_origin = { 0, 0, 0 };
 
 #define IA		16807
@@ -411,6 +418,69 @@ int SignbitsForPlane( const vec3_t normal )
 	return bits;
 }
 
+/*
+=================
+ClassifyPointsEpsilon
+
+computes the plane distance and side of each point. The
+arrays must have room for numpoints + 1 entries, the last
+one repeats the first point so clippers can check i + 1
+=================
+*/
+void ClassifyPointsEpsilon( const vec3_t *points, int numpoints, const vec3_t normal, vec_t dist, vec_t epsilon, vec_t *dists, int *sides, int *counts )
+{
+	int	i = 0;
+
+#ifdef MATHLIB_SSE2
+	__m128d	nx = _mm_set1_pd( normal[0] );
+	__m128d	ny = _mm_set1_pd( normal[1] );
+	__m128d	nz = _mm_set1_pd( normal[2] );
+	__m128d	d = _mm_set1_pd( dist );
+	__m128d	eps = _mm_set1_pd( epsilon );
+	__m128d	neps = _mm_set1_pd( -epsilon );
+
+	// two points per iteration, same operation order as DotProduct
+	for( ; i + 1 < numpoints; i += 2 )
+	{
+		__m128d	x = _mm_set_pd( points[i+1][0], points[i][0] );
+		__m128d	y = _mm_set_pd( points[i+1][1], points[i][1] );
+		__m128d	z = _mm_set_pd( points[i+1][2], points[i][2] );
+		__m128d	dot = _mm_add_pd( _mm_add_pd( _mm_mul_pd( x, nx ), _mm_mul_pd( y, ny )), _mm_mul_pd( z, nz ));
+
+		dot = _mm_sub_pd( dot, d );
+		_mm_storeu_pd( &dists[i], dot );
+
+		int front = _mm_movemask_pd( _mm_cmpgt_pd( dot, eps ));
+		int back = _mm_movemask_pd( _mm_cmplt_pd( dot, neps ));
+
+		// front wins over back like in the scalar code
+		sides[i+0] = ( 1 - ( front & 1 )) * ( 2 - ( back & 1 ));
+		sides[i+1] = ( 1 - ( front >> 1 )) * ( 2 - ( back >> 1 ));
+	}
+#endif
+	for( ; i < numpoints; i++ )
+	{
+		vec_t	dot = DotProduct( points[i], normal );
+
+		dot -= dist;
+		dists[i] = dot;
+
+		if( dot > epsilon )
+			sides[i] = SIDE_FRONT;
+		else if( dot < -epsilon )
+			sides[i] = SIDE_BACK;
+		else sides[i] = SIDE_ON;
+	}
+
+	counts[0] = counts[1] = counts[2] = 0;
+
+	for( i = 0; i < numpoints; i++ )
+		counts[sides[i]]++;
+
+	sides[i] = sides[0];
+	dists[i] = dists[0];
+}
+
 //
 // bounds operations
 //
@@ -236,6 +236,7 @@ void SinCos( float radians, float *sine, float *cosine );
 uint VertexHashKey( const vec3_t point, uint hashSize );
 int PlaneTypeForNormal( const vec3_t normal );
 int SignbitsForPlane( const vec3_t normal );
+void ClassifyPointsEpsilon( const vec3_t *points, int numpoints, const vec3_t normal, vec_t dist, vec_t epsilon, vec_t *dists, int *sides, int *counts );
 float RandomFloat( float flLow, float flHigh );
 float ColorNormalize( const vec3_t in, vec3_t out );
 unsigned short FloatToHalf( float v );
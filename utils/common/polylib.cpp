@@ -367,79 +367,31 @@ winding_t *BaseWindingForPlane( const vec3_t normal, vec_t dist )
 	return w;	
 }
 
+// clipping results are built here before they are known to survive
+typedef struct
+{
+	int	numpoints;
+	vec3_t	p[MAX_POINTS_ON_WINDING+4];
+} stackwinding_t;
+
 /*
 =============
-ClipWindingEpsilon
+SplitWindingEpsilon
+
+builds the front and back parts of a winding that was classified
+by ClassifyPointsEpsilon. Either of the parts may be NULL
 =============
 */
-void ClipWindingEpsilon( winding_t *in, const vec3_t normal, vec_t dist, vec_t epsilon, winding_t **front, winding_t **back, bool keepon )
+static void SplitWindingEpsilon( const winding_t *in, const vec3_t normal, vec_t dist, vec_t epsilon, const vec_t *dists, const int *sides, stackwinding_t *f, stackwinding_t *b, const char *caller )
 {
-	vec_t	dists[MAX_POINTS_ON_WINDING+4];
-	int	sides[MAX_POINTS_ON_WINDING+4];
-	int	counts[3];
+	int	maxpts = in->numpoints + 4;	// cant use counts[0] + 2 because of fp grouping errors
+	const vec_t	*p1, *p2;
+	vec3_t	mid;
 	vec_t	dot;
 	int	i, j;
-	vec_t	*p1, *p2;
-	vec3_t	mid;
-	winding_t	*f, *b;
-	int	maxpts;
-
-	counts[0] = counts[1] = counts[2] = 0;
-
-	// determine sides for each point
-	for( i = 0; i < in->numpoints; i++ )
-	{
-		dot = DotProduct( in->p[i], normal );
-		dot -= dist;
-		dists[i] = dot;
-
-		if( dot > epsilon )
-			sides[i] = SIDE_FRONT;
-		else if( dot < -epsilon )
-			sides[i] = SIDE_BACK;
-		else sides[i] = SIDE_ON;
-
-		counts[sides[i]]++;
-	}
-
-	sides[i] = sides[0];
-	dists[i] = dists[0];
-
-	*front = *back = NULL;
-
-	if( keepon && !counts[SIDE_FRONT] && !counts[SIDE_BACK] )
-	{
-		vec_t sum = 0.0;
-		for( i = 0; i < in->numpoints; i++)
-		{
-			dot = DotProduct( in->p[i], normal );
-			dot -= dist;
-			sum += dot;
-		}
-
-		if( sum > NORMAL_EPSILON )
-			*front = CopyWinding( in );
-		else *back = CopyWinding( in );
-		return;
-	}
 
-	if( !counts[SIDE_FRONT] )
-	{
-		*back = CopyWinding( in );
-		return;
-	}
-
-	if( !counts[SIDE_BACK] )
-	{
-		*front = CopyWinding( in );
-		return;
-	}
-
-	maxpts = in->numpoints + 4;	// cant use counts[0] + 2 because of fp grouping errors
-
-	*front = f = AllocWinding( maxpts );
-	*back = b = AllocWinding( maxpts );
-	VectorClear( mid );
+	if( f ) f->numpoints = 0;
+	if( b ) b->numpoints = 0;
 
 	for( i = 0; i < in->numpoints; i++ )
 	{
@@ -447,18 +399,25 @@ void ClipWindingEpsilon( winding_t *in, const vec3_t normal, vec_t dist, vec_t e
 
 		if( sides[i] == SIDE_ON )
 		{
-			VectorCopy( p1, f->p[f->numpoints] );
-			VectorCopy( p1, b->p[b->numpoints] );
-			f->numpoints++;
-			b->numpoints++;
+			if( f )
+			{
+				VectorCopy( p1, f->p[f->numpoints] );
+				f->numpoints++;
+			}
+
+			if( b )
+			{
+				VectorCopy( p1, b->p[b->numpoints] );
+				b->numpoints++;
+			}
 			continue;
 		}
-		else if( sides[i] == SIDE_FRONT )
+		else if( sides[i] == SIDE_FRONT && f )
 		{
 			VectorCopy( p1, f->p[f->numpoints] );
 			f->numpoints++;
 		}
-		else if( sides[i] == SIDE_BACK )
+		else if( sides[i] == SIDE_BACK && b )
 		{
 			VectorCopy( p1, b->p[b->numpoints] );
 			b->numpoints++;
@@ -482,32 +441,84 @@ void ClipWindingEpsilon( winding_t *in, const vec3_t normal, vec_t dist, vec_t e
 			else mid[j] = p1[j] + dot * ( p2[j] - p1[j] );
 		}
 
-		VectorCopy( mid, f->p[f->numpoints] );
-		VectorCopy( mid, b->p[b->numpoints] );
-		f->numpoints++;
-		b->numpoints++;
+		if( f )
+		{
+			VectorCopy( mid, f->p[f->numpoints] );
+			f->numpoints++;
+		}
+
+		if( b )
+		{
+			VectorCopy( mid, b->p[b->numpoints] );
+			b->numpoints++;
+		}
 	}
 
-	if(( f->numpoints > maxpts ) | ( b->numpoints > maxpts ))
-		COM_FatalError( "ClipWinding: points exceeded estimate\n" );
+	if(( f && f->numpoints > maxpts ) || ( b && b->numpoints > maxpts ))
+		COM_FatalError( "%s: points exceeded estimate\n", caller );
 
-	if(( f->numpoints > MAX_POINTS_ON_WINDING ) | ( b->numpoints > MAX_POINTS_ON_WINDING ))
-		COM_FatalError( "ClipWinding: MAX_POINTS_ON_WINDING limit exceeded\n" );
+	if(( f && f->numpoints > MAX_POINTS_ON_WINDING ) || ( b && b->numpoints > MAX_POINTS_ON_WINDING ))
+		COM_FatalError( "%s: MAX_POINTS_ON_WINDING limit exceeded\n", caller );
 
-	RemoveColinearPointsEpsilon( f, epsilon );
-	RemoveColinearPointsEpsilon( b, epsilon );
+	if( f ) RemoveColinearPointsEpsilon( (winding_t *)f, epsilon );
+	if( b ) RemoveColinearPointsEpsilon( (winding_t *)b, epsilon );
+}
 
-	if( f->numpoints < 3 )
+/*
+=============
+ClipWindingEpsilon
+
+front or back may be NULL if the caller
+doesn't need that part of the winding
+=============
+*/
+void ClipWindingEpsilon( winding_t *in, const vec3_t normal, vec_t dist, vec_t epsilon, winding_t **front, winding_t **back, bool keepon )
+{
+	vec_t		dists[MAX_POINTS_ON_WINDING+4];
+	int		sides[MAX_POINTS_ON_WINDING+4];
+	stackwinding_t	f, b;
+	int		counts[3];
+	int		i, side;
+
+	ClassifyPointsEpsilon( in->p, in->numpoints, normal, dist, epsilon, dists, sides, counts );
+
+	if( front ) *front = NULL;
+	if( back ) *back = NULL;
+
+	if( keepon && !counts[SIDE_FRONT] && !counts[SIDE_BACK] )
+	{
+		vec_t sum = 0.0;
+		for( i = 0; i < in->numpoints; i++)
+			sum += dists[i];
+
+		side = ( sum > NORMAL_EPSILON ) ? SIDE_FRONT : SIDE_BACK;
+	}
+	else if( !counts[SIDE_FRONT] )
+		side = SIDE_BACK;
+	else if( !counts[SIDE_BACK] )
+		side = SIDE_FRONT;
+	else side = SIDE_CROSS;
+
+	if( side == SIDE_FRONT )
 	{
-		FreeWinding( f );
-		*front = NULL;
+		if( front ) *front = CopyWinding( in );
+		return;
 	}
 
-	if( b->numpoints < 3 )
+	if( side == SIDE_BACK )
 	{
-		FreeWinding( b );
-		*back = NULL;
+		if( back ) *back = CopyWinding( in );
+		return;
 	}
+
+	SplitWindingEpsilon( in, normal, dist, epsilon, dists, sides, front ? &f : NULL, back ? &b : NULL, "ClipWinding" );
+
+	// only the parts that survived go to the heap
+	if( front && f.numpoints >= 3 )
+		*front = CopyWinding( (winding_t *)&f );
+
+	if( back && b.numpoints >= 3 )
+		*back = CopyWinding( (winding_t *)&b );
 }
 
 /*
@@ -522,36 +533,13 @@ new windings will be created.
 */
 void DivideWindingEpsilon( winding_t *in, vec3_t normal, vec_t dist, vec_t epsilon, winding_t **front, winding_t **back, vec_t *fnormal, bool keepon )
 {
-	vec_t	dists[MAX_POINTS_ON_WINDING+4];
-	int	sides[MAX_POINTS_ON_WINDING+4];
-	int	counts[3];
-	vec_t	dot;
-	int	i, j;
-	vec_t	*p1, *p2;
-	vec3_t	mid;
-	winding_t	*f, *b;
-	int	maxpts;
-
-	counts[0] = counts[1] = counts[2] = 0;
-
-	// determine sides for each point
-	for( i = 0; i < in->numpoints; i++ )
-	{
-		dot = DotProduct( in->p[i], normal );
-		dot -= dist;
-		dists[i] = dot;
-
-		if( dot > epsilon )
-			sides[i] = SIDE_FRONT;
-		else if( dot < -epsilon )
-			sides[i] = SIDE_BACK;
-		else sides[i] = SIDE_ON;
-
-		counts[sides[i]]++;
-	}
+	vec_t		dists[MAX_POINTS_ON_WINDING+4];
+	int		sides[MAX_POINTS_ON_WINDING+4];
+	stackwinding_t	f, b;
+	int		counts[3];
+	int		i;
 
-	sides[i] = sides[0];
-	dists[i] = dists[0];
+	ClassifyPointsEpsilon( in->p, in->numpoints, normal, dist, epsilon, dists, sides, counts );
 
 	*front = *back = NULL;
 
@@ -568,11 +556,7 @@ void DivideWindingEpsilon( winding_t *in, vec3_t normal, vec_t dist, vec_t epsil
 		{
 			vec_t sum = 0.0;
 			for( i = 0; i < in->numpoints; i++)
-			{
-				dot = DotProduct( in->p[i], normal );
-				dot -= dist;
-				sum += dot;
-			}
+				sum += dists[i];
 
 			if( sum > NORMAL_EPSILON )
 				*front = in;
@@ -593,197 +577,109 @@ void DivideWindingEpsilon( winding_t *in, vec3_t normal, vec_t dist, vec_t epsil
 		return;
 	}
 
-	maxpts = in->numpoints + 4;	// can't use counts[0]+2 because of fp grouping errors
-
-	*front = f = AllocWinding( maxpts );
-	*back = b = AllocWinding( maxpts );
-
-	for( i = 0; i < in->numpoints; i++ )
-	{
-		p1 = in->p[i];
-
-		if( sides[i] == SIDE_ON )
-		{
-			VectorCopy( p1, f->p[f->numpoints] );
-			VectorCopy( p1, b->p[b->numpoints] );
-			f->numpoints++;
-			b->numpoints++;
-			continue;
-		}
-
-		if( sides[i] == SIDE_FRONT )
-		{
-			VectorCopy( p1, f->p[f->numpoints] );
-			f->numpoints++;
-		}
-		else if( sides[i] == SIDE_BACK )
-		{
-			VectorCopy( p1, b->p[b->numpoints] );
-			b->numpoints++;
-		}
-
-		if(( sides[i+1] == SIDE_ON ) | ( sides[i+1] == sides[i] ))  // | instead of || for branch optimization
-			continue;
-
-		// generate a split point
-		p2 = in->p[(i + 1) % in->numpoints];
-
-		dot = dists[i] / (dists[i] - dists[i+1]);
-
-		for( j = 0; j < 3; j++ )
-		{
-			// avoid round off error when possible
-			if( normal[j] == 1 )
-				mid[j] = dist;
-			else if( normal[j] == -1 )
-				mid[j] = -dist;
-			else mid[j] = p1[j] + dot * ( p2[j] - p1[j] );
-		}
-
-		VectorCopy( mid, f->p[f->numpoints] );
-		VectorCopy( mid, b->p[b->numpoints] );
-		f->numpoints++;
-		b->numpoints++;
-	}
-
-	if(( f->numpoints > maxpts ) | ( b->numpoints > maxpts ))
-		COM_FatalError( "ClipWinding: points exceeded estimate\n" );
-
-	if(( f->numpoints > MAX_POINTS_ON_WINDING ) | ( b->numpoints > MAX_POINTS_ON_WINDING ))
-		COM_FatalError( "ClipWinding: MAX_POINTS_ON_WINDING limit exceeded\n" );
-
-	RemoveColinearPointsEpsilon( f, epsilon );
-	RemoveColinearPointsEpsilon( b, epsilon );
+	SplitWindingEpsilon( in, normal, dist, epsilon, dists, sides, &f, &b, "ClipWinding" );
 
-	if( f->numpoints < 3 )
+	if( f.numpoints < 3 )
 	{
-		FreeWinding( f );
-		FreeWinding( b );
-		*front = NULL;
 		*back = in;
 	}
-	else if( b->numpoints < 3 )
+	else if( b.numpoints < 3 )
 	{
-		FreeWinding( f );
-		FreeWinding( b );
 		*front = in;
-		*back = NULL;
+	}
+	else
+	{
+		*front = CopyWinding( (winding_t *)&f );
+		*back = CopyWinding( (winding_t *)&b );
 	}
 }
 
 /*
 =============
-ChopWindingInPlace
+ChopWindingScratch
+
+shared by ChopWindingInPlace and ChopWindingsInPlace,
+scratch space is provided by the caller
 =============
 */
-bool ChopWindingInPlace( winding_t **inout, const vec3_t normal, vec_t dist, vec_t epsilon, bool keepon )
+static bool ChopWindingScratch( winding_t **inout, const vec3_t normal, vec_t dist, vec_t epsilon, bool keepon, vec_t *dists, int *sides, stackwinding_t *f )
 {
-	winding_t		*in;
-	vec_t		dists[MAX_POINTS_ON_WINDING+4];
-	int		sides[MAX_POINTS_ON_WINDING+4];
-	int		counts[3];
-	vec_t		dot;
-	int		i, j;
-	vec_t		*p1, *p2;
-	vec3_t		mid;
-	winding_t		*f;
-	int		maxpts;
-
-	in = *inout;
-	counts[0] = counts[1] = counts[2] = 0;
-
-	// determine sides for each point
-	for( i = 0; i < in->numpoints; i++ )
-	{
-		dot = DotProduct( in->p[i], normal );
-		dot -= dist;
-		dists[i] = dot;
-
-		if( dot > epsilon )
-			sides[i] = SIDE_FRONT;
-		else if( dot < -epsilon )
-			sides[i] = SIDE_BACK;
-		else sides[i] = SIDE_ON;
-
-		counts[sides[i]]++;
-	}
+	winding_t	*in = *inout;
+	int	counts[3];
 
-	sides[i] = sides[0];
-	dists[i] = dists[0];
+	ClassifyPointsEpsilon( in->p, in->numpoints, normal, dist, epsilon, dists, sides, counts );
 
 	if( keepon && !counts[SIDE_FRONT] && !counts[SIDE_BACK] )
 		return true; // SIDE_ON
 
-	if( !counts[0] )
+	if( !counts[SIDE_FRONT] )
 	{
 		FreeWinding( in );
 		*inout = NULL;
 		return false;
 	}
 
-	if( !counts[1] ) return true;	// inout stays the same
-
-	maxpts = in->numpoints + 4;	// cant use counts[0] + 2 because of fp grouping errors
-	VectorClear( mid );
+	if( !counts[SIDE_BACK] ) return true;	// inout stays the same
 
-	f = AllocWinding( maxpts );
+	SplitWindingEpsilon( in, normal, dist, epsilon, dists, sides, f, NULL, "ChopWinding" );
 
-	for( i = 0; i < in->numpoints; i++ )
+	if( f->numpoints < 3 )
 	{
-		p1 = in->p[i];
-
-		if( sides[i] == SIDE_ON )
-		{
-			VectorCopy( p1, f->p[f->numpoints] );
-			f->numpoints++;
-			continue;
-		}
-
-		if( sides[i] == SIDE_FRONT )
-		{
-			VectorCopy( p1, f->p[f->numpoints] );
-			f->numpoints++;
-		}
-
-		if(( sides[i+1] == SIDE_ON ) | ( sides[i+1] == sides[i] ))  // | instead of || for branch optimization
-			continue;
+		FreeWinding( in );
+		*inout = NULL;
+		return false;
+	}
 
-		// generate a split point
-		p2 = in->p[(i + 1) % in->numpoints];
+	// chopping rarely grows the winding, so try to keep the old memory
+	if( Mem_Size( in ) >= (size_t)WindingSize( f ))
+	{
+		memcpy( in, f, WindingSize( f ));
+		return true;
+	}
 
-		dot = dists[i] / (dists[i] - dists[i+1]);
+	FreeWinding( in );
+	*inout = CopyWinding( (winding_t *)f );
+	return true;
+}
 
-		for( j = 0; j < 3; j++ )
-		{	
-			// avoid round off error when possible
-			if( normal[j] == 1 )
-				mid[j] = dist;
-			else if( normal[j] == -1 )
-				mid[j] = -dist;
-			else mid[j] = p1[j] + dot * ( p2[j] - p1[j] );
-		}
+/*
+=============
+ChopWindingInPlace
+=============
+*/
+bool ChopWindingInPlace( winding_t **inout, const vec3_t normal, vec_t dist, vec_t epsilon, bool keepon )
+{
+	vec_t		dists[MAX_POINTS_ON_WINDING+4];
+	int		sides[MAX_POINTS_ON_WINDING+4];
+	stackwinding_t	f;
 
-		VectorCopy( mid, f->p[f->numpoints] );
-		f->numpoints++;
-	}
+	return ChopWindingScratch( inout, normal, dist, epsilon, keepon, dists, sides, &f );
+}
 
-	if( f->numpoints > maxpts )
-		COM_FatalError( "ChopWinding: points exceeded estimate\n" );
-	if( f->numpoints > MAX_POINTS_ON_WINDING )
-		COM_FatalError( "ChopWinding: MAX_POINTS_ON_WINDING limit exceeded\n" );
+/*
+=============
+ChopWindingsInPlace
 
-	RemoveColinearPointsEpsilon( f, epsilon );
+chops a batch of windings by one plane. Clipped away windings
+are freed and set to NULL, returns count of windings left
+=============
+*/
+int ChopWindingsInPlace( winding_t **windings, int numwindings, const vec3_t normal, vec_t dist, vec_t epsilon, bool keepon )
+{
+	vec_t		dists[MAX_POINTS_ON_WINDING+4];
+	int		sides[MAX_POINTS_ON_WINDING+4];
+	stackwinding_t	f;
+	int		numleft = 0;
 
-	if( f->numpoints < 3 )
+	for( int i = 0; i < numwindings; i++ )
 	{
-		FreeWinding( f );
-		*inout = NULL;
-		return false;
+		if( !windings[i] ) continue;
+
+		if( ChopWindingScratch( &windings[i], normal, dist, epsilon, keepon, dists, sides, &f ))
+			numleft++;
 	}
 
-	FreeWinding( in );
-	*inout = f;
-	return true;
+	return numleft;
 }
 
 /*
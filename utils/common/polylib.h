@@ -28,6 +28,7 @@ vec_t WindingArea( const winding_t *w );
 void WindingCenter( winding_t *w, vec3_t center );
 vec_t WindingAreaAndBalancePoint( winding_t *w, vec3_t center );
 bool ChopWindingInPlace( winding_t **inout, const vec3_t normal, vec_t dist, vec_t epsilon, bool keepon = true );
+int ChopWindingsInPlace( winding_t **windings, int numwindings, const vec3_t normal, vec_t dist, vec_t epsilon, bool keepon = true );
 winding_t *TryMergeWindingEpsilon( winding_t *w1, winding_t *w2, const vec3_t planenormal, vec_t epsilon );
 void ClipWindingEpsilon( winding_t *in, const vec3_t normal, vec_t dist, vec_t epsilon, winding_t **front, winding_t **back, bool keepon = false );
 void DivideWindingEpsilon( winding_t *in, vec3_t normal, vec_t dist, vec_t eps, winding_t **fw, winding_t **bw, vec_t *fnorm = 0, bool keepon = true );
@@ -27,6 +27,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "scriplib.h"
 #include "stringlib.h"
 #include "filesystem.h"
+#include "threads.h"
 #include <stdarg.h>
 #include <windows.h>
 
@@ -47,20 +48,65 @@ typedef struct
 	const char	*end_p;
 	int		line;
 	bool		separate_stack;
+	bool		mapped;		// buffer is a file view
+	bool		noinclude;	// $include is returned as a token
+
+	// tokenizer state of the parent script (PushScriptMemory only)
+	int		oldscriptline;
+	bool		oldendofscript;
+	bool		oldtokenready;
 } script_t;
 
-script_t	scriptstack[MAX_INCLUDES];
-script_t	*script;
-int	scriptline;
-int	oldscriptline;
-int	scriptdepth;
+// tokenizer state is per-thread so the scripts can be parsed in parallel
+THREAD_LOCAL script_t	scriptstack[MAX_INCLUDES];
+THREAD_LOCAL script_t	*script;
+THREAD_LOCAL int		scriptline;
+THREAD_LOCAL int		oldscriptline;
+THREAD_LOCAL int		scriptdepth;
+
+THREAD_LOCAL char		token[MAXTOKEN];
+THREAD_LOCAL char		g_TXcommand;	// QuArK 'TX' comment
+THREAD_LOCAL int		g_DXspecial;	// Doom2Gold 'DX' comment
+
+THREAD_LOCAL bool		endofscript;
+THREAD_LOCAL bool		tokenready; // only true if UnGetToken was just called
+
+/*
+==============
+LoadScriptBuffer
+
+tokenizer may look up to three chars past the end
+of the buffer, so the file is only mapped if the
+last page has room for them. The rest of the page
+is zero-filled by the system
+==============
+*/
+static const char *LoadScriptBuffer( const char *filename, size_t *size, bool *mapped )
+{
+	static size_t	pagesize = 0;
+	const char	*buffer;
+
+	if( !pagesize )
+	{
+		SYSTEM_INFO	info;
+
+		GetSystemInfo( &info );
+		pagesize = info.dwPageSize;
+	}
+
+	buffer = (const char *)COM_MapFile( filename, size, false );
+
+	if( buffer != NULL && ( *size % pagesize ) != 0 && ( *size % pagesize ) <= ( pagesize - 4 ))
+	{
+		*mapped = true;
+		return buffer;
+	}
 
-char	token[MAXTOKEN];
-char	g_TXcommand;	// QuArK 'TX' comment
-int	g_DXspecial;	// Doom2Gold 'DX' comment
+	COM_UnmapFile( (byte *)buffer );
+	*mapped = false;
 
-bool	endofscript;
-bool	tokenready; // only true if UnGetToken was just called
+	return (const char *)COM_LoadFile( filename, size, true );
+}
 
 /*
 ==============
@@ -76,12 +122,13 @@ void AddScriptToStack( const char *filename )
 		COM_FatalError( "script file exceeded MAX_INCLUDES\n" );
 	Q_strcpy( script->filename, filename );
 
-	script->buffer = (char *)COM_LoadFile( script->filename, &size, true );
+	script->buffer = LoadScriptBuffer( script->filename, &size, &script->mapped );
 
 	script->line = 1;
 	script->script_p = script->buffer;
 	script->end_p = script->buffer + size;
 	script->separate_stack = false;
+	script->noinclude = false;
 }
 
 /*
@@ -105,6 +152,8 @@ void IncludeScriptFile( const char *filename )
 	script->script_p = script->buffer;
 	script->end_p = script->buffer + size;
 	script->separate_stack = true;
+	script->mapped = false;
+	script->noinclude = false;
 }
 #endif
 
@@ -142,11 +191,102 @@ void ParseFromMemory( const char *buffer, size_t size )
 	script->script_p = script->buffer;
 	script->end_p = script->buffer + size;
 	script->separate_stack = false;
+	script->mapped = false;
+	script->noinclude = false;
 
 	endofscript = false;
 	tokenready = false;
 }
 
+/*
+==============
+PushScriptMemory
+
+parse the buffer on top of the current script
+without losing the position in it. Each push must
+be paired with PopScriptMemory
+==============
+*/
+void PushScriptMemory( const char *buffer, size_t size, int line )
+{
+	if( !script ) script = scriptstack; // first use on this thread
+	script++;
+
+	if( script == &scriptstack[MAX_INCLUDES] )
+		COM_FatalError( "script file exceeded MAX_INCLUDES\n" );
+	Q_strcpy( script->filename, "memory buffer" );
+
+	script->buffer = buffer;
+	script->line = line;
+	script->script_p = script->buffer;
+	script->end_p = script->buffer + size;
+	script->separate_stack = false;
+	script->mapped = false;
+	script->noinclude = true;	// the parent script expands them
+
+	script->oldscriptline = scriptline;
+	script->oldendofscript = endofscript;
+	script->oldtokenready = tokenready;
+
+	scriptline = line - 1;
+	endofscript = false;
+	tokenready = false;
+}
+
+/*
+==============
+PopScriptMemory
+==============
+*/
+void PopScriptMemory( void )
+{
+	if( !script || script == scriptstack || Q_strcmp( script->filename, "memory buffer" ))
+		COM_FatalError( "PopScriptMemory: script stack underflow\n" );
+
+	scriptline = script->oldscriptline;
+	endofscript = script->oldendofscript;
+	tokenready = script->oldtokenready;
+	script--;
+}
+
+/*
+==============
+GetScriptPointer
+
+returns the current position in the script text,
+end of the text and the line number
+==============
+*/
+const char *GetScriptPointer( const char **end, int *line )
+{
+	if( !script || script == scriptstack )
+		return NULL;
+
+	if( end ) *end = script->end_p;
+	if( line ) *line = script->line;
+
+	return script->script_p;
+}
+
+/*
+==============
+SetScriptPointer
+
+moves the current script to a position that was
+reached by a parser working on the same text
+==============
+*/
+void SetScriptPointer( const char *pos, int line )
+{
+	if( !script || script == scriptstack || pos < script->buffer || pos > script->end_p )
+		COM_FatalError( "SetScriptPointer: position is outside of the script\n" );
+
+	script->script_p = pos;
+	script->line = line;
+	scriptline = line - 1;
+	tokenready = false;
+}
+
 /*
 ==============
 UnGetToken
@@ -180,7 +320,9 @@ bool EndOfScript( bool crossline )
 		return false;
 	}
 
-	Mem_Free( (char *)script->buffer, C_FILESYSTEM );
+	if( script->mapped )
+		COM_UnmapFile( (byte *)script->buffer );
+	else Mem_Free( (char *)script->buffer, C_FILESYSTEM );
 
 	if( script == scriptstack + 1 )
 	{
@@ -315,7 +457,7 @@ skipspace:
 
 	*token_p = 0; // null terminate
 
-	if( !Q_stricmp( token, "$include" ))
+	if( !script->noinclude && !Q_stricmp( token, "$include" ))
 	{
 		GetToken( false );
 		MsgDev( D_REPORT, "entering the script %s\n", token );
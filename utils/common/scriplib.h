@@ -26,17 +26,24 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "cmdlib.h"
 #endif
 
+#include "threads.h"
+
 #define MAXTOKEN	2048
 
-extern char	token[MAXTOKEN];
-extern char	g_TXcommand;
-extern int	g_DXspecial;
-extern int	scriptline;
-extern bool	endofscript;
+// tokenizer state is per-thread
+extern THREAD_LOCAL char	token[MAXTOKEN];
+extern THREAD_LOCAL char	g_TXcommand;
+extern THREAD_LOCAL int	g_DXspecial;
+extern THREAD_LOCAL int	scriptline;
+extern THREAD_LOCAL bool	endofscript;
 
 void LoadScriptFile( const char *filename );
 void IncludeScriptFile( const char *filename );
 void ParseFromMemory( const char *buffer, size_t size );
+void PushScriptMemory( const char *buffer, size_t size, int line );
+void PopScriptMemory( void );
+const char *GetScriptPointer( const char **end, int *line );
+void SetScriptPointer( const char *pos, int line );
 
 bool GetToken( bool crossline );
 bool GetTokenAppend( char *buffer, bool crossline );
@@ -22,8 +22,11 @@ GNU General Public License for more details.
 #include "scriplib.h"
 #include "bspfile.h"
 
+#define SHADER_HASH_SIZE	4096	// must be power of two
+
 shaderInfo_t	*shaderInfo = NULL;
 int		numShaderInfo;
+static shaderInfo_t	*shaderHashTable[SHADER_HASH_SIZE];
 surfaceParm_t	surfaceParams[] =
 {
 { "default", 	CONTENTS_NONE,		FSHADER_DEFAULT	},
@@ -121,6 +124,61 @@ bool ApplySurfaceParm( const char *name, int *contents, int *compileFlags )
 	return false;
 }
 
+/*
+=================
+ShaderHashForName
+
+case insensitive, same as the name compare
+=================
+*/
+static unsigned int ShaderHashForName( const char *name )
+{
+	unsigned int	hash = 0;
+
+	while( *name )
+		hash = hash * 31 + (byte)Q_tolower( *name++ );
+
+	return hash & (SHADER_HASH_SIZE - 1);
+}
+
+/*
+=================
+FindShaderInfo
+=================
+*/
+static shaderInfo_t *FindShaderInfo( const char *name )
+{
+	shaderInfo_t	*si;
+
+	for( si = shaderHashTable[ShaderHashForName( name )]; si != NULL; si = si->hashNext )
+	{
+		if( !Q_stricmp( name, si->name ))
+			return si;
+	}
+
+	return NULL;
+}
+
+/*
+=================
+AddShaderInfoToHash
+
+must be called once the name is set. Duplicates
+are skipped so the first definition always wins
+=================
+*/
+static void AddShaderInfoToHash( shaderInfo_t *si )
+{
+	int	hash;
+
+	if( FindShaderInfo( si->name ) != NULL )
+		return;
+
+	hash = ShaderHashForName( si->name );
+	si->hashNext = shaderHashTable[hash];
+	shaderHashTable[hash] = si;
+}
+
 /*
 =================
 AllocShaderInfo
@@ -135,6 +193,7 @@ static shaderInfo_t *AllocShaderInfo( void )
 	if( shaderInfo == NULL )
 	{
 		shaderInfo = (shaderInfo_t *)Mem_Alloc( sizeof( shaderInfo_t ) * MAX_SHADER_INFO );
+		memset( shaderHashTable, 0, sizeof( shaderHashTable ));
 		numShaderInfo = 0;
 	}
 
@@ -213,23 +272,19 @@ shaderInfo_t *ShaderInfoForShader( const char *shaderName )
 	Q_snprintf( shader, sizeof( shader ), "textures/%s", shaderName );
 	COM_StripExtension( shader );
 
-	for( int i = 0; i < numShaderInfo; i++ )
+	if(( si = FindShaderInfo( shader )) != NULL )
 	{
-		si = &shaderInfo[i];
-
-		if( !Q_stricmp( shader, si->name ))
+		if( !si->finished )
 		{
-			if( !si->finished )
-			{
-				LoadShaderImages( si );
-				FinishShader( si );
-			}
-			return si;
+			LoadShaderImages( si );
+			FinishShader( si );
 		}
+		return si;
 	}
 
 	si = AllocShaderInfo();
 	Q_strcpy( si->name, shader );
+	AddShaderInfoToHash( si );
 	SetBits( si->flags, FSHADER_DEFAULTED );
 	LoadShaderImages( si );
 	FinishShader( si );
@@ -279,6 +334,7 @@ static void ParseShaderFile( const char *filename )
 		// ignore ":q3map" suffix
 		suffix = Q_strstr( si->name, ":q3map" );
 		if( suffix != NULL ) *suffix = '\0';
+		AddShaderInfoToHash( si );
 
 		/* handle { } section */
 		if( !GetTokenAppend( shaderText, true ))
@@ -421,5 +477,6 @@ void FreeShaderInfo( void )
 	}
 
 	Mem_Free( shaderInfo );
+	memset( shaderHashTable, 0, sizeof( shaderHashTable ));
 	shaderInfo = NULL;
 }
\ No newline at end of file
@@ -66,6 +66,8 @@ typedef struct shaderInfo_s
 	float	vertexScale;			// vertex light scale
 	bool	vertexShadows;			// shadows will be casted at this surface even when vertex lit
 	bool	finished;
+
+	struct shaderInfo_s	*hashNext;		// next shader in the same name hash bin
 } shaderInfo_t;
 
 shaderInfo_t *ShaderInfoForShader( const char *shaderName );
@@ -0,0 +1,85 @@
+/*
+telemetry.cpp - machine-readable build statistics
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include <windows.h>
+#include <stdio.h>
+#include "cmdlib.h"
+#include "threads.h"
+#include "telemetry.h"
+
+static double FileTimeToSeconds( const FILETIME *ft )
+{
+	// 100-nanosecond intervals
+	return ((double)ft->dwLowDateTime + (double)ft->dwHighDateTime * 4294967296.0 ) * 1e-7;
+}
+
+/*
+=============
+Telemetry_WriteReport
+=============
+*/
+bool Telemetry_WriteReport( const char *filename, const char *toolname, double walltime )
+{
+	FILETIME			creation, exit, kernel, user;
+	const threadstats_t		*st;
+	double			cputime = 0.0;
+	memstats_t		mem;
+	int			i, numstats;
+	FILE			*f;
+
+	if( !filename || !*filename )
+		return false;
+
+	if(( f = fopen( filename, "w" )) == NULL )
+	{
+		MsgDev( D_ERROR, "couldn't write report %s\n", filename );
+		return false;
+	}
+
+	if( GetProcessTimes( GetCurrentProcess(), &creation, &exit, &kernel, &user ))
+		cputime = FileTimeToSeconds( &kernel ) + FileTimeToSeconds( &user );
+
+	Mem_GetStats( &mem );
+	numstats = ThreadGetStats( &st );
+
+	fprintf( f, "{\n" );
+	fprintf( f, "\t\"tool\": \"%s\",\n", toolname );
+	fprintf( f, "\t\"threads\": %i,\n", g_numthreads );
+	fprintf( f, "\t\"wall\": %.3f,\n", walltime );
+	fprintf( f, "\t\"cpu\": %.3f,\n", cputime );
+	fprintf( f, "\t\"memory\": { \"active\": %ld, \"peak\": %ld, \"categories\": [", mem.active, mem.peakactive );
+
+	for( i = 0; i < C_MAXSTAT; i++ )
+	{
+		fprintf( f, "%s\n\t\t{ \"name\": \"%s\", \"active\": %ld, \"peak\": %ld }",
+		i ? "," : "", c_stats[i], mem.catactive[i], mem.catpeak[i] );
+	}
+	fprintf( f, "\n\t] },\n" );
+
+	fprintf( f, "\t\"phases\": [" );
+
+	for( i = 0; i < numstats; i++ )
+	{
+		// how much of the available thread time was really spent
+		double utilization = ( st[i].threadtime > 0.0 ) ? st[i].cputime / st[i].threadtime : 0.0;
+
+		fprintf( f, "%s\n\t\t{ \"name\": \"%s\", \"calls\": %i, \"work\": %i, \"threads\": %i, \"wall\": %.3f, \"cpu\": %.3f, \"utilization\": %.3f }",
+		i ? "," : "", st[i].name, st[i].calls, st[i].workcount, st[i].maxthreads, st[i].walltime, st[i].cputime, utilization );
+	}
+	fprintf( f, "\n\t]\n}\n" );
+	fclose( f );
+
+	return true;
+}
@@ -0,0 +1,23 @@
+/*
+telemetry.h - machine-readable build statistics
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+// writes timing of every RunThreadsOn function and zone
+// usage by category as a JSON object, used by p2build
+bool Telemetry_WriteReport( const char *filename, const char *toolname, double walltime );
+
+#endif//TELEMETRY_H
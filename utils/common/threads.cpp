@@ -9,6 +9,7 @@
 ****/
 
 #include "cmdlib.h"
+#include "stringlib.h"
 #define NO_THREAD_NAMES
 #include "threads.h"
 #include <windows.h>
@@ -16,6 +17,7 @@
 #define THREAD_STACK_SIZE	(4096 * 1024)	// 4 Mb
 #define PACIFIER_STEP	40
 #define PACIFIER_REM	( PACIFIER_STEP / 10 )
+#define MAX_THREAD_STATS	64
 
 typedef struct thread_s
 {
@@ -23,8 +25,19 @@ typedef struct thread_s
 	pfnRunThreads	func;	// thread func
 } thread_t;
 
+struct threadtask_s
+{
+	int		slot;
+	HANDLE		handle;
+	pfnThreadTask	func;
+	void		*data;
+	msgbuf_t		*capture;	// output of the spawning worker
+};
+
 static HANDLE		g_threadhandles[MAX_THREADS];
 static thread_t		g_threads[MAX_THREADS];
+static threadtask_t		g_tasks[MAX_THREADS];
+static volatile long	g_taskbusy[MAX_THREADS];
 static int		g_dispatch = 0;
 static int		g_workcount = 0;
 static qboolean		g_pacifier = false;
@@ -34,8 +47,87 @@ int			g_numthreads = -1;
 static int		g_oldnumthreads;
 static int		g_oldf = -1;
 static bool		g_enter;
+static const char		*g_workname;
+static threadstats_t	g_threadstats[MAX_THREAD_STATS];
+static int		g_numthreadstats;
 CRITICAL_SECTION		g_crit;
 
+/*
+=============
+ThreadWorkName
+
+set by RunThreadsOn macros before the call
+=============
+*/
+void ThreadWorkName( const char *name )
+{
+	g_workname = name;
+}
+
+/*
+=============
+ThreadGetStats
+=============
+*/
+int ThreadGetStats( const threadstats_t **stats )
+{
+	*stats = g_threadstats;
+	return g_numthreadstats;
+}
+
+// whole process, so the tasks spawned by the workers are counted too
+static double ProcessCPUTime( void )
+{
+	FILETIME	creation, exit, kernel, user;
+
+	if( !GetProcessTimes( GetCurrentProcess(), &creation, &exit, &kernel, &user ))
+		return 0.0;
+
+	// 100-nanosecond intervals
+	return ((double)kernel.dwLowDateTime + (double)kernel.dwHighDateTime * 4294967296.0 +
+		(double)user.dwLowDateTime + (double)user.dwHighDateTime * 4294967296.0 ) * 1e-7;
+}
+
+static void ThreadAddStats( const char *name, int workcnt, int numthreads, double walltime, double cputime )
+{
+	threadstats_t	*st = NULL;
+	int		i;
+
+	if( !name ) name = "unnamed";
+
+	for( i = 0; i < g_numthreadstats; i++ )
+	{
+		if( !Q_strcmp( g_threadstats[i].name, name ))
+		{
+			st = &g_threadstats[i];
+			break;
+		}
+	}
+
+	if( !st )
+	{
+		// last slot collects everything that doesn't fit
+		if( g_numthreadstats == MAX_THREAD_STATS )
+		{
+			st = &g_threadstats[MAX_THREAD_STATS - 1];
+			st->name = "other";
+		}
+		else
+		{
+			st = &g_threadstats[g_numthreadstats++];
+			st->name = name;
+		}
+	}
+
+	st->calls++;
+	st->workcount += workcnt;
+	if( numthreads > st->maxthreads )
+		st->maxthreads = numthreads;
+	st->walltime += walltime;
+	st->cputime += cputime;
+	st->threadtime += walltime * numthreads;
+}
+
 void UpdatePacifier( float percent )
 {
 	int	f;
@@ -121,11 +213,83 @@ static DWORD WINAPI InternalRunThreadsFn( LPVOID pData )
 {
 	thread_t *pThread = (thread_t *)pData;
 
+	// slot 0 is reserved for main thread
+	Mem_ThreadInit( pThread->number + 1 );
 	pThread->func( pThread->number );
 
 	return 0;
 }
 
+static DWORD WINAPI InternalRunTaskFn( LPVOID pData )
+{
+	threadtask_t *pTask = (threadtask_t *)pData;
+
+	// memory slots after workers are reserved for tasks,
+	// release what the previous tasks left empty
+	Mem_ThreadInit( MAX_THREADS + 1 + pTask->slot );
+	Mem_ResetThreadArena();
+
+	Sys_BeginCapture( pTask->capture );
+	pTask->func( pTask->data );
+	Sys_EndCapture();
+
+	return 0;
+}
+
+/*
+=============
+ThreadSpawnTask
+
+run the function on a separate thread.
+returns NULL when all the task threads are busy,
+so caller should do the job himself
+=============
+*/
+threadtask_t *ThreadSpawnTask( pfnThreadTask func, void *data )
+{
+	DWORD	dwDummy;
+	int	i;
+
+	for( i = 0; i < g_numthreads - 1 && i < MAX_THREADS; i++ )
+	{
+		if( InterlockedCompareExchange( &g_taskbusy[i], 1, 0 ) == 0 )
+			break;
+	}
+
+	if( i >= g_numthreads - 1 || i >= MAX_THREADS )
+		return NULL;
+
+	threadtask_t *task = &g_tasks[i];
+	task->slot = i;
+	task->func = func;
+	task->data = data;
+	task->capture = Sys_GetCapture();
+	task->handle = CreateThread( NULL, THREAD_STACK_SIZE, InternalRunTaskFn, task, 0, &dwDummy );
+
+	if( !task->handle )
+	{
+		InterlockedExchange( &g_taskbusy[i], 0 );
+		return NULL;
+	}
+
+	return task;
+}
+
+/*
+=============
+ThreadWaitTask
+=============
+*/
+void ThreadWaitTask( threadtask_t *task )
+{
+	if( !task ) return;
+
+	WaitForSingleObject( task->handle, INFINITE );
+	CloseHandle( task->handle );
+	task->handle = NULL;
+	InterlockedExchange( &g_taskbusy[task->slot], 0 );
+}
+
 void ThreadSetDefault( void )
 {
 	SYSTEM_INFO	info;
@@ -187,6 +351,7 @@ RunThreadsOn
 void RunThreadsOn( int workcnt, bool showpacifier, pfnRunThreads func )
 {
 	double	start, end;
+	double	cputime;
 	DWORD	dwDummy;
 	int	i;
 
@@ -202,6 +367,7 @@ void RunThreadsOn( int workcnt, bool showpacifier, pfnRunThreads func )
 	g_workcount = workcnt;
 	g_dispatch = 0;
 	if( g_pacifier ) StartPacifier();
+	cputime = -ProcessCPUTime();
 
 	if( g_numthreads == 1 )
 	{	
@@ -219,7 +385,7 @@ void RunThreadsOn( int workcnt, bool showpacifier, pfnRunThreads func )
 			g_threads[i].number = i;
 			g_threads[i].func = func;
 
-			g_threadhandles[i] = CreateThread( NULL, THREAD_STACK_SIZE, InternalRunThreadsFn, &g_threads, 0, &dwDummy );
+			g_threadhandles[i] = CreateThread( NULL, THREAD_STACK_SIZE, InternalRunThreadsFn, &g_threads[i], 0, &dwDummy );
 		}
 
 		WaitForMultipleObjects( g_numthreads, g_threadhandles, TRUE, INFINITE );
@@ -232,6 +398,10 @@ void RunThreadsOn( int workcnt, bool showpacifier, pfnRunThreads func )
 	}
 
 	end = I_FloatTime ();
+	cputime += ProcessCPUTime();
+
+	ThreadAddStats( g_workname, workcnt, g_numthreads, end - start, cputime );
+	g_workname = NULL;
 
 	if( g_pacifier ) EndPacifier( end - start );
 }
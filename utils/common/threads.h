@@ -8,10 +8,20 @@
 *
 ****/
 
+#ifndef THREADS_H
+#define THREADS_H
+
 extern int g_numthreads;
 
 #define MAX_THREADS		16
 
+// per-thread copy of variable, POD types only
+#ifdef _MSC_VER
+#define THREAD_LOCAL	__declspec( thread )
+#else
+#define THREAD_LOCAL	__thread
+#endif
+
 typedef void (*pfnThreadWork)( int current, int threadnum );
 typedef void (*pfnRunThreads)( int threadnum );
 
@@ -26,12 +36,36 @@ void ThreadUnlock( void );
 void ThreadPush( void );
 void ThreadPop( void );
 
+// fork-join helpers, can be used from inside RunThreadsOn
+typedef struct threadtask_s threadtask_t;
+typedef void (*pfnThreadTask)( void *data );
+
+threadtask_t *ThreadSpawnTask( pfnThreadTask func, void *data );
+void ThreadWaitTask( threadtask_t *task );
+
+// accumulated for each RunThreadsOn function
+typedef struct
+{
+	const char	*name;
+	int		calls;
+	int		workcount;
+	int		maxthreads;
+	double		walltime;		// seconds
+	double		cputime;		// process time, includes spawned tasks
+	double		threadtime;	// walltime * numthreads
+} threadstats_t;
+
+void ThreadWorkName( const char *name );
+int ThreadGetStats( const threadstats_t **stats );
+
 void StartPacifier( void );
 void UpdatePacifier( float percent );
 void EndPacifier( double total );
 
 #ifndef NO_THREAD_NAMES
-#define RunThreadsOn( n, p, f ) { if( p ) Msg( "%-20s", #f ":" ); RunThreadsOn( n, p, f ); }
-#define RunThreadsOnIncremental( n, p, f, i ) { if( p ) Msg( "%s %i:", #f, i ); RunThreadsOnIncremental( n, p, f ); }
-#define RunThreadsOnIndividual( n, p, f ) { if (p) Msg( "%-20s", #f ":" ); RunThreadsOnIndividual( n, p, f ); }
+#define RunThreadsOn( n, p, f ) { if( p ) Msg( "%-20s", #f ":" ); ThreadWorkName( #f ); RunThreadsOn( n, p, f ); }
+#define RunThreadsOnIncremental( n, p, f, i ) { if( p ) Msg( "%s %i:", #f, i ); ThreadWorkName( #f ); RunThreadsOnIncremental( n, p, f ); }
+#define RunThreadsOnIndividual( n, p, f ) { if (p) Msg( "%-20s", #f ":" ); ThreadWorkName( #f ); RunThreadsOnIndividual( n, p, f ); }
 #endif
+
+#endif//THREADS_H
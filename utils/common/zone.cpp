@@ -22,14 +22,51 @@ GNU General Public License for more details.
 #define ZONE_ATTEMPT_CALLOC
 //#define ZONE_DEBUG
 
-static int	c_alloc[C_MAXSTAT] = { 0 };
-static size_t	total_active, total_peakactive;
+#define ZONE_MAX_SLOTS		( MAX_THREADS * 2 + 1 )	// main thread, workers and tasks
+#define ZONE_CLASS_SIZE		16			// size-class granularity
+#define ZONE_MAX_SMALL		1024			// bigger blocks goes directly to calloc
+#define ZONE_NUM_CLASSES		( ZONE_MAX_SMALL / ZONE_CLASS_SIZE )
+#define ZONE_SLAB_SIZE		( 256 * 1024 )
+
+typedef struct zoneslab_s
+{
+	struct zoneslab_s	*next;
+	volatile long	live;		// blocks in use, may be freed by any thread
+	bool		empty;		// snapshot of live == 0 for the reset
+	byte		*cur;		// bump pointer
+	byte		*end;
+} zoneslab_t;
 
 typedef struct memhdr_s
 {
-	size_t	size;
+	size_t		size;
+	zoneslab_t	*slab;		// NULL for big blocks
+	unsigned int	target;		// category that is charged for the block
+	int		owner;		// slot that allocated the block
 } memhdr_t;
 
+// every thread slot owns its size-class lists and slabs, so no locks are needed.
+// blocks freed by another thread are pushed to the owner's remote list instead
+typedef struct
+{
+	memhdr_t		*freelist[ZONE_NUM_CLASSES];
+	memhdr_t		*volatile remote;	// lock-free stack, drained by the owner only
+	zoneslab_t	*slabs;
+	zoneslab_t	*current;
+	long		active;
+	long		peakactive;
+	long		catactive[C_MAXSTAT];
+	long		catpeak[C_MAXSTAT];
+	volatile long	remoteactive;	// changed by other threads, added to active
+	volatile long	remotecat[C_MAXSTAT];
+#ifdef ZONE_DEBUG
+	int		c_alloc[C_MAXSTAT];
+#endif
+} zonecache_t;
+
+static zonecache_t		g_zonecache[ZONE_MAX_SLOTS];
+static THREAD_LOCAL int	t_zoneslot;	// 0 for main thread
+
 const char *c_stats[] =
 {
 	"Common",
@@ -67,6 +104,147 @@ static void *attempt_calloc( size_t size )
 	return NULL;
 }
 
+/*
+=============
+Mem_ThreadInit
+
+bind the calling thread to the cache slot
+=============
+*/
+void Mem_ThreadInit( int slot )
+{
+	if( slot < 0 || slot >= ZONE_MAX_SLOTS )
+		COM_FatalError( "Mem_ThreadInit: bad slot %i\n", slot );
+	t_zoneslot = slot;
+}
+
+/*
+=============
+Mem_AllocSlab
+
+carve new slab for the thread cache
+=============
+*/
+static zoneslab_t *Mem_AllocSlab( zonecache_t *cache )
+{
+	zoneslab_t	*slab;
+	byte		*mem;
+
+#ifdef ZONE_ATTEMPT_CALLOC
+	mem = (byte *)attempt_calloc( ZONE_SLAB_SIZE );
+#else
+	mem = (byte *)calloc( ZONE_SLAB_SIZE, 1 );
+#endif
+	if( !mem ) return NULL;
+
+	slab = (zoneslab_t *)mem;
+	slab->cur = mem + ((sizeof( zoneslab_t ) + 15) & ~15);
+	slab->end = mem + ZONE_SLAB_SIZE;
+	slab->next = cache->slabs;
+	cache->slabs = slab;
+
+	return slab;
+}
+
+/*
+=============
+Mem_DrainRemote
+
+move the blocks released by other
+threads into the owner's freelists
+=============
+*/
+static void Mem_DrainRemote( zonecache_t *cache )
+{
+	memhdr_t	*chunk, *next;
+
+	// take the whole stack at once, pushers never pop so there is no ABA
+	chunk = (memhdr_t *)InterlockedExchangePointer( (void * volatile *)&cache->remote, NULL );
+
+	for( ; chunk != NULL; chunk = next )
+	{
+		int	cls = (int)(( chunk->size - 1 ) / ZONE_CLASS_SIZE );
+
+		next = *(memhdr_t **)( chunk + 1 );
+		*(memhdr_t **)( chunk + 1 ) = cache->freelist[cls];
+		cache->freelist[cls] = chunk;
+	}
+}
+
+/*
+=============
+Mem_AllocSmall
+
+allocate block from the thread cache
+=============
+*/
+static memhdr_t *Mem_AllocSmall( size_t size )
+{
+	zonecache_t	*cache = &g_zonecache[t_zoneslot];
+	int		cls = (int)(( size - 1 ) / ZONE_CLASS_SIZE );
+	size_t		blocksize = sizeof( memhdr_t ) + ( cls + 1 ) * ZONE_CLASS_SIZE;
+	memhdr_t		*chunk;
+
+	if( !cache->freelist[cls] && cache->remote )
+		Mem_DrainRemote( cache );
+
+	if(( chunk = cache->freelist[cls] ) != NULL )
+	{
+		// reuse freed block
+		cache->freelist[cls] = *(memhdr_t **)( chunk + 1 );
+		memset( chunk + 1, 0, blocksize - sizeof( memhdr_t ));
+	}
+	else
+	{
+		zoneslab_t	*slab = cache->current;
+
+		if( !slab || slab->cur + blocksize > slab->end )
+		{
+			if(( slab = Mem_AllocSlab( cache )) == NULL )
+				return NULL;
+			cache->current = slab;
+		}
+
+		// slab memory is already zeroed
+		chunk = (memhdr_t *)slab->cur;
+		chunk->slab = slab;
+		slab->cur += blocksize;
+	}
+
+	InterlockedIncrement( (long *)&chunk->slab->live );
+
+	return chunk;
+}
+
+/*
+=============
+Mem_CountAlloc
+
+bytes are always charged to the slot that allocated
+the block. The owner thread counts without locks,
+other threads use the interlocked remote counters
+=============
+*/
+static void Mem_CountAlloc( int slot, unsigned int target, long size )
+{
+	zonecache_t	*cache = &g_zonecache[slot];
+
+	if( slot != t_zoneslot )
+	{
+		InterlockedExchangeAdd( &cache->remoteactive, size );
+		InterlockedExchangeAdd( &cache->remotecat[target], size );
+		return;
+	}
+
+	cache->active += size;
+	cache->catactive[target] += size;
+
+	if( size <= 0 ) return;
+
+	cache->peakactive = Q_max( cache->peakactive, cache->active + cache->remoteactive );
+	cache->catpeak[target] = Q_max( cache->catpeak[target], cache->catactive[target] + cache->remotecat[target] );
+}
+
 /*
 =============
 Mem_Alloc
@@ -77,32 +255,41 @@ allocate mem
 void *Mem_Alloc( size_t size, unsigned int target )
 {
 	memhdr_t	*memhdr = NULL;
-	void	*mem;
 
 	if( size <= 0 ) return NULL;
 
+	if( size <= ZONE_MAX_SMALL )
+	{
+		memhdr = Mem_AllocSmall( size );
+	}
+	else
+	{
 #ifdef ZONE_ATTEMPT_CALLOC
-	mem = attempt_calloc( sizeof( memhdr_t ) + size );
+		memhdr = (memhdr_t *)attempt_calloc( sizeof( memhdr_t ) + size );
 #else
-	mem = calloc( sizeof( memhdr_t ) + size, 1 );
+		memhdr = (memhdr_t *)calloc( sizeof( memhdr_t ) + size, 1 );
 #endif
-	if( mem == NULL )
+		if( memhdr ) memhdr->slab = NULL;
+	}
+
+	if( memhdr == NULL )
 	{
 		if( target == C_SAFEALLOC )
 			return NULL;
 		COM_FatalError( "out of memory!\n" );
 	}
 
-	memhdr = (memhdr_t *)mem;
+	if( target >= C_MAXSTAT )
+		target = C_COMMON;
+
 	memhdr->size = size;
+	memhdr->target = target;
+	memhdr->owner = t_zoneslot;
+	Mem_CountAlloc( memhdr->owner, target, (long)size );
 #ifdef ZONE_DEBUG
-	ThreadLock();
-	total_active += size;
-	total_peakactive = Q_max( total_peakactive, total_active );
-	c_alloc[target]++;
-	ThreadUnlock();
+	g_zonecache[t_zoneslot].c_alloc[target]++;
 #endif
-	return (void *)((byte *)mem + sizeof( memhdr_t ));
+	return (void *)( memhdr + 1 );
 }
 
 void *Mem_Realloc( void *ptr, size_t size, unsigned int target )
@@ -116,6 +303,16 @@ void *Mem_Realloc( void *ptr, size_t size, unsigned int target )
 	{
 		memhdr = (memhdr_t *)((byte *)ptr - sizeof( memhdr_t ));
 		if( size == memhdr->size ) return ptr;
+
+		// still fits into the same size class
+		if( memhdr->slab && size <= ZONE_MAX_SMALL && ( size - 1 ) / ZONE_CLASS_SIZE == ( memhdr->size - 1 ) / ZONE_CLASS_SIZE )
+		{
+			if( size > memhdr->size )
+				memset( (byte *)ptr + memhdr->size, 0, size - memhdr->size );
+			Mem_CountAlloc( memhdr->owner, memhdr->target, (long)size - (long)memhdr->size );
+			memhdr->size = size;
+			return ptr;
+		}
 	}
 
 	mem = Mem_Alloc( size, target );
@@ -130,26 +327,192 @@ void *Mem_Realloc( void *ptr, size_t size, unsigned int target )
 	return mem;
 }
 
+/*
+=============
+Mem_Free
+
+category is taken from the block header,
+caller's target is kept for compatibility
+=============
+*/
 void Mem_Free( void *ptr, unsigned int target )
 {
-	memhdr_t	*chunk;
+	zonecache_t	*cache = &g_zonecache[t_zoneslot];
+	memhdr_t		*chunk;
 
 	if( !ptr ) return;
 
 	chunk = (memhdr_t *)((byte *)ptr - sizeof( memhdr_t ));
+	Mem_CountAlloc( chunk->owner, chunk->target, -(long)chunk->size );
+#ifdef ZONE_DEBUG
+	cache->c_alloc[chunk->target]--;
+#endif
+	if( chunk->slab )
+	{
+		zonecache_t	*owner = &g_zonecache[chunk->owner];
+		zoneslab_t	*slab = chunk->slab;	// block may be reused as soon as it's pushed
+
+		if( owner == cache )
+		{
+			int	cls = (int)(( chunk->size - 1 ) / ZONE_CLASS_SIZE );
+
+			*(memhdr_t **)( chunk + 1 ) = cache->freelist[cls];
+			cache->freelist[cls] = chunk;
+		}
+		else
+		{
+			memhdr_t	*head;
+
+			// foreign block, hand it back to the slot that owns the slab
+			do {
+				head = owner->remote;
+				*(memhdr_t **)( chunk + 1 ) = head;
+			} while( InterlockedCompareExchangePointer( (void * volatile *)&owner->remote, chunk, head ) != head );
+		}
+
+		// dropped after the push, so an empty slab has no blocks in flight
+		InterlockedDecrement( (long *)&slab->live );
+	}
+	else
+	{
+		free( chunk );
+	}
+}
+
+/*
+=============
+Mem_ResetSlot
+
+release the fully unused slabs of the slot.
+only the owner thread may call it, other
+threads are allowed to free the blocks
+=============
+*/
+static void Mem_ResetSlot( zonecache_t *cache )
+{
+	zoneslab_t	**prev, *slab;
+	int		j;
+
+	// only the owner allocates from the slabs, so
+	// the empty ones can't be refilled during reset
+	for( slab = cache->slabs; slab != NULL; slab = slab->next )
+		slab->empty = ( slab->live == 0 );
+
+	Mem_DrainRemote( cache );
+
+	// unlink free blocks that belongs to empty slabs
+	for( j = 0; j < ZONE_NUM_CLASSES; j++ )
+	{
+		memhdr_t	**link = &cache->freelist[j];
+		memhdr_t	*chunk;
+
+		while(( chunk = *link ) != NULL )
+		{
+			memhdr_t	*next = *(memhdr_t **)( chunk + 1 );
+
+			if( chunk->slab->empty )
+				*link = next;
+			else link = (memhdr_t **)( chunk + 1 );
+		}
+	}
+
+	prev = &cache->slabs;
+
+	while(( slab = *prev ) != NULL )
+	{
+		if( !slab->empty )
+		{
+			prev = &slab->next;
+			continue;
+		}
+
+		if( cache->current == slab )
+			cache->current = NULL;
+		*prev = slab->next;
+		free( slab );
+	}
+}
+
+/*
+=============
+Mem_ResetThreadArena
+
+release the empty slabs of the calling
+thread while the others are still running
+=============
+*/
+void Mem_ResetThreadArena( void )
+{
+	Mem_ResetSlot( &g_zonecache[t_zoneslot] );
+}
+
+/*
+=============
+Mem_ResetArenas
+
+release all the fully unused slabs.
+must be called between stages
+when no threads are running
+=============
+*/
+void Mem_ResetArenas( void )
+{
+	for( int i = 0; i < ZONE_MAX_SLOTS; i++ )
+		Mem_ResetSlot( &g_zonecache[i] );
+}
+
+// each slot keeps its own peak, they may happen at different
+// moments so their sum can exceed the real peak of the process
+static void Mem_Totals( long *active, long *peakactive, int *c_alloc )
+{
+	*active = *peakactive = 0;
+
+	for( int i = 0; i < ZONE_MAX_SLOTS; i++ )
+	{
+		*active += g_zonecache[i].active + g_zonecache[i].remoteactive;
+		*peakactive += g_zonecache[i].peakactive;
 #ifdef ZONE_DEBUG
-	ThreadLock();
-	total_active -= chunk->size;
-	c_alloc[target]--;
-	ThreadUnlock();
+		if( !c_alloc ) continue;
+
+		for( int j = 0; j < C_MAXSTAT; j++ )
+			c_alloc[j] += g_zonecache[i].c_alloc[j];
 #endif
-	free( chunk );
+	}
+}
+
+/*
+=============
+Mem_GetStats
+
+totals and per-category usage in bytes,
+peaks are the sum of the slot peaks
+=============
+*/
+void Mem_GetStats( memstats_t *stats )
+{
+	memset( stats, 0, sizeof( *stats ));
+	Mem_Totals( &stats->active, &stats->peakactive, NULL );
+
+	for( int i = 0; i < ZONE_MAX_SLOTS; i++ )
+	{
+		for( int j = 0; j < C_MAXSTAT; j++ )
+		{
+			stats->catactive[j] += g_zonecache[i].catactive[j] + g_zonecache[i].remotecat[j];
+			stats->catpeak[j] += g_zonecache[i].catpeak[j];
+		}
+	}
 }
 
 void Mem_Check( void )
 {
 #ifdef ZONE_DEBUG
-	MsgDev( D_INFO, "active memory %s, peak memory %s\n", Q_memprint( total_active ), Q_memprint( total_peakactive ));
+	int	c_alloc[C_MAXSTAT];
+	long	active, peakactive;
+
+	memset( c_alloc, 0, sizeof( c_alloc ));
+	Mem_Totals( &active, &peakactive, c_alloc );
+
+	MsgDev( D_INFO, "active memory %s, peak memory %s\n", Q_memprint( active ), Q_memprint( peakactive ));
 	for( int i = 0; i < C_MAXSTAT; i++ )
 	{
 		if( c_alloc[i] ) MsgDev( D_REPORT, "%s memory allocations leaks count: %d\n", c_stats[i], c_alloc[i] );
@@ -160,7 +523,10 @@ void Mem_Check( void )
 void Mem_Peak( void )
 {
 #ifdef ZONE_DEBUG
-	MsgDev( D_INFO, "active memory %s, peak memory %s\n", Q_memprint( total_active ), Q_memprint( total_peakactive ));
+	long	active, peakactive;
+
+	Mem_Totals( &active, &peakactive, NULL );
+	MsgDev( D_INFO, "active memory %s, peak memory %s\n", Q_memprint( active ), Q_memprint( peakactive ));
 #endif
 }
 
@@ -173,4 +539,4 @@ size_t Mem_Size( void *ptr )
 	chunk = (memhdr_t *)((byte *)ptr - sizeof( memhdr_t ));
 
 	return chunk->size;
-}
\ No newline at end of file
+}
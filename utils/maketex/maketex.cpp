@@ -23,6 +23,8 @@ GNU General Public License for more details.
 #include "stringlib.h"
 #include "filesystem.h"
 #include "imagelib.h"
+#include "threads.h"
+#include "ddstex.h"
 
 int processed_files = 0;
 int processed_errors = 0;
@@ -305,6 +307,25 @@ int main( int argc, char **argv )
 		{
 			no_mips = true;
 		}
+		else if( !Q_stricmp( argv[i], "-fast" ))
+		{
+			g_dxtquality = DXT_QUALITY_FAST;
+		}
+		else if( !Q_stricmp( argv[i], "-quality" ))
+		{
+			g_dxtquality = bound( DXT_QUALITY_FAST, atoi( argv[i+1] ), DXT_QUALITY_HIGH );
+			i++;
+		}
+		else if( !Q_stricmp( argv[i], "-cache" ))
+		{
+			Q_strncpy( g_dxtcache, argv[i+1], sizeof( g_dxtcache ));
+			i++;
+		}
+		else if( !Q_stricmp( argv[i], "-threads" ))
+		{
+			g_numthreads = atoi( argv[i+1] );
+			i++;
+		}
 		else if( !srcset )
 		{
 			Q_strncpy( srcpath, argv[i], sizeof( srcpath ));
@@ -327,6 +348,10 @@ int main( int argc, char **argv )
 		"^2-dev^7 - shows developer messages\n"
 		"^2-sdf^7 - create signed distance field from alpha-channel\n"
 		"^2-nomips^7 - don't build mip-levels for cubemaps\n"
+		"^2-fast^7 - fast low quality compression for previews\n"
+		"^2-quality^7 - compression quality 0-2 (default is 2)\n"
+		"^2-cache^7 - folder to reuse already compressed images\n"
+		"^2-threads^7 - manually specify the number of threads to run\n"
 		"\t\tPress any key to exit" );
 
 		system( "pause>nul" );
@@ -335,6 +360,7 @@ int main( int argc, char **argv )
 	else
 	{
 		BuildGammaTable();	// init gamma conversion helper
+		ThreadSetDefault();
 
 		start = I_FloatTime();
 		ProcessFiles( srcpath, "dds" );
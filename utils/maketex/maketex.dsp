@@ -116,6 +116,10 @@ SOURCE=..\common\conprint.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\crc32.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\ddstex.cpp
 # End Source File
 # Begin Source File
@@ -148,6 +152,10 @@ SOURCE=..\common\stringlib.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\threads.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\virtualfs.cpp
 # End Source File
 # Begin Source File
@@ -86,6 +86,7 @@ typedef struct surface_s
 					// as a splitting node
 	int		detaillevel;	// minimum detail level of its faces
 	face_t		*faces;		// links to all the faces on either side of the surf
+	double		splitvalue[2];	// used by ChoosePlaneFromList
 } surface_t;
 
 // detail brushes stuff
@@ -174,6 +175,7 @@ void SplitFaceEpsilon( face_t *in, plane_t *split, face_t **front, face_t **back
 void DivideFacet( face_t *in, plane_t *split, face_t **front, face_t **back );
 void CalcSurfaceInfo( surface_t *surf );
 void SubdivideFace( face_t *f, face_t **prevptr );
+void CalcMaxNodeSize( tree_t *tree );
 void SolidBSP( tree_t *tree, int modnum, int hullnum );
 vec_t SplitPlaneMetric( const plane_t *p, const vec3_t mins, const vec3_t maxs );
 void MakeNodePortal( node_t *node );
@@ -192,8 +194,34 @@ void MergeTreeFaces( tree_t *tree );
 
 // surfaces.c
 
+// spatial hash of points, entries are numbered in insertion order
+typedef struct
+{
+	vec3_t		*points;
+	int		*next;		// next entry in the same bucket
+	int		*buckets;		// first entry in the bucket or -1
+	int		numbuckets;	// always power of two
+	int		numentries;
+	int		maxentries;
+	vec_t		epsilon;		// points closer than epsilon are matched
+} vechash_t;
+
+typedef struct
+{
+	int		buckets[8];
+	int		numbuckets;
+	int		current;
+	int		entry;
+	vec3_t		point;
+} vechashiter_t;
+
 extern	int		firstmodeledge;
 
+void VecHash_Init( vechash_t *hash, vec_t epsilon, int expected );
+void VecHash_Free( vechash_t *hash );
+int VecHash_Insert( vechash_t *hash, const vec3_t point );
+int VecHash_First( const vechash_t *hash, const vec3_t point, vechashiter_t *it );
+int VecHash_Next( const vechash_t *hash, vechashiter_t *it );
 void SubdivideFaces (surface_t *surfhead);
 int GetEdge (vec3_t p1, vec3_t p2, face_t *f);
 void GatherTreeFaces( tree_t *tree );
@@ -249,6 +277,7 @@ void WriteDrawNodes (node_t *headnode);
 
 void EmitDrawNodes( tree_t *tree );
 void EmitClipNodes( tree_t *tree, int modnum, int hullnum );
+void FlushClipNodes( void );
 void EmitNodeFaces( node_t *headnode );
 int EmitVertex( const vec3_t point );
 void BeginBSPFile( void );
@@ -272,9 +301,10 @@ extern int	g_maxnode_size;
 extern int	g_merge_level;
 extern vec_t	g_prtepsilon;
 
-extern int	valid;
-extern int	c_splitnodes;
-extern int	c_unsplitted_faces;
+// hulls are built in parallel, so tree building state is per-thread
+extern THREAD_LOCAL int	valid;
+extern THREAD_LOCAL int	c_splitnodes;
+extern THREAD_LOCAL int	c_unsplitted_faces;
 
 extern char	g_portfilename[1024];
 extern char	g_pointfilename[1024];
@@ -282,7 +312,7 @@ extern char	g_linefilename[1024];
 
 extern plane_t	g_mapplanes[MAX_INTERNAL_MAP_PLANES];
 extern int	g_nummapplanes;
-extern node_t	g_outside_node;
+extern THREAD_LOCAL node_t	g_outside_node;
 
 void AddFaceToBounds( face_t *f, vec3_t mins, vec3_t maxs );
 
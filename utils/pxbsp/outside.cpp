@@ -10,16 +10,16 @@
 
 #include "bsp5.h"
 
-int	outleafs;
-int	valid;
-int	c_falsenodes;
-int	c_free_faces;
-int	c_keep_faces;
-portal_t	*prevleaknode;
-FILE	*pointfile = NULL;
-FILE	*linefile = NULL;
-int	hit_occupied;
-int	backdraw;
+THREAD_LOCAL int		outleafs;
+THREAD_LOCAL int		valid;
+THREAD_LOCAL int		c_falsenodes;
+THREAD_LOCAL int		c_free_faces;
+THREAD_LOCAL int		c_keep_faces;
+THREAD_LOCAL portal_t	*prevleaknode;
+FILE		*pointfile = NULL;	// only drawing hull writes leaks
+FILE		*linefile = NULL;
+THREAD_LOCAL int		hit_occupied;
+THREAD_LOCAL int		backdraw;
 
 /*
 ===========
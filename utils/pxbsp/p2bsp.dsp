@@ -175,6 +175,10 @@ SOURCE=.\surfaces.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\telemetry.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\threads.cpp
 # End Source File
 # Begin Source File
@@ -215,6 +219,10 @@ SOURCE=..\common\scriplib.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\telemetry.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\threads.h
 # End Source File
 # End Group
@@ -11,6 +11,8 @@
 #include "bsp5.h"
 
 #define MarkFacesCount( mf )	( (mf) ? mf->count : 0 )
+#define PARALLEL_MIN_PLANES	64	// don't spawn tasks for small nodes
+#define PARALLEL_MIN_CHUNK	16	// planes per task
 
 typedef struct
 {
@@ -41,14 +43,18 @@ typedef struct
 	bool		dontbuild;
 	vec_t		epsilon;		// if a face is not epsilon far from the splitting plane, put it in result.middle
 	surfnode_t	*headnode;
+	markfaces_t	*allfaces;	// result of every test when tree is not built
+} surftree_t;
 
-	// result
+// result of the TestSurfaceTree, tree can be tested from several threads
+typedef struct
+{
 	int		frontsize;
 	int		backsize;
-	markfaces_t	*middle;	// may contains coplanar faces and discardable(SOLIDHINT) faces
-} surftree_t;
+	markfaces_t	middle;		// may contains coplanar faces and discardable(SOLIDHINT) faces
+	face_t		**faces;		// middle or allfaces
+} surftest_t;
 
-static double	g_splitvalue[MAX_INTERNAL_MAP_PLANES][2];
 
 // organize all surfaces into a tree structure to accelerate intersection test
 // can reduce more than 90% compile time for very complicated maps
@@ -237,7 +243,7 @@ surftree_t *BuildSurfaceTree( surface_t *surfaces, vec_t epsilon )
 
 	tree->headnode = AllocSurfNode();
 	tree->headnode->leaffaces = AllocMarkFaces();
-	tree->middle = AllocMarkFaces();
+	tree->allfaces = AllocMarkFaces();
 	tree->epsilon = epsilon;
 
 	for( p2 = surfaces; p2 != NULL; p2 = p2->next )
@@ -248,24 +254,20 @@ surftree_t *BuildSurfaceTree( surface_t *surfaces, vec_t epsilon )
 		for( f = p2->faces; f != NULL; f = f->next )
 		{
 			InsertMarkFace( tree->headnode->leaffaces, f );
-			InsertMarkFace( tree->middle, f );
+			InsertMarkFace( tree->allfaces, f );
 		}
 	}
 
 	tree->dontbuild = MarkFacesCount( tree->headnode->leaffaces ) < 20;
 	BuildSurfaceTree_r( tree, tree->headnode );
 
-	if( tree->dontbuild )
-	{
-		tree->backsize = 0;
-		tree->frontsize = 0;
-	}
-	else ClearMarkFaces( tree->middle );
+	if( !tree->dontbuild )
+		ClearMarkFaces( tree->allfaces );
 
 	return tree;
 }
 
-void TestSurfaceTree_r( surftree_t *tree, const surfnode_t *node, const plane_t *split )
+void TestSurfaceTree_r( const surftree_t *tree, surftest_t *test, const surfnode_t *node, const plane_t *split )
 {
 	vec_t	low, high;
 	face_t	**fp;
@@ -291,15 +293,15 @@ void TestSurfaceTree_r( surftree_t *tree, const surfnode_t *node, const plane_t
 
 	if( low > tree->epsilon )
 	{
-		tree->frontsize += node->size;
-		tree->frontsize -= node->size_discardable;
+		test->frontsize += node->size;
+		test->frontsize -= node->size_discardable;
 		return;
 	}
 
 	if( high < -tree->epsilon )
 	{
-		tree->backsize += node->size;
-		tree->backsize -= node->size_discardable;
+		test->backsize += node->size;
+		test->backsize -= node->size_discardable;
 		return;
 	}
 
@@ -307,29 +309,34 @@ void TestSurfaceTree_r( surftree_t *tree, const surfnode_t *node, const plane_t
 	{
 		for( fp = node->leaffaces->array; fp && *fp != NULL; fp++ )
 		{
-			InsertMarkFace( tree->middle, *fp );
+			InsertMarkFace( &test->middle, *fp );
 		}
 	}
 	else
 	{
 		for( fp = node->nodefaces->array; fp && *fp != NULL; fp++ )
 		{
-			InsertMarkFace( tree->middle, *fp );
+			InsertMarkFace( &test->middle, *fp );
 		}
 
-		TestSurfaceTree_r( tree, node->children[0], split );
-		TestSurfaceTree_r( tree, node->children[1], split );
+		TestSurfaceTree_r( tree, test, node->children[0], split );
+		TestSurfaceTree_r( tree, test, node->children[1], split );
 	}
 }
 
-void TestSurfaceTree( surftree_t *tree, const plane_t *split )
+void TestSurfaceTree( const surftree_t *tree, surftest_t *test, const plane_t *split )
 {
+	test->backsize = test->frontsize = 0;
+
 	if( tree->dontbuild )
+	{
+		test->faces = tree->allfaces->array;
 		return;
+	}
 
-	ClearMarkFaces( tree->middle );
-	tree->backsize = tree->frontsize = 0;
-	TestSurfaceTree_r( tree, tree->headnode, split );
+	ClearMarkFaces( &test->middle );
+	TestSurfaceTree_r( tree, test, tree->headnode, split );
+	test->faces = test->middle.array;
 }
 
 void DeleteSurfaceTree_r( surfnode_t *node )
@@ -352,7 +359,7 @@ void DeleteSurfaceTree( surftree_t *tree )
 {
 	DeleteSurfaceTree_r( tree->headnode );
 	FreeSurfNode( tree->headnode );
-	FreeMarkFaces( &tree->middle );
+	FreeMarkFaces( &tree->allfaces );
 	Mem_Free( tree, C_BSPTREE );
 }
 
@@ -431,10 +438,12 @@ surface_t *ChooseMidPlaneFromList( surface_t *surfaces, const vec3_t mins, const
 	vec_t		bestvalue, value;
 	plane_t		*plane;
 	surftree_t	*surfacetree;
+	surftest_t	test;
 	vec_t		dist;
 	face_t		*f, **fp;
 
 	surfacetree = BuildSurfaceTree( surfaces, BSPCHOP_EPSILON );
+	memset( &test, 0, sizeof( test ));
 
 	// pick the plane that splits the least
 	bestsurface = NULL;
@@ -466,11 +475,11 @@ surface_t *ChooseMidPlaneFromList( surface_t *surfaces, const vec3_t mins, const
 		double	backcount = 0;
 		double	coplanarcount = 0;
 
-		TestSurfaceTree( surfacetree, plane );
-		frontcount += surfacetree->frontsize;
-		backcount += surfacetree->backsize;
+		TestSurfaceTree( surfacetree, &test, plane );
+		frontcount += test.frontsize;
+		backcount += test.backsize;
 
-		for( fp = surfacetree->middle->array; fp && *fp != NULL; fp++ )
+		for( fp = test.faces; fp && *fp != NULL; fp++ )
 		{
 			f = *fp;
 
@@ -514,11 +523,115 @@ surface_t *ChooseMidPlaneFromList( surface_t *surfaces, const vec3_t mins, const
 		bestsurface = p;
 	}
 
+	ClearMarkFaces( &test.middle );
 	DeleteSurfaceTree( surfacetree );
 
 	return bestsurface;
 }
 
+/*
+==================
+CalcSurfaceSplitValue
+
+fill the split values of surface,
+returns number of the splitted faces
+==================
+*/
+static double CalcSurfaceSplitValue( const surftree_t *surfacetree, surftest_t *test, surface_t *p )
+{
+	double	crosscount = 0;
+	double	frontcount = 0;
+	double	backcount = 0;
+	double	coplanarcount = 0;
+	double	epsilonsplit = 0;
+	double	totalsplit = 0;
+	plane_t	*plane;
+	face_t	*f, **fp;
+	vec_t	value;
+
+	plane = &g_mapplanes[p->planenum];
+
+	for( f = p->faces; f != NULL; f = f->next )
+	{
+		if( f->facestyle == face_discardable )
+			continue;
+		coplanarcount++;
+	}
+
+	TestSurfaceTree( surfacetree, test, plane );
+
+	frontcount += test->frontsize;
+	backcount += test->backsize;
+
+	for( fp = test->faces; fp && *fp != NULL; fp++ )
+	{
+		f = *fp;
+
+		if( f->planenum == p->planenum || f->planenum == ( p->planenum ^ 1 ))
+			continue;
+
+		if( f->facestyle == face_discardable )
+		{
+			FaceSide( f, plane, &epsilonsplit );
+			continue;
+		}
+
+		switch( FaceSide( f, plane, &epsilonsplit ))
+		{
+		case SIDE_FRONT:
+			frontcount++;
+			break;
+		case SIDE_BACK:
+			backcount++;
+			break;
+		case SIDE_ON:
+			totalsplit++;
+			crosscount++;
+			break;
+		}
+	}
+
+	value = crosscount - sqrt( coplanarcount ); // Not optimized. --vluzacn
+	if( coplanarcount == 0 ) crosscount += 1;
+
+	// This is the most efficient code among what I have ever tested:
+	// (1) BSP file is small, despite possibility of slowing down vis and rad
+	// (but still faster than the original non BSP balancing method).
+	// (2) Factors need not adjust across various maps.
+	double	frac = (coplanarcount / 2 + crosscount / 2 + frontcount) / (coplanarcount + frontcount + backcount + crosscount);
+	double	ent = 0.0;
+
+	if( frac > 0.0001 && frac < 0.9999 )
+		ent = (-frac * log( frac ) / log( 2.0 ) - (1.0 - frac) * log( 1.0 - frac ) / log( 2.0 ));
+	p->splitvalue[1] = crosscount * (1.0 - ent);
+	value += epsilonsplit * 10000;
+	p->splitvalue[0] = value;
+
+	return totalsplit;
+}
+
+typedef struct
+{
+	const surftree_t	*surfacetree;
+	surface_t		**planes;
+	double		*splits;
+	int		first;
+	int		last;
+} splittask_t;
+
+static void CalcSplitValuesTask( void *data )
+{
+	splittask_t	*st = (splittask_t *)data;
+	surftest_t	test;
+
+	memset( &test, 0, sizeof( test ));
+
+	for( int i = st->first; i < st->last; i++ )
+		st->splits[i] = CalcSurfaceSplitValue( st->surfacetree, &test, st->planes[i] );
+
+	ClearMarkFaces( &test.middle );
+}
+
 /*
 ==================
 ChoosePlaneFromList
@@ -529,101 +642,82 @@ Choose the plane that splits the least faces
 surface_t *ChoosePlaneFromList( surface_t *surfaces, const vec3_t mins, const vec3_t maxs, int detaillevel )
 {
 	surface_t		*p, *bestsurface;
+	surface_t		**planes;
 	vec_t		value, bestvalue;
 	double		totalsplit;
 	double		avesplit;
-	double		planecount;
+	double		*splits;
+	int		planecount;
 	surftree_t*	surfacetree;
-	plane_t		*plane;
-	face_t		*f, **fp;
+	splittask_t	tasks[MAX_THREADS];
+	threadtask_t	*handles[MAX_THREADS];
+	int		i, numtasks;
 
-	planecount = totalsplit = 0;
+	planecount = 0;
+	totalsplit = 0;
 	surfacetree = BuildSurfaceTree( surfaces, BSPCHOP_EPSILON );
 
-	// pick the plane that splits the least
-	bestvalue = 9e30;
-	bestsurface = NULL;
-
 	for( p = surfaces; p != NULL; p = p->next )
 	{
 		if( p->onnode || p->detaillevel != detaillevel )
 			continue;
-
 		planecount++;
+	}
 
-		double	crosscount = 0;
-		double	frontcount = 0;
-		double	backcount = 0;
-		double	coplanarcount = 0;
-		double	epsilonsplit = 0;
-
-		plane = &g_mapplanes[p->planenum];
-
-		for( f = p->faces; f != NULL; f = f->next )
-		{
-			if( f->facestyle == face_discardable )
-				continue;
-			coplanarcount++;
-		}
-
-		TestSurfaceTree( surfacetree, plane );
+	planes = (surface_t **)Mem_Alloc( Q_max( planecount, 1 ) * sizeof( surface_t* ));
+	splits = (double *)Mem_Alloc( Q_max( planecount, 1 ) * sizeof( double ));
 
-		frontcount += surfacetree->frontsize;
-		backcount += surfacetree->backsize;
+	for( p = surfaces, i = 0; p != NULL; p = p->next )
+	{
+		if( p->onnode || p->detaillevel != detaillevel )
+			continue;
+		planes[i++] = p;
+	}
 
-		for( fp = surfacetree->middle->array; fp && *fp != NULL; fp++ )
-		{
-			f = *fp;
+	// every plane is tested independently, so big nodes
+	// can be splitted between the threads
+	numtasks = 1;
+	if( planecount >= PARALLEL_MIN_PLANES && g_numthreads > 1 )
+		numtasks = bound( 1, planecount / PARALLEL_MIN_CHUNK, g_numthreads );
 
-			if( f->planenum == p->planenum || f->planenum == ( p->planenum ^ 1 ))
-				continue;
+	for( i = 0; i < numtasks; i++ )
+	{
+		tasks[i].surfacetree = surfacetree;
+		tasks[i].planes = planes;
+		tasks[i].splits = splits;
+		tasks[i].first = planecount * i / numtasks;
+		tasks[i].last = planecount * ( i + 1 ) / numtasks;
+		handles[i] = NULL;
+	}
 
-			if( f->facestyle == face_discardable )
-			{
-				FaceSide( f, plane, &epsilonsplit );
-				continue;
-			}
+	for( i = 1; i < numtasks; i++ )
+	{
+		if(( handles[i] = ThreadSpawnTask( CalcSplitValuesTask, &tasks[i] )) == NULL )
+			break; // no free threads
+	}
 
-			switch( FaceSide( f, plane, &epsilonsplit ))
-			{
-			case SIDE_FRONT:
-				frontcount++;
-				break;
-			case SIDE_BACK:
-				backcount++;
-				break;
-			case SIDE_ON:
-				totalsplit++;
-				crosscount++;
-				break;
-			}
-		}
+	CalcSplitValuesTask( &tasks[0] );
 
-		value = crosscount - sqrt( coplanarcount ); // Not optimized. --vluzacn
-		if( coplanarcount == 0 ) crosscount += 1;
-
-		// This is the most efficient code among what I have ever tested:
-		// (1) BSP file is small, despite possibility of slowing down vis and rad
-		// (but still faster than the original non BSP balancing method).
-		// (2) Factors need not adjust across various maps.
-		double	frac = (coplanarcount / 2 + crosscount / 2 + frontcount) / (coplanarcount + frontcount + backcount + crosscount);
-		double	ent = 0.0;
-
-		if( frac > 0.0001 && frac < 0.9999 )
-			ent = (-frac * log( frac ) / log( 2.0 ) - (1.0 - frac) * log( 1.0 - frac ) / log( 2.0 ));
-		g_splitvalue[p->planenum][1] = crosscount * (1.0 - ent);
-		value += epsilonsplit * 10000;
-		g_splitvalue[p->planenum][0] = value;
+	for( i = 1; i < numtasks; i++ )
+	{
+		if( handles[i] ) ThreadWaitTask( handles[i] );
+		else CalcSplitValuesTask( &tasks[i] );
 	}
 
+	// sum in the list order, same as sequental test
+	for( i = 0; i < planecount; i++ )
+		totalsplit += splits[i];
+
 	avesplit = totalsplit / planecount;
 
-	for( p = surfaces; p != NULL; p = p->next )
-	{
-		if( p->onnode || p->detaillevel != detaillevel )
-			continue;
+	// pick the plane that splits the least
+	bestvalue = 9e30;
+	bestsurface = NULL;
 
-		value = g_splitvalue[p->planenum][0] + avesplit * g_splitvalue[p->planenum][1];
+	for( i = 0; i < planecount; i++ )
+	{
+		p = planes[i];
+		value = p->splitvalue[0] + avesplit * p->splitvalue[1];
 
 		if( value < bestvalue )
 		{
@@ -635,6 +729,8 @@ surface_t *ChoosePlaneFromList( surface_t *surfaces, const vec3_t mins, const ve
 	if( !bestsurface )
 		COM_FatalError( "ChoosePlaneFromList: no valid planes\n" );
 
+	Mem_Free( planes );
+	Mem_Free( splits );
 	DeleteSurfaceTree( surfacetree );
 
 	return bestsurface;
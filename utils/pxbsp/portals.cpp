@@ -11,7 +11,7 @@
 #include "bsp5.h"
 
 
-node_t	g_outside_node;		// portals outside the world face this
+THREAD_LOCAL node_t	g_outside_node;	// portals outside the world face this
 
 //=============================================================================
 /*
@@ -130,12 +130,21 @@ void MakeHeadnodePortals( node_t *node, const vec3_t mins, const vec3_t maxs )
 	}		
 
 	// clip the basewindings by all the other planes
-	for( i = 0; i < 6; i++ )
+	for( j = 0; j < 6; j++ )
 	{
-		for( j = 0; j < 6; j++ )
+		winding_t	*windings[5];
+		int	count = 0;
+
+		for( i = 0; i < 6; i++ )
+		{
+			if( i != j ) windings[count++] = portals[i]->winding;
+		}
+
+		ChopWindingsInPlace( windings, count, bplanes[j].normal, bplanes[j].dist, g_prtepsilon );
+
+		for( i = count = 0; i < 6; i++ )
 		{
-			if( j == i ) continue;
-			ChopWindingInPlace( &portals[i]->winding, bplanes[j].normal, bplanes[j].dist, g_prtepsilon );
+			if( i != j ) portals[i]->winding = windings[count++];
 		}
 	}
 }
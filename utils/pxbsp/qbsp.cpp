@@ -11,6 +11,7 @@
 // qbsp.c
 
 #include "bsp5.h"
+#include "telemetry.h"
 
 //
 // command line flags
@@ -172,9 +173,10 @@ void SplitFace( face_t *in, plane_t *split, face_t **front, face_t **back, bool
 
 //===========================================================================
 
-int	c_activefaces, c_peakfaces;
-int	c_activesurfaces, c_peaksurfaces;
-int	c_activeportals, c_peakportals;
+// counted for each thread
+THREAD_LOCAL int	c_activefaces, c_peakfaces;
+THREAD_LOCAL int	c_activesurfaces, c_peaksurfaces;
+THREAD_LOCAL int	c_activeportals, c_peakportals;
 
 void PrintMemory( void )
 {
@@ -365,30 +367,81 @@ void FreeLeaf( node_t *n )
 }
 
 //===========================================================================
+typedef struct
+{
+	FILE	*polyfile;
+	FILE	*brushfile;
+	tree_t	*tree;		// already readed tree
+	msgbuf_t	output;		// messages of the hull thread
+} hullfile_t;
+
+static hullfile_t	g_hullfiles[MAX_MAP_HULLS];
+
 /*
 =================
-CreateSingleHull
+OpenHullFiles
 =================
 */
-void CreateSingleHull( const char *source, int hullnum )
+static void OpenHullFiles( const char *source, int hullnum )
 {
-	int	modnum = 0;
-	FILE	*brushfile;
-	FILE	*polyfile;
-	char	name[1024];
-	tree_t	*tree;
+	hullfile_t	*hf = &g_hullfiles[hullnum];
+	char		name[1024];
 
-	Msg( "CreateHull: %i\n", hullnum );
+	Q_snprintf( name, sizeof( name ), "%s.p%i", source, hullnum );
+	hf->polyfile = fopen( name, "r" );
+	if( !hf->polyfile ) COM_FatalError( "Can't open %s", name );
+
+	Q_snprintf( name, sizeof( name ), "%s.b%i", source, hullnum );
+	hf->brushfile = fopen( name, "r" );
+	if( !hf->brushfile ) COM_FatalError( "Can't open %s", name );
+
+	hf->tree = NULL;
+}
+
+/*
+=================
+CloseHullFiles
+=================
+*/
+static void CloseHullFiles( const char *source, int hullnum )
+{
+	hullfile_t	*hf = &g_hullfiles[hullnum];
+	char		name[1024];
 
 	Q_snprintf( name, sizeof( name ), "%s.p%i", source, hullnum );
-	polyfile = fopen( name, "r" );
-	if( !polyfile ) COM_FatalError( "Can't open %s", name );
+	fclose( hf->polyfile );
+	unlink( name );
 
 	Q_snprintf( name, sizeof( name ), "%s.b%i", source, hullnum );
-	brushfile = fopen( name, "r" );
-	if( !brushfile ) COM_FatalError( "Can't open %s", name );
+	fclose( hf->brushfile );
+	unlink( name );
+
+	memset( hf, 0, sizeof( *hf ));
+}
 
-	while(( tree = MakeTreeFromHullFaces( polyfile, brushfile )) != NULL )
+/*
+=================
+CreateSingleHull
+
+drawing hull emits nodes and faces directly,
+clipping hulls are collected for FlushClipNodes
+=================
+*/
+static void CreateSingleHull( int hullnum, int threadnum )
+{
+	hullfile_t	*hf = &g_hullfiles[hullnum];
+	int		modnum = 0;
+	tree_t		*tree;
+
+	// printed by ProcessFile when all the hulls are done
+	Sys_BeginCapture( &hf->output );
+	Msg( "CreateHull: %i\n", hullnum );
+
+	if(( tree = hf->tree ) == NULL )
+		tree = MakeTreeFromHullFaces( hf->polyfile, hf->brushfile );
+	hf->tree = NULL;
+
+	while( tree != NULL )
 	{
 		tree = TreeProcessModel( tree, modnum, hullnum );
 	
@@ -397,15 +450,15 @@ void CreateSingleHull( const char *source, int hullnum )
 
 		FreeTree( tree );
 		modnum++;
+
+		tree = MakeTreeFromHullFaces( hf->polyfile, hf->brushfile );
 	}
 
-	Q_snprintf( name, sizeof( name ), "%s.p%i", source, hullnum );
-	fclose( polyfile );
-	unlink( name );
+	Sys_EndCapture();
 
-	Q_snprintf( name, sizeof( name ), "%s.b%i", source, hullnum );
-	fclose( brushfile );
-	unlink( name );
+	// trees of this hull are freed, don't keep the slabs
+	// until the other hulls are finished
+	Mem_ResetThreadArena();
 }
 
 /*
@@ -445,11 +498,31 @@ void ProcessFile( const char *source )
 	// init the tables to be shared by all models
 	BeginBSPFile ();
 
+	for( i = 0; i < MAX_MAP_HULLS; i++ )
+		OpenHullFiles( source, i );
+
+	// all the hulls are using maxnode size of the world
+	if( g_maxnode_size == DEFAULT_MAXNODE_SIZE )
+	{
+		g_hullfiles[0].tree = MakeTreeFromHullFaces( g_hullfiles[0].polyfile, g_hullfiles[0].brushfile );
+		if( g_hullfiles[0].tree ) CalcMaxNodeSize( g_hullfiles[0].tree );
+	}
+
+	// hulls are independent and shares only the planes
+	RunThreadsOnIndividual( MAX_MAP_HULLS, false, CreateSingleHull );
+
 	for( i = 0; i < MAX_MAP_HULLS; i++ )
 	{
-		CreateSingleHull( source, i );
+		Sys_FlushCapture( &g_hullfiles[i].output );
+		CloseHullFiles( source, i );
 	}
 
+	// clipnodes goes after drawing hull
+	FlushClipNodes();
+
+	// release slabs of the trees
+	Mem_ResetArenas();
+
 	// write the updated bsp file out
 	FinishBSPFile( bspfilename );
 
@@ -510,6 +583,7 @@ static void PrintBspUsage( void )
 	Msg( "\n-= p2bsp Options =-\n\n" );
 	Msg( "    -dev #           : compile with developer message (1 - 4). default is %d\n", DEFAULT_DEVELOPER );
 	Msg( "    -threads #       : manually specify the number of threads to run\n" );
+	Msg( "    -report file     : write build statistics to the file\n" );
 	Msg( "    -noclip          : don't create clipping hulls\n" );
 	Msg( "    -notjunc         : don't break edges on t-junctions (not for final runs)\n" );
  	Msg( "    -nofill          : don't fill outside (used for brush models, not levels)\n" );
@@ -530,6 +604,7 @@ main
 */
 int main( int argc, char **argv )
 {
+	char	report[1024];
 	int	i;
 	double	start, end;
 	char	source[1024];
@@ -537,6 +612,7 @@ int main( int argc, char **argv )
 
 	atexit( Sys_CloseLog );
 	source[0] = '\0';
+	report[0] = '\0';
 
 	for( i = 1; i < argc; i++ )
 	{
@@ -550,6 +626,11 @@ int main( int argc, char **argv )
 			g_numthreads = atoi( argv[i+1] );
 			i++;
 		}
+		else if( !Q_strcmp( argv[i], "-report" ))
+		{
+			Q_strncpy( report, argv[i+1], sizeof( report ));
+			i++;
+		}
 		else if( !Q_strcmp( argv[i], "-noclip" ))
 		{
 			g_noclip = true;
@@ -629,5 +710,7 @@ int main( int argc, char **argv )
 	Q_timestring((int)( end - start ), str );
 	Msg( "%s elapsed\n", str );
 
+	Telemetry_WriteReport( report, "p2bsp", end - start );
+
 	return 0;
 }
@@ -20,16 +20,15 @@
 
 */
 
-int		c_leaffaces;
-int		c_nodefaces;
-int		c_splitnodes;
-int		c_clipped_portals;
+THREAD_LOCAL int	c_leaffaces;
+THREAD_LOCAL int	c_nodefaces;
+THREAD_LOCAL int	c_splitnodes;
+THREAD_LOCAL int	c_clipped_portals;
 
 //============================================================================
-static bool	g_report_progress = false;
-static face_t	*markfaces[MAX_MAP_MARKSURFACES + 1];
-static int	dispatch_tree_faces;
-static int	total_tree_faces;
+static THREAD_LOCAL bool	g_report_progress;
+static THREAD_LOCAL int	dispatch_tree_faces;
+static THREAD_LOCAL int	total_tree_faces;
 
 /*
 ==================
@@ -772,31 +771,35 @@ static void MakeLeaf( node_t *leafnode )
 
 	if( !( FBitSet( leafnode->flags, FNODE_LEAFPORTAL ) && leafnode->contents == CONTENTS_SOLID ))
 	{
-		nummarkfaces = 0;
-		for (surf = leafnode->surfaces; surf; surf = surf->next )
+		// first pass count the faces, second pass fill the list
+		for( int pass = 0; pass < 2; pass++ )
 		{
-			if( !surf->onnode )
-				continue;
-
-			for( f = surf->faces; f != NULL; f = f->next )
+			nummarkfaces = 0;
+			for (surf = leafnode->surfaces; surf; surf = surf->next )
 			{
-				if( f->original == NULL )
-				{
-					// because it is not on node or its content is solid
+				if( !surf->onnode )
 					continue;
-				}
 
-				if( nummarkfaces == MAX_MAP_MARKSURFACES )
-					COM_FatalError( "MAX_MAP_MARKSURFACES limit exceeded\n" );
-				markfaces[nummarkfaces++] = f->original;
+				for( f = surf->faces; f != NULL; f = f->next )
+				{
+					if( f->original == NULL )
+					{
+						// because it is not on node or its content is solid
+						continue;
+					}
+
+					if( pass == 1 )
+						leafnode->markfaces[nummarkfaces] = f->original;
+					nummarkfaces++;
+				}
 			}
-		}
 
-		markfaces[nummarkfaces] = NULL; // end marker
-		nummarkfaces++;
+			if( nummarkfaces > MAX_MAP_MARKSURFACES )
+				COM_FatalError( "MAX_MAP_MARKSURFACES limit exceeded\n" );
 
-		leafnode->markfaces = (face_t **)Mem_Alloc( nummarkfaces * sizeof( *leafnode->markfaces ));
-		memcpy( leafnode->markfaces, markfaces, nummarkfaces * sizeof( *leafnode->markfaces ));
+			if( pass == 0 ) // one more for end marker, already cleared
+				leafnode->markfaces = (face_t **)Mem_Alloc(( nummarkfaces + 1 ) * sizeof( *leafnode->markfaces ));
+		}
 	}
 
 	FreeLeafSurfs( leafnode );
@@ -870,6 +873,93 @@ void FixDetaillevelForDiscardable( node_t *node, int detaillevel )
 	}
 }
 
+void BuildBspTree_r( node_t *node, bool subdivide );
+
+#define PARALLEL_MIN_FACES	256	// smaller subtrees are always built in place
+
+typedef struct
+{
+	node_t		*node;
+	bool		subdivide;
+
+	// counters of task thread
+	int		c_leaffaces;
+	int		c_nodefaces;
+	int		c_splitnodes;
+	int		c_unsplitted_faces;
+	int		dispatch_tree_faces;
+} bsptask_t;
+
+static void BuildBspTreeTask( void *data )
+{
+	bsptask_t	*task = (bsptask_t *)data;
+
+	c_leaffaces = c_nodefaces = c_splitnodes = 0;
+	c_unsplitted_faces = dispatch_tree_faces = 0;
+	g_report_progress = false;
+
+	BuildBspTree_r( task->node, task->subdivide );
+
+	task->c_leaffaces = c_leaffaces;
+	task->c_nodefaces = c_nodefaces;
+	task->c_splitnodes = c_splitnodes;
+	task->c_unsplitted_faces = c_unsplitted_faces;
+	task->dispatch_tree_faces = dispatch_tree_faces;
+}
+
+static int CountNodeFaces( const node_t *node )
+{
+	int	count = 0;
+
+	for( surface_t *s = node->surfaces; s != NULL; s = s->next )
+	{
+		for( face_t *f = s->faces; f != NULL; f = f->next )
+			count++;
+	}
+
+	return count;
+}
+
+/*
+==================
+BuildChildren
+
+children without portals doesn't share anything,
+so they can be built on the different threads
+==================
+*/
+static void BuildChildren( node_t *node, bool subdivide )
+{
+	threadtask_t	*handle = NULL;
+	bsptask_t		task;
+
+	if( g_numthreads > 1 && !node->children[0]->portals && !node->children[1]->portals )
+	{
+		if( CountNodeFaces( node->children[0] ) >= PARALLEL_MIN_FACES && CountNodeFaces( node->children[1] ) >= PARALLEL_MIN_FACES )
+		{
+			task.node = node->children[0];
+			task.subdivide = subdivide;
+			handle = ThreadSpawnTask( BuildBspTreeTask, &task );
+		}
+	}
+
+	if( !handle )
+	{
+		BuildBspTree_r( node->children[0], subdivide );
+		BuildBspTree_r( node->children[1], subdivide );
+		return;
+	}
+
+	BuildBspTree_r( node->children[1], subdivide );
+	ThreadWaitTask( handle );
+
+	c_leaffaces += task.c_leaffaces;
+	c_nodefaces += task.c_nodefaces;
+	c_splitnodes += task.c_splitnodes;
+	c_unsplitted_faces += task.c_unsplitted_faces;
+	dispatch_tree_faces += task.dispatch_tree_faces;
+}
+
 /*
 ==================
 BuildBspTree_r
@@ -983,8 +1073,26 @@ void BuildBspTree_r( node_t *node, bool subdivide )
 	}
 
 	// recursively do the children
-	BuildBspTree_r( node->children[0], subdivide );
-	BuildBspTree_r( node->children[1], subdivide );
+	BuildChildren( node, subdivide );
+}
+
+/*
+==================
+CalcMaxNodeSize
+
+calc the maxnode size based on world size
+==================
+*/
+void CalcMaxNodeSize( tree_t *tree )
+{
+	vec3_t	size;
+	vec_t	maxnode;
+
+	VectorSubtract( tree->maxs, tree->mins, size );
+	maxnode = VectorMax( size ) / 8.0; // 8192 / 8 = 1024
+	maxnode = Q_roundup( maxnode, 1024.0 );
+	MsgDev( D_REPORT, "max node size %g\n", maxnode );
+	g_maxnode_size = maxnode;
 }
 
 /*
@@ -999,23 +1107,18 @@ The original surface chain will be completely freed.
 */
 void SolidBSP( tree_t *tree, int modnum, int hullnum )
 {
-	vec3_t	brushmins, brushmaxs, size;
-	bool	report = (modnum == 0);
+	vec3_t	brushmins, brushmaxs;
+	bool	report = (modnum == 0 && hullnum == 0);	// other hulls are built at the same time
 	double	start, end;
 	int	flags = 0;
-	vec_t	maxnode;
 
 	MsgDev( D_REPORT, "----- SolidBSP ----- (hull %i, model %i)\n", hullnum, modnum );
 
 	// calc the maxnode size based on world size
+	// NOTE: hulls are built in parallel, so world
+	// drawing hull should be processed before
 	if( g_maxnode_size == DEFAULT_MAXNODE_SIZE )
-	{
-		VectorSubtract( tree->maxs, tree->mins, size );
-		maxnode = VectorMax( size ) / 8.0; // 8192 / 8 = 1024
-		maxnode = Q_roundup( maxnode, 1024.0 );
-		MsgDev( D_REPORT, "max node size %g\n", maxnode );
-		g_maxnode_size = maxnode;
-	}
+		CalcMaxNodeSize( tree );
 
 	tree->headnode = AllocNode ();
 	tree->headnode->detailbrushes = tree->detailbrushes;
@@ -21,7 +21,7 @@ the outside filling stage can remove some of them so a better bsp can be generat
 
 int	c_totalverts;
 int	c_uniqueverts;
-int	c_unsplitted_faces;
+THREAD_LOCAL int	c_unsplitted_faces;
 
 /*
 ===============
@@ -130,109 +130,242 @@ void SubdivideFace( face_t *f, face_t **prevptr )
 	}
 }
 
+
 //===========================================================================
-#define MAX_HASH		4096
-#define MAX_HASH_NEIGHBORS	4
+#define VECHASH_CELLSIZE	1.0	// integer points are in the middle of the cell
+#define VECHASH_MIN_BUCKETS	1024
 
-typedef struct hashvert_s
+/*
+===============
+VecHash_Cell
+===============
+*/
+static void VecHash_Cell( const vec3_t point, int cell[3] )
 {
-	struct hashvert_s	*next;
-	vec3_t		point;
-	int		planenums[2];
-	int		numplanes;	// for corner determination
-	int		num;
-} hashvert_t;
+	for( int i = 0; i < 3; i++ )
+		cell[i] = (int)floor( point[i] / VECHASH_CELLSIZE + 0.5 );
+}
 
-static face_t	*g_edgefaces[MAX_MAP_EDGES][2];
-static hashvert_t	hvertex[MAX_MAP_VERTS];
-static hashvert_t	*hashverts[MAX_HASH];
-static int	firstmodeledge = 1;
-static int	h_numslots[3];
-static hashvert_t	*hvert_p;
-static vec3_t	h_scale;
-static vec3_t	h_min;
+static int VecHash_Bucket( const vechash_t *hash, const int cell[3] )
+{
+	unsigned int	key;
+
+	key = (unsigned int)cell[0] * 73856093 ^ (unsigned int)cell[1] * 19349663 ^ (unsigned int)cell[2] * 83492791;
+
+	return (int)( key & ( hash->numbuckets - 1 ));
+}
 
-//============================================================================
 /*
 ===============
-InitHash
+VecHash_Rehash
+
+doubles the buckets count, entries keeps their numbers
 ===============
 */
-void InitHash( void )
+static void VecHash_Rehash( vechash_t *hash, int numbuckets )
+{
+	int	cell[3];
+
+	if( hash->buckets ) Mem_Free( hash->buckets );
+	hash->buckets = (int *)Mem_Alloc( numbuckets * sizeof( int ));
+	memset( hash->buckets, 0xFF, numbuckets * sizeof( int ));
+	hash->numbuckets = numbuckets;
+
+	for( int i = 0; i < hash->numentries; i++ )
+	{
+		VecHash_Cell( hash->points[i], cell );
+		int h = VecHash_Bucket( hash, cell );
+		hash->next[i] = hash->buckets[h];
+		hash->buckets[h] = i;
+	}
+}
+
+/*
+===============
+VecHash_Init
+===============
+*/
+void VecHash_Init( vechash_t *hash, vec_t epsilon, int expected )
 {
-	vec_t           volume;
-	vec_t           scale;
-	vec3_t          size;
+	int	numbuckets = VECHASH_MIN_BUCKETS;
+
+	// the match can't be farther than one neighbor cell
+	if( epsilon * 2.0 >= VECHASH_CELLSIZE )
+		COM_FatalError( "VecHash_Init: epsilon %g is too big\n", epsilon );
+
+	while( numbuckets < expected )
+		numbuckets <<= 1;
+
+	memset( hash, 0, sizeof( *hash ));
+	hash->maxentries = Q_max( expected, VECHASH_MIN_BUCKETS );
+	hash->points = (vec3_t *)Mem_Alloc( hash->maxentries * sizeof( vec3_t ));
+	hash->next = (int *)Mem_Alloc( hash->maxentries * sizeof( int ));
+	hash->epsilon = epsilon;
 
-	memset( hashverts, 0, sizeof( hashverts ));
-	VectorFill( h_min, -8000 );
-	VectorFill( size, 16000 );
+	VecHash_Rehash( hash, numbuckets );
+}
 
-	volume = size[0] * size[1];
-	scale = sqrt( volume / MAX_HASH );
+/*
+===============
+VecHash_Free
+===============
+*/
+void VecHash_Free( vechash_t *hash )
+{
+	Mem_Free( hash->points );
+	Mem_Free( hash->next );
+	Mem_Free( hash->buckets );
+	memset( hash, 0, sizeof( *hash ));
+}
 
-	h_numslots[0] = (int)floor( size[0] / scale );
-	h_numslots[1] = (int)floor( size[1] / scale );
+/*
+===============
+VecHash_Insert
 
-	while( h_numslots[0] * h_numslots[1] > MAX_HASH )
+returns number of the new entry
+===============
+*/
+int VecHash_Insert( vechash_t *hash, const vec3_t point )
+{
+	int	cell[3];
+	int	h, num;
+
+	if( hash->numentries == hash->maxentries )
+	{
+		hash->maxentries *= 2;
+		hash->points = (vec3_t *)Mem_Realloc( hash->points, hash->maxentries * sizeof( vec3_t ));
+		hash->next = (int *)Mem_Realloc( hash->next, hash->maxentries * sizeof( int ));
+	}
+
+	num = hash->numentries++;
+	VectorCopy( point, hash->points[num] );
+
+	// keep the chains short
+	if( hash->numentries > hash->numbuckets )
 	{
-		h_numslots[0]--;
-		h_numslots[1]--;
+		VecHash_Rehash( hash, hash->numbuckets * 2 );
+		return num;
 	}
 
-	h_scale[0] = h_numslots[0] / size[0];
-	h_scale[1] = h_numslots[1] / size[1];
-	hvert_p = hvertex;
+	VecHash_Cell( point, cell );
+	h = VecHash_Bucket( hash, cell );
+	hash->next[num] = hash->buckets[h];
+	hash->buckets[h] = num;
+
+	return num;
 }
 
 /*
 ===============
-HashVec
+VecHash_First
 
-returned value: the one bucket that a new vertex may "write" into
-returned hashneighbors: the buckets that we should "read" to check for an existing vertex
+returns the first entry within epsilon or -1,
+lookups don't modify the hash and can be done from any thread
 ===============
 */
-static int HashVec( const vec3_t vec, int *num, int *hash )
+int VecHash_First( const vechash_t *hash, const vec3_t point, vechashiter_t *it )
 {
-	vec_t	normalized[2];
-	int	h, i, x, y;
-	vec_t	sdiff[2];
-	int	slot[2];
+	int	mins[3], maxs[3];
+	int	cell[3], c[3];
+	vec_t	frac;
 
-	for( i = 0; i < 2; i++ )
-	{
-		normalized[i] = h_scale[i] * (vec[i] - h_min[i]);
-		slot[i] = (int)floor( normalized[i] );
-		sdiff[i] = normalized[i] - (vec_t)slot[i];
+	VecHash_Cell( point, cell );
 
-		slot[i] = (slot[i] + h_numslots[i]) % h_numslots[i];
-		slot[i] = (slot[i] + h_numslots[i]) % h_numslots[i]; // do it twice to handle negative values
+	// check the neighbor cell only if point is near the border
+	for( int i = 0; i < 3; i++ )
+	{
+		frac = point[i] - ( cell[i] - 0.5 ) * VECHASH_CELLSIZE;
+		mins[i] = ( frac <= hash->epsilon ) ? cell[i] - 1 : cell[i];
+		maxs[i] = ( VECHASH_CELLSIZE - frac <= hash->epsilon ) ? cell[i] + 1 : cell[i];
 	}
 
-	h = slot[0] * h_numslots[1] + slot[1];
-	*num = 0;
+	it->numbuckets = 0;
 
-	for( x = -1; x <= 1; x++ )
+	for( c[0] = mins[0]; c[0] <= maxs[0]; c[0]++ )
 	{
-		if( x == -1 && sdiff[0] > h_scale[0] * ON_EPSILON || x == 1 && sdiff[0] < 1 - h_scale[0] * ON_EPSILON )
-			continue;
+		for( c[1] = mins[1]; c[1] <= maxs[1]; c[1]++ )
+		{
+			for( c[2] = mins[2]; c[2] <= maxs[2]; c[2]++ )
+			{
+				int	h = VecHash_Bucket( hash, c );
+				int	j;
+
+				// different cells may share the bucket
+				for( j = 0; j < it->numbuckets; j++ )
+				{
+					if( it->buckets[j] == h )
+						break;
+				}
+
+				if( j == it->numbuckets )
+					it->buckets[it->numbuckets++] = h;
+			}
+		}
+	}
+
+	VectorCopy( point, it->point );
+	it->current = 0;
+	it->entry = hash->buckets[it->buckets[0]];
 
-		for( y = -1; y <= 1; y++ )
+	return VecHash_Next( hash, it );
+}
+
+/*
+===============
+VecHash_Next
+===============
+*/
+int VecHash_Next( const vechash_t *hash, vechashiter_t *it )
+{
+	while( it->current < it->numbuckets )
+	{
+		while( it->entry != -1 )
 		{
-			if( y == -1 && sdiff[1] > h_scale[1] * ON_EPSILON || y == 1 && sdiff[1] < 1 - h_scale[1] * ON_EPSILON )
-				continue;
+			int	num = it->entry;
 
-			if( *num >= MAX_HASH_NEIGHBORS )
-				COM_FatalError( "HashVec: internal error\n" );
+			it->entry = hash->next[num];
 
-			hash[*num] = ((slot[0] + x + h_numslots[0]) % h_numslots[0]) * h_numslots[1] +
-				    (slot[1] + y + h_numslots[1]) % h_numslots[1];
-			(*num)++;
+			if( VectorCompareEpsilon( hash->points[num], it->point, hash->epsilon ))
+				return num;
 		}
+
+		if( ++it->current < it->numbuckets )
+			it->entry = hash->buckets[it->buckets[it->current]];
 	}
 
-	return h;
+	return -1;
+}
+
+//===========================================================================
+#define EDGE_HASH_SIZE	0x10000	// must be power of two
+
+typedef struct
+{
+	int		planenums[2];
+	int		numplanes;	// for corner determination
+	int		num;
+} hashvert_t;
+
+static face_t	*g_edgefaces[MAX_MAP_EDGES][2];
+static int	g_edgechain[MAX_MAP_EDGES];	// next edge with the same vertexes, 0 is end
+static int	g_edgehash[EDGE_HASH_SIZE];
+static hashvert_t	hvertex[MAX_MAP_VERTS];
+static vechash_t	hashverts;
+static int	firstmodeledge = 1;
+
+//============================================================================
+/*
+===============
+InitHash
+===============
+*/
+void InitHash( void )
+{
+	if( hashverts.points )
+		VecHash_Free( &hashverts );
+
+	VecHash_Init( &hashverts, ON_EPSILON, 0 );
+	memset( g_edgehash, 0, sizeof( g_edgehash ));
 }
 
 /*
@@ -242,9 +375,8 @@ GetVertex
 */
 static int GetVertex( const vec3_t in, const int planenum )
 {
-	int		hashneighbors[MAX_HASH_NEIGHBORS];
-	int		num_hashneighbors;
-	int		i, h;
+	vechashiter_t	it;
+	int		i, num, best;
 	vec3_t		vert;
 	hashvert_t	*hv;
 
@@ -255,48 +387,46 @@ static int GetVertex( const vec3_t in, const int planenum )
 		else vert[i] = in[i];
 	}
 
-	h = HashVec( vert, &num_hashneighbors, hashneighbors );
+	// pick the oldest vertex to make result independent of the hash layout
+	best = -1;
 
-	for( i = 0; i < num_hashneighbors; i++ )
+	for( num = VecHash_First( &hashverts, vert, &it ); num != -1; num = VecHash_Next( &hashverts, &it ))
 	{
-		for( hv = hashverts[hashneighbors[i]]; hv != NULL; hv = hv->next )
-		{
-			if( !VectorCompareEpsilon( hv->point, vert, ON_EPSILON ))
-				continue;
-
-			// already known to be a corner
-			if( hv->numplanes == 3 )
-				return hv->num;
-
-			for( i = 0; i < hv->numplanes; i++ )
-			{
-				// already know this plane
-				if( hv->planenums[i] == planenum )
-					return hv->num; 
-			}
+		if( best == -1 || num < best )
+			best = num;
+	}
 
-			if( hv->numplanes != 2 )
-				hv->planenums[hv->numplanes] = planenum;
-			hv->numplanes++;
+	if( best != -1 )
+	{
+		hv = &hvertex[best];
 
+		// already known to be a corner
+		if( hv->numplanes == 3 )
 			return hv->num;
+
+		for( i = 0; i < hv->numplanes; i++ )
+		{
+			// already know this plane
+			if( hv->planenums[i] == planenum )
+				return hv->num; 
 		}
+
+		if( hv->numplanes != 2 )
+			hv->planenums[hv->numplanes] = planenum;
+		hv->numplanes++;
+
+		return hv->num;
 	}
 
-	hv = hvert_p;
+	// emit a vertex
+	if( g_numvertexes == MAX_MAP_VERTS )
+		COM_FatalError( "MAX_MAP_VERTS limit exceeded\n" );
+
+	hv = &hvertex[VecHash_Insert( &hashverts, vert )];
 	hv->numplanes = 1;
 	hv->planenums[0] = planenum;
-	hv->next = hashverts[h];
-	hashverts[h] = hv;
-	VectorCopy( vert, hv->point );
 	hv->num = g_numvertexes;
-	if( hv->num == MAX_MAP_VERTS )
-		COM_FatalError( "MAX_MAP_VERTS limit exceeded\n" );
-	hvert_p++;
 
-	// emit a vertex
-	if( g_numvertexes == MAX_MAP_VERTS )
-		COM_FatalError( "MAX_MAP_VERTS limit exceeded\n" );
 	VectorCopy( vert, g_dvertexes[g_numvertexes].point );
 	g_numvertexes++;
 
@@ -305,6 +435,11 @@ static int GetVertex( const vec3_t in, const int planenum )
 
 //===========================================================================
 
+static int EdgeHashKey( int v1, int v2 )
+{
+	return ((unsigned int)v1 * 73856093 ^ (unsigned int)v2 * 19349663 ) & ( EDGE_HASH_SIZE - 1 );
+}
+
 /*
 ==================
 GetEdge
@@ -316,7 +451,7 @@ int GetEdge( vec3_t p1, vec3_t p2, face_t *f )
 {
 	int	v1, v2;
 	dedge_t	*edge;
-	int	i;
+	int	i, h, best;
 
 	if( !f->contents )
 		COM_FatalError( "GetEdge: CONTENTS_NONE\n" );
@@ -324,28 +459,41 @@ int GetEdge( vec3_t p1, vec3_t p2, face_t *f )
 	v1 = GetVertex( p1, f->planenum );
 	v2 = GetVertex( p2, f->planenum );
 
-	for( i = firstmodeledge; i < g_numedges; i++ )
+	// edges of previous models are never shared
+	// chain is sorted from newest to oldest so the oldest match is taken
+	best = 0;
+
+	for( i = g_edgehash[EdgeHashKey( v2, v1 )]; i >= firstmodeledge; i = g_edgechain[i] )
 	{
 		edge = &g_dedges[i];
 
 		if( v1 == edge->v[1] && v2 == edge->v[0] && !g_edgefaces[i][1] && g_edgefaces[i][0]->contents == f->contents
 		 && g_edgefaces[i][0]->planenum != ( f->planenum ^ 1 ))
-		{
-			g_edgefaces[i][1] = f;
-			return -i;
-		}
+			best = i;
+	}
+
+	if( best )
+	{
+		g_edgefaces[best][1] = f;
+		return -best;
 	}
 	
 	// emit an edge
 	if( g_numedges >= MAX_MAP_EDGES )
 		COM_FatalError( "MAX_MAP_EDGES limit exceeded\n" );
-	edge = &g_dedges[g_numedges];
+	i = g_numedges;
+	edge = &g_dedges[i];
 	g_numedges++;
 
 	g_edgefaces[i][0] = f;
+	g_edgefaces[i][1] = NULL;
 	edge->v[0] = v1;
 	edge->v[1] = v2;
 
+	h = EdgeHashKey( v1, v2 );
+	g_edgechain[i] = g_edgehash[h];
+	g_edgehash[h] = i;
+
 	return i;
 }
 
@@ -358,4 +506,4 @@ void MakeFaceEdges( void )
 {
 	firstmodeledge = g_numedges;	// !!!
 //	InitHash();
-}
\ No newline at end of file
+}
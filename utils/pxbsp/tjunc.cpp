@@ -13,7 +13,8 @@
 #include "bsp5.h"
 
 #define MAX_VERTS_ON_SUPERFACE	8192
-#define MAX_HASH_NEIGHBORS		4
+#define PARALLEL_MIN_FACES		256	// don't spawn tasks for small models
+#define PARALLEL_MIN_CHUNK		64	// faces per task
 
 typedef struct wvert_s
 {
@@ -24,12 +25,20 @@ typedef struct wvert_s
 
 typedef struct wedge_s
 {
-	struct wedge_s	*next;
 	vec3_t		dir;
 	vec3_t		origin;
 	wvert_t		head;
 } wedge_t;
 
+// face edge in the canonical form
+typedef struct
+{
+	vec3_t		dir;
+	vec3_t		origin;
+	vec_t		t1, t2;
+	bool		valid;
+} tjedge_t;
+
 typedef struct
 {
 	int		numpoints;
@@ -37,101 +46,39 @@ typedef struct
 	face_t		original;
 } superface_t;
 
-int	maxwedges, maxwverts;
-int	numwedges, numwverts;
-int	c_degenerateEdges;
-int	c_degenerateFaces;
-int	c_tjuncs;
-int	c_tjuncfaces;
-int	c_rotated;
-
-wvert_t	*wverts;
-wedge_t	*wedges;
-
+typedef struct
+{
+	face_t		**faces;
+	face_t		**fixed;		// tjunction split faces for each face
+	tjedge_t		*edges;
+	int		*firstedge;
+	int		first;
+	int		last;
+
+	int		c_degenerateEdges;
+	int		c_degenerateFaces;
+	int		c_tjuncs;
+	int		c_tjuncfaces;
+	int		c_rotated;
+} tjunctask_t;
+
+static int		maxwedges, maxwverts;
+static int		numwedges, numwverts;
+static THREAD_LOCAL int	c_degenerateEdges;
+static THREAD_LOCAL int	c_degenerateFaces;
+static THREAD_LOCAL int	c_tjuncs;
+static THREAD_LOCAL int	c_tjuncfaces;
+static THREAD_LOCAL int	c_rotated;
+
+static wvert_t		*wverts;
+static wedge_t		*wedges;
+static vechash_t		wedgehash;	// wedges by origin
 
 void PrintFace( face_t *f )
 {
 	if( f->w ) pw( f->w );
 }
 
-//============================================================================
-
-#define NUM_HASH		1024
-
-wedge_t		*wedge_hash[NUM_HASH];
-
-static vec3_t	h_min, h_scale;
-static int	h_numslots[3];
-
-static void InitHash( void )
-{
-	vec3_t	size;
-	vec_t	volume;
-	vec_t	scale;
-
-	memset( wedge_hash, 0, sizeof( wedge_hash ));
-	VectorFill( h_min, -8000 );
-	VectorFill( size, 16000 );
-	
-	volume = size[0] * size[1];
-	
-	scale = sqrt( volume / NUM_HASH );
-
-	h_numslots[0] = (int)floor( size[0] / scale );
-	h_numslots[1] = (int)floor( size[1] / scale );
-
-	while( h_numslots[0] * h_numslots[1] > NUM_HASH )
-	{
-		h_numslots[0]--;
-		h_numslots[1]--;
-	}
-
-	h_scale[0] = h_numslots[0] / size[0];
-	h_scale[1] = h_numslots[1] / size[1];
-}
-
-static int HashVec( const vec3_t vec, int *num, int *hash )
-{
-	int	h, i, x, y;
-	vec_t	normalized[2];
-	vec_t	sdiff[2];
-	int	slot[2];
-
-	for( i = 0; i < 2; i++ )
-	{
-		normalized[i] = h_scale[i] * (vec[i] - h_min[i]);
-		slot[i] = (int)floor( normalized[i] );
-		sdiff[i] = normalized[i] - (vec_t)slot[i];
-
-		slot[i] = (slot[i] + h_numslots[i]) % h_numslots[i];
-		slot[i] = (slot[i] + h_numslots[i]) % h_numslots[i]; // do it twice to handle negative values
-	}
-
-	h = slot[0] * h_numslots[1] + slot[1];
-	*num = 0;
-
-	for( x = -1; x <= 1; x++ )
-	{
-		if( x == -1 && sdiff[0] > h_scale[0] * ( 2 * ON_EPSILON ) || x == 1 && sdiff[0] < 1 - h_scale[0] * ( 2 * ON_EPSILON ))
-			continue;
-
-		for( y = -1; y <= 1; y++ )
-		{
-			if( y == -1 && sdiff[1] > h_scale[1] * ( 2 * ON_EPSILON ) || y == 1 && sdiff[1] < 1 - h_scale[1] * ( 2 * ON_EPSILON ))
-				continue;
-
-			if( *num >= MAX_HASH_NEIGHBORS )
-				COM_FatalError( "HashVec: internal error\n" );
-
-			hash[*num] = ((slot[0] + x + h_numslots[0]) % h_numslots[0]) * h_numslots[1] +
-				    (slot[1] + y + h_numslots[1]) % h_numslots[1];
-			(*num)++;
-		}
-	}
-
-	return h;
-}
-
 //============================================================================
 bool CanonicalVector( vec3_t vec )
 {
@@ -184,62 +131,83 @@ bool CanonicalVector( vec3_t vec )
 	return false;
 }
 
-wedge_t *FindEdge( vec3_t p1, vec3_t p2, vec_t *t1, vec_t *t2 )
+/*
+===============
+CanonicalEdge
+
+edges on the same line have the same origin and dir
+===============
+*/
+static bool CanonicalEdge( const vec3_t p1, const vec3_t p2, tjedge_t *e )
 {
-	vec3_t	origin, dir;
-	int	h, num_hashneighbors;
-	int	hashneighbors[MAX_HASH_NEIGHBORS];
 	vec_t	temp;
-	wedge_t	*w;
 
-	VectorSubtract( p2, p1, dir );
+	VectorSubtract( p2, p1, e->dir );
 
 	// ignore degenerate edges
-	if( !CanonicalVector( dir ))
+	if( !CanonicalVector( e->dir ))
 	{
 		c_degenerateEdges++;
-		return NULL;
+		return (e->valid = false);
 	}
 
-	*t1 = DotProduct( p1, dir );
-	*t2 = DotProduct( p2, dir );
+	e->t1 = DotProduct( p1, e->dir );
+	e->t2 = DotProduct( p2, e->dir );
 
-	VectorMA( p1, -*t1, dir, origin );
+	VectorMA( p1, -e->t1, e->dir, e->origin );
 
-	if( *t1 > *t2 )
+	if( e->t1 > e->t2 )
 	{
-		temp = *t1;
-		*t1 = *t2;
-		*t2 = temp;
+		temp = e->t1;
+		e->t1 = e->t2;
+		e->t2 = temp;
 	}
-	
-	h = HashVec( origin, &num_hashneighbors, hashneighbors );
 
-	for( int i = 0; i < num_hashneighbors; i++ )
+	return (e->valid = true);
+}
+
+/*
+===============
+FindEdge
+
+lookups without create are safe to do from any thread
+===============
+*/
+static wedge_t *FindEdge( const tjedge_t *e, bool create )
+{
+	vechashiter_t	it;
+	int		num, best = -1;
+	wedge_t		*w;
+
+	// pick the oldest wedge to make result independent of the hash layout
+	for( num = VecHash_First( &wedgehash, e->origin, &it ); num != -1; num = VecHash_Next( &wedgehash, &it ))
 	{
-		for( w = wedge_hash[hashneighbors[i]]; w; w = w->next )
-		{
-			if( !VectorCompareEpsilon( w->origin, origin, EQUAL_EPSILON ))
-				continue;
+		if( best != -1 && num > best )
+			continue;
 
-			if( !VectorCompareEpsilon( w->dir, dir, NORMAL_EPSILON ))
-				continue;
+		if( !VectorCompareEpsilon( wedges[num].dir, e->dir, NORMAL_EPSILON ))
+			continue;
 
-			return w;
-		}
-	}	
+		best = num;
+	}
+
+	if( best != -1 )
+		return &wedges[best];
+
+	if( !create )
+		return NULL;
 
 	if( numwedges == maxwedges )
 		COM_FatalError( "FindEdge: numwedges == MAXWEDGES\n" );
 	w = &wedges[numwedges];
+
+	if( VecHash_Insert( &wedgehash, e->origin ) != numwedges )
+		COM_FatalError( "FindEdge: wedge hash out of sync\n" );
 	numwedges++;
-	
-	w->next = wedge_hash[h];
-	wedge_hash[h] = w;
-	
-	VectorCopy( origin, w->origin );
+
+	VectorCopy( e->origin, w->origin );
 	w->head.next = w->head.prev = &w->head;
-	VectorCopy( dir, w->dir );
+	VectorCopy( e->dir, w->dir );
 	w->head.t = 99999;
 	return w;
 }
@@ -279,44 +247,30 @@ void AddVert( wedge_t *w, vec_t t )
 
 /*
 ===============
-AddEdge
+AddFaceEdgesTask
 
+edges are converted to the canonical form in parallel,
+wedges are inserted later in the face order
 ===============
 */
-void AddEdge( vec3_t p1, vec3_t p2 )
+static void AddFaceEdgesTask( void *data )
 {
-	wedge_t	*w;
-	vec_t	t1, t2;
-	
-	w = FindEdge( p1, p2, &t1, &t2 );
-	if( !w ) return;
-
-	AddVert( w, t1 );
-	AddVert( w, t2 );
-}
-
-/*
-===============
-AddFaceEdges
+	tjunctask_t	*task = (tjunctask_t *)data;
 
-===============
-*/
-void AddFaceEdges( face_t *f )
-{
-	winding_t	*w = f->w;
-	int	i, j;
-	
-	for( i = 0; i < w->numpoints; i++ )
+	for( int i = task->first; i < task->last; i++ )
 	{
-		 j = (i+1) % w->numpoints;
-		 AddEdge( w->p[i], w->p[j] );
+		winding_t	*w = task->faces[i]->w;
+		tjedge_t	*e = &task->edges[task->firstedge[i]];
+
+		for( int j = 0; j < w->numpoints; j++ )
+			CanonicalEdge( w->p[j], w->p[(j+1) % w->numpoints], &e[j] );
 	}
 }
 
 //============================================================================
 
-superface_t	*superface;
-face_t		*newlist;
+static THREAD_LOCAL superface_t	*superface;
+static THREAD_LOCAL face_t		*newlist;
 
 void FaceFromSuperface( face_t *original )
 {
@@ -426,7 +380,7 @@ FixFaceEdges
 void FixFaceEdges( face_t *f )
 {
 	int	i, j, k;
-	vec_t	t1, t2;
+	tjedge_t	e;
 	wedge_t	*w;
 	wvert_t	*v;
 
@@ -443,12 +397,16 @@ restart:
 	{
 		 j = (i+1) % superface->numpoints;
 
-		w = FindEdge( superface->points[i], superface->points[j], &t1, &t2 );
-		if( !w ) continue;
+		if( !CanonicalEdge( superface->points[i], superface->points[j], &e ))
+			continue;
+
+		// edge without wedge has no points to insert
+		if(( w = FindEdge( &e, false )) == NULL )
+			continue;
 		
-		for( v = w->head.next; v->t < t1 + T_EPSILON; v = v->next );
+		for( v = w->head.next; v->t < e.t1 + T_EPSILON; v = v->next );
 
-		if( v->t < t2 - T_EPSILON )
+		if( v->t < e.t2 - T_EPSILON )
 		{
 			c_tjuncs++;
 
@@ -468,55 +426,114 @@ restart:
 	FaceFromSuperface( f );
 }
 
-//============================================================================
+/*
+===============
+FixFacesTask
+===============
+*/
+static void FixFacesTask( void *data )
+{
+	tjunctask_t	*task = (tjunctask_t *)data;
+
+	c_tjuncs = c_tjuncfaces = c_degenerateEdges = c_degenerateFaces = c_rotated = 0;
+	superface = (superface_t *)Mem_Alloc( sizeof( superface_t ));
+
+	for( int i = task->first; i < task->last; i++ )
+	{
+		newlist = NULL;
+		FixFaceEdges( task->faces[i] );
+		task->fixed[i] = newlist;
+	}
+
+	Mem_Free( superface );
+	superface = NULL;
+
+	task->c_tjuncs = c_tjuncs;
+	task->c_tjuncfaces = c_tjuncfaces;
+	task->c_degenerateEdges = c_degenerateEdges;
+	task->c_degenerateFaces = c_degenerateFaces;
+	task->c_rotated = c_rotated;
+}
 
-static void tjunc_count_r( node_t *node )
+/*
+===============
+RunTjuncTasks
+
+faces are splitted into the equal ranges
+===============
+*/
+static void RunTjuncTasks( tjunctask_t *tasks, int numfaces, pfnThreadTask func )
 {
-	face_t	*f;
+	threadtask_t	*handles[MAX_THREADS];
+	int		i, numtasks = 1;
 
-	if( node->planenum == PLANENUM_LEAF )
-		return;
+	if( numfaces >= PARALLEL_MIN_FACES && g_numthreads > 1 )
+		numtasks = bound( 1, numfaces / PARALLEL_MIN_CHUNK, g_numthreads );
 
-	for( f = node->faces; f != NULL; f = f->next )
-		maxwedges += f->w->numpoints;
+	for( i = 0; i < numtasks; i++ )
+	{
+		tasks[i] = tasks[0];
+		tasks[i].first = numfaces * i / numtasks;
+		tasks[i].last = numfaces * ( i + 1 ) / numtasks;
+		handles[i] = NULL;
+	}
+
+	for( i = 1; i < numtasks; i++ )
+	{
+		if(( handles[i] = ThreadSpawnTask( func, &tasks[i] )) == NULL )
+			break; // no free threads
+	}
+
+	func( &tasks[0] );
 
-	tjunc_count_r( node->children[0] );
-	tjunc_count_r( node->children[1] );
+	for( i = 1; i < numtasks; i++ )
+	{
+		if( handles[i] ) ThreadWaitTask( handles[i] );
+		else func( &tasks[i] );
+	}
+
+	// clear the unused tasks so the counters can be summed
+	for( ; i < MAX_THREADS; i++ )
+		memset( &tasks[i], 0, sizeof( tasks[i] ));
 }
 
-void tjunc_find_r( node_t *node )
+//============================================================================
+
+static int tjunc_count_r( node_t *node )
 {
+	int	count = 0;
 	face_t	*f;
 
 	if( node->planenum == PLANENUM_LEAF )
-		return;
-		
+		return 0;
+
 	for( f = node->faces; f != NULL; f = f->next )
-		AddFaceEdges( f );
-		
-	tjunc_find_r( node->children[0] );
-	tjunc_find_r( node->children[1] );
+	{
+		maxwedges += f->w->numpoints;
+		count++;
+	}
+
+	count += tjunc_count_r( node->children[0] );
+	count += tjunc_count_r( node->children[1] );
+
+	return count;
 }
 
-void tjunc_fix_r( node_t *node )
+static void tjunc_gather_r( node_t *node, face_t **faces, node_t **owners, int *numfaces )
 {
-	face_t	*f, *next;
+	face_t	*f;
 
 	if( node->planenum == PLANENUM_LEAF )
 		return;
-		
-	newlist = NULL;
-	
-	for( f = node->faces; f != NULL; f = next )
+
+	for( f = node->faces; f != NULL; f = f->next )
 	{
-		next = f->next;
-		FixFaceEdges( f );
+		owners[*numfaces] = node;
+		faces[(*numfaces)++] = f;
 	}
 
-	node->faces = newlist;
-
-	tjunc_fix_r( node->children[0] );
-	tjunc_fix_r( node->children[1] );
+	tjunc_gather_r( node->children[0], faces, owners, numfaces );
+	tjunc_gather_r( node->children[1], faces, owners, numfaces );
 }
 
 /*
@@ -527,43 +544,112 @@ tjunc
 */
 void tjunc( node_t *headnode, bool worldmodel )
 {
-	double	start, end;
-	char	str[64];
+	tjunctask_t	tasks[MAX_THREADS];
+	face_t		**faces, **fixed;
+	node_t		**owners;
+	int		*firstedge;
+	tjedge_t		*edges;
+	int		i, j, numfaces;
+	double		start, end;
+	char		str[64];
 
 	if( g_notjunc ) return;
 	
 	MsgDev( D_REPORT, "---- tjunc ----\n");
 	start = I_FloatTime ();
-	InitHash();
 	
 	maxwedges = maxwverts = 0;
-	tjunc_count_r( headnode );
+	numfaces = tjunc_count_r( headnode );
 	maxwverts = maxwedges * 2;
 
 	// alloc space for work
 	wverts = (wvert_t *)Mem_Alloc( sizeof( *wverts ) * maxwverts );
 	wedges = (wedge_t *)Mem_Alloc( sizeof( *wedges ) * maxwedges );
-	superface = (superface_t *)Mem_Alloc( sizeof( superface_t ));
+	edges = (tjedge_t *)Mem_Alloc( sizeof( *edges ) * Q_max( maxwedges, 1 ));
+	faces = (face_t **)Mem_Alloc( sizeof( *faces ) * Q_max( numfaces, 1 ));
+	fixed = (face_t **)Mem_Alloc( sizeof( *fixed ) * Q_max( numfaces, 1 ));
+	owners = (node_t **)Mem_Alloc( sizeof( *owners ) * Q_max( numfaces, 1 ));
+	firstedge = (int *)Mem_Alloc( sizeof( *firstedge ) * Q_max( numfaces, 1 ));
+	VecHash_Init( &wedgehash, EQUAL_EPSILON, maxwedges );
 	numwedges = numwverts = 0;
 
+	numfaces = 0;
+	tjunc_gather_r( headnode, faces, owners, &numfaces );
+
+	for( i = j = 0; i < numfaces; i++ )
+	{
+		firstedge[i] = j;
+		j += faces[i]->w->numpoints;
+	}
+
+	memset( &tasks[0], 0, sizeof( tasks[0] ));
+	tasks[0].faces = faces;
+	tasks[0].fixed = fixed;
+	tasks[0].edges = edges;
+	tasks[0].firstedge = firstedge;
+
 	//
 	// identify all points on common edges
 	//
-	tjunc_find_r( headnode );
+	RunTjuncTasks( tasks, numfaces, AddFaceEdgesTask );
+
+	for( i = 0; i < maxwedges; i++ )
+	{
+		wedge_t	*w;
+
+		if( !edges[i].valid ) continue;
+
+		w = FindEdge( &edges[i], true );
+		AddVert( w, edges[i].t1 );
+		AddVert( w, edges[i].t2 );
+	}
 		
 	MsgDev( D_REPORT, "%i world edges  %i edge points\n", numwedges, numwverts );
 
 	//
 	// add extra vertexes on edges where needed
 	//
+	RunTjuncTasks( tasks, numfaces, FixFacesTask );
+
+	// relink the faces in the same order as sequental fix does
+	for( i = 0; i < numfaces; i = j )
+	{
+		node_t	*node = owners[i];
+		face_t	*list = NULL;
+
+		for( j = i; j < numfaces && owners[j] == node; j++ )
+		{
+			face_t	*last;
+
+			if( !fixed[j] ) continue;
+
+			for( last = fixed[j]; last->next != NULL; last = last->next );
+			last->next = list;
+			list = fixed[j];
+		}
+
+		node->faces = list;
+	}
+
 	c_tjuncs = c_tjuncfaces = c_degenerateEdges = c_degenerateFaces = c_rotated = 0;
 
-	tjunc_fix_r( headnode );
+	for( i = 0; i < MAX_THREADS; i++ )
+	{
+		c_tjuncs += tasks[i].c_tjuncs;
+		c_tjuncfaces += tasks[i].c_tjuncfaces;
+		c_degenerateEdges += tasks[i].c_degenerateEdges;
+		c_degenerateFaces += tasks[i].c_degenerateFaces;
+		c_rotated += tasks[i].c_rotated;
+	}
 
+	VecHash_Free( &wedgehash );
 	Mem_Free( wverts );
 	Mem_Free( wedges );
-	Mem_Free( superface );
-	superface = NULL;
+	Mem_Free( edges );
+	Mem_Free( faces );
+	Mem_Free( fixed );
+	Mem_Free( owners );
+	Mem_Free( firstedge );
 
 	MsgDev( D_REPORT, "%i degenerate edges\n", c_degenerateEdges );
 	MsgDev( D_REPORT, "%i degenerate faces\n", c_degenerateFaces );
@@ -575,4 +661,4 @@ void tjunc( node_t *headnode, bool worldmodel )
 	end = I_FloatTime ();
 	Q_timestring((int)( end - start ), str );
 	if( worldmodel ) MsgDev( D_INFO, "t-junction: %s elapsed\n", str );
-}
\ No newline at end of file
+}
@@ -18,6 +18,30 @@ dtexinfo_t	g_maptexinfo[MAX_MAP_TEXINFO];
 int		g_nummaptexinfo;
 int		g_nummapplanes;
 
+// clipping hulls are built in parallel with drawing hull,
+// so clipnodes are collected here and emitted after it
+typedef struct
+{
+	int		modnum;
+	int		headnode;		// local clipnode or CONTENTS_EMPTY
+	int		firstnode;
+	int		numnodes;
+	vec3_t		mins, maxs;	// tree bounds
+	bool		empty;
+} clipmodel_t;
+
+typedef struct
+{
+	dclipnode32_t	*nodes;		// mapplane numbers, local children
+	int		numnodes;
+	int		maxnodes;
+	clipmodel_t	*models;
+	int		nummodels;
+	int		maxmodels;
+} cliphull_t;
+
+static cliphull_t		g_cliphulls[MAX_MAP_HULLS];
+
 /*
 =============================================================================
 
@@ -104,8 +128,12 @@ FindFloatPlane
 int FindFloatPlane( const vec3_t normal, vec_t dist )
 {
 	vec_t	srcdist = dist;
+	int	planenum;
 	plane_t	*p;
 
+	// hulls are portalized from different threads
+	ThreadLock();
+
 	// NOTE: bsp only alloc a few planes for world portalize
 	// so linear search doesn't hit by perfomance
 	for( int i = 0; i < g_nummapplanes; i++ )
@@ -113,11 +141,17 @@ int FindFloatPlane( const vec3_t normal, vec_t dist )
 		p = &g_mapplanes[i];
 
 		if( PlaneEqual( p, normal, dist ))
+		{
+			ThreadUnlock();
 			return p - g_mapplanes;
+		}
 	}
 
 	// allocate a new two opposite planes
-	return CreateNewFloatPlane( normal, srcdist );
+	planenum = CreateNewFloatPlane( normal, srcdist );
+	ThreadUnlock();
+
+	return planenum;
 }
 
 /*
@@ -181,10 +215,9 @@ int EmitTexinfo( int texinfo )
 EmitClipNodes_r
 ==================
 */
-static int EmitClipNodes_r( node_t *node, const node_t *portalleaf )
+static int EmitClipNodes_r( cliphull_t *hull, node_t *node, const node_t *portalleaf )
 {
 	int		i, c;
-	dclipnode32_t	*cn;
 	int		num;
 
 	if( FBitSet( node->flags, FNODE_LEAFPORTAL ))
@@ -203,23 +236,27 @@ static int EmitClipNodes_r( node_t *node, const node_t *portalleaf )
 		return num;
 	}
 
-	// emit a clipnode
-	if( g_numclipnodes == MAX_MAP_CLIPNODES )
-		MsgAnim( D_INFO, "^3=== MAX_MAP_CLIPNODES is exceeded. Map will not run under GoldSource ===\r" );
-
-	if( g_numclipnodes == MAX_MAP_CLIPNODES32 )
+	// collect a clipnode
+	if( hull->numnodes == MAX_MAP_CLIPNODES32 )
 		COM_FatalError( "MAX_MAP_CLIPNODES32 limit exceeded\n" );
 
-	c = g_numclipnodes;
-	cn = &g_dclipnodes32[g_numclipnodes++];
+	if( hull->numnodes == hull->maxnodes )
+	{
+		hull->maxnodes = Q_max( hull->maxnodes * 2, 1024 );
+		hull->nodes = (dclipnode32_t *)Mem_Realloc( hull->nodes, hull->maxnodes * sizeof( dclipnode32_t ));
+	}
 
 	if( node->planenum & 1 )
 		COM_FatalError( "WriteClipNodes_r: odd planenum\n" );
 
-	cn->planenum = EmitPlane( node->planenum, false );
+	c = hull->numnodes++;
+	hull->nodes[c].planenum = node->planenum; // mapped by FlushClipNodes
 
 	for( i = 0; i < 2; i++ )
-		cn->children[i] = EmitClipNodes_r( node->children[i], portalleaf );
+	{
+		num = EmitClipNodes_r( hull, node->children[i], portalleaf );
+		hull->nodes[c].children[i] = num; // array may be reallocated
+	}
 
 	return c;
 }
@@ -477,12 +514,12 @@ static void FreeDrawNodes_r( node_t *node )
 CalcModelBoundBox
 ===========
 */
-static void CalcModelBoundBox( dmodel_t *bmod, tree_t *tree, int hullnum, int modnum )
+static void CalcModelBoundBox( dmodel_t *bmod, const vec3_t treemins, const vec3_t treemaxs, bool empty, int hullnum, int modnum )
 {
 	vec3_t	mins, maxs;
 	int	i;
 
-	if( !tree->surfaces || ( tree->mins[0] > tree->maxs[0] ))
+	if( empty || ( treemins[0] > treemaxs[0] ))
 	{
 		MsgDev( D_REPORT, "model %d hull %d empty\n", modnum, hullnum );
 	}
@@ -491,8 +528,8 @@ static void CalcModelBoundBox( dmodel_t *bmod, tree_t *tree, int hullnum, int mo
 		if( hullnum && ( bmod->mins[0] <= bmod->maxs[0] ))
 			return; // bbox is computed
 
-		VectorSubtract( tree->mins, g_hull_size[0][0], mins );
-		VectorSubtract( tree->maxs, g_hull_size[0][1], maxs );
+		VectorSubtract( treemins, g_hull_size[0][0], mins );
+		VectorSubtract( treemaxs, g_hull_size[0][1], maxs );
 
 		for( i = 0; i < 3; i++ )
 		{
@@ -645,7 +682,7 @@ void EmitDrawNodes( tree_t *tree )
 	bm->numfaces = g_numfaces - bm->firstface;
 	bm->visleafs = g_numleafs - firstleaf;
 
-	CalcModelBoundBox( bm, tree, 0, g_nummodels - 1 );
+	CalcModelBoundBox( bm, tree->mins, tree->maxs, !tree->surfaces, 0, g_nummodels - 1 );
 
 	// g-cont. copy origin from entity settings into dmodel_t struct
 	entity_t *ent = EntityForModel( g_nummodels - 1 );
@@ -661,29 +698,101 @@ void EmitDrawNodes( tree_t *tree )
 EmitClipNodes
 
 Called after the clipping hull is completed. Generates a disk format
-representation and frees the original memory.
+representation and frees the original memory. Clipnodes are written
+into the bsp by FlushClipNodes after the all hulls are done.
 ==================
 */
 void EmitClipNodes( tree_t *tree, int modnum, int hullnum )
 {
-	dmodel_t	*bm;
+	cliphull_t	*hull = &g_cliphulls[hullnum];
+	clipmodel_t	*cm;
 
 	MsgDev( D_REPORT, "--- EmitClipNodes ---\n" );
 
-	bm = &g_dmodels[modnum]; // emit a model
+	if( hull->nummodels == hull->maxmodels )
+	{
+		hull->maxmodels = Q_max( hull->maxmodels * 2, 64 );
+		hull->models = (clipmodel_t *)Mem_Realloc( hull->models, hull->maxmodels * sizeof( clipmodel_t ));
+	}
+
+	cm = &hull->models[hull->nummodels++]; // emit a model
+	cm->modnum = modnum;
+	cm->firstnode = hull->numnodes;
 
 	// if noclip is enabled
 	if( tree->headnode->planenum == PLANENUM_LEAF )
-		bm->headnode[hullnum] = CONTENTS_EMPTY;
-	else bm->headnode[hullnum] = g_numclipnodes;
+		cm->headnode = CONTENTS_EMPTY;
+	else cm->headnode = hull->numnodes;
 
-	EmitClipNodes_r( tree->headnode, NULL );
-	CalcModelBoundBox( bm, tree, hullnum, modnum );
+	EmitClipNodes_r( hull, tree->headnode, NULL );
+
+	cm = &hull->models[hull->nummodels - 1];
+	cm->numnodes = hull->numnodes - cm->firstnode;
+	VectorCopy( tree->mins, cm->mins );
+	VectorCopy( tree->maxs, cm->maxs );
+	cm->empty = !tree->surfaces;
 
 	FreeDrawNodes_r( tree->headnode );
 	tree->headnode = NULL;
 }
 
+/*
+==================
+FlushClipNodes
+
+write collected clipnodes in the hull order,
+so output is the same as sequental build
+==================
+*/
+void FlushClipNodes( void )
+{
+	int	hullnum, i, j, k;
+
+	for( hullnum = 0; hullnum < MAX_MAP_HULLS; hullnum++ )
+	{
+		cliphull_t	*hull = &g_cliphulls[hullnum];
+
+		for( i = 0; i < hull->nummodels; i++ )
+		{
+			clipmodel_t	*cm = &hull->models[i];
+			dmodel_t		*bm = &g_dmodels[cm->modnum];
+			int		base = g_numclipnodes - cm->firstnode;
+
+			if( cm->headnode == CONTENTS_EMPTY )
+				bm->headnode[hullnum] = CONTENTS_EMPTY;
+			else bm->headnode[hullnum] = g_numclipnodes;
+
+			for( j = cm->firstnode; j < cm->firstnode + cm->numnodes; j++ )
+			{
+				dclipnode32_t	*src = &hull->nodes[j];
+				dclipnode32_t	*cn;
+
+				if( g_numclipnodes == MAX_MAP_CLIPNODES )
+					MsgAnim( D_INFO, "^3=== MAX_MAP_CLIPNODES is exceeded. Map will not run under GoldSource ===\r" );
+
+				if( g_numclipnodes == MAX_MAP_CLIPNODES32 )
+					COM_FatalError( "MAX_MAP_CLIPNODES32 limit exceeded\n" );
+
+				cn = &g_dclipnodes32[g_numclipnodes++];
+				cn->planenum = EmitPlane( src->planenum, false );
+
+				for( k = 0; k < 2; k++ )
+				{
+					if( src->children[k] >= 0 )
+						cn->children[k] = src->children[k] + base;
+					else cn->children[k] = src->children[k];
+				}
+			}
+
+			CalcModelBoundBox( bm, cm->mins, cm->maxs, cm->empty, hullnum, cm->modnum );
+		}
+
+		Mem_Free( hull->nodes );
+		Mem_Free( hull->models );
+		memset( hull, 0, sizeof( *hull ));
+	}
+}
+
 /*
 ==================
 EmitVertex
@@ -0,0 +1,355 @@
+/*
+pxbuild.cpp - runs the compile pipeline and collects build statistics
+Copyright (C) 2026 PrimeXT contributors
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+*/
+
+#include <windows.h>
+#include <stdio.h>
+#include "cmdlib.h"
+#include "stringlib.h"
+#include "filesystem.h"
+
+#define BUILD_VERSION	"^3v.0.1^7"
+
+// layout of PROCESS_MEMORY_COUNTERS from psapi.h
+typedef struct
+{
+	DWORD		cb;
+	DWORD		PageFaultCount;
+	size_t		PeakWorkingSetSize;
+	size_t		WorkingSetSize;
+	size_t		QuotaPeakPagedPoolUsage;
+	size_t		QuotaPagedPoolUsage;
+	size_t		QuotaPeakNonPagedPoolUsage;
+	size_t		QuotaNonPagedPoolUsage;
+	size_t		PagefileUsage;
+	size_t		PeakPagefileUsage;
+} procmemcounters_t;
+
+typedef BOOL (WINAPI *pfnGetProcessMemoryInfo)( HANDLE process, procmemcounters_t *counters, DWORD cb );
+
+typedef struct
+{
+	const char	*name;		// executable name
+	bool		enabled;
+	char		options[1024];	// extra options for this stage
+	char		report[1024];	// stage report, merged into the build report
+
+	// filled by RunStage
+	bool		done;
+	DWORD		exitcode;
+	double		walltime;
+	double		cputime;
+	size_t		peakworkingset;
+	size_t		peakpagefile;
+} buildstage_t;
+
+static buildstage_t		g_stages[] =
+{
+{ "p2csg", true },
+{ "p2bsp", true },
+{ "p2vis", true },
+{ "p2rad", true },
+};
+
+#define NUM_STAGES		((int)( sizeof( g_stages ) / sizeof( g_stages[0] )))
+
+static pfnGetProcessMemoryInfo	pGetProcessMemoryInfo;
+
+static double FileTimeToSeconds( const FILETIME *ft )
+{
+	// 100-nanosecond intervals
+	return ((double)ft->dwLowDateTime + (double)ft->dwHighDateTime * 4294967296.0 ) * 1e-7;
+}
+
+/*
+============
+RunStage
+
+runs one compile tool and waits for it
+============
+*/
+static bool RunStage( buildstage_t *stage, const char *tooldir, const char *options, const char *source )
+{
+	FILETIME		creation, exit, kernel, user;
+	STARTUPINFO	si;
+	PROCESS_INFORMATION	pi;
+	char		cmdline[4096];
+	double		start;
+
+	Q_snprintf( cmdline, sizeof( cmdline ), "\"%s%s.exe\" %s %s -report \"%s\" \"%s\"",
+	tooldir, stage->name, options, stage->options, stage->report, source );
+
+	memset( &si, 0, sizeof( si ));
+	si.cb = sizeof( si );
+
+	MsgDev( D_REPORT, "%s\n", cmdline );
+	start = I_FloatTime();
+
+	if( !CreateProcess( NULL, cmdline, NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi ))
+	{
+		MsgDev( D_ERROR, "couldn't run %s%s.exe\n", tooldir, stage->name );
+		return false;
+	}
+
+	WaitForSingleObject( pi.hProcess, INFINITE );
+	stage->walltime = I_FloatTime() - start;
+	stage->done = true;
+
+	GetExitCodeProcess( pi.hProcess, &stage->exitcode );
+
+	if( GetProcessTimes( pi.hProcess, &creation, &exit, &kernel, &user ))
+		stage->cputime = FileTimeToSeconds( &kernel ) + FileTimeToSeconds( &user );
+
+	if( pGetProcessMemoryInfo )
+	{
+		procmemcounters_t	counters;
+
+		memset( &counters, 0, sizeof( counters ));
+		counters.cb = sizeof( counters );
+
+		if( pGetProcessMemoryInfo( pi.hProcess, &counters, sizeof( counters )))
+		{
+			stage->peakworkingset = counters.PeakWorkingSetSize;
+			stage->peakpagefile = counters.PeakPagefileUsage;
+		}
+	}
+
+	CloseHandle( pi.hThread );
+	CloseHandle( pi.hProcess );
+
+	return ( stage->exitcode == 0 );
+}
+
+/*
+============
+WriteBuildReport
+
+merges the stage reports into one JSON file
+============
+*/
+static void WriteBuildReport( const char *filename, const char *source, double walltime )
+{
+	FILE	*f;
+
+	if(( f = fopen( filename, "w" )) == NULL )
+	{
+		MsgDev( D_ERROR, "couldn't write report %s\n", filename );
+		return;
+	}
+
+	fprintf( f, "{\n" );
+	fprintf( f, "\"map\": \"%s\",\n", COM_FileWithoutPath( source ));
+	fprintf( f, "\"wall\": %.3f,\n", walltime );
+	fprintf( f, "\"stages\": [" );
+
+	for( int i = 0, count = 0; i < NUM_STAGES; i++ )
+	{
+		buildstage_t	*stage = &g_stages[i];
+		size_t		size;
+		byte		*data;
+
+		if( !stage->done ) continue;
+
+		fprintf( f, "%s\n{\n", count++ ? "," : "" );
+		fprintf( f, "\"name\": \"%s\",\n", stage->name );
+		fprintf( f, "\"exitcode\": %lu,\n", stage->exitcode );
+		fprintf( f, "\"wall\": %.3f,\n", stage->walltime );
+		fprintf( f, "\"cpu\": %.3f,\n", stage->cputime );
+		fprintf( f, "\"peakworkingset\": %lu,\n", (unsigned long)stage->peakworkingset );
+		fprintf( f, "\"peakpagefile\": %lu,\n", (unsigned long)stage->peakpagefile );
+
+		// tool report is missing if the tool has failed
+		if(( data = COM_LoadFile( stage->report, &size, false )) != NULL )
+		{
+			fprintf( f, "\"report\": %s", (char *)data );
+			Mem_Free( data, C_FILESYSTEM );
+			remove( stage->report );
+		}
+		else fprintf( f, "\"report\": null\n" );
+
+		fprintf( f, "}" );
+	}
+
+	fprintf( f, "\n]\n}\n" );
+	fclose( f );
+}
+
+/*
+============
+PrintBuildUsage
+============
+*/
+static void PrintBuildUsage( void )
+{
+	Msg( "\n-= p2build Options =-\n\n" );
+	Msg( "    -dev #         : compile with developer message (1 - 4). default is %d\n", DEFAULT_DEVELOPER );
+	Msg( "    -threads #     : manually specify the number of threads to run\n" );
+	Msg( "    -report file   : build report name. default is mapname.build.json\n" );
+	Msg( "    -novis         : skip the p2vis stage\n" );
+	Msg( "    -norad         : skip the p2rad stage\n" );
+	Msg( "    -csg \"opts\"    : extra options for p2csg\n" );
+	Msg( "    -bsp \"opts\"    : extra options for p2bsp\n" );
+	Msg( "    -vis \"opts\"    : extra options for p2vis\n" );
+	Msg( "    -rad \"opts\"    : extra options for p2rad\n" );
+	Msg( "    mapfile        : The mapfile to compile\n\n" );
+
+	exit( 1 );
+}
+
+/*
+============
+FindStage
+============
+*/
+static buildstage_t *FindStage( const char *option )
+{
+	for( int i = 0; i < NUM_STAGES; i++ )
+	{
+		// -csg matches p2csg
+		if( !Q_stricmp( option + 1, g_stages[i].name + 2 ))
+			return &g_stages[i];
+	}
+
+	return NULL;
+}
+
+/*
+===========
+main
+===========
+*/
+int main( int argc, char **argv )
+{
+	char		source[1024];
+	char		report[1024];
+	char		tooldir[1024];
+	char		options[256];
+	char		exepath[1024];
+	buildstage_t	*stage;
+	double		start, end;
+	char		str[64];
+	bool		success = true;
+	HMODULE		psapi;
+	int		i;
+
+	source[0] = report[0] = options[0] = '\0';
+
+	for( i = 1; i < argc; i++ )
+	{
+		if( !Q_strcmp( argv[i], "-dev" ))
+		{
+			SetDeveloperLevel( atoi( argv[i+1] ));
+			Q_strncat( options, va( "-dev %s ", argv[i+1] ), sizeof( options ));
+			i++;
+		}
+		else if( !Q_strcmp( argv[i], "-threads" ))
+		{
+			Q_strncat( options, va( "-threads %s ", argv[i+1] ), sizeof( options ));
+			i++;
+		}
+		else if( !Q_strcmp( argv[i], "-report" ))
+		{
+			Q_strncpy( report, argv[i+1], sizeof( report ));
+			i++;
+		}
+		else if( !Q_strcmp( argv[i], "-novis" ))
+		{
+			FindStage( "-vis" )->enabled = false;
+		}
+		else if( !Q_strcmp( argv[i], "-norad" ))
+		{
+			FindStage( "-rad" )->enabled = false;
+		}
+		else if(( stage = FindStage( argv[i] )) != NULL && ( i + 1 ) < argc )
+		{
+			Q_strncpy( stage->options, argv[i+1], sizeof( stage->options ));
+			i++;
+		}
+		else if( argv[i][0] == '-' )
+		{
+			MsgDev( D_ERROR, "\nUnknown option \"%s\"\n", argv[i] );
+			break;
+		}
+		else if( !source[0] )
+		{
+			Q_strncpy( source, COM_ExpandArg( argv[i] ), sizeof( source ));
+			COM_StripExtension( source );
+		}
+		else
+		{
+			MsgDev( D_ERROR, "\nUnknown option \"%s\"\n", argv[i] );
+			break;
+		}
+	}
+
+	if( i != argc || !source[0] )
+	{
+		if( !source[0] )
+			Msg( "no mapfile specified\n" );
+		PrintBuildUsage();
+	}
+
+	if( !report[0] )
+		Q_snprintf( report, sizeof( report ), "%s.build.json", source );
+
+	// compile tools are expected next to us
+	GetModuleFileName( NULL, exepath, sizeof( exepath ));
+	COM_ExtractFilePath( exepath, tooldir );
+	if( tooldir[0] ) Q_strncat( tooldir, "\\", sizeof( tooldir ));
+
+	// not available on old systems, the report just lacks process memory
+	if(( psapi = LoadLibrary( "psapi.dll" )) != NULL )
+		pGetProcessMemoryInfo = (pfnGetProcessMemoryInfo)GetProcAddress( psapi, "GetProcessMemoryInfo" );
+
+	Msg( "\n%s %s (%s)\n", "^1P2:Savior^7 build", BUILD_VERSION, __DATE__ );
+
+	start = I_FloatTime ();
+
+	for( i = 0; i < NUM_STAGES; i++ )
+	{
+		stage = &g_stages[i];
+
+		if( !stage->enabled ) continue;
+
+		Q_snprintf( stage->report, sizeof( stage->report ), "%s.%s.json", source, stage->name );
+
+		if( !RunStage( stage, tooldir, options, source ))
+		{
+			MsgDev( D_ERROR, "%s failed, build stopped\n", stage->name );
+			success = false;
+			break;
+		}
+	}
+
+	end = I_FloatTime ();
+
+	WriteBuildReport( report, source, end - start );
+
+	for( i = 0; i < NUM_STAGES; i++ )
+	{
+		stage = &g_stages[i];
+
+		if( !stage->done ) continue;
+
+		Q_timestring((int)stage->walltime, str );
+		Msg( "%s: %s, cpu %.1f secs, peak memory %s\n", stage->name, str, stage->cputime, Q_memprint( stage->peakworkingset ));
+	}
+
+	Q_timestring((int)( end - start ), str );
+	Msg( "%s elapsed, report written to %s\n", str, report );
+
+	if( psapi ) FreeLibrary( psapi );
+
+	return success ? 0 : 1;
+}
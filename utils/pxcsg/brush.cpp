@@ -13,7 +13,8 @@
 #include "csg.h"
 
 plane_t		g_mapplanes[MAX_INTERNAL_MAP_PLANES];
-int		g_planehash[PLANE_HASHES];
+static volatile long	g_planehash[PLANE_HASHES];	// readers never lock it
+static volatile long	g_planelocks[PLANE_HASHES];	// writers lock the bin and both neighbours
 int		g_nummapplanes;
 
 /*
@@ -44,41 +45,94 @@ bool PlaneEqual( const plane_t *p, const vec3_t normal, const vec3_t origin, vec
 	return false;
 }
 
+/*
+================
+PlaneHashForDist
+================
+*/
+static int PlaneHashForDist( vec_t dist )
+{
+	return (PLANE_HASHES - 1) & (int)fabs( dist );
+}
+
 /*
 ================
 AddPlaneToHash
+
+plane must be completely filled before
+it become visible for lock-free readers
 ================
 */
-void AddPlaneToHash( plane_t *p )
+static void AddPlaneToHash( plane_t *p )
 {
-	int hash;
+	int hash = PlaneHashForDist( p->dist );
 
-	hash = (PLANE_HASHES - 1) & (int)fabs( p->dist );
 	p->hash_chain = g_planehash[hash];
-	g_planehash[hash] = p - g_mapplanes + 1;
+	InterlockedExchange( &g_planehash[hash], (long)( p - g_mapplanes + 1 ));
+}
+
+/*
+================
+LockPlaneBins
+
+lock the bins in ascending order to prevent deadlocks
+================
+*/
+static void LockPlaneBins( int bins[3] )
+{
+	int	i, j, t;
+
+	for( i = 0; i < 3; i++ )
+	{
+		for( j = i + 1; j < 3; j++ )
+		{
+			if( bins[j] < bins[i] )
+			{
+				t = bins[i];
+				bins[i] = bins[j];
+				bins[j] = t;
+			}
+		}
+	}
+
+	for( i = 0; i < 3; i++ )
+	{
+		while( InterlockedCompareExchange( &g_planelocks[bins[i]], 1, 0 ) != 0 )
+			Sleep( 0 );
+	}
+}
+
+static void UnlockPlaneBins( const int bins[3] )
+{
+	for( int i = 2; i >= 0; i-- )
+		InterlockedExchange( &g_planelocks[bins[i]], 0 );
 }
 
 /*
 ================
 CreateNewFloatPlane
+
+caller must hold the bins of plane
 ================
 */
-int CreateNewFloatPlane( const vec3_t srcnormal, const vec3_t origin )
+static int CreateNewFloatPlane( const vec3_t srcnormal, const vec3_t origin )
 {
 	plane_t	*p0, *p1, temp;
 	vec3_t	normal;
 	vec_t	dist;
-	int	type;
+	int	type, planenum;
 
 	if( VectorLength( srcnormal ) < 0.5 )
 		return -1;
 
-	// create a new plane
-	if(( g_nummapplanes + 2 ) > MAX_INTERNAL_MAP_PLANES )
+	// reserve two slots for pair of opposite planes
+	planenum = InterlockedExchangeAdd( (volatile long *)&g_nummapplanes, 2 );
+
+	if(( planenum + 2 ) > MAX_INTERNAL_MAP_PLANES )
 		COM_FatalError( "MAX_INTERNAL_MAP_PLANES limit exceeded\n" );
 
-	p0 = &g_mapplanes[g_nummapplanes+0];
-	p1 = &g_mapplanes[g_nummapplanes+1];
+	p0 = &g_mapplanes[planenum+0];
+	p1 = &g_mapplanes[planenum+1];
 
 	// snap plane normal
 	VectorCopy( srcnormal, normal );
@@ -100,7 +154,6 @@ int CreateNewFloatPlane( const vec3_t srcnormal, const vec3_t origin )
 	p1->dist = -dist;
 	p0->type = type;
 	p1->type = type;
-	g_nummapplanes += 2;
 
 	// always put axial planes facing positive first
 	if( normal[type % 3] < 0 )
@@ -112,131 +165,76 @@ int CreateNewFloatPlane( const vec3_t srcnormal, const vec3_t origin )
 
 		AddPlaneToHash( p0 );
 		AddPlaneToHash( p1 );
-		return g_nummapplanes - 1;
+		return planenum + 1;
 	}
 
 	AddPlaneToHash( p0 );
 	AddPlaneToHash( p1 );
 
-	return g_nummapplanes - 2;
+	return planenum;
 }
 
 /*
 =============
-FindFloatPlane
+SearchPlaneBins
 
+search the border bins as well
 =============
 */
-int FindFloatPlane( const vec3_t normal, const vec3_t origin )
+static int SearchPlaneBins( const int bins[3], const vec3_t normal, const vec3_t origin, vec_t dist )
 {
-	int	i, hash, h;
-	vec_t	dist;
 	plane_t	*p;
 
-	dist = DotProduct( origin, normal );
-	hash = (PLANE_HASHES - 1) & (int)fabs( dist );
-
-	ThreadLock();
-
-	// search the border bins as well
-	for( i = -1; i <= 1; i++ )
+	for( int i = 0; i < 3; i++ )
 	{
-		h = (hash + i) & (PLANE_HASHES - 1);
-		for( int pidx = g_planehash[h] - 1; pidx != -1; pidx = g_mapplanes[pidx].hash_chain - 1 )
+		for( int pidx = g_planehash[bins[i]] - 1; pidx != -1; pidx = p->hash_chain - 1 )
 		{
 			p = &g_mapplanes[pidx];
 
 			if( PlaneEqual( p, normal, origin, dist ))
-			{
-				ThreadUnlock();
-				return p - g_mapplanes;
-			}
+				return pidx;
 		}
 	}
 
-	// allocate a new two opposite planes
-	int returnval = CreateNewFloatPlane( normal, origin );
-
-	ThreadUnlock();
-
-	return returnval;
+	return -1;
 }
 
-int FindFloatPlane2( const vec3_t normal, const vec3_t origin )
-{
-	int	returnval;
-	plane_t	*p, temp;
-	vec_t	t;
-
-	returnval = 0;
-
-find_plane:
-	for( ; returnval < g_nummapplanes; returnval++ )
-	{
-		// BUG: there might be some multithread issue --vluzacn
-		if( -DIR_EPSILON < ( t = normal[0] - g_mapplanes[returnval].normal[0] ) && t < DIR_EPSILON &&
-		    -DIR_EPSILON < ( t = normal[1] - g_mapplanes[returnval].normal[1] ) && t < DIR_EPSILON &&
-		    -DIR_EPSILON < ( t = normal[2] - g_mapplanes[returnval].normal[2] ) && t < DIR_EPSILON )
-		{
-			t = DotProduct (origin, g_mapplanes[returnval].normal) - g_mapplanes[returnval].dist;
-
-			if( -DIST_EPSILON < t && t < DIST_EPSILON )
-				return returnval;
-		}
-	}
+/*
+=============
+FindFloatPlane
 
-	ThreadLock();
+existing planes are found without locking,
+new planes are inserted under the bin locks
+=============
+*/
+int FindFloatPlane( const vec3_t normal, const vec3_t origin )
+{
+	int	hash, bins[3];
+	int	planenum;
+	vec_t	dist;
 
-	if( returnval != g_nummapplanes ) // make sure we don't race
-	{
-		ThreadUnlock();
-		// check to see if other thread added plane we need
-		goto find_plane;
-	}
+	dist = DotProduct( origin, normal );
+	hash = PlaneHashForDist( dist );
 
-	// create new planes - double check that we have room for 2 planes
-	if(( g_nummapplanes + 2 ) > MAX_INTERNAL_MAP_PLANES )
-		COM_FatalError( "MAX_INTERNAL_MAP_PLANES limit exceeded\n" );
+	bins[0] = (hash - 1) & (PLANE_HASHES - 1);
+	bins[1] = hash;
+	bins[2] = (hash + 1) & (PLANE_HASHES - 1);
 
-	p = &g_mapplanes[g_nummapplanes];
-	VectorCopy( origin, p->origin );
-	VectorCopy( normal, p->normal );
-	VectorNormalize( p->normal );
-	p->type = MapPlaneTypeForNormal( p->normal );
-	// snap normal to nearest axial if possible
-	if( p->type <= PLANE_LAST_AXIAL )
-	{
-		for( int i = 0; i < 3; i++ )
-		{
-			if( i == p->type )
-				p->normal[i] = p->normal[i] > 0 ? 1 : -1;
-			else p->normal[i] = 0;
-		}
-	}
+	if(( planenum = SearchPlaneBins( bins, normal, origin, dist )) != -1 )
+		return planenum;
 
-	p->dist = DotProduct( origin, p->normal );
-	VectorCopy( origin, (p+1)->origin );
-	VectorNegate( p->normal, (p+1)->normal );
-	(p+1)->type = p->type;
-	(p+1)->dist = -p->dist;
+	LockPlaneBins( bins );
 
-	// always put axial planes facing positive first
-	if( normal[(p->type) % 3] < 0 )
-	{
-		temp = *p;
-		*p = *(p+1);
-		*(p+1) = temp;
-		returnval = g_nummapplanes + 1;
-	}
-	else
+	// check to see if other thread added plane we need
+	if(( planenum = SearchPlaneBins( bins, normal, origin, dist )) == -1 )
 	{
-		returnval = g_nummapplanes;
+		// allocate a new two opposite planes
+		planenum = CreateNewFloatPlane( normal, origin );
 	}
 
-	g_nummapplanes += 2;
-	ThreadUnlock();
+	UnlockPlaneBins( bins );
 
-	return returnval;
+	return planenum;
 }
 
 /*
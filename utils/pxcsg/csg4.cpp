@@ -13,6 +13,26 @@
 int	c_outfaces;
 int	g_firstbrush;
 
+#define CSG_GRID_MAX_DIM		128	// cells per axis
+#define CSG_GRID_MAX_CELLS		64	// bigger brushes are checked against everything
+
+// uniform grid of the brush bounds, one for each hull
+typedef struct
+{
+	vec3_t		origin;
+	vec3_t		cellsize;
+	int		size[3];
+	int		*cellstart;	// numcells + 1
+	int		*cellbrushes;	// entity brush indexes, sorted in each cell
+	int		*large;		// brushes that covers too many cells
+	int		numlarge;
+} csggrid_t;
+
+static csggrid_t		g_csggrid[MAX_MAP_HULLS];
+static int		*g_csgstamps[MAX_THREADS];	// last query that touched the brush
+static int		*g_csgcandidates[MAX_THREADS];
+static int		g_csgquery[MAX_THREADS];
+
 /*
 ===========
 AllocFace
@@ -238,6 +258,230 @@ static void SaveOutside( brush_t *b, int hull, bface_t *outside )
 	}
 }
 
+//==========================================================================
+/*
+===========
+CSGGridCells
+
+returns the number of covered cells
+===========
+*/
+static int CSGGridCells( const csggrid_t *grid, const vec3_t mins, const vec3_t maxs, int lo[3], int hi[3] )
+{
+	int	count = 1;
+
+	for( int i = 0; i < 3; i++ )
+	{
+		lo[i] = (int)floor(( mins[i] - grid->origin[i] ) / grid->cellsize[i] );
+		hi[i] = (int)floor(( maxs[i] - grid->origin[i] ) / grid->cellsize[i] );
+		lo[i] = bound( 0, lo[i], grid->size[i] - 1 );
+		hi[i] = bound( 0, hi[i], grid->size[i] - 1 );
+		count *= ( hi[i] - lo[i] + 1 );
+	}
+
+	return count;
+}
+
+/*
+===========
+CSGGridUsesBrush
+===========
+*/
+static bool CSGGridUsesBrush( const brush_t *b, int hull )
+{
+	const brushhull_t	*bh = &b->hull[hull];
+
+	if( b->contents == CONTENTS_EMPTY || !bh->faces )
+		return false;
+
+	if( hull == 0 && FBitSet( b->flags, FBRUSH_NOCSG ))
+		return false;
+
+	return true;
+}
+
+/*
+===========
+BuildCSGGrid
+
+only brushes that can clip something are linked
+===========
+*/
+static void BuildCSGGrid( const mapent_t *e, int hull )
+{
+	csggrid_t	*grid = &g_csggrid[hull];
+	int	lo[3], hi[3];
+	vec3_t	mins, maxs;
+	int	i, x, y, z;
+	int	numcells;
+	int	pass;
+	vec_t	volume;
+
+	memset( grid, 0, sizeof( *grid ));
+	ClearBounds( mins, maxs );
+
+	for( i = 0; i < e->numbrushes; i++ )
+	{
+		brush_t	*b = &g_mapbrushes[e->firstbrush + i];
+
+		if( !CSGGridUsesBrush( b, hull ))
+			continue;
+		AddPointToBounds( b->hull[hull].mins, mins, maxs );
+		AddPointToBounds( b->hull[hull].maxs, mins, maxs );
+	}
+
+	if( mins[0] > maxs[0] )
+	{
+		// nothing to clip
+		VectorClear( mins );
+		VectorClear( maxs );
+	}
+
+	// roughly one cell per brush
+	volume = 1.0;
+	for( i = 0; i < 3; i++ )
+		volume *= Q_max( maxs[i] - mins[i], 1.0 );
+	vec_t edge = pow( volume / Q_max( e->numbrushes, 1 ), 1.0 / 3.0 );
+
+	VectorCopy( mins, grid->origin );
+
+	for( i = 0; i < 3; i++ )
+	{
+		vec_t	extent = Q_max( maxs[i] - mins[i], 1.0 );
+
+		grid->size[i] = bound( 1, (int)ceil( extent / Q_max( edge, 1.0 )), CSG_GRID_MAX_DIM );
+		grid->cellsize[i] = extent / grid->size[i];
+	}
+
+	numcells = grid->size[0] * grid->size[1] * grid->size[2];
+	grid->cellstart = (int *)Mem_Alloc(( numcells + 1 ) * sizeof( int ));
+	grid->large = (int *)Mem_Alloc( e->numbrushes * sizeof( int ));
+
+	// first pass count the links, second pass fill the cells
+	for( pass = 0; pass < 2; pass++ )
+	{
+		int	*fill = NULL;
+
+		if( pass == 1 )
+		{
+			// convert counts into starts
+			for( i = 0, x = 0; i <= numcells; i++ )
+			{
+				y = grid->cellstart[i];
+				grid->cellstart[i] = x;
+				x += y;
+			}
+
+			grid->cellbrushes = (int *)Mem_Alloc( Q_max( x, 1 ) * sizeof( int ));
+			fill = (int *)Mem_Alloc( numcells * sizeof( int ));
+			memcpy( fill, grid->cellstart, numcells * sizeof( int ));
+		}
+
+		for( i = 0; i < e->numbrushes; i++ )
+		{
+			brush_t	*b = &g_mapbrushes[e->firstbrush + i];
+
+			if( !CSGGridUsesBrush( b, hull ))
+				continue;
+
+			if( CSGGridCells( grid, b->hull[hull].mins, b->hull[hull].maxs, lo, hi ) > CSG_GRID_MAX_CELLS )
+			{
+				if( pass == 1 ) grid->large[grid->numlarge++] = i;
+				continue;
+			}
+
+			for( z = lo[2]; z <= hi[2]; z++ )
+			{
+				for( y = lo[1]; y <= hi[1]; y++ )
+				{
+					for( x = lo[0]; x <= hi[0]; x++ )
+					{
+						int	cell = ( z * grid->size[1] + y ) * grid->size[0] + x;
+
+						if( pass == 0 ) grid->cellstart[cell]++;
+						else grid->cellbrushes[fill[cell]++] = i;
+					}
+				}
+			}
+		}
+
+		if( fill ) Mem_Free( fill );
+	}
+}
+
+/*
+===========
+FreeCSGGrid
+===========
+*/
+static void FreeCSGGrid( int hull )
+{
+	csggrid_t	*grid = &g_csggrid[hull];
+
+	Mem_Free( grid->cellstart );
+	Mem_Free( grid->cellbrushes );
+	Mem_Free( grid->large );
+	memset( grid, 0, sizeof( *grid ));
+}
+
+static int CSGSortCandidates( const void *a, const void *b )
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+/*
+===========
+CSGGridCandidates
+
+collect brushes which bounds may intersect with
+specified bounds. they are returned in ascending
+order to keep the output exactly as full search
+===========
+*/
+static int CSGGridCandidates( int hull, const vec3_t mins, const vec3_t maxs, int thread )
+{
+	const csggrid_t	*grid = &g_csggrid[hull];
+	int		*stamps = g_csgstamps[thread];
+	int		*list = g_csgcandidates[thread];
+	int		query = ++g_csgquery[thread];
+	int		lo[3], hi[3];
+	int		i, x, y, z;
+	int		count = 0;
+
+	for( i = 0; i < grid->numlarge; i++ )
+	{
+		stamps[grid->large[i]] = query;
+		list[count++] = grid->large[i];
+	}
+
+	CSGGridCells( grid, mins, maxs, lo, hi );
+
+	for( z = lo[2]; z <= hi[2]; z++ )
+	{
+		for( y = lo[1]; y <= hi[1]; y++ )
+		{
+			for( x = lo[0]; x <= hi[0]; x++ )
+			{
+				int	cell = ( z * grid->size[1] + y ) * grid->size[0] + x;
+
+				for( i = grid->cellstart[cell]; i < grid->cellstart[cell+1]; i++ )
+				{
+					int	bn = grid->cellbrushes[i];
+
+					if( stamps[bn] == query )
+						continue;
+					stamps[bn] = query;
+					list[count++] = bn;
+				}
+			}
+		}
+	}
+
+	qsort( list, count, sizeof( int ), CSGSortCandidates );
+
+	return count;
+}
+
 //==========================================================================
 /*
 ===========
@@ -246,6 +490,8 @@ CSGBrush
 */
 static void CSGBrush( int brushnum, int threadnum = -1 )
 {
+	int		*candidates;
+	int		numcandidates;
 	bface_t		*f, *f2, *next;
 	brushhull_t	*bh1, *bh2;
 	bool		overwrite;
@@ -292,9 +538,18 @@ static void CSGBrush( int brushnum, int threadnum = -1 )
 			}
 		}
 
-		// for each brush in entity e
-		for( int bn = 0; bn < e->numbrushes; bn++ )
+		if( bh1->faces )
 		{
+			numcandidates = CSGGridCandidates( hull, bh1->mins, bh1->maxs, Q_max( threadnum, 0 ));
+			candidates = g_csgcandidates[Q_max( threadnum, 0 )];
+		}
+		else numcandidates = 0;
+
+		// for each brush in entity e that touches b1
+		for( int cn = 0; cn < numcandidates; cn++ )
+		{
+			int	bn = candidates[cn];
+
 			// see if b2 needs to clip a chunk out of b1
 			if( e->firstbrush + bn == brushnum )
 				continue;
@@ -389,14 +644,10 @@ static void CSGBrush( int brushnum, int threadnum = -1 )
 						}
 					}
 
-					winding_t	*fw, *bw;
-
-					ClipWindingEpsilon( w, f2->plane->normal, f2->plane->dist, g_csgepsilon, &fw, &bw );
+					winding_t	*bw;
 
-					if( fw )
-					{
-						FreeWinding( fw );
-					}
+					// front part is never used, so don't build it
+					ClipWindingEpsilon( w, f2->plane->normal, f2->plane->dist, g_csgepsilon, NULL, &bw );
 
 					if( bw )
 					{
@@ -570,9 +821,21 @@ void ChopEntityBrushes( mapent_t *mapent )
 {
 	ASSERT( mapent->numbrushes > 0 );
 
+	int	i;
+
 	// sort the contents down so stone bites water, etc
 	g_firstbrush = mapent->firstbrush;
 
+	for( i = 0; i < MAX_MAP_HULLS; i++ )
+		BuildCSGGrid( mapent, i );
+
+	for( i = 0; i < Q_max( g_numthreads, 1 ); i++ )
+	{
+		g_csgstamps[i] = (int *)Mem_Alloc( mapent->numbrushes * sizeof( int ));
+		g_csgcandidates[i] = (int *)Mem_Alloc( mapent->numbrushes * sizeof( int ));
+		g_csgquery[i] = 0;
+	}
+
 	// csg them in order
 	if( mapent == &g_mapentities[0] )
 	{
@@ -583,4 +846,14 @@ void ChopEntityBrushes( mapent_t *mapent )
 		// brushmodels use silent threads
 		RunThreadsOnIndividual( mapent->numbrushes, false, CSGBrush );
 	}
+
+	for( i = 0; i < Q_max( g_numthreads, 1 ); i++ )
+	{
+		Mem_Free( g_csgstamps[i] );
+		Mem_Free( g_csgcandidates[i] );
+		g_csgstamps[i] = g_csgcandidates[i] = NULL;
+	}
+
+	for( i = 0; i < MAX_MAP_HULLS; i++ )
+		FreeCSGGrid( i );
 }
\ No newline at end of file
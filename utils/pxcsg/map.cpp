@@ -21,6 +21,35 @@ static short	g_world_faceinfo = -1;	// shared faceinfo in case level-desginer ap
 int		g_world_luxels = 0;		// alternative lightmap matrix will be used (luxels per world units instead of luxels per texels)
 static int	g_brushtype = BRUSH_UNKNOWN;
 
+#define PARALLEL_MIN_BRUSHES	64
+
+// brush parsed ahead of the serial pass
+typedef struct
+{
+	const char	*start;		// script position after the opening brace
+	const char	*end;		// script position after the closing brace
+	int		line;
+	int		endline;
+	int		entitynum;	// for messages only
+	int		brushnum;
+	bool		brushdef;		// radiant brush primitive
+	bool		wc22;		// first side switches brush to Worldcraft 2.2
+	bool		radiant;		// sides keeps the raw texture matrix
+	bool		ready;
+	short		end_type;		// brush type after the brush
+	brush_t		brush;
+} prebrush_t;
+
+typedef struct
+{
+	CUtlArray<prebrush_t>	brushes;
+	const char		*start;	// script text
+	const char		*end;
+	int			current;	// first brush not reached by the serial parser
+} prescan_t;
+
+static prescan_t	*g_prescan = NULL;
+
 const char *g_sMapType[BRUSH_COUNT] =
 {
 "Unknown format",
@@ -368,10 +397,8 @@ SetupSideParams
 load shader, apply side flags
 =================
 */
-static void SetupSideParams( mapent_t *mapent, brush_t *brush, side_t *side )
+static void SetupSideParams( brush_t *brush, side_t *side )
 {
-	const char *classname = ValueForKey( (entity_t *)mapent, "classname" );
-
 	// check for Quake1 issues
 	if( side->name[0] == '*' )
 		side->name[0] = '!';
@@ -379,7 +406,9 @@ static void SetupSideParams( mapent_t *mapent, brush_t *brush, side_t *side )
 	SetupSideContents( brush, side );
 
 	// try to find shader for this side
+	ThreadLock();
 	side->shader = ShaderInfoForShader( side->name );
+	ThreadUnlock();
 
 	// no user shader specified, ignore it
 	if( !FBitSet( side->shader->flags, FSHADER_DEFAULTED ))
@@ -431,34 +460,89 @@ static void SetupSideParams( mapent_t *mapent, brush_t *brush, side_t *side )
 		SetBits( side->flags, FSIDE_NOLIGHTMAP );
 		SetBits( brush->flags, FBRUSH_NOCSG );
 	}
+}
 
-	// for each face of each brush of this entity
-	if( BoolForKey( (entity_t *)mapent, "zhlt_invisible" ) && side->contents != CONTENTS_ORIGIN )
-		SetBits( side->flags, FSIDE_NODRAW );
+/*
+=================
+SetupBrushEntityParams
 
-	const int shadow = IntForKey( (entity_t *)mapent, "_shadow" );
+apply entity settings to the brush and its sides
+=================
+*/
+static void SetupBrushEntityParams( mapent_t *mapent, brush_t *brush )
+{
+	const char	*classname = ValueForKey( (entity_t *)mapent, "classname" );
+	bool		invisible = BoolForKey( (entity_t *)mapent, "zhlt_invisible" );
+	const int		shadow = IntForKey( (entity_t *)mapent, "_shadow" );
+	bool		nodirt = ( IntForKey( (entity_t *)mapent, "_dirt" ) == -1 );
 
-	if( IntForKey( (entity_t *)mapent, "_dirt" ) == -1 )
-		SetBits( side->flags, FSIDE_NODIRT );
+	// read ZHLT settings for this brush (detail shaders have a priority)
+	if( !brush->detaillevel )
+		brush->detaillevel = Q_max( IntForKey( (entity_t *)mapent, "zhlt_detaillevel" ), 0 );
 
-	if( shadow == -1 )
-		SetBits( side->flags, FSIDE_NOSHADOW );
+	if( BoolForKey( (entity_t *)mapent, "zhlt_noclip" ))
+		SetBits( brush->flags, FBRUSH_NOCLIP );
+	if( BoolForKey( (entity_t *)mapent, "zhlt_nocsg" ))
+		SetBits( brush->flags, FBRUSH_NOCSG );
 
-	if( !Q_stricmp( classname, "func_detail_illusionary" ))
+	// for each face of each brush of this entity
+	for( int i = 0; i < brush->sides.Count(); i++ )
 	{
-		// mark these entities as TEX_NOSHADOW unless the mapper set "_shadow" "1"
-		if( shadow != 1 ) SetBits( side->flags, FSIDE_NOSHADOW );
+		side_t	*side = &brush->sides[i];
+
+		if( invisible && side->contents != CONTENTS_ORIGIN )
+			SetBits( side->flags, FSIDE_NODRAW );
+
+		if( nodirt )
+			SetBits( side->flags, FSIDE_NODIRT );
+
+		if( shadow == -1 )
+			SetBits( side->flags, FSIDE_NOSHADOW );
+
+		if( !Q_stricmp( classname, "func_detail_illusionary" ))
+		{
+			// mark these entities as TEX_NOSHADOW unless the mapper set "_shadow" "1"
+			if( shadow != 1 ) SetBits( side->flags, FSIDE_NOSHADOW );
+		}
 	}
 }
 
+/*
+=================
+SetupRadiantVectors
+
+brush primitives needs a texture size
+=================
+*/
+static void SetupRadiantVectors( side_t *side, const vec_t matrix[2][3] )
+{
+	int	width, height;
+	vec3_t	axis[2];
+
+	TEX_GetSize( side->shader->imagePath, &width, &height );
+	TextureAxisFromSide( side, axis[0], axis[1], true );
+
+	side->vecs[0][0] = width * ((axis[0][0] * matrix[0][0]) + (axis[1][0] * matrix[0][1]));
+	side->vecs[0][1] = width * ((axis[0][1] * matrix[0][0]) + (axis[1][1] * matrix[0][1]));
+	side->vecs[0][2] = width * ((axis[0][2] * matrix[0][0]) + (axis[1][2] * matrix[0][1]));
+	side->vecs[0][3] = width * matrix[0][2];
+
+	side->vecs[1][0] = height * ((axis[0][0] * matrix[1][0]) + (axis[1][0] * matrix[1][1]));
+	side->vecs[1][1] = height * ((axis[0][1] * matrix[1][0]) + (axis[1][1] * matrix[1][1]));
+	side->vecs[1][2] = height * ((axis[0][2] * matrix[1][0]) + (axis[1][2] * matrix[1][1]));
+	side->vecs[1][3] = height * matrix[1][2];
+}
+
 /*
 =================
 SetupTextureVectors
 
-parse and setup tex->vecs
+parse and setup tex->vecs. Ahead of the serial
+parse the radiant matrix is kept in side->vecs
+because texture size is unknown yet
 =================
 */
-static void SetupTextureVectors( mapent_t *mapent, brush_t *brush, side_t *side, short &brush_type )
+static bool SetupTextureVectors( brush_t *brush, side_t *side, short &brush_type, prebrush_t *ahead )
 {
 	int	side_flags = 0;
 	bool	read_flags;
@@ -471,7 +555,7 @@ static void SetupTextureVectors( mapent_t *mapent, brush_t *brush, side_t *side,
 	GetToken( false );
 
 	Q_strncpy( side->name, token, sizeof( side->name ));
-	SetupSideParams( mapent, brush, side );
+	SetupSideParams( brush, side );
 
 	// continue determine brush type
 	if( brush_type != BRUSH_RADIANT )
@@ -479,6 +563,8 @@ static void SetupTextureVectors( mapent_t *mapent, brush_t *brush, side_t *side,
 
 	if( brush_type == BRUSH_WORLDCRAFT_22 || !Q_strcmp( token, "[" )) // Worldcraft 2.2+
 	{
+		if( ahead && brush->sides.Count() == 1 && brush_type != BRUSH_WORLDCRAFT_22 )
+			ahead->wc22 = true;
 		brush_type = BRUSH_WORLDCRAFT_22;
 
 		// texture U axis
@@ -682,21 +768,13 @@ static void SetupTextureVectors( mapent_t *mapent, brush_t *brush, side_t *side,
 	}
 	else if( brush_type == BRUSH_RADIANT )
 	{
-		int	width, height;
-		vec3_t	axis[2];
-
-		TEX_GetSize( side->shader->imagePath, &width, &height );
-		TextureAxisFromSide( side, axis[0], axis[1], true );
-
-		side->vecs[0][0] = width * ((axis[0][0] * tex_vects.matrix[0][0]) + (axis[1][0] * tex_vects.matrix[0][1]));
-		side->vecs[0][1] = width * ((axis[0][1] * tex_vects.matrix[0][0]) + (axis[1][1] * tex_vects.matrix[0][1]));
-		side->vecs[0][2] = width * ((axis[0][2] * tex_vects.matrix[0][0]) + (axis[1][2] * tex_vects.matrix[0][1]));
-		side->vecs[0][3] = width * tex_vects.matrix[0][2];
-
-		side->vecs[1][0] = height * ((axis[0][0] * tex_vects.matrix[1][0]) + (axis[1][0] * tex_vects.matrix[1][1]));
-		side->vecs[1][1] = height * ((axis[0][1] * tex_vects.matrix[1][0]) + (axis[1][1] * tex_vects.matrix[1][1]));
-		side->vecs[1][2] = height * ((axis[0][2] * tex_vects.matrix[1][0]) + (axis[1][2] * tex_vects.matrix[1][1]));
-		side->vecs[1][3] = height * tex_vects.matrix[1][2];
+		if( ahead )
+		{
+			// TEX_GetSize modifies the miptex list, so leave it for the serial pass
+			for( int i = 0; i < 2; i++ )
+				VectorCopy( tex_vects.matrix[i], side->vecs[i] );
+		}
+		else SetupRadiantVectors( side, tex_vects.matrix );
 	}
 
 	// Quake3 detail brushes or Volatile3D detail brushes
@@ -708,7 +786,10 @@ static void SetupTextureVectors( mapent_t *mapent, brush_t *brush, side_t *side,
 //		SetBits( brush->flags, FBRUSH_NOCSG );
 	}
 
-	// Doom2Gold extrainfo
+	// Doom2Gold extrainfo (faceinfo table is not thread-safe)
+	if( g_DXspecial != 0 && ahead )
+		return false;
+
 	if( g_DXspecial != 0 )
 	{
 		dfaceinfo_t	*fi = NULL;
@@ -741,42 +822,36 @@ static void SetupTextureVectors( mapent_t *mapent, brush_t *brush, side_t *side,
 		TryToken(); // unused
 		TryToken(); // unused
 	}
+
+	return true;
 }
 
 /*
 =================
-ParseBrush
+ParseBrushSides
+
+returns false if the brush can't be parsed ahead
+of the serial pass, script state is undefined then
 =================
 */
-static void ParseBrush( mapent_t *mapent, short entindex, short faceinfo, short &brush_type )
+static bool ParseBrushSides( brush_t *brush, short faceinfo, short &brush_type, prebrush_t *ahead )
 {
-	brush_t	*brush;
+	short	start_type = brush_type;
 	side_t	*side;
-	int	i;
 
 	if( brush_type == BRUSH_RADIANT )
 		CheckToken( "{" );
 
-	brush = AllocBrush( mapent );
-	brush->originalentitynum = g_numparsedentities;
-	brush->originalbrushnum = g_numparsedbrushes;
-	brush->entitynum = entindex;
-
-	// read ZHLT settings for this brush
-	brush->detaillevel = Q_max( IntForKey( (entity_t *)mapent, "zhlt_detaillevel" ), 0 );
-
-	if( BoolForKey( (entity_t *)mapent, "zhlt_noclip" ))
-		SetBits( brush->flags, FBRUSH_NOCLIP );
-	if( BoolForKey( (entity_t *)mapent, "zhlt_nocsg" ))
-		SetBits( brush->flags, FBRUSH_NOCSG );
-
 	while( 1 )
 	{
 		g_TXcommand = 0;
 		g_DXspecial = 0;
 
 		if( !GetToken( true ))
+		{
+			if( ahead ) return false;
 			break;
+		}
 
 		if( !Q_strcmp( token, "}" ))
 			break;
@@ -803,9 +878,14 @@ static void ParseBrush( mapent_t *mapent, short entindex, short faceinfo, short
 		// store faceinfo number for group of brushes. Otherwise write -1
 		side->faceinfo = faceinfo;
 
-		SetupTextureVectors( mapent, brush, side, brush_type );
+		if( !SetupTextureVectors( brush, side, brush_type, ahead ))
+			return false;
 	}
 
+	// radiant matrices are stored for the whole brush
+	if( ahead && start_type == BRUSH_RADIANT && brush_type != BRUSH_RADIANT )
+		return false;
+
 	if( brush_type == BRUSH_RADIANT )
 	{
 		UnGetToken();
@@ -813,6 +893,23 @@ static void ParseBrush( mapent_t *mapent, short entindex, short faceinfo, short
 		CheckToken( "}" );
 	}
 
+	return true;
+}
+
+/*
+=================
+FinishBrush
+
+entity dependent part of the brush setup
+=================
+*/
+static void FinishBrush( mapent_t *mapent, brush_t *brush )
+{
+	side_t	*side;
+	int	i;
+
+	SetupBrushEntityParams( mapent, brush );
+
 	brush->contents = BrushContents( mapent, brush );
 
 	// check for faces that should be a nullify
@@ -861,6 +958,262 @@ static void ParseBrush( mapent_t *mapent, short entindex, short faceinfo, short
 	}
 }
 
+/*
+=================
+ParseBrush
+=================
+*/
+static void ParseBrush( mapent_t *mapent, short entindex, short faceinfo, short &brush_type )
+{
+	brush_t	*brush;
+
+	brush = AllocBrush( mapent );
+	brush->originalentitynum = g_numparsedentities;
+	brush->originalbrushnum = g_numparsedbrushes;
+	brush->entitynum = entindex;
+
+	ParseBrushSides( brush, faceinfo, brush_type, NULL );
+	FinishBrush( mapent, brush );
+}
+
+/*
+==============================================================================
+
+PARALLEL BRUSH PARSING
+
+brushes of a script are found by the fast token scan first,
+then parsed and set up in parallel. The serial parser still
+walks through the entities and takes each prepared brush when
+it reaches its position and the brush would be parsed the same
+way, so numbering and the order of global tables is unchanged.
+Everything else is parsed as before
+==============================================================================
+*/
+/*
+=================
+ScanMapBrushes
+
+finds the brush bodies in the rest of current script,
+patches and terrains are left to the serial parser
+=================
+*/
+static void ScanMapBrushes( prescan_t *scan )
+{
+	int	line, entitynum = 0;
+	const char	*pos;
+
+	scan->start = GetScriptPointer( &scan->end, &line );
+	scan->current = 0;
+
+	if( !scan->start ) return;
+
+	PushScriptMemory( scan->start, scan->end - scan->start, line );
+
+	while( GetToken( true ))
+	{
+		int	brushnum = 0;
+
+		// let the serial parser report the errors
+		if( Q_strcmp( token, "{" ))
+			break;
+
+		while( 1 )
+		{
+			if( !GetToken( true ))
+				goto done;
+
+			if( !Q_strcmp( token, "}" ))
+				break;
+
+			if( Q_strcmp( token, "{" ))
+			{
+				// value must be on the same line
+				if( !TokenAvailable( ))
+					goto done;
+				GetToken( false );
+				continue;
+			}
+
+			pos = GetScriptPointer( NULL, &line );
+
+			if( !GetToken( true ))
+				goto done;
+
+			bool	terrain = !Q_strcmp( token, "terrainDef" );
+			bool	patch = !Q_strcmp( token, "patchDef2" );
+			bool	include = false;
+			int	depth = 1;
+
+			// skip the body
+			do {
+				if( !Q_strcmp( token, "{" ))
+					depth++;
+				else if( !Q_strcmp( token, "}" ))
+					depth--;
+				else if( !Q_stricmp( token, "$include" ))
+					include = true;
+				if( depth > 0 && !GetToken( true ))
+					goto done;
+			} while( depth > 0 );
+
+			if( !terrain && !patch && !include )
+			{
+				prebrush_t	*pb = &scan->brushes[scan->brushes.AddToTail()];
+
+				memset( pb, 0, sizeof( prebrush_t ));
+				pb->start = pos;
+				pb->line = line;
+				pb->entitynum = entitynum;
+				pb->brushnum = brushnum;
+			}
+
+			if( !terrain ) brushnum++;
+		}
+
+		entitynum++;
+	}
+done:
+	PopScriptMemory();
+}
+
+/*
+=================
+ParseBrushAhead
+
+plain brushes are parsed as the Worldcraft 2.1
+since brush type before them is unknown yet
+=================
+*/
+static void ParseBrushAhead( int num, int threadnum )
+{
+	prebrush_t	*pb = &g_prescan->brushes[num];
+	short		brush_type = BRUSH_WORLDCRAFT_21;
+	brush_t		*brush = &pb->brush;
+
+	PushScriptMemory( pb->start, g_prescan->end - pb->start, pb->line );
+	brush->originalentitynum = pb->entitynum;
+	brush->originalbrushnum = pb->brushnum;
+
+	if( GetToken( true ))
+	{
+		if( !Q_strcmp( token, "brushDef" ))
+		{
+			brush_type = BRUSH_RADIANT;
+			pb->brushdef = true;
+		}
+		else UnGetToken();
+
+		if( ParseBrushSides( brush, -1, brush_type, pb ))
+		{
+			pb->end = GetScriptPointer( NULL, &pb->endline );
+			pb->radiant = ( brush_type == BRUSH_RADIANT );
+			pb->end_type = brush_type;
+			pb->ready = ( pb->end > pb->start && pb->end <= g_prescan->end );
+		}
+	}
+
+	PopScriptMemory();
+}
+
+/*
+=================
+PrepareScriptBrushes
+=================
+*/
+static void PrepareScriptBrushes( prescan_t *scan )
+{
+	ScanMapBrushes( scan );
+
+	if( scan->brushes.Count() < PARALLEL_MIN_BRUSHES )
+		return;
+
+	g_prescan = scan;
+	RunThreadsOnIndividual( scan->brushes.Count(), false, ParseBrushAhead );
+}
+
+/*
+=================
+FreeScriptBrushes
+=================
+*/
+static void FreeScriptBrushes( prescan_t *scan )
+{
+	for( int i = 0; i < scan->brushes.Count(); i++ )
+		scan->brushes[i].brush.sides.Purge();
+	scan->brushes.Purge();
+}
+
+/*
+=================
+TakePreparedBrush
+
+moves the prepared brush into the entity if it was parsed
+from this position with the same brush type
+=================
+*/
+static bool TakePreparedBrush( mapent_t *mapent, short entindex, short faceinfo, short &brush_type, const char *pos )
+{
+	prescan_t		*scan = g_prescan;
+	prebrush_t	*pb;
+	brush_t		*brush;
+
+	// $include may switch the text
+	if( !scan || pos < scan->start || pos > scan->end )
+		return false;
+
+	while( scan->current < scan->brushes.Count() && scan->brushes[scan->current].start < pos )
+		scan->current++;
+
+	if( scan->current == scan->brushes.Count( ))
+		return false;
+
+	pb = &scan->brushes[scan->current];
+
+	if( pb->start != pos || !pb->ready )
+		return false;
+
+	// brush was parsed as Worldcraft 2.1 which gives the same
+	// result for 2.2 and QuArK types if the first side is 2.2
+	if( !pb->brushdef )
+	{
+		short	incoming = ( brush_type == BRUSH_UNKNOWN ) ? BRUSH_WORLDCRAFT_21 : brush_type;
+
+		if( incoming != BRUSH_WORLDCRAFT_21 && !( pb->wc22 && ( incoming == BRUSH_WORLDCRAFT_22 || incoming == BRUSH_QUARK )))
+			return false;
+	}
+
+	brush = AllocBrush( mapent );
+	memcpy( brush, &pb->brush, sizeof( brush_t ));
+	memset( &pb->brush, 0, sizeof( brush_t ));
+	pb->ready = false;
+
+	brush->originalentitynum = g_numparsedentities;
+	brush->originalbrushnum = g_numparsedbrushes;
+	brush->entitynum = entindex;
+
+	for( int i = 0; i < brush->sides.Count(); i++ )
+	{
+		side_t	*side = &brush->sides[i];
+		vec_t	matrix[2][3];
+
+		side->faceinfo = faceinfo;
+
+		if( !pb->radiant )
+			continue;
+
+		VectorCopy( side->vecs[0], matrix[0] );
+		VectorCopy( side->vecs[1], matrix[1] );
+		SetupRadiantVectors( side, matrix );
+	}
+
+	SetScriptPointer( pb->end, pb->endline );
+	brush_type = pb->end_type;
+
+	FinishBrush( mapent, brush );
+
+	return true;
+}
+
 /*
 ================
 ParseMapEntity
@@ -1001,6 +1354,8 @@ bool ParseMapEntity( CUtlArray<mapent_t> *entities, bool external = false )
 
 		if( !Q_strcmp( token, "{" ))
 		{
+			const char	*brushpos = GetScriptPointer( NULL, NULL );
+
 			// parse a brush or patch
 			if( !GetToken( true ))
 				break;
@@ -1012,7 +1367,11 @@ bool ParseMapEntity( CUtlArray<mapent_t> *entities, bool external = false )
 			if( !mapent->brushes.Count( ))
 				faceinfo = GetFaceInfoForEntity( mapent );
 
-			if( !Q_strcmp( token, "patchDef2" ))
+			if( TakePreparedBrush( mapent, index, faceinfo, brush_type, brushpos ))
+			{
+				g_numparsedbrushes++;
+			}
+			else if( !Q_strcmp( token, "patchDef2" ))
 			{
 				// NOTE: patchDef may be combined with old brush descripton
 				ParsePatch( mapent, index, faceinfo, brush_type );
@@ -1197,6 +1556,32 @@ bool ParseMapEntity( CUtlArray<mapent_t> *entities, bool external = false )
 	return true;
 }
 
+/*
+=================
+ParseMapEntities
+
+parse all the entities in the current script
+=================
+*/
+static void ParseMapEntities( CUtlArray<mapent_t> *entities, bool external )
+{
+	prescan_t	*oldscan = g_prescan;
+	prescan_t	scan;
+
+	g_prescan = NULL;
+
+	if( g_numthreads > 1 )
+		PrepareScriptBrushes( &scan );
+
+	while( ParseMapEntity( entities, external ))
+	{
+		g_numparsedentities++;
+	}
+
+	FreeScriptBrushes( &scan );
+	g_prescan = oldscan;
+}
+
 /*
 ================
 IncludeMapFile
@@ -1257,10 +1642,7 @@ bool IncludeMapFile( const char *filename, CUtlArray<mapent_t> *entities, int in
 	g_brushtype = BRUSH_UNKNOWN;
 	localents.Purge();
 
-	while( ParseMapEntity( &localents, true ))
-	{
-		g_numparsedentities++;
-	}
+	ParseMapEntities( &localents, true );
 
 	// deal only with world entity (all the misc_models should be recursive include into the worldentity)
 	localworld = &localents[0];
@@ -1434,10 +1816,7 @@ void LoadMapFile( const char *filename )
 	g_numparsedentities = 0;
 	g_mapentities.Purge();
 
-	while( ParseMapEntity( &g_mapentities ))
-	{
-		g_numparsedentities++;
-	}
+	ParseMapEntities( &g_mapentities, false );
 
 	Msg( "LoadMapFile: ^2%s^7\n\n", g_sMapType[g_brushtype] );
 
@@ -175,6 +175,10 @@ SOURCE=.\textures.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\telemetry.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\threads.cpp
 # End Source File
 # Begin Source File
@@ -227,6 +231,10 @@ SOURCE=..\common\shaders.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\telemetry.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\threads.h
 # End Source File
 # End Group
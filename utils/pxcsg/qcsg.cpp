@@ -9,6 +9,7 @@
 ****/
 
 #include "csg.h"
+#include "telemetry.h"
 
 // default compiler settings
 #define DEFAULT_ONLYENTS		false
@@ -636,6 +637,7 @@ static void PrintCsgUsage( void )
 	Msg( "\n-= p2csg Options =-\n\n" );
 	Msg( "    -dev #           : compile with developer message (1 - 4). default is %d\n", DEFAULT_DEVELOPER );
 	Msg( "    -threads #       : manually specify the number of threads to run\n" );
+	Msg( "    -report file     : write build statistics to the file\n" );
 	Msg( "    -noclip          : don't create clipping hulls\n" );
 	Msg( "    -onlyents        : do an entity update from .map to .bsp\n" );
  	Msg( "    -nowadtextures   : include all used textures into bsp\n" );
@@ -654,6 +656,7 @@ main
 */
 int main( int argc, char **argv )
 {
+	char	report[1024];
 	char	source[1024];
 	char	mapname[1024];
 	double	start, end;
@@ -662,6 +665,7 @@ int main( int argc, char **argv )
 
 	atexit( Sys_CloseLog );
 	source[0] = '\0';
+	report[0] = '\0';
 
 	for( i = 1; i < argc; i++ )
 	{
@@ -675,6 +679,11 @@ int main( int argc, char **argv )
 			g_numthreads = atoi( argv[i+1] );
 			i++;
 		}
+		else if( !Q_strcmp( argv[i], "-report" ))
+		{
+			Q_strncpy( report, argv[i+1], sizeof( report ));
+			i++;
+		}
 		else if( !Q_strcmp( argv[i], "-noclip" ))
 		{
 			g_noclip = true;
@@ -779,6 +788,9 @@ int main( int argc, char **argv )
 
 		ProcessModels ( source );
 
+		// release slabs of the clipped windings
+		Mem_ResetArenas ();
+
 		WriteHullSizes( source );
 
 		WriteMapPlanes( source );
@@ -804,5 +816,7 @@ int main( int argc, char **argv )
 	Q_timestring((int)( end - start ), str );
 	Msg( "%s elapsed\n", str );
 
+	Telemetry_WriteReport( report, "p2csg", end - start );
+
 	return 0;
 }
\ No newline at end of file
@@ -483,7 +483,7 @@ void PrecompLightmapOffsets( void )
 		g_lightdatasize += fl->numsamples * 3 * lightstyles;
 	}
 
-	g_dlightdata = (byte *)Mem_Realloc( g_dlightdata, g_lightdatasize );
+	g_dlightdata = (byte *)ReallocLumpData( g_dlightdata, g_lightdatasize );
 }
 
 void FinalLightFace( int facenum, int threadnum )
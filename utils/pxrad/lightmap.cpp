@@ -843,7 +843,8 @@ void CalcFaceExtents( lightinfo_t *l )
 			COM_FatalError( "negative extents\n" );
 	}
 
-	l->lmcache_density = 1;
+	// subsamples are only affordable when most of them are interpolated
+	l->lmcache_density = ( g_extra && g_adaptive ) ? DEFAULT_EXTRA_DENSITY : 1;
 	l->lmcache_side = (int)ceil(( 0.5 * g_blur * l->lmcache_density - 0.5 ) * ( 1.0 - NORMAL_EPSILON ));
 	l->lmcache_offset = l->lmcache_side;
 	l->lmcachewidth = l->texsize[0] * l->lmcache_density + 1 + 2 * l->lmcache_side;
@@ -2246,7 +2247,7 @@ void CreateDirectLights( void )
 #ifdef HLRAD_COMPUTE_VISLIGHTMATRIX
 	// rows: facenum -> visible light bits like a normal vis info
 	g_vislightdatasize = g_numfaces * ((g_numworldlights + 7) / 8);
-	if( g_dvislightdata ) Mem_Free( g_dvislightdata );
+	FreeLumpData( g_dvislightdata );
 	g_dvislightdata = (byte *)Mem_Alloc( g_vislightdatasize );
 #endif
 }
@@ -2697,6 +2698,127 @@ static void AddSamplesToPatches( int threadnum, const sample_t *samples, const b
 	Mem_Free( texwindings );
 }
 
+static void GatherLightmapSample( int thread, lightinfo_t *l, int i, const vec3_t spot, int leaf, const vec3_t normal, byte *vislight )
+{
+	dface_t	*f = l->face;
+
+#if defined( HLRAD_DELUXEMAPPING ) && defined( HLRAD_SHADOWMAPPING )
+	GatherSampleLight( thread, l->surfnum, spot, leaf, normal, l->light[i], l->deluxe[i], l->shadow[i], f->styles, vislight, 0 );
+#elif defined( HLRAD_DELUXEMAPPING )
+	GatherSampleLight( thread, l->surfnum, spot, leaf, normal, l->light[i], l->deluxe[i], NULL, f->styles, vislight, 0 );
+#else
+	GatherSampleLight( thread, l->surfnum, spot, leaf, normal, l->light[i], NULL, NULL, f->styles, vislight, 0 );
+#endif
+}
+
+/*
+=============
+AdaptiveSampleCorners
+
+find lightmap cache samples at the luxel centers around the subsample
+returns false if the subsample is not enclosed by them
+=============
+*/
+static bool AdaptiveSampleCorners( const lightinfo_t *l, int i, int corners[4], vec_t *frac_s, vec_t *frac_t )
+{
+	int	density = l->lmcache_density;
+	int	s = (i % l->lmcachewidth) - l->lmcache_offset;
+	int	t = (i / l->lmcachewidth) - l->lmcache_offset;
+	int	s0, t0, s1, t1;
+
+	// luxel centers are at multiples of density
+	s0 = (int)floor( (vec_t)s / density ) * density;
+	t0 = (int)floor( (vec_t)t / density ) * density;
+	s1 = ( s0 == s ) ? s0 : s0 + density;
+	t1 = ( t0 == t ) ? t0 : t0 + density;
+
+	if( s0 + l->lmcache_offset < 0 || s1 + l->lmcache_offset >= l->lmcachewidth )
+		return false;
+
+	if( t0 + l->lmcache_offset < 0 || t1 + l->lmcache_offset >= l->lmcacheheight )
+		return false;
+
+	*frac_s = (vec_t)( s - s0 ) / density;
+	*frac_t = (vec_t)( t - t0 ) / density;
+
+	s0 += l->lmcache_offset;
+	s1 += l->lmcache_offset;
+	t0 += l->lmcache_offset;
+	t1 += l->lmcache_offset;
+
+	corners[0] = s0 + l->lmcachewidth * t0;
+	corners[1] = s1 + l->lmcachewidth * t0;
+	corners[2] = s0 + l->lmcachewidth * t1;
+	corners[3] = s1 + l->lmcachewidth * t1;
+
+	return true;
+}
+
+/*
+=============
+InterpolateAdaptiveSample
+
+blend the corner samples if they are close enough,
+otherwise the subsample should be gathered
+=============
+*/
+static bool InterpolateAdaptiveSample( lightinfo_t *l, int i, const int corners[4], vec_t frac_s, vec_t frac_t, const bool *blocked )
+{
+	dface_t	*f = l->face;
+	vec_t	weight[4];
+	int	j, k, c;
+
+	for( c = 0; c < 4; c++ )
+	{
+		if( blocked[corners[c]] )
+			return false;
+	}
+
+	// shadow boundaries and lightstyle edges
+	for( j = 0; j < MAXLIGHTMAPS && f->styles[j] != 255; j++ )
+	{
+		vec_t	minv = l->light[corners[0]][j][0];
+		vec_t	maxv = minv;
+
+		for( c = 0; c < 4; c++ )
+		{
+			for( k = 0; k < 3; k++ )
+			{
+				minv = Q_min( minv, l->light[corners[c]][j][k] );
+				maxv = Q_max( maxv, l->light[corners[c]][j][k] );
+			}
+#ifdef HLRAD_SHADOWMAPPING
+			if( fabs( l->shadow[corners[c]][j] - l->shadow[corners[0]][j] ) > ADAPTIVE_SHADOW_CONTRAST )
+				return false;
+#endif
+		}
+
+		if(( maxv - minv ) > Q_max( ADAPTIVE_MIN_CONTRAST, maxv * ADAPTIVE_CONTRAST ))
+			return false;
+	}
+
+	weight[0] = (1.0 - frac_s) * (1.0 - frac_t);
+	weight[1] = frac_s * (1.0 - frac_t);
+	weight[2] = (1.0 - frac_s) * frac_t;
+	weight[3] = frac_s * frac_t;
+
+	for( j = 0; j < MAXLIGHTMAPS && f->styles[j] != 255; j++ )
+	{
+		for( c = 0; c < 4; c++ )
+		{
+			VectorMA( l->light[i][j], weight[c], l->light[corners[c]][j], l->light[i][j] );
+#ifdef HLRAD_DELUXEMAPPING
+			VectorMA( l->deluxe[i][j], weight[c], l->deluxe[corners[c]][j], l->deluxe[i][j] );
+#ifdef HLRAD_SHADOWMAPPING
+			l->shadow[i][j] += l->shadow[corners[c]][j] * weight[c];
+#endif
+#endif
+		}
+	}
+
+	return true;
+}
+
 static void CalcLightmap( int thread, lightinfo_t *l, facelight_t *fl )
 {
 	vec_t	texture_step = GetTextureStep( &g_dfaces[l->surfnum] );
@@ -2705,6 +2827,11 @@ static void CalcLightmap( int thread, lightinfo_t *l, facelight_t *fl )
 	int	h = l->texsize[1] + 1;
 	byte	*vislight = NULL;
 	dface_t	*f = l->face;
+	int	numcache = l->lmcachewidth * l->lmcacheheight;
+	bool	adaptive = ( g_adaptive && l->lmcache_density > 1 );
+	vec3_t	*spots = NULL, *normals = NULL;
+	bool	*blocks = NULL;
+	int	*leafs = NULL;
 	vec_t	square[2][2];
 	int	i, j;
 
@@ -2726,8 +2853,17 @@ static void CalcLightmap( int thread, lightinfo_t *l, facelight_t *fl )
 		fl->samples[i].surface = l->surfpt[i].surface;
 	}
 
+	if( adaptive )
+	{
+		// gather light at the luxel centers first
+		spots = (vec3_t *)Mem_Alloc( numcache * sizeof( vec3_t ));
+		normals = (vec3_t *)Mem_Alloc( numcache * sizeof( vec3_t ));
+		blocks = (bool *)Mem_Alloc( numcache * sizeof( bool ));
+		leafs = (int *)Mem_Alloc( numcache * sizeof( int ));
+	}
+
 	// for each sample whose light we need to calculate
-	for( i = 0; i < l->lmcachewidth * l->lmcacheheight; i++ )
+	for( i = 0; i < numcache; i++ )
 	{
 		vec_t	s, t, s_vec, t_vec;
 		int	nearest_s, nearest_t;
@@ -2773,19 +2909,57 @@ static void CalcLightmap( int thread, lightinfo_t *l, facelight_t *fl )
 #ifdef HLRAD_DELUXEMAPPING
 		VectorCopy( pointnormal, l->normals[i] );
 #endif
+		if( adaptive ) blocks[i] = blocked;
 		if( blocked ) continue;
 
 		// calculate visibility for the sample
 		int leaf = PointInLeaf( spot ) - g_dleafs;
 
+		if( adaptive )
+		{
+			int	ofs_s = (i % l->lmcachewidth) - l->lmcache_offset;
+			int	ofs_t = (i / l->lmcachewidth) - l->lmcache_offset;
+
+			// subsamples will be processed later
+			if(( ofs_s % l->lmcache_density ) || ( ofs_t % l->lmcache_density ))
+			{
+				VectorCopy( spot, spots[i] );
+				VectorCopy( pointnormal, normals[i] );
+				leafs[i] = leaf;
+				continue;
+			}
+		}
+
 		// gather light
-#if defined( HLRAD_DELUXEMAPPING ) && defined( HLRAD_SHADOWMAPPING )
-		GatherSampleLight( thread, l->surfnum, spot, leaf, pointnormal, l->light[i], l->deluxe[i], l->shadow[i], f->styles, vislight, 0 );
-#elif defined( HLRAD_DELUXEMAPPING )
-		GatherSampleLight( thread, l->surfnum, spot, leaf, pointnormal, l->light[i], l->deluxe[i], NULL, f->styles, vislight, 0 );
-#else
-		GatherSampleLight( thread, l->surfnum, spot, leaf, pointnormal, l->light[i], NULL, NULL, f->styles, vislight, 0 );
-#endif
+		GatherLightmapSample( thread, l, i, spot, leaf, pointnormal, vislight );
+	}
+
+	if( adaptive )
+	{
+		// supersample only where neighbour luxels are differ
+		for( i = 0; i < numcache; i++ )
+		{
+			int	ofs_s = (i % l->lmcachewidth) - l->lmcache_offset;
+			int	ofs_t = (i / l->lmcachewidth) - l->lmcache_offset;
+			vec_t	frac_s, frac_t;
+			int	corners[4];
+
+			if( blocks[i] || !(( ofs_s % l->lmcache_density ) || ( ofs_t % l->lmcache_density )))
+				continue;
+
+			if( AdaptiveSampleCorners( l, i, corners, &frac_s, &frac_t ))
+			{
+				if( InterpolateAdaptiveSample( l, i, corners, frac_s, frac_t, blocks ))
+					continue;
+			}
+
+			GatherLightmapSample( thread, l, i, spots[i], leafs[i], normals[i], vislight );
+		}
+
+		Mem_Free( spots );
+		Mem_Free( normals );
+		Mem_Free( blocks );
+		Mem_Free( leafs );
 	}
 
 	for( i = 0; i < fl->numsamples; i++ )
@@ -2873,8 +3047,8 @@ static void CalcLightmap( int thread, lightinfo_t *l, facelight_t *fl )
 	{
 		for( j = 0; j < MAXLIGHTMAPS && f->styles[j] != 255; j++ )
 		{
-			int	s = (i % w) + l->lmcache_side;
-			int	t = (i / w) + l->lmcache_side;
+			int	s = (i % w) * l->lmcache_density + l->lmcache_offset;
+			int	t = (i / w) * l->lmcache_density + l->lmcache_offset;
 			int	pos = s + l->lmcachewidth * t;
 			fl->samples[i].shadow[j] = l->shadow[pos][j];
 		}
@@ -3075,7 +3249,7 @@ void PrecompLightmapOffsets( void )
 		g_lightdatasize += fl->numsamples * 3 * lightstyles;
 	}
 
-	g_dlightdata = (byte *)Mem_Realloc( g_dlightdata, g_lightdatasize );
+	g_dlightdata = (byte *)ReallocLumpData( g_dlightdata, g_lightdatasize );
 }
 #else
 void PrecompLightmapOffsets( void )
@@ -3283,19 +3457,19 @@ void PrecompLightmapOffsets( void )
 	if( g_found_extradata )
 	{
 #ifdef HLRAD_DELUXEMAPPING
-		g_ddeluxdata = (byte *)Mem_Realloc( g_ddeluxdata, g_lightdatasize );
+		g_ddeluxdata = (byte *)ReallocLumpData( g_ddeluxdata, g_lightdatasize );
 		g_deluxdatasize = g_lightdatasize;
 #ifdef HLRAD_SHADOWMAPPING
-		g_dshadowdata = (byte *)Mem_Realloc( g_dshadowdata, g_lightdatasize / 3 );
+		g_dshadowdata = (byte *)ReallocLumpData( g_dshadowdata, g_lightdatasize / 3 );
 		g_shadowdatasize = g_lightdatasize / 3;
 #endif
 #endif
 	}
-	g_dlightdata = (byte *)Mem_Realloc( g_dlightdata, g_lightdatasize );
+	g_dlightdata = (byte *)ReallocLumpData( g_dlightdata, g_lightdatasize );
 
 	// calc normal datasize
 	g_normaldatasize = sizeof( dnormallump_t ) + ( g_numvertnormals * sizeof( dvertnorm_t )) + (g_numnormals * sizeof( dnormal_t ));
-	g_dnormaldata = (byte *)Mem_Realloc( g_dnormaldata, g_normaldatasize );
+	g_dnormaldata = (byte *)ReallocLumpData( g_dnormaldata, g_normaldatasize );
 
 	// write indexed normals into memory
 	byte *buffer = g_dnormaldata;
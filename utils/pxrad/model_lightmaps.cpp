@@ -35,6 +35,42 @@ static uint	g_modellight_numindexes;
 static float	g_nudge[2][9] = {{ 0, -1, 0, 1, -1, 1, -1, 0, 1 }, { 0, -1, -1, -1, 0, 0, 1, 1, 1 }};
 static float	g_studio_blur;
 
+// model lightmaps cache
+#define MODELCACHE_IDENT		(('1'<<24)+('C'<<16)+('L'<<8)+'M') // little-endian "MLC1"
+#define MODELCACHE_VERSION		2
+#define MODELCACHE_COMPUTE		-1	// instance must be lighted
+#define MODELCACHE_LOADED		-2	// instance restored from the cache file
+#define MODELCACHE_MAX_LEAFS		256
+
+typedef struct
+{
+	int	ident;
+	int	version;
+	int	samplesize;	// sizeof( sample_t ), reject files from other builds
+	int	vislightsize;
+	dword	sceneCRC;		// world geometry and compile settings
+	int	nummodels;
+} dmodelcache_t;
+
+typedef struct
+{
+	dword	modelCRC;
+	dword	lightsCRC;	// lights and shadow casters that can reach the instance
+	int	flags;
+	int	texture_step;
+	int	numfaces;
+	float	origin[3];
+	float	angles[3];
+	float	scale[3];
+} dmodelcachekey_t;
+
+// each dmodelcachekey_t followed by vislight bits and numfaces records:
+// byte styles[MAXLIGHTMAPS], int numsamples (-1 for unlit face), sample_t samples[numsamples]
+
+static dmodelcachekey_t	*g_modellight_keys;
+static int		*g_modellight_reuse;	// owner model index or MODELCACHE_*
+static dword		g_modellight_sceneCRC;
+
 static void CalcLightmapAxis( tmesh_t *mesh, lface_t *face, trivert_t *a, trivert_t *b, trivert_t *c )
 {
 	int	ssize = face->texture_step;
@@ -678,6 +714,10 @@ void BuildModelLightmaps( int indexnum, int thread = -1 )
 	facelight_t *fl = &f->facelight;
 	f->lightofs = -1;
 
+	// lightmaps will be shared with another instance
+	if( g_modellight_reuse != NULL && g_modellight_reuse[modelnum] != MODELCACHE_COMPUTE )
+		return;
+
 	if( VectorIsNull( f->normal ))
 		return;
 
@@ -1369,7 +1409,7 @@ void WriteModelLighting( void )
 	}
 
 	Msg( "total modellight data: %s\n", Q_memprint( totaldatasize ));
-	g_dflightdata = (byte *)Mem_Realloc( g_dflightdata, totaldatasize );
+	g_dflightdata = (byte *)ReallocLumpData( g_dflightdata, totaldatasize );
 
 	// now setup to get the miptex data (or just the headers if using -wadtextures) from the wadfile
 	l = (dvlightlump_t *)g_dflightdata;
@@ -1402,6 +1442,510 @@ void WriteModelLighting( void )
 	// otherwise it's valid
 }
 
+/*
+============
+ModelLeafs
+
+collect world leafs touched by the bounds
+returns -1 when list is overflowed
+============
+*/
+static int ModelLeafs( const vec3_t absmin, const vec3_t absmax, int *leafs, int maxleafs )
+{
+	vec3_t	mins, maxs;
+	vec3_t	lmins, lmaxs;
+	int	numleafs = 0;
+
+	VectorCopy( absmin, mins );
+	VectorCopy( absmax, maxs );
+	ExpandBounds( mins, maxs, DEFAULT_HUNT_OFFSET + 1.0f );
+
+	for( int i = 1; i <= g_numvisleafs; i++ )
+	{
+		dleaf_t	*leaf = &g_dleafs[i];
+
+		if( leaf->contents == CONTENTS_SOLID )
+			continue;
+
+		VectorCopy( leaf->mins, lmins );
+		VectorCopy( leaf->maxs, lmaxs );
+
+		if( !BoundsIntersect( mins, maxs, lmins, lmaxs ))
+			continue;
+
+		if( numleafs == maxleafs )
+			return -1;
+		leafs[numleafs++] = i;
+	}
+
+	return numleafs;
+}
+
+/*
+============
+CalcModelSceneCRC
+
+anything that invalidates all the cached model lightmaps
+============
+*/
+static dword CalcModelSceneCRC( void )
+{
+	dword	crc;
+	int	i;
+
+	CRC32_Init( &crc );
+
+	// world geometry
+	CRC32_ProcessBuffer( &crc, g_dplanes, g_numplanes * sizeof( dplane_t ));
+	CRC32_ProcessBuffer( &crc, g_dnodes, g_numnodes * sizeof( dnode_t ));
+	CRC32_ProcessBuffer( &crc, g_dvertexes, g_numvertexes * sizeof( dvertex_t ));
+	CRC32_ProcessBuffer( &crc, g_dmodels, g_nummodels * sizeof( dmodel_t ));
+	CRC32_ProcessBuffer( &crc, g_face_offset, g_numfaces * sizeof( vec3_t ));
+
+	// surface flags, lightmap scales and textures (alpha-tested and translucent shadows)
+	CRC32_ProcessBuffer( &crc, g_texinfo, g_numtexinfo * sizeof( dtexinfo_t ));
+	CRC32_ProcessBuffer( &crc, g_dtexdata, g_texdatasize );
+
+	// brush entities that cast shadows
+	for( i = 1; i < g_numentities; i++ )
+	{
+		entity_t	*mapent = &g_entities[i];
+
+		if( mapent->modtype != mod_brush )
+			continue;
+
+		const char *keys[] = { "model", "origin", "zhlt_lightflags", "_shadow" };
+
+		for( int j = 0; j < ARRAYSIZE( keys ); j++ )
+		{
+			const char *value = ValueForKey( mapent, keys[j] );
+			CRC32_ProcessBuffer( &crc, value, Q_strlen( value ));
+		}
+	}
+
+	// compile settings that affects direct lighting
+	CRC32_ProcessBuffer( &crc, g_ambient, sizeof( g_ambient ));
+	CRC32_ProcessBuffer( &crc, &g_studio_blur, sizeof( g_studio_blur ));
+	CRC32_ProcessBuffer( &crc, &g_extra, sizeof( g_extra ));
+	CRC32_ProcessBuffer( &crc, &g_fastmode, sizeof( g_fastmode ));
+	CRC32_ProcessBuffer( &crc, &g_dirtmapping, sizeof( g_dirtmapping ));
+	CRC32_ProcessBuffer( &crc, &g_nomodelshadow, sizeof( g_nomodelshadow ));
+	CRC32_ProcessBuffer( &crc, &g_indirect_sun, sizeof( g_indirect_sun ));
+	CRC32_ProcessBuffer( &crc, &g_smoothing_threshold, sizeof( g_smoothing_threshold ));
+	CRC32_ProcessBuffer( &crc, &g_numworldlights, sizeof( g_numworldlights ));
+
+	CRC32_Final( &crc );
+
+	return crc;
+}
+
+/*
+============
+CalcModelLightKeys
+
+build the cache keys and find duplicated instances
+============
+*/
+static void CalcModelLightKeys( void )
+{
+	int	*casterleafs = (int *)Mem_Alloc( g_numentities * MODELCACHE_MAX_LEAFS * sizeof( int ));
+	int	*numcasterleafs = (int *)Mem_Alloc( g_numentities * sizeof( int ));
+	dword	*castercrc = (dword *)Mem_Alloc( g_numentities * sizeof( dword ));
+	byte	*pvs = (byte *)Mem_Alloc(( g_numvisleafs + 7 ) / 8 );
+	byte	*instancepvs = (byte *)Mem_Alloc(( g_numvisleafs + 7 ) / 8 );
+	int	leafs[MODELCACHE_MAX_LEAFS];
+	int	i, j, k, numleafs;
+	int	numshared = 0;
+	tmesh_t	*mesh;
+
+	g_modellight_keys = (dmodelcachekey_t *)Mem_Alloc( g_modellight_modnum * sizeof( dmodelcachekey_t ));
+	g_modellight_reuse = (int *)Mem_Alloc( g_modellight_modnum * sizeof( int ));
+	g_modellight_sceneCRC = CalcModelSceneCRC();
+
+	// collect the shadow casters
+	for( i = 1; i < g_numentities && !g_nomodelshadow; i++ )
+	{
+		entity_t	*mapent = &g_entities[i];
+
+		if( mapent->modtype != mod_alias && mapent->modtype != mod_studio )
+			continue;
+
+		if( !mapent->cache ) continue;
+
+		mesh = (tmesh_t *)mapent->cache;
+
+		if( !FBitSet( mesh->flags, FMESH_CAST_SHADOW ))
+			continue;
+
+		numcasterleafs[i] = ModelLeafs( mesh->absmin, mesh->absmax, &casterleafs[i * MODELCACHE_MAX_LEAFS], MODELCACHE_MAX_LEAFS );
+
+		CRC32_Init( &castercrc[i] );
+		CRC32_ProcessBuffer( &castercrc[i], &mesh->modelCRC, sizeof( mesh->modelCRC ));
+		CRC32_ProcessBuffer( &castercrc[i], mesh->origin, sizeof( mesh->origin ));
+		CRC32_ProcessBuffer( &castercrc[i], mesh->angles, sizeof( mesh->angles ));
+		CRC32_ProcessBuffer( &castercrc[i], mesh->scale, sizeof( mesh->scale ));
+		CRC32_Final( &castercrc[i] );
+	}
+
+	for( i = 0; i < g_modellight_modnum; i++ )
+	{
+		entity_t		*mapent = g_modellight[i];
+		dmodelcachekey_t	*key = &g_modellight_keys[i];
+		dword		crc;
+
+		mesh = (tmesh_t *)mapent->cache;
+		key->modelCRC = mesh->modelCRC;
+		key->flags = mesh->flags;
+		key->texture_step = mesh->texture_step;
+		key->numfaces = mesh->numfaces;
+		VectorCopy( mesh->origin, key->origin );
+		VectorCopy( mesh->angles, key->angles );
+		VectorCopy( mesh->scale, key->scale );
+
+		numleafs = ModelLeafs( mesh->absmin, mesh->absmax, leafs, MODELCACHE_MAX_LEAFS );
+
+		// what the instance can see
+		if( numleafs < 0 || !g_visdatasize )
+		{
+			memset( instancepvs, 255, ( g_numvisleafs + 7 ) / 8 );
+		}
+		else
+		{
+			memset( instancepvs, 0, ( g_numvisleafs + 7 ) / 8 );
+
+			for( j = 0; j < numleafs; j++ )
+			{
+				if( g_dleafs[leafs[j]].visofs == -1 )
+					continue;
+
+				DecompressVis( &g_dvisdata[g_dleafs[leafs[j]].visofs], pvs );
+				SETVISBIT( instancepvs, leafs[j] - 1 );
+
+				for( k = 0; k < ( g_numvisleafs + 7 ) / 8; k++ )
+					instancepvs[k] |= pvs[k];
+			}
+		}
+
+		CRC32_Init( &crc );
+
+		// lights that may reach the instance, same test as GatherSampleLight
+		for( directlight_t *dl = g_directlights; dl != NULL; dl = dl->next )
+		{
+			if( !dl->pvs ) continue;
+
+			for( j = 0; j < numleafs; j++ )
+			{
+				if( CHECKVISBIT( dl->pvs, leafs[j] - 1 ))
+					break;
+			}
+
+			if( numleafs >= 0 && j == numleafs )
+				continue;
+
+			CRC32_ProcessBuffer( &crc, &dl->type, sizeof( dl->type ));
+			CRC32_ProcessBuffer( &crc, &dl->style, sizeof( dl->style ));
+			CRC32_ProcessBuffer( &crc, &dl->fade, sizeof( dl->fade ));
+			CRC32_ProcessBuffer( &crc, &dl->falloff, sizeof( dl->falloff ));
+			CRC32_ProcessBuffer( &crc, &dl->lightnum, sizeof( dl->lightnum ));
+			CRC32_ProcessBuffer( &crc, dl->origin, sizeof( dl->origin ));
+			CRC32_ProcessBuffer( &crc, dl->intensity, sizeof( dl->intensity ));
+			CRC32_ProcessBuffer( &crc, dl->diffuse_intensity, sizeof( dl->diffuse_intensity ));
+			CRC32_ProcessBuffer( &crc, dl->normal, sizeof( dl->normal ));
+			CRC32_ProcessBuffer( &crc, &dl->stopdot, sizeof( dl->stopdot ));
+			CRC32_ProcessBuffer( &crc, &dl->stopdot2, sizeof( dl->stopdot2 ));
+			CRC32_ProcessBuffer( &crc, &dl->lf_scale, sizeof( dl->lf_scale ));
+			CRC32_ProcessBuffer( &crc, &dl->topatch, sizeof( dl->topatch ));
+			CRC32_ProcessBuffer( &crc, &dl->facenum, sizeof( dl->facenum ));
+			CRC32_ProcessBuffer( &crc, &dl->radius, sizeof( dl->radius ));
+			CRC32_ProcessBuffer( &crc, &dl->sunspreadangle, sizeof( dl->sunspreadangle ));
+
+			if( dl->numsunnormals > 0 )
+			{
+				CRC32_ProcessBuffer( &crc, dl->sunnormals, dl->numsunnormals * sizeof( vec3_t ));
+				CRC32_ProcessBuffer( &crc, dl->sunnormalweights, dl->numsunnormals * sizeof( vec_t ));
+			}
+		}
+
+		// shadow casters in sight of the instance (non-casters have no leafs)
+		for( j = 1; j < g_numentities; j++ )
+		{
+			for( k = 0; k < numcasterleafs[j]; k++ )
+			{
+				if( CHECKVISBIT( instancepvs, casterleafs[j * MODELCACHE_MAX_LEAFS + k] - 1 ))
+					break;
+			}
+
+			if( numcasterleafs[j] >= 0 && k == numcasterleafs[j] )
+				continue;
+
+			CRC32_ProcessBuffer( &crc, &castercrc[j], sizeof( dword ));
+		}
+
+		CRC32_Final( &crc );
+		key->lightsCRC = crc;
+
+		// duplicated entity: same model at the same spot in the same lighting
+		g_modellight_reuse[i] = MODELCACHE_COMPUTE;
+
+		for( j = 0; j < i; j++ )
+		{
+			if( g_modellight_reuse[j] != MODELCACHE_COMPUTE )
+				continue;
+
+			if( !memcmp( &g_modellight_keys[j], key, sizeof( *key )))
+			{
+				g_modellight_reuse[i] = j;
+				numshared++;
+				break;
+			}
+		}
+	}
+
+	Mem_Free( casterleafs );
+	Mem_Free( numcasterleafs );
+	Mem_Free( castercrc );
+	Mem_Free( instancepvs );
+	Mem_Free( pvs );
+
+	if( numshared > 0 )
+		MsgDev( D_INFO, "%i duplicated model instances share lightmaps\n", numshared );
+}
+
+/*
+============
+LoadModelLightCache
+
+restore lightmaps of unchanged instances from the previous compile
+============
+*/
+static void LoadModelLightCache( void )
+{
+	int		vislightsize = (g_numworldlights + 7) / 8;
+	int		i, j, numloaded = 0;
+	dmodelcache_t	*hdr;
+	byte		*data, *in, *end;
+	size_t		filesize;
+
+	data = COM_LoadFile( va( "%s.mlc", source ), &filesize, false );
+	if( !data ) return;
+
+	hdr = (dmodelcache_t *)data;
+
+	if( filesize < sizeof( dmodelcache_t ) || hdr->ident != MODELCACHE_IDENT || hdr->version != MODELCACHE_VERSION )
+	{
+		MsgDev( D_WARN, "%s.mlc has wrong format, ignored\n", source );
+		Mem_Free( data );
+		return;
+	}
+
+	// settings or world geometry was changed
+	if( hdr->samplesize != sizeof( sample_t ) || hdr->vislightsize != vislightsize || hdr->sceneCRC != g_modellight_sceneCRC )
+	{
+		Mem_Free( data );
+		return;
+	}
+
+	in = data + sizeof( dmodelcache_t );
+	end = data + filesize;
+
+	for( int m = 0; m < hdr->nummodels; m++ )
+	{
+		dmodelcachekey_t	*key = (dmodelcachekey_t *)in;
+		byte		*faces;
+
+		if( in + sizeof( dmodelcachekey_t ) + vislightsize > end )
+			break;
+
+		// validate face records before restoring
+		faces = in = in + sizeof( dmodelcachekey_t ) + vislightsize;
+
+		for( j = 0; j < key->numfaces; j++ )
+		{
+			int	numsamples;
+
+			if( in + MAXLIGHTMAPS + sizeof( int ) > end )
+				break;
+			memcpy( &numsamples, in + MAXLIGHTMAPS, sizeof( int ));
+			in += MAXLIGHTMAPS + sizeof( int );
+
+			if( numsamples < 0 ) continue;
+			if( in + numsamples * sizeof( sample_t ) > end )
+				break;
+			in += numsamples * sizeof( sample_t );
+		}
+
+		if( j != key->numfaces )
+			break;	// file is truncated
+
+		for( i = 0; i < g_modellight_modnum; i++ )
+		{
+			if( g_modellight_reuse[i] == MODELCACHE_COMPUTE && !memcmp( &g_modellight_keys[i], key, sizeof( *key )))
+				break;
+		}
+
+		if( i == g_modellight_modnum )
+			continue;	// instance was changed or removed
+
+		tmesh_t *mesh = (tmesh_t *)g_modellight[i]->cache;
+
+		if( mesh->vislight != NULL )
+			memcpy( mesh->vislight, (byte *)key + sizeof( dmodelcachekey_t ), vislightsize );
+
+		for( j = 0, in = faces; j < key->numfaces; j++ )
+		{
+			lface_t	*f = mesh->faces[j].light;
+			int	numsamples;
+
+			memcpy( &numsamples, in + MAXLIGHTMAPS, sizeof( int ));
+
+			if( f != NULL && numsamples >= 0 )
+			{
+				facelight_t *fl = &f->facelight;
+
+				memcpy( f->styles, in, MAXLIGHTMAPS );
+				f->lightofs = -1;
+				fl->numsamples = numsamples;
+				fl->samples = (sample_t *)Mem_Alloc( numsamples * sizeof( sample_t ));
+				memcpy( fl->samples, in + MAXLIGHTMAPS + sizeof( int ), numsamples * sizeof( sample_t ));
+			}
+
+			in += MAXLIGHTMAPS + sizeof( int ) + Q_max( numsamples, 0 ) * sizeof( sample_t );
+		}
+
+		g_modellight_reuse[i] = MODELCACHE_LOADED;
+		numloaded++;
+	}
+
+	Mem_Free( data );
+
+	if( numloaded > 0 )
+		Msg( "%i model instances restored from cache\n", numloaded );
+}
+
+/*
+============
+ShareModelLightmaps
+
+copy lightmaps to identical instances
+============
+*/
+static void ShareModelLightmaps( void )
+{
+	int	vislightsize = (g_numworldlights + 7) / 8;
+
+	for( int i = 0; i < g_modellight_modnum; i++ )
+	{
+		if( g_modellight_reuse[i] < 0 )
+			continue;
+
+		tmesh_t	*dst = (tmesh_t *)g_modellight[i]->cache;
+		tmesh_t	*src = (tmesh_t *)g_modellight[g_modellight_reuse[i]]->cache;
+
+		if( dst->vislight != NULL && src->vislight != NULL )
+			memcpy( dst->vislight, src->vislight, vislightsize );
+
+		for( int j = 0; j < dst->numfaces; j++ )
+		{
+			lface_t	*fdst = dst->faces[j].light;
+			lface_t	*fsrc = src->faces[j].light;
+
+			if( !fdst || !fsrc || !fsrc->facelight.samples )
+				continue;
+
+			memcpy( fdst->styles, fsrc->styles, sizeof( fdst->styles ));
+			fdst->lightofs = -1;
+			fdst->facelight.numsamples = fsrc->facelight.numsamples;
+			fdst->facelight.samples = (sample_t *)Mem_Alloc( fsrc->facelight.numsamples * sizeof( sample_t ));
+			memcpy( fdst->facelight.samples, fsrc->facelight.samples, fsrc->facelight.numsamples * sizeof( sample_t ));
+		}
+	}
+}
+
+/*
+============
+SaveModelLightCache
+============
+*/
+static void SaveModelLightCache( void )
+{
+	int		vislightsize = (g_numworldlights + 7) / 8;
+	size_t		filesize = sizeof( dmodelcache_t );
+	dmodelcache_t	*hdr;
+	byte		*data, *out;
+	int		i, j;
+
+	for( i = 0; i < g_modellight_modnum; i++ )
+	{
+		tmesh_t	*mesh = (tmesh_t *)g_modellight[i]->cache;
+
+		if( g_modellight_reuse[i] >= 0 )
+			continue; // not unique
+
+		filesize += sizeof( dmodelcachekey_t ) + vislightsize;
+
+		for( j = 0; j < mesh->numfaces; j++ )
+		{
+			lface_t	*f = mesh->faces[j].light;
+
+			filesize += MAXLIGHTMAPS + sizeof( int );
+			if( f != NULL && f->facelight.samples != NULL )
+				filesize += f->facelight.numsamples * sizeof( sample_t );
+		}
+	}
+
+	data = (byte *)Mem_Alloc( filesize );
+	hdr = (dmodelcache_t *)data;
+	hdr->ident = MODELCACHE_IDENT;
+	hdr->version = MODELCACHE_VERSION;
+	hdr->samplesize = sizeof( sample_t );
+	hdr->vislightsize = vislightsize;
+	hdr->sceneCRC = g_modellight_sceneCRC;
+	out = data + sizeof( dmodelcache_t );
+
+	for( i = 0; i < g_modellight_modnum; i++ )
+	{
+		tmesh_t	*mesh = (tmesh_t *)g_modellight[i]->cache;
+
+		if( g_modellight_reuse[i] >= 0 )
+			continue; // not unique
+
+		memcpy( out, &g_modellight_keys[i], sizeof( dmodelcachekey_t ));
+		out += sizeof( dmodelcachekey_t );
+		if( mesh->vislight != NULL )
+			memcpy( out, mesh->vislight, vislightsize );
+		out += vislightsize;
+
+		for( j = 0; j < mesh->numfaces; j++ )
+		{
+			lface_t	*f = mesh->faces[j].light;
+			int	numsamples = -1;
+
+			if( f != NULL && f->facelight.samples != NULL )
+			{
+				memcpy( out, f->styles, MAXLIGHTMAPS );
+				numsamples = f->facelight.numsamples;
+			}
+			else memset( out, 255, MAXLIGHTMAPS );
+
+			memcpy( out + MAXLIGHTMAPS, &numsamples, sizeof( int ));
+			out += MAXLIGHTMAPS + sizeof( int );
+
+			if( numsamples > 0 )
+			{
+				memcpy( out, f->facelight.samples, numsamples * sizeof( sample_t ));
+				out += numsamples * sizeof( sample_t );
+			}
+		}
+		hdr->nummodels++;
+	}
+
+	if(( out - data ) != filesize )
+		COM_FatalError( "SaveModelLightCache: memory corrupted\n" );
+
+	COM_SaveFile( va( "%s.mlc", source ), data, filesize );
+	Mem_Free( data );
+}
+
 void BuildModelLightmaps( void )
 {
 	GenerateLightCacheNumbers();
@@ -1411,7 +1955,24 @@ void BuildModelLightmaps( void )
 
 	if( !g_modellight_numindexes ) return;
 
+	if( g_modelcache )
+	{
+		CalcModelLightKeys();
+		LoadModelLightCache();
+	}
+
 	RunThreadsOnIndividual( g_modellight_numindexes, true, BuildModelLightmaps );
+
+	if( g_modelcache )
+	{
+		ShareModelLightmaps();
+		SaveModelLightCache();
+
+		Mem_Free( g_modellight_keys );
+		Mem_Free( g_modellight_reuse );
+		g_modellight_keys = NULL;
+		g_modellight_reuse = NULL;
+	}
 }
 
 void FinalModelLightFace( void )
@@ -208,6 +208,10 @@ SOURCE=.\textures.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\telemetry.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\threads.cpp
 # End Source File
 # Begin Source File
@@ -272,6 +276,10 @@ SOURCE=..\common\scriplib.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\telemetry.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\threads.h
 # End Source File
 # End Group
@@ -11,6 +11,7 @@
 // qrad.c
 
 #include "qrad.h"
+#include "telemetry.h"
 
 /*
 NOTES
@@ -61,9 +62,11 @@ float		g_indirect_sun = DEFAULT_INDIRECT_SUN;
 bool		g_dirtmapping = DEFAULT_DIRTMAPPING;
 bool		g_lerp_enabled = DEFAULT_LERP_ENABLED;
 bool		g_extra = DEFAULT_EXTRAMODE;
+bool		g_adaptive = DEFAULT_ADAPTIVE;
 bool		g_nomodelshadow = false;
 bool		g_lightbalance = false;
 bool		g_onlylights = false;
+bool		g_modelcache = false;
 float		g_smoothing_threshold;		// cosine of smoothing angle(in radians)
 char		source[MAX_PATH] = "";
 uint		g_gammamode = DEFAULT_GAMMAMODE;
@@ -2311,6 +2314,9 @@ void RadWorld( void )
 
 	FreeFacePositions ();
 
+	// release slabs of the temporary windings
+	Mem_ResetArenas ();
+
 	CalcLuxelsCount();
 
 	if( g_numbounce > 0 )
@@ -2432,6 +2438,7 @@ static void PrintRadSettings( void )
 	Msg( "developer             [ %7d ] [ %7d ]\n", GetDeveloperLevel(), DEFAULT_DEVELOPER );
 	Msg( "fast rad              [ %7s ] [ %7s ]\n", g_fastmode ? "on" : "off", DEFAULT_FASTMODE ? "on" : "off" );
 	Msg( "extra rad             [ %7s ] [ %7s ]\n", g_extra ? "on" : "off", DEFAULT_EXTRAMODE ? "on" : "off" );
+	Msg( "adaptive supersample  [ %7s ] [ %7s ]\n", g_adaptive ? "on" : "off", DEFAULT_ADAPTIVE ? "on" : "off" );
 	Msg( "bounces               [ %7d ] [ %7d ]\n", g_numbounce, DEFAULT_BOUNCE );
 	Q_snprintf( buf1, sizeof( buf1 ), "%3.3f", g_smoothvalue );
 	Q_snprintf( buf2, sizeof( buf2 ), "%3.3f", DEFAULT_SMOOTHVALUE );
@@ -2458,6 +2465,7 @@ static void PrintRadSettings( void )
 	Q_snprintf( buf2, sizeof( buf2 ), "%3.3f", DEFAULT_INDIRECT_SUN );
 	Msg( "global sky diffusion  [ %7s ] [ %7s ]\n", buf1, buf2 );
 	Msg( "dirtmapping           [ %7s ] [ %7s ]\n", g_dirtmapping ? "on" : "off", DEFAULT_DIRTMAPPING ? "on" : "off" );
+	Msg( "model lightmap cache  [ %7s ] [ %7s ]\n", g_modelcache ? "on" : "off", "off" );
 #ifdef HLRAD_PARANOIA_BUMP
 	Msg( "gamma mode            [ %7d ] [ %7d ]\n", g_gammamode, DEFAULT_GAMMAMODE );
 #endif
@@ -2476,7 +2484,9 @@ static void PrintRadUsage( void )
 	Msg( "\n-= p2rad Options =-\n\n" );
 	Msg( "    -dev #         : compile with developer message (1 - 4). default is %d\n", DEFAULT_DEVELOPER );
 	Msg( "    -threads #     : manually specify the number of threads to run\n" );
+	Msg( "    -report file   : write build statistics to the file\n" );
  	Msg( "    -extra         : improve lighting quality with lightmap filtering\n" );
+	Msg( "    -adaptive      : supersample the contrast luxels in extra mode (changes the output)\n" );
 	Msg( "    -bounce #      : set number of radiosity bounces\n" );
 	Msg( "    -ambient r g b : set ambient world light (0.0 to 1.0, r g b)\n" );
 	Msg( "    -smooth #      : set smoothing threshold for blending (in degrees)\n" );
@@ -2490,6 +2500,7 @@ static void PrintRadUsage( void )
 	Msg( "    -balance       : -dscale will be interpret as global scaling factor\n" );
 	Msg( "    -dirty         : enable dirtmapping (baked AO)\n" );
 	Msg( "    -onlylights    : update only worldlights lump\n" );
+	Msg( "    -modelcache    : reuse lightmaps of unchanged models from previous compile\n" );
 #ifdef HLRAD_PARANOIA_BUMP
 	Msg( "    -gammamode #   : gamma correction mode (0, 1, 2)\n" );
 #endif
@@ -2507,12 +2518,14 @@ light modelfile
 */
 int main( int argc, char **argv )
 {
+	char	report[1024];
 	double	start, end;
 	char	str[64];
 	int	i;
 
 	atexit( Sys_CloseLog );
 	source[0] = '\0';
+	report[0] = '\0';
 
 	g_smoothing_threshold = cos( DEG2RAD( g_smoothvalue )); // Originally zero.
 
@@ -2528,6 +2541,11 @@ int main( int argc, char **argv )
 			g_numthreads = atoi( argv[i+1] );
 			i++;
 		}
+		else if( !Q_strcmp( argv[i], "-report" ))
+		{
+			Q_strncpy( report, argv[i+1], sizeof( report ));
+			i++;
+		}
 		else if( !Q_strcmp( argv[i], "-fast" ))
 		{
 			g_nomodelshadow = true;
@@ -2541,6 +2559,10 @@ int main( int argc, char **argv )
 			g_extra = true;
 			g_blur = 1.5f;
 		}
+		else if( !Q_strcmp( argv[i], "-adaptive" ))
+		{
+			g_adaptive = true;
+		}
 		else if( !Q_strcmp( argv[i], "-bounce" ))
 		{
 			g_numbounce = atoi( argv[i+1] );
@@ -2612,6 +2634,10 @@ int main( int argc, char **argv )
 		{
 			g_onlylights = true;
 		}
+		else if( !Q_strcmp( argv[i], "-modelcache" ))
+		{
+			g_modelcache = true;
+		}
 		else if( !Q_strcmp( argv[i], "-quake" ))
 		{
 			// special preset for quake
@@ -2716,6 +2742,8 @@ int main( int argc, char **argv )
 	end = I_FloatTime ();
 	Q_timestring((int)( end - start ), str );
 	Msg( "%s elapsed\n", str );
+
+	Telemetry_WriteReport( report, "p2rad", end - start );
 	
 	return 0;
 }
\ No newline at end of file
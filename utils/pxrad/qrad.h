@@ -22,6 +22,8 @@
 
 #define DEFAULT_FASTMODE		false
 #define DEFAULT_EXTRAMODE		false
+#define DEFAULT_ADAPTIVE		false
+#define DEFAULT_EXTRA_DENSITY	3		// lightmap cache samples per luxel in adaptive extra mode
 #define DEFAULT_TEXSCALE		true
 #define DEFAULT_CHOP		128.0
 #define DEFAULT_TEXCHOP		32.0
@@ -63,6 +65,11 @@
 #define DEFAULT_GAMMAMODE		0
 #define FRAC_EPSILON		(1.0f / 32.0f)
 
+// adaptive supersampling: luxel neighbourhood is uniform if all corner samples are within the contrast
+#define ADAPTIVE_CONTRAST		0.05	// relative to the brightest corner
+#define ADAPTIVE_MIN_CONTRAST		1.0	// absolute, for dark areas
+#define ADAPTIVE_SHADOW_CONTRAST	0.05
+
 #define MAX_SINGLEMAP		((MAX_CUSTOM_SURFACE_EXTENT+1) * (MAX_CUSTOM_SURFACE_EXTENT+1) * 3)
 #define MAX_SINGLEMAP_MODEL		((MAX_MODEL_SURFACE_EXTENT+1) * (MAX_MODEL_SURFACE_EXTENT+1) * 3)
 #define MAX_SUBDIVIDE		16384
@@ -361,6 +368,7 @@ extern uint		g_num_patches;
 //==============================================
 
 extern bool		g_extra;
+extern bool		g_adaptive;
 extern vec3_t		g_ambient;
 extern bool		g_fastmode;
 extern float		g_maxlight;
@@ -382,6 +390,7 @@ extern int		g_numdlights;
 extern uint		g_gammamode;
 extern vec_t		g_gamma;
 extern vec_t		g_blur;
+extern bool		g_modelcache;
 
 //
 // ambientcube.c
@@ -448,6 +457,8 @@ extern void FreeTriangulations( void );
 //
 // lightmap.c
 //
+extern directlight_t	*g_directlights;
+
 void GatherSampleLight( int threadnum, int fn, const vec3_t pos, int leafnum, const vec3_t normal,
 vec3_t *s_light, vec3_t *s_dir, vec_t *s_occ, byte *styles, byte *vislight, bool topatch, entity_t *ignoreent = NULL );
 void TexelSpaceToWorld( const lightinfo_t *l, vec3_t world, const vec_t s, const vec_t t );
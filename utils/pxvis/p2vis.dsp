@@ -151,6 +151,10 @@ SOURCE=..\common\stringlib.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\telemetry.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\threads.cpp
 # End Source File
 # Begin Source File
@@ -183,6 +187,10 @@ SOURCE=..\common\scriplib.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\telemetry.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\common\threads.h
 # End Source File
 # End Group
@@ -12,6 +12,7 @@
 
 #include "qvis.h"
 #include "threads.h"
+#include "telemetry.h"
 
 int	g_numportals;
 int	g_portalleafs;
@@ -556,6 +557,7 @@ static void PrintVisUsage( void )
 	Msg( "\n-= p2vis Options =-\n\n" );
 	Msg( "    -dev #         : compile with developer message (1 - 4). default is %d\n", DEFAULT_DEVELOPER );
 	Msg( "    -threads #     : manually specify the number of threads to run\n" );
+	Msg( "    -report file   : write build statistics to the file\n" );
  	Msg( "    -fast          : only do first quick pass on vis calculations\n" );
 	Msg( "    -nosort        : don't sort portals (disable optimization)\n" );
 	Msg( "    -maxdistance   : limit visible distance (e.g. for fogged levels)\n" );
@@ -571,6 +573,7 @@ main
 */
 int main( int argc, char **argv )
 {
+	char	report[1024];
 	char	portalfile[1024];
 	char		source[1024];
 	int		i;
@@ -579,6 +582,7 @@ int main( int argc, char **argv )
 
 	atexit( Sys_CloseLog );
 	source[0] = '\0';
+	report[0] = '\0';
 
 	for( i = 1; i < argc; i++ )
 	{
@@ -592,6 +596,11 @@ int main( int argc, char **argv )
 			g_numthreads = atoi( argv[i+1] );
 			i++;
 		}
+		else if( !Q_strcmp( argv[i], "-report" ))
+		{
+			Q_strncpy( report, argv[i+1], sizeof( report ));
+			i++;
+		}
 		else if( !Q_strcmp( argv[i], "-fast" ))
 		{
 			g_fastvis = true;
@@ -655,6 +664,9 @@ int main( int argc, char **argv )
 
 	CalcVis ();
 
+	// release slabs of the temporary windings
+	Mem_ResetArenas();
+
 	MsgDev( D_REPORT, "c_chains: %i\n", c_chains );
 	g_visdatasize = vismap_p - g_dvisdata;	
 
@@ -678,5 +690,7 @@ int main( int argc, char **argv )
 	Q_timestring((int)( end - start ), str );
 	Msg( "%s elapsed\n", str );
 
+	Telemetry_WriteReport( report, "p2vis", end - start );
+
 	return 0;
 }
\ No newline at end of file
@@ -125,26 +125,11 @@ winding_t	*ChopWindingEpsilon( winding_t *in, pstack_t *stack, plane_t *split, v
 	vec3_t	mid;
 	winding_t	*neww;
 
-	counts[0] = counts[1] = counts[2] = 0;
-
 	if( in->numpoints > MAX_POINTS_ON_WINDING )
 		COM_FatalError( "ChopWinding: MAX_POINTS_ON_WINDING limit exceeded\n" );
 
 	// determine sides for each point
-	for( i = 0; i < in->numpoints; i++ )
-	{
-		dot = DotProduct( in->p[i], split->normal );
-		dot -= split->dist;
-		dists[i] = dot;
-
-		if( dot > epsilon )
-			sides[i] = SIDE_FRONT;
-		else if( dot < -epsilon )
-			sides[i] = SIDE_BACK;
-		else sides[i] = SIDE_ON;
-
-		counts[sides[i]]++;
-	}
+	ClassifyPointsEpsilon( in->p, in->numpoints, split->normal, split->dist, epsilon, dists, sides, counts );
 
 	if( counts[SIDE_ON] == in->numpoints )
 		return in;
@@ -158,9 +143,6 @@ winding_t	*ChopWindingEpsilon( winding_t *in, pstack_t *stack, plane_t *split, v
 		return NULL;
 	}
 
-	sides[i] = sides[0];
-	dists[i] = dists[0];
-	
 	neww = AllocStackWinding( stack );
 	neww->numpoints = 0;
 
@@ -118,6 +118,14 @@ bool ClusterFit::ConstructOrdering( Vec3 const& axis, int iteration )
 
 void ClusterFit::Compress3( void* block )
 {
+#if SQUISH_USE_AVX2
+    if( CpuHasAVX2() )
+    {
+        Compress3Wide( block );
+        return;
+    }
+#endif
+
     // declare variables
     int const count = m_colours->GetCount();
     Vec4 const two = VEC4_CONST( 2.0 );
@@ -135,7 +143,6 @@ void ClusterFit::Compress3( void* block )
     Vec4 beststart = VEC4_CONST( 0.0f );
     Vec4 bestend = VEC4_CONST( 0.0f );
     Vec4 besterror = m_besterror;
-    u8 bestindices[16];
     int bestiteration = 0;
     int besti = 0, bestj = 0;
 
@@ -222,32 +229,19 @@ void ClusterFit::Compress3( void* block )
     }
 
     // save the block if necessary
-    if( CompareAnyLessThan( besterror, m_besterror ) )
-    {
-        // remap the indices
-        u8 const* order = ( u8* )m_order + 16*bestiteration;
-        int m;
-
-        u8 unordered[16];
-        for( m = 0; m < besti; ++m )
-            unordered[order[m]] = 0;
-        for( m = besti; m < bestj; ++m )
-            unordered[order[m]] = 2;
-        for( m = bestj; m < count; ++m )
-            unordered[order[m]] = 1;
-
-        m_colours->RemapIndices( unordered, bestindices );
-
-        // save the block
-        WriteColourBlock3( beststart.GetVec3(), bestend.GetVec3(), bestindices, block );
-
-        // save the error
-        m_besterror = besterror;
-    }
+    SaveBlock3( beststart, bestend, besterror, bestiteration, besti, bestj, block );
 }
 
 void ClusterFit::Compress4( void* block )
 {
+#if SQUISH_USE_AVX2
+    if( CpuHasAVX2() )
+    {
+        Compress4Wide( block );
+        return;
+    }
+#endif
+
     // declare variables
     int const count = m_colours->GetCount();
     Vec4 const two = VEC4_CONST( 2.0f );
@@ -267,7 +261,6 @@ void ClusterFit::Compress4( void* block )
     Vec4 beststart = VEC4_CONST( 0.0f );
     Vec4 bestend = VEC4_CONST( 0.0f );
     Vec4 besterror = m_besterror;
-    u8 bestindices[16];
     int bestiteration = 0;
     int besti = 0, bestj = 0, bestk = 0;
 
@@ -366,29 +359,64 @@ void ClusterFit::Compress4( void* block )
     }
 
     // save the block if necessary
-    if( CompareAnyLessThan( besterror, m_besterror ) )
+    SaveBlock4( beststart, bestend, besterror, bestiteration, besti, bestj, bestk, block );
+}
+
+void ClusterFit::SaveBlock3( Vec4::Arg start, Vec4::Arg end, Vec4::Arg error, int iteration, int i, int j, void* block )
+{
+    if( CompareAnyLessThan( error, m_besterror ) )
+    {
+        // remap the indices
+        int const count = m_colours->GetCount();
+        u8 const* order = ( u8* )m_order + 16*iteration;
+        int m;
+
+        u8 unordered[16];
+        u8 bestindices[16];
+        for( m = 0; m < i; ++m )
+            unordered[order[m]] = 0;
+        for( m = i; m < j; ++m )
+            unordered[order[m]] = 2;
+        for( m = j; m < count; ++m )
+            unordered[order[m]] = 1;
+
+        m_colours->RemapIndices( unordered, bestindices );
+
+        // save the block
+        WriteColourBlock3( start.GetVec3(), end.GetVec3(), bestindices, block );
+
+        // save the error
+        m_besterror = error;
+    }
+}
+
+void ClusterFit::SaveBlock4( Vec4::Arg start, Vec4::Arg end, Vec4::Arg error, int iteration, int i, int j, int k, void* block )
+{
+    if( CompareAnyLessThan( error, m_besterror ) )
     {
         // remap the indices
-        u8 const* order = ( u8* )m_order + 16*bestiteration;
+        int const count = m_colours->GetCount();
+        u8 const* order = ( u8* )m_order + 16*iteration;
         int m;
 
         u8 unordered[16];
-        for( m = 0; m < besti; ++m )
+        u8 bestindices[16];
+        for( m = 0; m < i; ++m )
             unordered[order[m]] = 0;
-        for( m = besti; m < bestj; ++m )
+        for( m = i; m < j; ++m )
             unordered[order[m]] = 2;
-        for( m = bestj; m < bestk; ++m )
+        for( m = j; m < k; ++m )
             unordered[order[m]] = 3;
-        for( m = bestk; m < count; ++m )
+        for( m = k; m < count; ++m )
             unordered[order[m]] = 1;
 
         m_colours->RemapIndices( unordered, bestindices );
 
         // save the block
-        WriteColourBlock4( beststart.GetVec3(), bestend.GetVec3(), bestindices, block );
+        WriteColourBlock4( start.GetVec3(), end.GetVec3(), bestindices, block );
 
         // save the error
-        m_besterror = besterror;
+        m_besterror = error;
     }
 }
 
@@ -45,6 +45,15 @@ private:
     virtual void Compress3( void* block );
     virtual void Compress4( void* block );
 
+    void SaveBlock3( Vec4::Arg start, Vec4::Arg end, Vec4::Arg error, int iteration, int i, int j, void* block );
+    void SaveBlock4( Vec4::Arg start, Vec4::Arg end, Vec4::Arg error, int iteration, int i, int j, int k, void* block );
+
+#if SQUISH_USE_AVX2
+    // same search as Compress3/4, two candidates per step (clusterfit_avx.cpp)
+    void Compress3Wide( void* block );
+    void Compress4Wide( void* block );
+#endif
+
     enum { kMaxIterations = 8 };
 
     int m_iterationCount;
@@ -0,0 +1,329 @@
+/* -----------------------------------------------------------------------------
+
+    Copyright (c) 2026 PrimeXT contributors
+
+    Based on clusterfit.cpp:
+    Copyright (c) 2006 Simon Brown                          si@sjbrown.co.uk
+    Copyright (c) 2007 Ignacio Castano                   icastano@nvidia.com
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the
+    "Software"), to    deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to
+    permit persons to whom the Software is furnished to do so, subject to
+    the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+    CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   -------------------------------------------------------------------------- */
+
+#include "maths.h"
+
+#if SQUISH_USE_AVX2
+
+// don't build this file with /arch:AVX2 or -mavx2: the inline code of
+// the shared headers must keep the baseline encoding. The kernels are
+// tagged with SQUISH_AVX2_TARGET and the caller checks CpuHasAVX2 first
+
+#include "clusterfit.h"
+#include "colourset.h"
+#include "simd_avx.h"
+
+namespace squish {
+
+/*
+    The wide kernels walk the cluster candidates in the same order as the
+    Vec4 ones, but evaluate two neighbouring positions of the innermost
+    cluster boundary per step. Partial sums are still accumulated one
+    point at a time and the winners are checked low lane first, so the
+    chosen clusters and the written block are identical to the SSE path.
+*/
+
+SQUISH_AVX2_TARGET void ClusterFit::Compress3Wide( void* block )
+{
+    // declare variables
+    int const count = m_colours->GetCount();
+    Vec8 const two = VEC8_CONST( 2.0 );
+    Vec8 const one = VEC8_CONST( 1.0f );
+    Vec8 const half_half2( Vec4( 0.5f, 0.5f, 0.5f, 0.25f ), Vec4( 0.5f, 0.5f, 0.5f, 0.25f ) );
+    Vec8 const zero = VEC8_CONST( 0.0f );
+    Vec8 const half = VEC8_CONST( 0.5f );
+    Vec8 const grid( Vec4( 31.0f, 63.0f, 31.0f, 0.0f ), Vec4( 31.0f, 63.0f, 31.0f, 0.0f ) );
+    Vec8 const gridrcp( Vec4( 1.0f/31.0f, 1.0f/63.0f, 1.0f/31.0f, 0.0f ), Vec4( 1.0f/31.0f, 1.0f/63.0f, 1.0f/31.0f, 0.0f ) );
+    Vec8 const metric( m_metric, m_metric );
+
+    // prepare an ordering using the principle axis
+    ConstructOrdering( m_principle, 0 );
+
+    // check all possible clusters and iterate on the total order
+    Vec4 beststart = VEC4_CONST( 0.0f );
+    Vec4 bestend = VEC4_CONST( 0.0f );
+    Vec4 besterror = m_besterror;
+    int bestiteration = 0;
+    int besti = 0, bestj = 0;
+
+    // loop over iterations (we avoid the case that all points in first or last cluster)
+    for( int iterationIndex = 0;; )
+    {
+        Vec8 const xsum_wsum( m_xsum_wsum, m_xsum_wsum );
+
+        // first cluster [0,i) is at the start
+        Vec4 part0 = VEC4_CONST( 0.0f );
+        for( int i = 0; i < count; ++i )
+        {
+            Vec8 const part0x2( part0, part0 );
+
+            // second cluster [i,j) is half along, low lane takes j and high lane j+1
+            Vec4 part1 = ( i == 0 ) ? m_points_weights[0] : VEC4_CONST( 0.0f );
+            int jmin = ( i == 0 ) ? 1 : i;
+            for( int j = jmin;; )
+            {
+                bool const pair = ( j < count );
+                Vec4 const part1next = pair ? part1 + m_points_weights[j] : part1;
+                Vec8 const part1x2( part1, part1next );
+
+                // last cluster [j,count) is at the end
+                Vec8 part2 = xsum_wsum - part1x2 - part0x2;
+
+                // compute least squares terms directly
+                Vec8 alphax_sum = MultiplyAdd( part1x2, half_half2, part0x2 );
+                Vec8 alpha2_sum = alphax_sum.SplatW();
+
+                Vec8 betax_sum = MultiplyAdd( part1x2, half_half2, part2 );
+                Vec8 beta2_sum = betax_sum.SplatW();
+
+                Vec8 alphabeta_sum = ( part1x2*half_half2 ).SplatW();
+
+                // compute the least-squares optimal points
+                Vec8 factor = Reciprocal( NegativeMultiplySubtract( alphabeta_sum, alphabeta_sum, alpha2_sum*beta2_sum ) );
+                Vec8 a = NegativeMultiplySubtract( betax_sum, alphabeta_sum, alphax_sum*beta2_sum )*factor;
+                Vec8 b = NegativeMultiplySubtract( alphax_sum, alphabeta_sum, betax_sum*alpha2_sum )*factor;
+
+                // clamp to the grid
+                a = Min( one, Max( zero, a ) );
+                b = Min( one, Max( zero, b ) );
+                a = Truncate( MultiplyAdd( grid, a, half ) )*gridrcp;
+                b = Truncate( MultiplyAdd( grid, b, half ) )*gridrcp;
+
+                // compute the error (we skip the constant xxsum)
+                Vec8 e1 = MultiplyAdd( a*a, alpha2_sum, b*b*beta2_sum );
+                Vec8 e2 = NegativeMultiplySubtract( a, alphax_sum, a*b*alphabeta_sum );
+                Vec8 e3 = NegativeMultiplySubtract( b, betax_sum, e2 );
+                Vec8 e4 = MultiplyAdd( two, e3, e1 );
+
+                // apply the metric to the error term
+                Vec8 e5 = e4*metric;
+                Vec8 error = e5.SplatX() + e5.SplatY() + e5.SplatZ();
+
+                // keep the solution if it wins, in the serial order
+                if( CompareAnyLessThan( error.Lo(), besterror ) )
+                {
+                    beststart = a.Lo();
+                    bestend = b.Lo();
+                    besti = i;
+                    bestj = j;
+                    besterror = error.Lo();
+                    bestiteration = iterationIndex;
+                }
+
+                if( pair && CompareAnyLessThan( error.Hi(), besterror ) )
+                {
+                    beststart = a.Hi();
+                    bestend = b.Hi();
+                    besti = i;
+                    bestj = j + 1;
+                    besterror = error.Hi();
+                    bestiteration = iterationIndex;
+                }
+
+                // advance
+                if( !pair || j + 1 == count )
+                    break;
+                part1 = part1next + m_points_weights[j + 1];
+                j += 2;
+            }
+
+            // advance
+            part0 += m_points_weights[i];
+        }
+
+        // stop if we didn't improve in this iteration
+        if( bestiteration != iterationIndex )
+            break;
+
+        // advance if possible
+        ++iterationIndex;
+        if( iterationIndex == m_iterationCount )
+            break;
+
+        // stop if a new iteration is an ordering that has already been tried
+        Vec3 axis = ( bestend - beststart ).GetVec3();
+        if( !ConstructOrdering( axis, iterationIndex ) )
+            break;
+    }
+
+    // save the block if necessary
+    // leave the AVX state before the SSE code
+    _mm256_zeroupper();
+    SaveBlock3( beststart, bestend, besterror, bestiteration, besti, bestj, block );
+}
+
+SQUISH_AVX2_TARGET void ClusterFit::Compress4Wide( void* block )
+{
+    // declare variables
+    int const count = m_colours->GetCount();
+    Vec8 const two = VEC8_CONST( 2.0f );
+    Vec8 const one = VEC8_CONST( 1.0f );
+    Vec8 const onethird_onethird2( Vec4( 1.0f/3.0f, 1.0f/3.0f, 1.0f/3.0f, 1.0f/9.0f ), Vec4( 1.0f/3.0f, 1.0f/3.0f, 1.0f/3.0f, 1.0f/9.0f ) );
+    Vec8 const twothirds_twothirds2( Vec4( 2.0f/3.0f, 2.0f/3.0f, 2.0f/3.0f, 4.0f/9.0f ), Vec4( 2.0f/3.0f, 2.0f/3.0f, 2.0f/3.0f, 4.0f/9.0f ) );
+    Vec8 const twonineths = VEC8_CONST( 2.0f/9.0f );
+    Vec8 const zero = VEC8_CONST( 0.0f );
+    Vec8 const half = VEC8_CONST( 0.5f );
+    Vec8 const grid( Vec4( 31.0f, 63.0f, 31.0f, 0.0f ), Vec4( 31.0f, 63.0f, 31.0f, 0.0f ) );
+    Vec8 const gridrcp( Vec4( 1.0f/31.0f, 1.0f/63.0f, 1.0f/31.0f, 0.0f ), Vec4( 1.0f/31.0f, 1.0f/63.0f, 1.0f/31.0f, 0.0f ) );
+    Vec8 const metric( m_metric, m_metric );
+
+    // prepare an ordering using the principle axis
+    ConstructOrdering( m_principle, 0 );
+
+    // check all possible clusters and iterate on the total order
+    Vec4 beststart = VEC4_CONST( 0.0f );
+    Vec4 bestend = VEC4_CONST( 0.0f );
+    Vec4 besterror = m_besterror;
+    int bestiteration = 0;
+    int besti = 0, bestj = 0, bestk = 0;
+
+    // loop over iterations (we avoid the case that all points in first or last cluster)
+    for( int iterationIndex = 0;; )
+    {
+        Vec8 const xsum_wsum( m_xsum_wsum, m_xsum_wsum );
+
+        // first cluster [0,i) is at the start
+        Vec4 part0 = VEC4_CONST( 0.0f );
+        for( int i = 0; i < count; ++i )
+        {
+            Vec8 const part0x2( part0, part0 );
+
+            // second cluster [i,j) is one third along
+            Vec4 part1 = VEC4_CONST( 0.0f );
+            for( int j = i;; )
+            {
+                Vec8 const part1x2( part1, part1 );
+
+                // third cluster [j,k) is two thirds along, low lane takes k and high lane k+1
+                Vec4 part2 = ( j == 0 ) ? m_points_weights[0] : VEC4_CONST( 0.0f );
+                int kmin = ( j == 0 ) ? 1 : j;
+                for( int k = kmin;; )
+                {
+                    bool const pair = ( k < count );
+                    Vec4 const part2next = pair ? part2 + m_points_weights[k] : part2;
+                    Vec8 const part2x2( part2, part2next );
+
+                    // last cluster [k,count) is at the end
+                    Vec8 part3 = xsum_wsum - part2x2 - part1x2 - part0x2;
+
+                    // compute least squares terms directly
+                    Vec8 const alphax_sum = MultiplyAdd( part2x2, onethird_onethird2, MultiplyAdd( part1x2, twothirds_twothirds2, part0x2 ) );
+                    Vec8 const alpha2_sum = alphax_sum.SplatW();
+
+                    Vec8 const betax_sum = MultiplyAdd( part1x2, onethird_onethird2, MultiplyAdd( part2x2, twothirds_twothirds2, part3 ) );
+                    Vec8 const beta2_sum = betax_sum.SplatW();
+
+                    Vec8 const alphabeta_sum = twonineths*( part1x2 + part2x2 ).SplatW();
+
+                    // compute the least-squares optimal points
+                    Vec8 factor = Reciprocal( NegativeMultiplySubtract( alphabeta_sum, alphabeta_sum, alpha2_sum*beta2_sum ) );
+                    Vec8 a = NegativeMultiplySubtract( betax_sum, alphabeta_sum, alphax_sum*beta2_sum )*factor;
+                    Vec8 b = NegativeMultiplySubtract( alphax_sum, alphabeta_sum, betax_sum*alpha2_sum )*factor;
+
+                    // clamp to the grid
+                    a = Min( one, Max( zero, a ) );
+                    b = Min( one, Max( zero, b ) );
+                    a = Truncate( MultiplyAdd( grid, a, half ) )*gridrcp;
+                    b = Truncate( MultiplyAdd( grid, b, half ) )*gridrcp;
+
+                    // compute the error (we skip the constant xxsum)
+                    Vec8 e1 = MultiplyAdd( a*a, alpha2_sum, b*b*beta2_sum );
+                    Vec8 e2 = NegativeMultiplySubtract( a, alphax_sum, a*b*alphabeta_sum );
+                    Vec8 e3 = NegativeMultiplySubtract( b, betax_sum, e2 );
+                    Vec8 e4 = MultiplyAdd( two, e3, e1 );
+
+                    // apply the metric to the error term
+                    Vec8 e5 = e4*metric;
+                    Vec8 error = e5.SplatX() + e5.SplatY() + e5.SplatZ();
+
+                    // keep the solution if it wins, in the serial order
+                    if( CompareAnyLessThan( error.Lo(), besterror ) )
+                    {
+                        beststart = a.Lo();
+                        bestend = b.Lo();
+                        besterror = error.Lo();
+                        besti = i;
+                        bestj = j;
+                        bestk = k;
+                        bestiteration = iterationIndex;
+                    }
+
+                    if( pair && CompareAnyLessThan( error.Hi(), besterror ) )
+                    {
+                        beststart = a.Hi();
+                        bestend = b.Hi();
+                        besterror = error.Hi();
+                        besti = i;
+                        bestj = j;
+                        bestk = k + 1;
+                        bestiteration = iterationIndex;
+                    }
+
+                    // advance
+                    if( !pair || k + 1 == count )
+                        break;
+                    part2 = part2next + m_points_weights[k + 1];
+                    k += 2;
+                }
+
+                // advance
+                if( j == count )
+                    break;
+                part1 += m_points_weights[j];
+                ++j;
+            }
+
+            // advance
+            part0 += m_points_weights[i];
+        }
+
+        // stop if we didn't improve in this iteration
+        if( bestiteration != iterationIndex )
+            break;
+
+        // advance if possible
+        ++iterationIndex;
+        if( iterationIndex == m_iterationCount )
+            break;
+
+        // stop if a new iteration is an ordering that has already been tried
+        Vec3 axis = ( bestend - beststart ).GetVec3();
+        if( !ConstructOrdering( axis, iterationIndex ) )
+            break;
+    }
+
+    // save the block if necessary
+    // leave the AVX state before the SSE code
+    _mm256_zeroupper();
+    SaveBlock4( beststart, bestend, besterror, bestiteration, besti, bestj, bestk, block );
+}
+
+} // namespace squish
+
+#endif // SQUISH_USE_AVX2
@@ -36,10 +36,19 @@
 #define SQUISH_USE_SSE 0
 #endif
 
+// Set to 1 when building squish to also compile the AVX2 fit kernels.
+// They are selected at runtime, so the library still runs on older CPUs.
+#ifndef SQUISH_USE_AVX2
+#define SQUISH_USE_AVX2 0
+#endif
+
 // Internally set SQUISH_USE_SIMD when either Altivec or SSE is available.
 #if SQUISH_USE_ALTIVEC && SQUISH_USE_SSE
 #error "Cannot enable both Altivec and SSE!"
 #endif
+#if SQUISH_USE_AVX2 && ( SQUISH_USE_SSE < 2 )
+#error "AVX2 requires SSE2!"
+#endif
 #if SQUISH_USE_ALTIVEC || SQUISH_USE_SSE
 #define SQUISH_USE_SIMD 1
 #else
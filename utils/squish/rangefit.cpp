@@ -26,6 +26,7 @@
 #include "rangefit.h"
 #include "colourset.h"
 #include "colourblock.h"
+#include "simd.h"
 #include <cfloat>
 
 namespace squish {
@@ -93,27 +94,25 @@ RangeFit::RangeFit( ColourSet const* colours, int flags, float* metric )
     m_end = Truncate( grid*end + half )*gridrcp;
 }
 
-void RangeFit::Compress3( void* block )
+float RangeFit::MatchCodes( Vec3 const* codes, int numCodes, u8* closest ) const
 {
+#if SQUISH_USE_AVX2
+    if( CpuHasAVX2() )
+        return MatchCodesWide( codes, numCodes, closest );
+#endif
+
     // cache some values
     int const count = m_colours->GetCount();
     Vec3 const* values = m_colours->GetPoints();
 
-    // create a codebook
-    Vec3 codes[3];
-    codes[0] = m_start;
-    codes[1] = m_end;
-    codes[2] = 0.5f*m_start + 0.5f*m_end;
-
     // match each point to the closest code
-    u8 closest[16];
     float error = 0.0f;
     for( int i = 0; i < count; ++i )
     {
         // find the closest code
         float dist = FLT_MAX;
         int idx = 0;
-        for( int j = 0; j < 3; ++j )
+        for( int j = 0; j < numCodes; ++j )
         {
             float d = LengthSquared( m_metric*( values[i] - codes[j] ) );
             if( d < dist )
@@ -130,6 +129,21 @@ void RangeFit::Compress3( void* block )
         error += dist;
     }
 
+    return error;
+}
+
+void RangeFit::Compress3( void* block )
+{
+    // create a codebook
+    Vec3 codes[3];
+    codes[0] = m_start;
+    codes[1] = m_end;
+    codes[2] = 0.5f*m_start + 0.5f*m_end;
+
+    // match each point to the closest code
+    u8 closest[16];
+    float error = MatchCodes( codes, 3, closest );
+
     // save this scheme if it wins
     if( error < m_besterror )
     {
@@ -147,10 +161,6 @@ void RangeFit::Compress3( void* block )
 
 void RangeFit::Compress4( void* block )
 {
-    // cache some values
-    int const count = m_colours->GetCount();
-    Vec3 const* values = m_colours->GetPoints();
-
     // create a codebook
     Vec3 codes[4];
     codes[0] = m_start;
@@ -160,28 +170,7 @@ void RangeFit::Compress4( void* block )
 
     // match each point to the closest code
     u8 closest[16];
-    float error = 0.0f;
-    for( int i = 0; i < count; ++i )
-    {
-        // find the closest code
-        float dist = FLT_MAX;
-        int idx = 0;
-        for( int j = 0; j < 4; ++j )
-        {
-            float d = LengthSquared( m_metric*( values[i] - codes[j] ) );
-            if( d < dist )
-            {
-                dist = d;
-                idx = j;
-            }
-        }
-
-        // save the index
-        closest[i] = ( u8 )idx;
-
-        // accumulate the error
-        error += dist;
-    }
+    float error = MatchCodes( codes, 4, closest );
 
     // save this scheme if it wins
     if( error < m_besterror )
@@ -43,6 +43,12 @@ private:
     virtual void Compress3( void* block );
     virtual void Compress4( void* block );
 
+    float MatchCodes( Vec3 const* codes, int numCodes, u8* closest ) const;
+#if SQUISH_USE_AVX2
+    // eight points per step (rangefit_avx.cpp)
+    float MatchCodesWide( Vec3 const* codes, int numCodes, u8* closest ) const;
+#endif
+
     Vec3 m_metric;
     Vec3 m_start;
     Vec3 m_end;
@@ -0,0 +1,106 @@
+/* -----------------------------------------------------------------------------
+
+    Copyright (c) 2026 PrimeXT contributors
+
+    Based on rangefit.cpp:
+    Copyright (c) 2006 Simon Brown                          si@sjbrown.co.uk
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the
+    "Software"), to    deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to
+    permit persons to whom the Software is furnished to do so, subject to
+    the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+    CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   -------------------------------------------------------------------------- */
+
+#include "maths.h"
+
+#if SQUISH_USE_AVX2
+
+// don't build this file with /arch:AVX2 or -mavx2: the inline code of
+// the shared headers must keep the baseline encoding. The kernels are
+// tagged with SQUISH_AVX2_TARGET and the caller checks CpuHasAVX2 first
+
+#include "rangefit.h"
+#include "colourset.h"
+#include "simd_avx.h"
+#include <cfloat>
+
+namespace squish {
+
+SQUISH_AVX2_TARGET float RangeFit::MatchCodesWide( Vec3 const* codes, int numCodes, u8* closest ) const
+{
+    // cache some values
+    int const count = m_colours->GetCount();
+    Vec3 const* values = m_colours->GetPoints();
+    Vec8 const mx( m_metric.X() );
+    Vec8 const my( m_metric.Y() );
+    Vec8 const mz( m_metric.Z() );
+
+    float error = 0.0f;
+    for( int i = 0; i < count; i += 8 )
+    {
+        float xs[8], ys[8], zs[8];
+        float dists[8], indices[8];
+        int const num = Q_min( count - i, 8 );
+
+        // transpose the points, padding with the last one
+        for( int n = 0; n < 8; ++n )
+        {
+            Vec3 const& v = values[i + Q_min( n, num - 1 )];
+            xs[n] = v.X();
+            ys[n] = v.Y();
+            zs[n] = v.Z();
+        }
+
+        Vec8 const px = Vec8::LoadUnaligned( xs );
+        Vec8 const py = Vec8::LoadUnaligned( ys );
+        Vec8 const pz = Vec8::LoadUnaligned( zs );
+
+        // find the closest code, same operation order as LengthSquared
+        Vec8 dist = VEC8_CONST( FLT_MAX );
+        Vec8 idx = VEC8_CONST( 0.0f );
+        for( int j = 0; j < numCodes; ++j )
+        {
+            Vec8 dx = mx*( px - Vec8( codes[j].X() ) );
+            Vec8 dy = my*( py - Vec8( codes[j].Y() ) );
+            Vec8 dz = mz*( pz - Vec8( codes[j].Z() ) );
+            Vec8 d = dx*dx + dy*dy + dz*dz;
+
+            Vec8 closer = CompareLessThan( d, dist );
+            dist = Select( closer, dist, d );
+            idx = Select( closer, idx, Vec8( ( float )j ) );
+        }
+
+        dist.StoreUnaligned( dists );
+        idx.StoreUnaligned( indices );
+
+        // save the indices and accumulate the error in point order
+        for( int n = 0; n < num; ++n )
+        {
+            closest[i + n] = ( u8 )indices[n];
+            error += dists[n];
+        }
+    }
+
+    // leave the AVX state before the SSE code
+    _mm256_zeroupper();
+    return error;
+}
+
+} // namespace squish
+
+#endif // SQUISH_USE_AVX2
@@ -36,5 +36,14 @@
 #include "simd_float.h"
 #endif
 
+#if SQUISH_USE_AVX2
+namespace squish {
+
+//! Returns true when both the CPU and the OS support AVX2.
+bool CpuHasAVX2();
+
+} // namespace squish
+#endif
+
 
 #endif // ndef SQUISH_SIMD_H
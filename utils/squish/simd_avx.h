@@ -0,0 +1,177 @@
+/* -----------------------------------------------------------------------------
+
+    Copyright (c) 2026 PrimeXT contributors
+
+    Based on simd_sse.h:
+    Copyright (c) 2006 Simon Brown                          si@sjbrown.co.uk
+
+    Permission is hereby granted, free of charge, to any person obtaining
+    a copy of this software and associated documentation files (the
+    "Software"), to    deal in the Software without restriction, including
+    without limitation the rights to use, copy, modify, merge, publish,
+    distribute, sublicense, and/or sell copies of the Software, and to
+    permit persons to whom the Software is furnished to do so, subject to
+    the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+    MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+    IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+    CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+   -------------------------------------------------------------------------- */
+
+#ifndef SQUISH_SIMD_AVX_H
+#define SQUISH_SIMD_AVX_H
+
+#include <immintrin.h>
+#include "simd_sse.h"
+
+// the kernels are built without AVX2 code generation for the whole file,
+// so shared inline code from other headers keeps the baseline encoding.
+// GCC needs the target on every function that uses 256-bit intrinsics
+#if defined( __GNUC__ )
+#define SQUISH_AVX2_TARGET __attribute__(( target( "avx2" ) ))
+#else
+#define SQUISH_AVX2_TARGET
+#endif
+
+#define SQUISH_AVX_SPLAT( a )                                        \
+    ( ( a ) | ( ( a ) << 2 ) | ( ( a ) << 4 ) | ( ( a ) << 6 ) )
+
+namespace squish {
+
+#define VEC8_CONST( X ) Vec8( X )
+
+/*! Two independent Vec4 values packed into one 256-bit register.
+
+    Every operation is applied per 128-bit lane with exactly the same
+    instructions as the SSE Vec4 (no FMA), so each lane gives the same
+    bits as the Vec4 path would for the same inputs.
+*/
+class Vec8
+{
+public:
+    typedef Vec8 const& Arg;
+
+    SQUISH_AVX2_TARGET Vec8() {}
+
+    SQUISH_AVX2_TARGET explicit Vec8( __m256 v ) : m_v( v ) {}
+
+    SQUISH_AVX2_TARGET Vec8( Vec8 const& arg ) : m_v( arg.m_v ) {}
+
+    SQUISH_AVX2_TARGET Vec8& operator=( Vec8 const& arg )
+    {
+        m_v = arg.m_v;
+        return *this;
+    }
+
+    SQUISH_AVX2_TARGET explicit Vec8( float s ) : m_v( _mm256_set1_ps( s ) ) {}
+
+    SQUISH_AVX2_TARGET Vec8( Vec4::Arg lo, Vec4::Arg hi ) : m_v( _mm256_insertf128_ps( _mm256_castps128_ps256( lo.m_v ), hi.m_v, 1 ) ) {}
+
+    SQUISH_AVX2_TARGET Vec4 Lo() const { return Vec4( _mm256_castps256_ps128( m_v ) ); }
+    SQUISH_AVX2_TARGET Vec4 Hi() const { return Vec4( _mm256_extractf128_ps( m_v, 1 ) ); }
+
+    SQUISH_AVX2_TARGET Vec8 SplatX() const { return Vec8( _mm256_shuffle_ps( m_v, m_v, SQUISH_AVX_SPLAT( 0 ) ) ); }
+    SQUISH_AVX2_TARGET Vec8 SplatY() const { return Vec8( _mm256_shuffle_ps( m_v, m_v, SQUISH_AVX_SPLAT( 1 ) ) ); }
+    SQUISH_AVX2_TARGET Vec8 SplatZ() const { return Vec8( _mm256_shuffle_ps( m_v, m_v, SQUISH_AVX_SPLAT( 2 ) ) ); }
+    SQUISH_AVX2_TARGET Vec8 SplatW() const { return Vec8( _mm256_shuffle_ps( m_v, m_v, SQUISH_AVX_SPLAT( 3 ) ) ); }
+
+    SQUISH_AVX2_TARGET static Vec8 LoadUnaligned( float const* in ) { return Vec8( _mm256_loadu_ps( in ) ); }
+    SQUISH_AVX2_TARGET void StoreUnaligned( float* out ) const { _mm256_storeu_ps( out, m_v ); }
+
+    SQUISH_AVX2_TARGET Vec8& operator+=( Arg v )
+    {
+        m_v = _mm256_add_ps( m_v, v.m_v );
+        return *this;
+    }
+
+    SQUISH_AVX2_TARGET Vec8& operator-=( Arg v )
+    {
+        m_v = _mm256_sub_ps( m_v, v.m_v );
+        return *this;
+    }
+
+    SQUISH_AVX2_TARGET Vec8& operator*=( Arg v )
+    {
+        m_v = _mm256_mul_ps( m_v, v.m_v );
+        return *this;
+    }
+
+    SQUISH_AVX2_TARGET friend Vec8 operator+( Vec8::Arg left, Vec8::Arg right  )
+    {
+        return Vec8( _mm256_add_ps( left.m_v, right.m_v ) );
+    }
+
+    SQUISH_AVX2_TARGET friend Vec8 operator-( Vec8::Arg left, Vec8::Arg right  )
+    {
+        return Vec8( _mm256_sub_ps( left.m_v, right.m_v ) );
+    }
+
+    SQUISH_AVX2_TARGET friend Vec8 operator*( Vec8::Arg left, Vec8::Arg right  )
+    {
+        return Vec8( _mm256_mul_ps( left.m_v, right.m_v ) );
+    }
+
+    //! Returns a*b + c
+    SQUISH_AVX2_TARGET friend Vec8 MultiplyAdd( Vec8::Arg a, Vec8::Arg b, Vec8::Arg c )
+    {
+        return Vec8( _mm256_add_ps( _mm256_mul_ps( a.m_v, b.m_v ), c.m_v ) );
+    }
+
+    //! Returns -( a*b - c )
+    SQUISH_AVX2_TARGET friend Vec8 NegativeMultiplySubtract( Vec8::Arg a, Vec8::Arg b, Vec8::Arg c )
+    {
+        return Vec8( _mm256_sub_ps( c.m_v, _mm256_mul_ps( a.m_v, b.m_v ) ) );
+    }
+
+    SQUISH_AVX2_TARGET friend Vec8 Reciprocal( Vec8::Arg v )
+    {
+        // get the reciprocal estimate
+        __m256 estimate = _mm256_rcp_ps( v.m_v );
+
+        // one round of Newton-Rhaphson refinement
+        __m256 diff = _mm256_sub_ps( _mm256_set1_ps( 1.0f ), _mm256_mul_ps( estimate, v.m_v ) );
+        return Vec8( _mm256_add_ps( _mm256_mul_ps( diff, estimate ), estimate ) );
+    }
+
+    SQUISH_AVX2_TARGET friend Vec8 Min( Vec8::Arg left, Vec8::Arg right )
+    {
+        return Vec8( _mm256_min_ps( left.m_v, right.m_v ) );
+    }
+
+    SQUISH_AVX2_TARGET friend Vec8 Max( Vec8::Arg left, Vec8::Arg right )
+    {
+        return Vec8( _mm256_max_ps( left.m_v, right.m_v ) );
+    }
+
+    SQUISH_AVX2_TARGET friend Vec8 Truncate( Vec8::Arg v )
+    {
+        return Vec8( _mm256_cvtepi32_ps( _mm256_cvttps_epi32( v.m_v ) ) );
+    }
+
+    //! Returns an all-ones mask in each element where left < right
+    SQUISH_AVX2_TARGET friend Vec8 CompareLessThan( Vec8::Arg left, Vec8::Arg right )
+    {
+        return Vec8( _mm256_cmp_ps( left.m_v, right.m_v, _CMP_LT_OQ ) );
+    }
+
+    //! Returns elements of right where mask is set, elements of left otherwise
+    SQUISH_AVX2_TARGET friend Vec8 Select( Vec8::Arg mask, Vec8::Arg left, Vec8::Arg right )
+    {
+        return Vec8( _mm256_blendv_ps( left.m_v, right.m_v, mask.m_v ) );
+    }
+
+private:
+    __m256 m_v;
+};
+
+} // namespace squish
+
+#endif // ndef SQUISH_SIMD_AVX_H
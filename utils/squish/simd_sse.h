@@ -172,6 +172,9 @@ public:
     }
 
 private:
+#if SQUISH_USE_AVX2
+    friend class Vec8;
+#endif
     __m128 m_v;
 };
 
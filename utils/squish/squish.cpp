@@ -31,9 +31,73 @@
 #include "colourblock.h"
 #include "alpha.h"
 #include "singlecolourfit.h"
+#include "simd.h"
+
+#if SQUISH_USE_AVX2
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
 
 namespace squish {
 
+#if SQUISH_USE_AVX2
+static bool DetectAVX2()
+{
+    int info[4] = { 0, 0, 0, 0 };
+
+#ifdef _MSC_VER
+    __cpuid( info, 0 );
+    if( info[0] < 7 )
+        return false;
+
+    // OSXSAVE and AVX
+    __cpuid( info, 1 );
+    if( ( info[2] & ( 1 << 27 ) ) == 0 || ( info[2] & ( 1 << 28 ) ) == 0 )
+        return false;
+
+    // the OS must save the YMM registers
+    if( ( _xgetbv( 0 ) & 6 ) != 6 )
+        return false;
+
+    __cpuidex( info, 7, 0 );
+#else
+    unsigned int a, b, c, d, lo, hi;
+
+    if( __get_cpuid_max( 0, 0 ) < 7 )
+        return false;
+
+    // OSXSAVE and AVX
+    __cpuid( 1, a, b, c, d );
+    if( ( c & ( 1 << 27 ) ) == 0 || ( c & ( 1 << 28 ) ) == 0 )
+        return false;
+
+    // the OS must save the YMM registers
+    __asm__ __volatile__( "xgetbv" : "=a"( lo ), "=d"( hi ) : "c"( 0 ) );
+    if( ( lo & 6 ) != 6 )
+        return false;
+
+    __cpuid_count( 7, 0, a, b, c, d );
+    info[1] = ( int )b;
+#endif
+
+    return ( info[1] & ( 1 << 5 ) ) != 0;
+}
+
+bool CpuHasAVX2()
+{
+    static int s_hasAVX2 = -1;
+
+    if( s_hasAVX2 == -1 )
+        s_hasAVX2 = DetectAVX2() ? 1 : 0;
+
+    return s_hasAVX2 != 0;
+}
+#endif
+
+
 static int FixFlags( int flags )
 {
     // grab the flag bits
@@ -95,6 +95,10 @@ SOURCE=.\clusterfit.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\clusterfit_avx.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\colourblock.cpp
 # End Source File
 # Begin Source File
@@ -115,6 +119,10 @@ SOURCE=.\rangefit.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\rangefit_avx.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\singlecolourfit.cpp
 # End Source File
 # Begin Source File
@@ -163,6 +171,10 @@ SOURCE=.\simd.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\simd_avx.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\simd_float.h
 # End Source File
 # Begin Source File
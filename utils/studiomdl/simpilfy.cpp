@@ -19,6 +19,7 @@ GNU General Public License for more details.
 #include "studio.h"
 #include "studiomdl.h"
 #include "iksolver.h"
+#include "threads.h"
 
 #define ANIM_COMPRESS_THRESHOLD	0	// more values compress animation but can skip frames (optimal range between 0-100)
 #define cmp_animvalue( x, y )		( abs( value[x] - value[y] ) <= ANIM_COMPRESS_THRESHOLD )
@@ -3661,158 +3662,237 @@ void MakeTransitions( void )
 	}
 }
 
-void processAnimations( void )
+//-----------------------------------------------------------------------------
+// Purpose: returns animation that is read by the command, if any
+//-----------------------------------------------------------------------------
+static s_animation_t *AnimationCmdReference( const s_animcmd_t *pcmd )
 {
-	int	i, j;
+	switch( pcmd->cmd )
+	{
+	case CMD_SUBTRACT:
+		return pcmd->subtract.ref;
+	case CMD_AO:
+		return pcmd->ao.ref;
+	case CMD_MATCH:
+	case CMD_MATCHBLEND:
+		return pcmd->match.ref;
+	case CMD_WORLDSPACEBLEND:
+		return pcmd->world.ref;
+	case CMD_REFMOTION:
+		return pcmd->motion.pRefAnim;
+	}
+
+	return NULL;
+}
 
-	// find global root bone.
-	if( Q_strlen( rootname ))
-	{
-		g_rootIndex = findGlobalBone( rootname );
-		if( g_rootIndex == -1 ) g_rootIndex = 0;
-	}
+//-----------------------------------------------------------------------------
+// Purpose: animation that neither reads another animation nor is read by one
+//	can be processed at any time, so it goes to the worker threads.
+//	Everything else keeps the serial order to get the same result
+//-----------------------------------------------------------------------------
+static void TagIndependentAnimations( bool *independent )
+{
+	int	i, j;
 
-	buildAnimationWeights( );
+	for( i = 0; i < g_numani; i++ )
+		independent[i] = true;
 
 	for( i = 0; i < g_numani; i++ )
 	{
 		s_animation_t *panim = g_panimation[i];
 
-		extractUnusedMotion( panim ); // FIXME: this should be part of LinearMotion()
+		for( j = 0; j < panim->numcmds; j++ )
+		{
+			s_animation_t *pref = AnimationCmdReference( &panim->cmds[j] );
 
-		setAnimationWeight( panim, 0 );
+			if( !pref || pref == panim )
+				continue;
 
-		int startframe = 0;
+			independent[i] = false;
 
-		if( panim->fudgeloop )
-		{
-			fixupMissingFrame( panim );
+			for( int k = 0; k < g_numani; k++ )
+			{
+				if( g_panimation[k] == pref )
+					independent[k] = false;
+			}
 		}
+	}
+}
 
-		for( j = 0; j < panim->numcmds; j++ )
-		{
-			s_animcmd_t *pcmd = &panim->cmds[j];
+static void processAnimation( s_animation_t *panim )
+{
+	int	j;
+
+	extractUnusedMotion( panim ); // FIXME: this should be part of LinearMotion()
+
+	setAnimationWeight( panim, 0 );
+
+	int startframe = 0;
 
-			switch( pcmd->cmd )
+	if( panim->fudgeloop )
+	{
+		fixupMissingFrame( panim );
+	}
+
+	for( j = 0; j < panim->numcmds; j++ )
+	{
+		s_animcmd_t *pcmd = &panim->cmds[j];
+
+		switch( pcmd->cmd )
+		{
+		case CMD_WEIGHTS:
+			setAnimationWeight( panim, pcmd->weightlist.index );
+			break;
+		case CMD_SUBTRACT:
+			panim->flags |= STUDIO_DELTA;
+			subtractBaseAnimations( pcmd->subtract.ref, panim, pcmd->subtract.frame, pcmd->subtract.flags );
+			break;
+		case CMD_AO:
 			{
-			case CMD_WEIGHTS:
-				setAnimationWeight( panim, pcmd->weightlist.index );
-				break;
-			case CMD_SUBTRACT:
-				panim->flags |= STUDIO_DELTA;
-				subtractBaseAnimations( pcmd->subtract.ref, panim, pcmd->subtract.frame, pcmd->subtract.flags );
-				break;
-			case CMD_AO:
+				int bone = g_rootIndex;
+				if( pcmd->ao.pBonename != NULL )
 				{
-					int bone = g_rootIndex;
-					if( pcmd->ao.pBonename != NULL )
+					bone = findGlobalBone( pcmd->ao.pBonename );
+					if( bone == -1 )
 					{
-						bone = findGlobalBone( pcmd->ao.pBonename );
-						if( bone == -1 )
-						{
-							COM_FatalError("unable to find bone %s to alignbone\n", pcmd->ao.pBonename );
-						}
+						COM_FatalError("unable to find bone %s to alignbone\n", pcmd->ao.pBonename );
 					}
-					processAutoorigin( pcmd->ao.ref, panim, pcmd->ao.motiontype, pcmd->ao.srcframe, pcmd->ao.destframe, bone );
 				}
-				break;
-			case CMD_MATCH:
-				processMatch( pcmd->match.ref, panim, false );
-				break;
-			case CMD_FIXUP:
-				fixupLoopingDiscontinuities( panim, pcmd->fixuploop.start, pcmd->fixuploop.end );
-				break;
-			case CMD_ANGLE:
-				makeAngle( panim, pcmd->angle.angle );
-				break;
-			case CMD_IKFIXUP:
-				break;
-			case CMD_IKRULE:
-				// processed later
-				break;
-			case CMD_MOTION:
-				extractLinearMotion( panim, pcmd->motion.motiontype, startframe, pcmd->motion.iEndFrame, pcmd->motion.iEndFrame, panim, startframe );
-				startframe = pcmd->motion.iEndFrame;
-				break;
-			case CMD_REFMOTION:
-				extractLinearMotion( panim, pcmd->motion.motiontype, startframe, pcmd->motion.iEndFrame, pcmd->motion.iSrcFrame, pcmd->motion.pRefAnim, pcmd->motion.iRefFrame );
-				startframe = pcmd->motion.iEndFrame;
-				break;
-			case CMD_DERIVATIVE:
-				createDerivative( panim, pcmd->derivative.scale );
-				break;
-			case CMD_NOANIMATION:
-				clearAnimations( panim );
-				break;
-			case CMD_LINEARDELTA:
-				panim->flags |= STUDIO_DELTA;
-				linearDelta( panim, panim, panim->numframes - 1, pcmd->linear.flags );
-				break;
-			case CMD_COMPRESS:
-				reencodeAnimation( panim, pcmd->compress.frames );
-				break;
-			case CMD_NUMFRAMES:
-				forceNumframes( panim, pcmd->numframes.frames );
-				break;
-			case CMD_COUNTERROTATE:
+				processAutoorigin( pcmd->ao.ref, panim, pcmd->ao.motiontype, pcmd->ao.srcframe, pcmd->ao.destframe, bone );
+			}
+			break;
+		case CMD_MATCH:
+			processMatch( pcmd->match.ref, panim, false );
+			break;
+		case CMD_FIXUP:
+			fixupLoopingDiscontinuities( panim, pcmd->fixuploop.start, pcmd->fixuploop.end );
+			break;
+		case CMD_ANGLE:
+			makeAngle( panim, pcmd->angle.angle );
+			break;
+		case CMD_IKFIXUP:
+			break;
+		case CMD_IKRULE:
+			// processed later
+			break;
+		case CMD_MOTION:
+			extractLinearMotion( panim, pcmd->motion.motiontype, startframe, pcmd->motion.iEndFrame, pcmd->motion.iEndFrame, panim, startframe );
+			startframe = pcmd->motion.iEndFrame;
+			break;
+		case CMD_REFMOTION:
+			extractLinearMotion( panim, pcmd->motion.motiontype, startframe, pcmd->motion.iEndFrame, pcmd->motion.iSrcFrame, pcmd->motion.pRefAnim, pcmd->motion.iRefFrame );
+			startframe = pcmd->motion.iEndFrame;
+			break;
+		case CMD_DERIVATIVE:
+			createDerivative( panim, pcmd->derivative.scale );
+			break;
+		case CMD_NOANIMATION:
+			clearAnimations( panim );
+			break;
+		case CMD_LINEARDELTA:
+			panim->flags |= STUDIO_DELTA;
+			linearDelta( panim, panim, panim->numframes - 1, pcmd->linear.flags );
+			break;
+		case CMD_COMPRESS:
+			reencodeAnimation( panim, pcmd->compress.frames );
+			break;
+		case CMD_NUMFRAMES:
+			forceNumframes( panim, pcmd->numframes.frames );
+			break;
+		case CMD_COUNTERROTATE:
+			{
+				int bone = findGlobalBone( pcmd->counterrotate.pBonename );
+				if( bone != -1 )
 				{
-					int bone = findGlobalBone( pcmd->counterrotate.pBonename );
-					if( bone != -1 )
-					{
-						Vector	target;
+					Vector	target;
 
-						if( !pcmd->counterrotate.bHasTarget )
-						{
-							matrix3x4	rootxform = matrix3x4( g_vecZero, panim->rotation );
-							matrix3x4	defaultBoneToWorld;
-							defaultBoneToWorld = rootxform.ConcatTransforms( g_bonetable[bone].boneToPose );
-							target = defaultBoneToWorld.GetAngles();
-						}
-						else
-						{
-							target = Vector( pcmd->counterrotate.targetAngle );
-						}
-
-						counterRotateBone( panim, bone, target );
+					if( !pcmd->counterrotate.bHasTarget )
+					{
+						matrix3x4	rootxform = matrix3x4( g_vecZero, panim->rotation );
+						matrix3x4	defaultBoneToWorld;
+						defaultBoneToWorld = rootxform.ConcatTransforms( g_bonetable[bone].boneToPose );
+						target = defaultBoneToWorld.GetAngles();
 					}
 					else
 					{
-						COM_FatalError( "unable to find bone %s to counterrotate\n", pcmd->counterrotate.pBonename );
+						target = Vector( pcmd->counterrotate.targetAngle );
 					}
+
+					counterRotateBone( panim, bone, target );
+				}
+				else
+				{
+					COM_FatalError( "unable to find bone %s to counterrotate\n", pcmd->counterrotate.pBonename );
 				}
-				break;
-			case CMD_WORLDSPACEBLEND:
-				worldspaceBlend( pcmd->world.ref, panim, pcmd->world.startframe, pcmd->world.loops );
-				break;
-			case CMD_MATCHBLEND:
-				matchBlend( panim, pcmd->match.ref, pcmd->match.srcframe, pcmd->match.destframe, pcmd->match.destpre, pcmd->match.destpost );
-				break;
 			}
+			break;
+		case CMD_WORLDSPACEBLEND:
+			worldspaceBlend( pcmd->world.ref, panim, pcmd->world.startframe, pcmd->world.loops );
+			break;
+		case CMD_MATCHBLEND:
+			matchBlend( panim, pcmd->match.ref, pcmd->match.srcframe, pcmd->match.destframe, pcmd->match.destpre, pcmd->match.destpost );
+			break;
 		}
+	}
+
+	if( panim->motiontype )
+	{
+		int	lastframe;
 
-		if( panim->motiontype )
+		if( !FBitSet( panim->flags, STUDIO_LOOPING ))
+		{
+			// roll back 0.2 seconds to try to prevent popping
+			int frames = panim->fps * panim->motionrollback;
+			lastframe = Q_max( Q_min( startframe + 1, panim->numframes - 1 ), panim->numframes - frames - 1 );
+		}
+		else
 		{
-			int	lastframe;
+			lastframe = panim->numframes - 1;
+		}
 
-			if( !FBitSet( panim->flags, STUDIO_LOOPING ))
-			{
-				// roll back 0.2 seconds to try to prevent popping
-				int frames = panim->fps * panim->motionrollback;
-				lastframe = Q_max( Q_min( startframe + 1, panim->numframes - 1 ), panim->numframes - frames - 1 );
-			}
-			else
-			{
-				lastframe = panim->numframes - 1;
-			}
+		extractLinearMotion( panim, panim->motiontype, startframe, lastframe, panim->numframes - 1, panim, startframe );
+		startframe = panim->numframes - 1;
+	}
 
-			extractLinearMotion( panim, panim->motiontype, startframe, lastframe, panim->numframes - 1, panim, startframe );
-			startframe = panim->numframes - 1;
-		}
+	realignLooping( panim );
+	forceAnimationLoop( panim );
+}
+
+static bool	*g_independentAnims;
+
+static void ProcessIndependentAnimation( int index, int threadnum )
+{
+	if( g_independentAnims[index] )
+		processAnimation( g_panimation[index] );
+}
+
+void processAnimations( void )
+{
+	int	i;
+
+	// find global root bone.
+	if( Q_strlen( rootname ))
+	{
+		g_rootIndex = findGlobalBone( rootname );
+		if( g_rootIndex == -1 ) g_rootIndex = 0;
+	}
+
+	buildAnimationWeights( );
+
+	g_independentAnims = (bool *)Mem_Alloc( g_numani * sizeof( bool ));
+	TagIndependentAnimations( g_independentAnims );
+
+	RunThreadsOnIndividual( g_numani, false, ProcessIndependentAnimation );
 
-		realignLooping( panim );
-		forceAnimationLoop( panim );
+	for( i = 0; i < g_numani; i++ )
+	{
+		if( !g_independentAnims[i] )
+			processAnimation( g_panimation[i] );
 	}
 
+	Mem_Free( g_independentAnims );
+	g_independentAnims = NULL;
+
 	// merge weightlists
 	for( i = 0; i < g_numseq; i++ )
 	{
@@ -3833,211 +3913,233 @@ void processAnimations( void )
 }
 
 //-----------------------------------------------------------------------------
-// CompressAnimations
+// CalcBoneScales: find position and rotation scales for a single bone
 //-----------------------------------------------------------------------------
-static void CompressAnimations( void )
+static void CalcBoneScales( int j, int threadnum )
 {
-	int	i, j, k, n, m;
+	int	i, k, n;
 	float	v;
 
-	// find scales for all bones
-	for( j = 0; j < g_numbones; j++ )
+	for( k = 0; k < 6; k++ )
 	{
-		for( k = 0; k < 6; k++ )
+		float	minv, maxv, scale;
+
+		if( k < 3 ) 
+		{
+			minv = -128.0f;
+			maxv = 128.0f;
+		}
+		else
 		{
-			float	minv, maxv, scale;
+			minv = -M_PI / 8.0;
+			maxv = M_PI / 8.0;
+		}
 
-			if( k < 3 ) 
-			{
-				minv = -128.0f;
-				maxv = 128.0f;
-			}
-			else
-			{
-				minv = -M_PI / 8.0;
-				maxv = M_PI / 8.0;
-			}
+		for( i = 0; i < g_numani; i++ )
+		{
+			s_animation_t *panim = g_panimation[i];
 
-			for( i = 0; i < g_numani; i++ )
+			for( n = 0; n < panim->numframes; n++ )
 			{
-				s_animation_t *panim = g_panimation[i];
-
-				for( n = 0; n < panim->numframes; n++ )
+				switch( k )
 				{
-					switch( k )
-					{
-					case 0: 
-					case 1: 
-					case 2: 
-						if( panim->flags & STUDIO_DELTA ) v = panim->sanim[n][j].pos[k]; 
-						else v = ( panim->sanim[n][j].pos[k] - g_bonetable[j].pos[k] ); 
-						break;
-					case 3:
-					case 4:
-					case 5:
-						if( panim->flags & STUDIO_DELTA ) v = panim->sanim[n][j].rot[k-3]; 
-						else v = ( panim->sanim[n][j].rot[k-3] - g_bonetable[j].rot[k-3] ); 
-						clip_rotations( v );
-						break;
-					}
-
-					minv = Q_min( v, minv );
-					maxv = Q_max( v, maxv );
+				case 0: 
+				case 1: 
+				case 2: 
+					if( panim->flags & STUDIO_DELTA ) v = panim->sanim[n][j].pos[k]; 
+					else v = ( panim->sanim[n][j].pos[k] - g_bonetable[j].pos[k] ); 
+					break;
+				case 3:
+				case 4:
+				case 5:
+					if( panim->flags & STUDIO_DELTA ) v = panim->sanim[n][j].rot[k-3]; 
+					else v = ( panim->sanim[n][j].rot[k-3] - g_bonetable[j].rot[k-3] ); 
+					clip_rotations( v );
+					break;
 				}
-			}
 
-			if( minv < maxv )
-			{
-				if( -minv > maxv )
-					scale = minv / -32768.0f;
-				else scale = maxv / 32767.0f;
-			}
-			else
-			{
-				scale = 1.0f / 32.0f;
+				minv = Q_min( v, minv );
+				maxv = Q_max( v, maxv );
 			}
+		}
 
-			switch( k )
-			{
-			case 0: 
-			case 1: 
-			case 2: 
-				g_bonetable[j].posscale[k] = scale;
-				break;
-			case 3:
-			case 4:
-			case 5:
-				g_bonetable[j].rotscale[k-3] = scale;
-				break;
-			}
+		if( minv < maxv )
+		{
+			if( -minv > maxv )
+				scale = minv / -32768.0f;
+			else scale = maxv / 32767.0f;
+		}
+		else
+		{
+			scale = 1.0f / 32.0f;
+		}
+
+		switch( k )
+		{
+		case 0: 
+		case 1: 
+		case 2: 
+			g_bonetable[j].posscale[k] = scale;
+			break;
+		case 3:
+		case 4:
+		case 5:
+			g_bonetable[j].rotscale[k-3] = scale;
+			break;
 		}
 	}
+}
 
+static int	g_animchanges;
+static int	g_animtotal;
+
+//-----------------------------------------------------------------------------
+// CompressAnimation: RLE encode every bone channel of a single animation
+//-----------------------------------------------------------------------------
+static void CompressAnimation( int i, int threadnum )
+{
+	s_animation_t *panim = g_panimation[i];
+	int	j, k, n, m;
 	int	changes = 0;
 	int	total = 0;
+	float	v;
 
-	// reduce animations
-	for( i = 0; i < g_numani; i++ )
+	for( j = 0; j < g_numbones; j++ )
 	{
-		s_animation_t *panim = g_panimation[i];
+		if( FBitSet( g_bonetable[j].flags, BONE_ALWAYS_PROCEDURAL ))
+			continue;
 
-		for( j = 0; j < g_numbones; j++ )
+		// skip bones that have no influence
+		if( panim->weight[j] < 0.001f )
+			continue;
+
+		for( k = 0; k < 6; k++ )
 		{
-			if( FBitSet( g_bonetable[j].flags, BONE_ALWAYS_PROCEDURAL ))
-				continue;
+			mstudioanimvalue_t data[MAXSTUDIOANIMATIONS];
+			mstudioanimvalue_t *pcount, *pvalue;
+			short value[MAXSTUDIOANIMATIONS];
 
-			// skip bones that have no influence
-			if( panim->weight[j] < 0.001f )
-				continue;
+			if( panim->numframes <= 0 )
+				COM_FatalError( "no animation frames: \"%s\"\n", panim->name );
 
-			for( k = 0; k < 6; k++ )
+			// find deltas from default pose
+			for( n = 0; n < panim->numframes; n++ )
 			{
-				mstudioanimvalue_t data[MAXSTUDIOANIMATIONS];
-				mstudioanimvalue_t *pcount, *pvalue;
-				short value[MAXSTUDIOANIMATIONS];
+				s_bone_t *psrcdata = &panim->sanim[n][j];
 
-				if( panim->numframes <= 0 )
-					COM_FatalError( "no animation frames: \"%s\"\n", panim->name );
-
-				// find deltas from default pose
-				for( n = 0; n < panim->numframes; n++ )
+				switch( k )
 				{
-					s_bone_t *psrcdata = &panim->sanim[n][j];
-
-					switch( k )
+				case 0: 
+				case 1: 
+				case 2: 
+					if( panim->flags & STUDIO_DELTA )
 					{
-					case 0: 
-					case 1: 
-					case 2: 
-						if( panim->flags & STUDIO_DELTA )
-						{
-							value[n] = psrcdata->pos[k] / g_bonetable[j].posscale[k]; 
-							// pre-scale pos delta since format only has room for "overall" weight
-							float r = panim->posweight[j] / panim->weight[j];
-							value[n] *= r;
-						}
-						else
-						{
-							v = ( psrcdata->pos[k] - g_bonetable[j].pos[k] );
-							value[n] = v / g_bonetable[j].posscale[k];
-						}
-						break;
-					case 3:
-					case 4:
-					case 5:
-						if( panim->flags & STUDIO_DELTA ) v = psrcdata->rot[k-3]; 
-						else v = ( psrcdata->rot[k-3] - g_bonetable[j].rot[k-3] ); 
-						clip_rotations( v );
-						value[n] = v / g_bonetable[j].rotscale[k-3]; 
-						break;
+						value[n] = psrcdata->pos[k] / g_bonetable[j].posscale[k]; 
+						// pre-scale pos delta since format only has room for "overall" weight
+						float r = panim->posweight[j] / panim->weight[j];
+						value[n] *= r;
+					}
+					else
+					{
+						v = ( psrcdata->pos[k] - g_bonetable[j].pos[k] );
+						value[n] = v / g_bonetable[j].posscale[k];
 					}
+					break;
+				case 3:
+				case 4:
+				case 5:
+					if( panim->flags & STUDIO_DELTA ) v = psrcdata->rot[k-3]; 
+					else v = ( psrcdata->rot[k-3] - g_bonetable[j].rot[k-3] ); 
+					clip_rotations( v );
+					value[n] = v / g_bonetable[j].rotscale[k-3]; 
+					break;
 				}
+			}
 
-				// FIXME: this compression algorithm needs work
+			// FIXME: this compression algorithm needs work
 
-				// initialize animation RLE block
-				panim->numanim[j][k] = 0;
+			// initialize animation RLE block
+			panim->numanim[j][k] = 0;
 
-				memset( data, 0, sizeof( data )); 
-				pcount = data; 
-				pvalue = pcount + 1;
+			memset( data, 0, sizeof( data )); 
+			pcount = data; 
+			pvalue = pcount + 1;
 
-				pcount->num.valid = 1;
-				pcount->num.total = 1;
-				pvalue->value = value[0];
-				pvalue++;
-				changes++;
-				total++;
+			pcount->num.valid = 1;
+			pcount->num.total = 1;
+			pvalue->value = value[0];
+			pvalue++;
+			changes++;
+			total++;
 
-				for( m = 1; m < n; m++ )
+			for( m = 1; m < n; m++ )
+			{
+				if( pcount->num.total == 255 )
+				{
+					// chain too long, force a new entry
+					pcount = pvalue;
+					pvalue = pcount + 1;
+					pcount->num.valid++;
+					pvalue->value = value[m];
+					pvalue++;
+					changes++;
+				} 
+
+				// insert value if they're not equal, 
+				// or if we're not on a run and the run is less than 3 units
+				else if( !cmp_animvalue( m, m - 1 ) || (( pcount->num.total == pcount->num.valid )
+				&& (( m < n - 1 ) && !cmp_animvalue( m, m + 1 ))))
 				{
-					if( pcount->num.total == 255 )
+					if( pcount->num.total != pcount->num.valid )
 					{
-						// chain too long, force a new entry
 						pcount = pvalue;
 						pvalue = pcount + 1;
-						pcount->num.valid++;
-						pvalue->value = value[m];
-						pvalue++;
-						changes++;
-					} 
-
-					// insert value if they're not equal, 
-					// or if we're not on a run and the run is less than 3 units
-					else if( !cmp_animvalue( m, m - 1 ) || (( pcount->num.total == pcount->num.valid )
-					&& (( m < n - 1 ) && !cmp_animvalue( m, m + 1 ))))
-					{
-						if( pcount->num.total != pcount->num.valid )
-						{
-							pcount = pvalue;
-							pvalue = pcount + 1;
-						}
-						pcount->num.valid++;
-						pvalue->value = value[m];
-						pvalue++;
-						changes++;
 					}
-					pcount->num.total++;
-					total++;
+					pcount->num.valid++;
+					pvalue->value = value[m];
+					pvalue++;
+					changes++;
 				}
+				pcount->num.total++;
+				total++;
+			}
 
-				panim->numanim[j][k] = pvalue - data;
-				if( panim->numanim[j][k] == 2 && value[0] == 0 )
-				{
-					panim->numanim[j][k] = 0;
-				}
-				else
-				{
-					size_t anim_size = ( pvalue - data ) * sizeof( mstudioanimvalue_t );
-					panim->anim[j][k] = (mstudioanimvalue_t *)Mem_Alloc( anim_size );
-					memmove( panim->anim[j][k], data, anim_size );
-				}
+			panim->numanim[j][k] = pvalue - data;
+			if( panim->numanim[j][k] == 2 && value[0] == 0 )
+			{
+				panim->numanim[j][k] = 0;
+			}
+			else
+			{
+				size_t anim_size = ( pvalue - data ) * sizeof( mstudioanimvalue_t );
+				panim->anim[j][k] = (mstudioanimvalue_t *)Mem_Alloc( anim_size );
+				memmove( panim->anim[j][k], data, anim_size );
 			}
 		}
 	}
 
-	if( total != 0 )
-		MsgDev( D_INFO, "animation compressed of %.1f%c at original size\n", ((float)changes / (float)total ) * 100.0f, '%' );
+	ThreadLock();
+	g_animchanges += changes;
+	g_animtotal += total;
+	ThreadUnlock();
+}
+
+//-----------------------------------------------------------------------------
+// CompressAnimations
+//-----------------------------------------------------------------------------
+static void CompressAnimations( void )
+{
+	// find scales for all bones
+	RunThreadsOnIndividual( g_numbones, false, CalcBoneScales );
+
+	g_animchanges = 0;
+	g_animtotal = 0;
+
+	// reduce animations
+	RunThreadsOnIndividual( g_numani, false, CompressAnimation );
+
+	if( g_animtotal != 0 )
+		MsgDev( D_INFO, "animation compressed of %.1f%c at original size\n", ((float)g_animchanges / (float)g_animtotal ) * 100.0f, '%' );
 }
 
 //-----------------------------------------------------------------------------
@@ -4176,71 +4278,78 @@ static void CompressSingle( s_animationstream_t *pStream )
 	}
 }
 
-static void CalcSequenceBoundingBoxes( void )
+//-----------------------------------------------------------------------------
+// CalcAnimationBoundingBox: find bounding box for a single animation
+//-----------------------------------------------------------------------------
+static void CalcAnimationBoundingBox( int i, int threadnum )
 {
-	int	i, j, k;
+	int	j, k;
 	int	n, m;
 
-	// find bounding box for each sequence
-	for( i = 0; i < g_numseq; i++ )
-	{
-		Vector	bmin, bmax;
+	Vector	bmin, bmax;
 
-		// find intersection box volume for each bone
-		ClearBounds( bmin, bmax );
+	// find intersection box volume for each bone
+	ClearBounds( bmin, bmax );
 
-		s_animation_t *panim = g_panimation[i];
+	s_animation_t *panim = g_panimation[i];
 
-		for( n = 0; n < panim->numframes; n++ )
-		{
-			matrix3x4	bonetransform[MAXSTUDIOBONES];	// bone transformation matrix
-			matrix3x4	posetransform[MAXSTUDIOBONES];	// bone transformation matrix
-			matrix3x4	bonematrix;			// local transformation matrix
-			Vector pos, tmp;
+	for( n = 0; n < panim->numframes; n++ )
+	{
+		matrix3x4	bonetransform[MAXSTUDIOBONES];	// bone transformation matrix
+		matrix3x4	posetransform[MAXSTUDIOBONES];	// bone transformation matrix
+		matrix3x4	bonematrix;			// local transformation matrix
+		Vector pos, tmp;
 
-			for( j = 0; j < g_numbones; j++ )
-			{
-				bonematrix = matrix3x4( panim->sanim[n][j].pos, panim->sanim[n][j].rot );
-				if( g_bonetable[j].parent == -1 ) bonetransform[j] = bonematrix;
-				else bonetransform[j] = bonetransform[g_bonetable[j].parent].ConcatTransforms( bonematrix );
+		for( j = 0; j < g_numbones; j++ )
+		{
+			bonematrix = matrix3x4( panim->sanim[n][j].pos, panim->sanim[n][j].rot );
+			if( g_bonetable[j].parent == -1 ) bonetransform[j] = bonematrix;
+			else bonetransform[j] = bonetransform[g_bonetable[j].parent].ConcatTransforms( bonematrix );
 
-				bonematrix = g_bonetable[j].boneToPose.Invert();
-				posetransform[j] = bonetransform[j].ConcatTransforms( bonematrix );
-			}
+			bonematrix = g_bonetable[j].boneToPose.Invert();
+			posetransform[j] = bonetransform[j].ConcatTransforms( bonematrix );
+		}
 
-			// include bones as well.
-			for( k = 0; k < g_numbones; k++ )
-			{
-				Vector tmpMin, tmpMax;
-				TransformAABB( bonetransform[k], g_bonetable[k].bmin, g_bonetable[k].bmax, tmpMin, tmpMax );
-				AddPointToBounds( tmpMin, bmin, bmax );
-				AddPointToBounds( tmpMax, bmin, bmax );
-			}
+		// include bones as well.
+		for( k = 0; k < g_numbones; k++ )
+		{
+			Vector tmpMin, tmpMax;
+			TransformAABB( bonetransform[k], g_bonetable[k].bmin, g_bonetable[k].bmax, tmpMin, tmpMax );
+			AddPointToBounds( tmpMin, bmin, bmax );
+			AddPointToBounds( tmpMax, bmin, bmax );
+		}
 
-			// include vertices
-			for( k = 0; k < g_nummodels; k++ )
+		// include vertices
+		for( k = 0; k < g_nummodels; k++ )
+		{
+			for( j = 0; j < g_model[k]->numsrcverts; j++ )
 			{
-				for( j = 0; j < g_model[k]->numsrcverts; j++ )
-				{
-					s_srcvertex_t *v = &g_model[k]->srcvert[j];
-					pos = g_vecZero;
+				s_srcvertex_t *v = &g_model[k]->srcvert[j];
+				pos = g_vecZero;
 
-					for( m = 0; m < v->globalWeight.numbones; m++ )
-					{
-						if( has_boneweights )
-							tmp = posetransform[v->globalWeight.bone[m]].VectorTransform( v->vert );
-						else tmp = bonetransform[v->globalWeight.bone[m]].VectorTransform( v->vert );
-						pos += tmp * v->globalWeight.weight[m];
-					}
-					AddPointToBounds( pos, bmin, bmax );
+				for( m = 0; m < v->globalWeight.numbones; m++ )
+				{
+					if( has_boneweights )
+						tmp = posetransform[v->globalWeight.bone[m]].VectorTransform( v->vert );
+					else tmp = bonetransform[v->globalWeight.bone[m]].VectorTransform( v->vert );
+					pos += tmp * v->globalWeight.weight[m];
 				}
+				AddPointToBounds( pos, bmin, bmax );
 			}
 		}
-
-		panim->bmin = bmin;
-		panim->bmax = bmax;
 	}
 
+	panim->bmin = bmin;
+	panim->bmax = bmax;
+}
+
+static void CalcSequenceBoundingBoxes( void )
+{
+	int	i, j;
+
+	// find bounding box for each sequence
+	RunThreadsOnIndividual( g_numseq, false, CalcAnimationBoundingBox );
+
 	for( i = 0; i < g_numseq; i++ )
 	{
 		Vector	bmin, bmax;
@@ -4809,306 +4918,334 @@ static void LinkIKLocks( void )
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: go through all the IK rules and calculate the animated path the IK'd 
-//			end point moves relative to its IK target.
+// Purpose: copy IK rules of a single animation and calculate the animated path
+//			the IK'd end point moves relative to its IK target.
 //-----------------------------------------------------------------------------
-static void ProcessIKRules( void )
+static void ProcessAnimationIKRules( int i, int threadnum )
 {
-	int i, j, k;
+	s_animation_t *panim = g_panimation[i];
+	int	j, k;
 
-	// copy source animations
-	for( i = 0; i < g_numani; i++ )
+
+	for( j = 0; j < panim->numcmds; j++ )
 	{
-		s_animation_t *panim = g_panimation[i];
-		const char *pAnimationName = g_panimation[i]->name;
+		if( panim->cmds[j].cmd == CMD_IKFIXUP )
+		{
+			fixupIKErrors( panim, panim->cmds[j].ikfixup.pRule );
+		}
 
-		for( j = 0; j < panim->numcmds; j++ )
+		if( panim->cmds[j].cmd != CMD_IKRULE )
+			continue;
+
+		if( panim->numikrules >= MAXSTUDIOIKRULES )
 		{
-			if( panim->cmds[j].cmd == CMD_IKFIXUP )
-			{
-				fixupIKErrors( panim, panim->cmds[j].ikfixup.pRule );
-			}
+			COM_FatalError("Too many IK rules in %s (%s)\n", panim->name, panim->filename );
+		}
 
-			if( panim->cmds[j].cmd != CMD_IKRULE )
-				continue;
+		s_ikrule_t *pRule = &panim->ikrule[panim->numikrules++];
 
-			if( panim->numikrules >= MAXSTUDIOIKRULES )
-			{
-				COM_FatalError("Too many IK rules in %s (%s)\n", panim->name, panim->filename );
-			}
+		// make a copy of the rule;
+		*pRule = *panim->cmds[j].ikrule.pRule;
+	}
 
-			s_ikrule_t *pRule = &panim->ikrule[panim->numikrules++];
+	for( j = 0; j < panim->numikrules; j++ )
+	{
+		s_ikrule_t *pRule = &panim->ikrule[j];
 
-			// make a copy of the rule;
-			*pRule = *panim->cmds[j].ikrule.pRule;
+		if( pRule->start == 0 && pRule->peak == 0 && pRule->tail == 0 && pRule->end == 0 )
+		{
+			pRule->tail = panim->numframes - 1;
+			pRule->end = panim->numframes - 1;
 		}
 
-		for( j = 0; j < panim->numikrules; j++ )
+		if( pRule->start != -1 && pRule->peak == -1 && pRule->tail == -1 && pRule->end != -1 )
 		{
-			s_ikrule_t *pRule = &panim->ikrule[j];
-
-			if( pRule->start == 0 && pRule->peak == 0 && pRule->tail == 0 && pRule->end == 0 )
-			{
-				pRule->tail = panim->numframes - 1;
-				pRule->end = panim->numframes - 1;
-			}
+			pRule->peak = (pRule->start + pRule->end) / 2;
+			pRule->tail = (pRule->start + pRule->end) / 2;
+		}
 
-			if( pRule->start != -1 && pRule->peak == -1 && pRule->tail == -1 && pRule->end != -1 )
-			{
-				pRule->peak = (pRule->start + pRule->end) / 2;
-				pRule->tail = (pRule->start + pRule->end) / 2;
-			}
+		if( pRule->start != -1 && pRule->peak == -1 && pRule->tail != -1 )
+		{
+			pRule->peak = (pRule->start + pRule->tail) / 2;
+		}
 
-			if( pRule->start != -1 && pRule->peak == -1 && pRule->tail != -1 )
-			{
-				pRule->peak = (pRule->start + pRule->tail) / 2;
-			}
+		if( pRule->peak != -1 && pRule->tail == -1 && pRule->end != -1 )
+		{
+			pRule->tail = (pRule->peak + pRule->end) / 2;
+		}
 
-			if( pRule->peak != -1 && pRule->tail == -1 && pRule->end != -1 )
-			{
-				pRule->tail = (pRule->peak + pRule->end) / 2;
-			}
+		if( pRule->peak == -1 )
+		{
+			pRule->start = 0;
+			pRule->peak = 0;
+		}
 
-			if( pRule->peak == -1 )
-			{
-				pRule->start = 0;
-				pRule->peak = 0;
-			}
+		if( pRule->tail == -1 )
+		{
+			pRule->tail = panim->numframes - 1;
+			pRule->end = panim->numframes - 1;
+		}
 
-			if( pRule->tail == -1 )
-			{
-				pRule->tail = panim->numframes - 1;
-				pRule->end = panim->numframes - 1;
-			}
+		if( pRule->contact == -1 )
+		{
+			pRule->contact = pRule->peak;
+		}
 
-			if( pRule->contact == -1 )
-			{
-				pRule->contact = pRule->peak;
-			}
+		// huh, make up start and end numbers
+		if( pRule->start == -1 )
+		{
+			s_ikrule_t *pPrev = FindPrevIKRule( panim, j );
 
-			// huh, make up start and end numbers
-			if( pRule->start == -1 )
+			if( pPrev->slot == pRule->slot )
 			{
-				s_ikrule_t *pPrev = FindPrevIKRule( panim, j );
-
-				if( pPrev->slot == pRule->slot )
+				if( pRule->peak < pPrev->tail )
 				{
-					if( pRule->peak < pPrev->tail )
-					{
-						pRule->start = pRule->peak + (pPrev->tail - pRule->peak) / 2;
-					}
-					else
-					{
-						pRule->start = pRule->peak + (pPrev->tail - pRule->peak + panim->numframes - 1) / 2;
-					}
-
-					pRule->start = (pRule->start + panim->numframes / 2) % (panim->numframes - 1);
-					pPrev->end = (pRule->start + panim->numframes - 1) % (panim->numframes - 1);
+					pRule->start = pRule->peak + (pPrev->tail - pRule->peak) / 2;
 				}
 				else
 				{
-					pRule->start = pPrev->tail;
-					pPrev->end = pRule->peak;
+					pRule->start = pRule->peak + (pPrev->tail - pRule->peak + panim->numframes - 1) / 2;
 				}
-			}
 
-			// huh, make up start and end numbers
-			if( pRule->end == -1 )
+				pRule->start = (pRule->start + panim->numframes / 2) % (panim->numframes - 1);
+				pPrev->end = (pRule->start + panim->numframes - 1) % (panim->numframes - 1);
+			}
+			else
 			{
-				s_ikrule_t *pNext = FindNextIKRule( panim, j );
+				pRule->start = pPrev->tail;
+				pPrev->end = pRule->peak;
+			}
+		}
 
-				if( pNext->slot == pRule->slot )
-				{
-					if( pNext->peak < pRule->tail )
-					{
-						pNext->start = pNext->peak + (pRule->tail - pNext->peak) / 2;
-					}
-					else
-					{
-						pNext->start = pNext->peak + (pRule->tail - pNext->peak + panim->numframes - 1) / 2;
-					}
+		// huh, make up start and end numbers
+		if( pRule->end == -1 )
+		{
+			s_ikrule_t *pNext = FindNextIKRule( panim, j );
 
-					pNext->start = (pNext->start + panim->numframes / 2) % (panim->numframes - 1);
-					pRule->end = (pNext->start + panim->numframes - 1) % (panim->numframes - 1);
+			if( pNext->slot == pRule->slot )
+			{
+				if( pNext->peak < pRule->tail )
+				{
+					pNext->start = pNext->peak + (pRule->tail - pNext->peak) / 2;
 				}
 				else
 				{
-					pNext->start = pRule->tail;
-					pRule->end = pNext->peak;
+					pNext->start = pNext->peak + (pRule->tail - pNext->peak + panim->numframes - 1) / 2;
 				}
-			}
 
-			// check for wrapping
-			if( pRule->peak < pRule->start )
-			{
-				pRule->peak += panim->numframes - 1;
+				pNext->start = (pNext->start + panim->numframes / 2) % (panim->numframes - 1);
+				pRule->end = (pNext->start + panim->numframes - 1) % (panim->numframes - 1);
 			}
-
-			if( pRule->tail < pRule->peak )
+			else
 			{
-				pRule->tail += panim->numframes - 1;
+				pNext->start = pRule->tail;
+				pRule->end = pNext->peak;
 			}
+		}
 
-			if( pRule->end < pRule->tail )
-			{
-				pRule->end += panim->numframes - 1;
-			}
+		// check for wrapping
+		if( pRule->peak < pRule->start )
+		{
+			pRule->peak += panim->numframes - 1;
+		}
 
-			if( pRule->contact < pRule->start )
-			{
-				pRule->contact += panim->numframes - 1;
-			}
+		if( pRule->tail < pRule->peak )
+		{
+			pRule->tail += panim->numframes - 1;
+		}
 
-			pRule->errorData.numerror = pRule->end - pRule->start + 1;
-			if( pRule->end >= panim->numframes )
-				pRule->errorData.numerror = pRule->errorData.numerror + 2;
+		if( pRule->end < pRule->tail )
+		{
+			pRule->end += panim->numframes - 1;
+		}
+
+		if( pRule->contact < pRule->start )
+		{
+			pRule->contact += panim->numframes - 1;
+		}
 
-			pRule->errorData.pError = (s_streamdata_t *)Mem_Alloc( pRule->errorData.numerror * sizeof( s_streamdata_t ));
+		pRule->errorData.numerror = pRule->end - pRule->start + 1;
+		if( pRule->end >= panim->numframes )
+			pRule->errorData.numerror = pRule->errorData.numerror + 2;
 
-			int n = 0;
+		pRule->errorData.pError = (s_streamdata_t *)Mem_Alloc( pRule->errorData.numerror * sizeof( s_streamdata_t ));
 
-			if( pRule->usesequence )
+		int n = 0;
+
+		if( pRule->usesequence )
+		{
+			// FIXME: bah, this is horrendously hacky, add a damn back pointer
+			for( n = 0; n < g_numseq; n++ )
 			{
-				// FIXME: bah, this is horrendously hacky, add a damn back pointer
-				for( n = 0; n < g_numseq; n++ )
-				{
-					if( g_sequence[n].panim[0] == panim )
-						break;
-				}
+				if( g_sequence[n].panim[0] == panim )
+					break;
 			}
+		}
 
-			switch( pRule->type )
+		switch( pRule->type )
+		{
+		case IK_SELF:
 			{
-			case IK_SELF:
+				matrix3x4	boneToWorld[MAXSTUDIOBONES];
+				matrix3x4	worldToBone;
+				matrix3x4	local;
+
+				if( !Q_strlen( pRule->bonename ))
 				{
-					matrix3x4	boneToWorld[MAXSTUDIOBONES];
-					matrix3x4	worldToBone;
-					matrix3x4	local;
+					pRule->bone = -1;
+				}
+				else
+				{
+					pRule->bone = findGlobalBone( pRule->bonename );
 
-					if( !Q_strlen( pRule->bonename ))
+					if( pRule->bone == -1 )
+						COM_FatalError( "unknown bone '%s' in ikrule\n", pRule->bonename );
+				}
+
+				for( k = 0; k < pRule->errorData.numerror; k++ )
+				{
+					if( pRule->usesequence )
 					{
-						pRule->bone = -1;
+						CalcSeqTransforms( n, k + pRule->start, boneToWorld );
 					}
-					else
+					else if( pRule->usesource )
 					{
-						pRule->bone = findGlobalBone( pRule->bonename );
-
-						if( pRule->bone == -1 )
-							COM_FatalError( "unknown bone '%s' in ikrule\n", pRule->bonename );
+						matrix3x4	srcBoneToWorld[MAXSTUDIOSRCBONES];
+						BuildRawTransforms( panim, k + pRule->start + panim->startframe - panim->source.startframe, panim->adjust, panim->rotation, srcBoneToWorld );
+						TranslateAnimations( panim->boneGlobalToLocal, srcBoneToWorld, boneToWorld );
+					}
+					else 
+					{
+						CalcBoneTransforms( panim, k + pRule->start, boneToWorld );
 					}
 
-					for( k = 0; k < pRule->errorData.numerror; k++ )
+					if( pRule->bone != -1 )
 					{
-						if( pRule->usesequence )
-						{
-							CalcSeqTransforms( n, k + pRule->start, boneToWorld );
-						}
-						else if( pRule->usesource )
-						{
-							matrix3x4	srcBoneToWorld[MAXSTUDIOSRCBONES];
-							BuildRawTransforms( panim, k + pRule->start + panim->startframe - panim->source.startframe, panim->adjust, panim->rotation, srcBoneToWorld );
-							TranslateAnimations( panim->boneGlobalToLocal, srcBoneToWorld, boneToWorld );
-						}
-						else 
-						{
-							CalcBoneTransforms( panim, k + pRule->start, boneToWorld );
-						}
+						worldToBone = boneToWorld[pRule->bone].Invert();
+						local = worldToBone.ConcatTransforms( boneToWorld[g_ikchain[pRule->chain].link[2].bone] );
+					}
+					else
+					{
+						local = boneToWorld[g_ikchain[pRule->chain].link[2].bone];
+					}
 
-						if( pRule->bone != -1 )
-						{
-							worldToBone = boneToWorld[pRule->bone].Invert();
-							local = worldToBone.ConcatTransforms( boneToWorld[g_ikchain[pRule->chain].link[2].bone] );
-						}
-						else
-						{
-							local = boneToWorld[g_ikchain[pRule->chain].link[2].bone];
-						}
+					pRule->errorData.pError[k].q = local.GetQuaternion();
+					pRule->errorData.pError[k].pos = local.GetOrigin();
+				}
+			}
+			break;
+		case IK_WORLD:
+			break;
+		case IK_ATTACHMENT:
+			{
+				matrix3x4	boneToWorld[MAXSTUDIOBONES];
+				matrix3x4	worldToBone;
+				matrix3x4	local;
 
-						pRule->errorData.pError[k].q = local.GetQuaternion();
-						pRule->errorData.pError[k].pos = local.GetOrigin();
+				int bone = g_ikchain[pRule->chain].link[2].bone;
+				CalcBoneTransforms( panim, pRule->contact, boneToWorld );
+				// FIXME: add in motion
+
+				if( !Q_strlen( pRule->bonename ))
+				{
+					if( pRule->bone != -1 )
+					{
+						pRule->bone = bone;
 					}
 				}
-				break;
-			case IK_WORLD:
-				break;
-			case IK_ATTACHMENT:
+				else
 				{
-					matrix3x4	boneToWorld[MAXSTUDIOBONES];
-					matrix3x4	worldToBone;
-					matrix3x4	local;
+					pRule->bone = findGlobalBone( pRule->bonename );
+					if( pRule->bone == -1 )
+					{
+						COM_FatalError( "unknown bone '%s' in ikrule\n", pRule->bonename );
+					}
+				}
 
-					int bone = g_ikchain[pRule->chain].link[2].bone;
+				if( pRule->bone != -1 )
+				{
+					// FIXME: look for local bones...
 					CalcBoneTransforms( panim, pRule->contact, boneToWorld );
-					// FIXME: add in motion
+					pRule->q = boneToWorld[pRule->bone].GetQuaternion();
+					pRule->pos = boneToWorld[pRule->bone].GetOrigin();
+				}
+
+				for( k = 0; k < pRule->errorData.numerror; k++ )
+				{
+					int t = k + pRule->start;
 
-					if( !Q_strlen( pRule->bonename ))
+					if( pRule->usesequence )
 					{
-						if( pRule->bone != -1 )
-						{
-							pRule->bone = bone;
-						}
+						CalcSeqTransforms( n, t, boneToWorld );
 					}
-					else
+					else if( pRule->usesource )
 					{
-						pRule->bone = findGlobalBone( pRule->bonename );
-						if( pRule->bone == -1 )
-						{
-							COM_FatalError( "unknown bone '%s' in ikrule\n", pRule->bonename );
-						}
+						matrix3x4	srcBoneToWorld[MAXSTUDIOSRCBONES];
+						BuildRawTransforms( panim, t + panim->startframe - panim->source.startframe, g_vecZero, g_radZero, srcBoneToWorld );
+						TranslateAnimations( panim->boneGlobalToLocal, srcBoneToWorld, boneToWorld );
 					}
-
-					if( pRule->bone != -1 )
+					else 
 					{
-						// FIXME: look for local bones...
-						CalcBoneTransforms( panim, pRule->contact, boneToWorld );
-						pRule->q = boneToWorld[pRule->bone].GetQuaternion();
-						pRule->pos = boneToWorld[pRule->bone].GetOrigin();
+						CalcBoneTransforms( panim, t, boneToWorld );
 					}
 
-					for( k = 0; k < pRule->errorData.numerror; k++ )
-					{
-						int t = k + pRule->start;
+					Vector pos = pRule->pos + calcMovement( panim, t, pRule->contact );
 
-						if( pRule->usesequence )
-						{
-							CalcSeqTransforms( n, t, boneToWorld );
-						}
-						else if( pRule->usesource )
-						{
-							matrix3x4	srcBoneToWorld[MAXSTUDIOSRCBONES];
-							BuildRawTransforms( panim, t + panim->startframe - panim->source.startframe, g_vecZero, g_radZero, srcBoneToWorld );
-							TranslateAnimations( panim->boneGlobalToLocal, srcBoneToWorld, boneToWorld );
-						}
-						else 
-						{
-							CalcBoneTransforms( panim, t, boneToWorld );
-						}
+					local = matrix3x4( pos, pRule->q );
+					worldToBone = local.Invert();
 
-						Vector pos = pRule->pos + calcMovement( panim, t, pRule->contact );
+					// calc position error
+					local = worldToBone.ConcatTransforms( boneToWorld[bone] );
+					pRule->errorData.pError[k].q = local.GetQuaternion();
+					pRule->errorData.pError[k].pos = local.GetOrigin();
+				}
+			}
+			break;
+		case IK_GROUND:
+			{
+				matrix3x4	boneToWorld[MAXSTUDIOBONES];
+				matrix3x4	worldToBone;
+				matrix3x4	local;
 
-						local = matrix3x4( pos, pRule->q );
-						worldToBone = local.Invert();
+				int bone = g_ikchain[pRule->chain].link[2].bone;
 
-						// calc position error
-						local = worldToBone.ConcatTransforms( boneToWorld[bone] );
-						pRule->errorData.pError[k].q = local.GetQuaternion();
-						pRule->errorData.pError[k].pos = local.GetOrigin();
-					}
+				if( pRule->usesequence )
+				{
+					CalcSeqTransforms( n, pRule->contact, boneToWorld );
 				}
-				break;
-			case IK_GROUND:
+				else if (pRule->usesource)
+				{
+					matrix3x4	srcBoneToWorld[MAXSTUDIOSRCBONES];
+					BuildRawTransforms( panim, pRule->contact + panim->startframe, panim->adjust, panim->rotation, srcBoneToWorld );
+					TranslateAnimations( panim->boneGlobalToLocal, srcBoneToWorld, boneToWorld );
+				}
+				else 
 				{
-					matrix3x4	boneToWorld[MAXSTUDIOBONES];
-					matrix3x4	worldToBone;
-					matrix3x4	local;
+					CalcBoneTransforms( panim, pRule->contact, boneToWorld );
+				}
+
+				// FIXME: add in motion
+
+				Vector footfall = boneToWorld[bone].VectorTransform( g_ikchain[pRule->chain].center );
+				footfall.z = pRule->floor;
+
+				local = matrix3x4( footfall, g_radZero );
+				worldToBone = local.Invert();
 
-					int bone = g_ikchain[pRule->chain].link[2].bone;
+				pRule->pos = footfall;
+				pRule->q = g_radZero;	// auto conversion Radian->Quaternion
+
+				float s;
+
+				for( k = 0; k < pRule->errorData.numerror; k++ )
+				{
+					int t = k + pRule->start;
 
 					if( pRule->usesequence )
 					{
-						CalcSeqTransforms( n, pRule->contact, boneToWorld );
+						CalcSeqTransforms( n, t, boneToWorld );
 					}
-					else if (pRule->usesource)
+					else if( pRule->usesource )
 					{
 						matrix3x4	srcBoneToWorld[MAXSTUDIOSRCBONES];
 						BuildRawTransforms( panim, pRule->contact + panim->startframe, panim->adjust, panim->rotation, srcBoneToWorld );
@@ -5116,112 +5253,114 @@ static void ProcessIKRules( void )
 					}
 					else 
 					{
-						CalcBoneTransforms( panim, pRule->contact, boneToWorld );
+						CalcBoneTransforms( panim, t, boneToWorld );
 					}
 
-					// FIXME: add in motion
+					Vector pos = pRule->pos + calcMovement( panim, t, pRule->contact );
+					s = 0.0;
 
-					Vector footfall = boneToWorld[bone].VectorTransform( g_ikchain[pRule->chain].center );
-					footfall.z = pRule->floor;
+					Vector cur = boneToWorld[bone].VectorTransform( g_ikchain[pRule->chain].center );
+					cur.z = pos.z;
 
-					local = matrix3x4( footfall, g_radZero );
-					worldToBone = local.Invert();
-
-					pRule->pos = footfall;
-					pRule->q = g_radZero;	// auto conversion Radian->Quaternion
-
-					float s;
-
-					for( k = 0; k < pRule->errorData.numerror; k++ )
+					if( t < pRule->start || t >= pRule->end )
 					{
-						int t = k + pRule->start;
-
-						if( pRule->usesequence )
-						{
-							CalcSeqTransforms( n, t, boneToWorld );
-						}
-						else if( pRule->usesource )
-						{
-							matrix3x4	srcBoneToWorld[MAXSTUDIOSRCBONES];
-							BuildRawTransforms( panim, pRule->contact + panim->startframe, panim->adjust, panim->rotation, srcBoneToWorld );
-							TranslateAnimations( panim->boneGlobalToLocal, srcBoneToWorld, boneToWorld );
-						}
-						else 
-						{
-							CalcBoneTransforms( panim, t, boneToWorld );
-						}
-
-						Vector pos = pRule->pos + calcMovement( panim, t, pRule->contact );
-						s = 0.0;
-
-						Vector cur = boneToWorld[bone].VectorTransform( g_ikchain[pRule->chain].center );
-						cur.z = pos.z;
-
-						if( t < pRule->start || t >= pRule->end )
-						{
-							pos = cur;
-						}
-						else if( t < pRule->peak )
-						{
-							s = (float)(pRule->peak - t) / (pRule->peak - pRule->start);
-							s = 3 * s * s - 2 * s * s * s;
-							pos = pos * (1 - s) + cur * s;
-						}
-						else if( t > pRule->tail )
-						{
-							s = (float)(t - pRule->tail) / (pRule->end - pRule->tail);
-							s = 3 * s * s - 2 * s * s * s;
-							pos = pos * (1 - s) + cur * s;
-						}
+						pos = cur;
+					}
+					else if( t < pRule->peak )
+					{
+						s = (float)(pRule->peak - t) / (pRule->peak - pRule->start);
+						s = 3 * s * s - 2 * s * s * s;
+						pos = pos * (1 - s) + cur * s;
+					}
+					else if( t > pRule->tail )
+					{
+						s = (float)(t - pRule->tail) / (pRule->end - pRule->tail);
+						s = 3 * s * s - 2 * s * s * s;
+						pos = pos * (1 - s) + cur * s;
+					}
 
-						local = matrix3x4( pos, pRule->q );
-						worldToBone = local.Invert();
+					local = matrix3x4( pos, pRule->q );
+					worldToBone = local.Invert();
 
-						// calc position error
-						local = worldToBone.ConcatTransforms( boneToWorld[bone] );
-						pRule->errorData.pError[k].q = local.GetQuaternion();
-						pRule->errorData.pError[k].pos = local.GetOrigin();
-					}
+					// calc position error
+					local = worldToBone.ConcatTransforms( boneToWorld[bone] );
+					pRule->errorData.pError[k].q = local.GetQuaternion();
+					pRule->errorData.pError[k].pos = local.GetOrigin();
 				}
-				break;
-			case IK_RELEASE:
-			case IK_UNLATCH:
-				break;
 			}
+			break;
+		case IK_RELEASE:
+		case IK_UNLATCH:
+			break;
 		}
+	}
 
-		if( FBitSet( panim->flags, STUDIO_DELTA ) || panim->noAutoIK )
-			continue;
+	if( FBitSet( panim->flags, STUDIO_DELTA ) || panim->noAutoIK )
+		return;
 
-		// auto release ik chains that are moved but not referenced and have no explicit rules
-		int count[16];
+	// auto release ik chains that are moved but not referenced and have no explicit rules
+	int count[16];
 
-		for( j = 0; j < g_numikchains; j++ )
-		{
-			count[j] = 0;
-		}
+	for( j = 0; j < g_numikchains; j++ )
+	{
+		count[j] = 0;
+	}
+
+	for( j = 0; j < panim->numikrules; j++ )
+	{
+		count[panim->ikrule[j].chain]++;
+	}
 
-		for( j = 0; j < panim->numikrules; j++ )
+	for( j = 0; j < g_numikchains; j++ )
+	{
+		if( count[j] == 0 && panim->weight[g_ikchain[j].link[2].bone] > 0.0f )
 		{
-			count[panim->ikrule[j].chain]++;
+			k = panim->numikrules++;
+			panim->ikrule[k].chain = j;
+			panim->ikrule[k].slot = j;
+			panim->ikrule[k].type = IK_RELEASE;
+			panim->ikrule[k].start = 0;
+			panim->ikrule[k].peak = 0;
+			panim->ikrule[k].tail = panim->numframes - 1;
+			panim->ikrule[k].end = panim->numframes - 1;
 		}
+	}
+}
 
-		for( j = 0; j < g_numikchains; j++ )
+//-----------------------------------------------------------------------------
+// Purpose: go through all the IK rules and calculate the animated path the IK'd 
+//			end point moves relative to its IK target.
+//-----------------------------------------------------------------------------
+static void ProcessIKRules( void )
+{
+	bool	threaded = true;
+	int	i, j, k;
+
+	// ikfixup modifies animation data that may be sampled
+	// by another animation's rules, so keep the serial order
+	for( i = 0; i < g_numani && threaded; i++ )
+	{
+		for( j = 0; j < g_panimation[i]->numcmds; j++ )
 		{
-			if( count[j] == 0 && panim->weight[g_ikchain[j].link[2].bone] > 0.0f )
+			if( g_panimation[i]->cmds[j].cmd == CMD_IKFIXUP )
 			{
-				k = panim->numikrules++;
-				panim->ikrule[k].chain = j;
-				panim->ikrule[k].slot = j;
-				panim->ikrule[k].type = IK_RELEASE;
-				panim->ikrule[k].start = 0;
-				panim->ikrule[k].peak = 0;
-				panim->ikrule[k].tail = panim->numframes - 1;
-				panim->ikrule[k].end = panim->numframes - 1;
+				threaded = false;
+				break;
 			}
 		}
 	}
 
+	// copy source animations
+	if( threaded )
+	{
+		RunThreadsOnIndividual( g_numani, false, ProcessAnimationIKRules );
+	}
+	else
+	{
+		for( i = 0; i < g_numani; i++ )
+			ProcessAnimationIKRules( i, 0 );
+	}
+
 	// realign IK across multiple animations
 	for( i = 0; i < g_numseq; i++ )
 	{
@@ -5277,26 +5416,27 @@ static void ProcessIKRules( void )
 	}
 }
 
-//-----------------------------------------------------------------------------
-// Compress all the IK data
-//-----------------------------------------------------------------------------
-static void CompressIKErrors( void )
+static void CompressAnimationIKErrors( int i, int threadnum )
 {
-	// find scales for all bones
-	for( int i = 0; i < g_numani; i++ )
+	for( int j = 0; j < g_panimation[i]->numikrules; j++ )
 	{
-		for( int j = 0; j < g_panimation[i]->numikrules; j++ )
-		{
-			s_ikrule_t *pRule = &g_panimation[i]->ikrule[j];
+		s_ikrule_t *pRule = &g_panimation[i]->ikrule[j];
 
-			if( pRule->errorData.numerror == 0 )
-				continue;
+		if( pRule->errorData.numerror == 0 )
+			continue;
 
-			CompressSingle( &pRule->errorData );
-		}
+		CompressSingle( &pRule->errorData );
 	}
 }
 
+//-----------------------------------------------------------------------------
+// Compress all the IK data
+//-----------------------------------------------------------------------------
+static void CompressIKErrors( void )
+{
+	RunThreadsOnIndividual( g_numani, false, CompressAnimationIKErrors );
+}
+
 void SimplifyModel( void )
 {
 	if( g_numseq == 0 )
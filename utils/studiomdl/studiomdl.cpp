@@ -19,6 +19,7 @@ GNU General Public License for more details.
 #include "stringlib.h"
 #include "scriplib.h"
 #include "filesystem.h"
+#include "threads.h"
 #define EXTERN
 #include "studio.h"
 #include "studiomdl.h"
@@ -5435,6 +5436,7 @@ int main( int argc, char **argv )
 		"^2-h^7 - dump hitboxes\n"
 		"^2-g^7 - dump transition graph\n"
 		"^2-dev^7 - shows developer messages\n"
+		"^2-threads^7 - number of threads to use\n"
 		"\n\t\tPress any key to exit" );
 
 		system( "pause>nul" );
@@ -5456,6 +5458,12 @@ int main( int argc, char **argv )
 				i++;
 				continue;
 			}
+			if( !Q_stricmp( argv[i], "-threads" ))
+			{
+				g_numthreads = verify_atoi( argv[i+1] );
+				i++;
+				continue;
+			}
 			switch( argv[i][1] )
 			{
 			case 't':
@@ -5499,6 +5507,8 @@ int main( int argc, char **argv )
 		return 1;
 	}
 
+	ThreadSetDefault ();
+
 	Q_strcpy( g_sequencegroup[g_numseqgroups].label, "default" );
 	g_numseqgroups = 1;
 
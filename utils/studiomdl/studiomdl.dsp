@@ -155,6 +155,10 @@ SOURCE=..\common\stringlib.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\common\threads.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\studiomdl.cpp
 # End Source File
 # Begin Source File